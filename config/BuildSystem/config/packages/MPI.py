@@ -244,6 +244,10 @@ class Configure(config.package.Package):
         self.addDefine('HAVE_MPI_WIN_CREATE_FEATURE',1)
         self.addDefine('HAVE_MPI_PROCESS_SHARED_MEMORY',1)
         self.support_mpi3_shm = 1
+    if self.checkLink('#include <mpi.h>\n', 'MPI_Comm ncomm; MPI_Request req; int c = 0;\nif (MPI_Dist_graph_create_adjacent(MPI_COMM_WORLD,0,&c,MPI_UNWEIGHTED,0,&c,MPI_UNWEIGHTED,MPI_INFO_NULL,0,&ncomm));\nif (MPI_Ineighbor_alltoallv(0,&c,&c,MPI_DOUBLE,0,&c,&c,MPI_DOUBLE,ncomm,&req));\n'):
+      self.addDefine('HAVE_MPI_NEIGHBORHOOD_COLLECTIVES', 1)
+      if self.checkLink('#include <mpi.h>\n', 'MPI_Request req; int c = 0;\nif (MPI_Neighbor_alltoallv_init(0,&c,&c,MPI_DOUBLE,0,&c,&c,MPI_DOUBLE,MPI_COMM_WORLD,MPI_INFO_NULL,&req));\n'):
+        self.addDefine('HAVE_MPI_PERSISTENT_NEIGHBORHOOD_COLLECTIVES', 1)
     self.compilers.CPPFLAGS = oldFlags
     self.compilers.LIBS = oldLibs
     self.logWrite(self.framework.restoreLog())
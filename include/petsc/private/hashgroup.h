@@ -0,0 +1,603 @@
+#if !defined(_PETSC_HASHGROUP_H)
+#define _PETSC_HASHGROUP_H
+
+#include <petsc/private/hashtable.h>
+#include <string.h>
+
+/*
+   Open addressing hash tables probed a group of slots at a time
+
+   Next to the keys (and values) each table keeps one control byte per slot: EMPTY, DELETED, or, for a slot in use,
+   the 7 high bits of the hash of its key. A lookup loads the control bytes of PETSC_HASH_GROUP_WIDTH consecutive slots
+   at once and compares all of them with the 7 bits of the key, with SSE2 when available, so that the keys are only
+   read for the (rare) slots whose bits match. The first PETSC_HASH_GROUP_WIDTH control bytes are repeated after the
+   last one so that a group starting near the end of the table can be loaded without wrapping around.
+
+   The capacity is a power of two of at least PETSC_HASH_GROUP_WIDTH slots, at most 7/8 of them are used or deleted
+   so that every probe sequence reaches a group with an EMPTY slot.
+*/
+
+#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__SSE2__)
+#include <immintrin.h>
+#define PETSC_HASH_GROUP_USE_SSE2
+#endif
+
+#define PETSC_HASH_GROUP_WIDTH   16
+#define PETSC_HASH_GROUP_EMPTY   ((signed char)-128)
+#define PETSC_HASH_GROUP_DELETED ((signed char)-2)
+/* number of keys hashed, and whose groups are prefetched, ahead of the insertions or lookups in the bulk operations */
+#define PETSC_HASH_GROUP_BATCH   64
+
+/* bit i of the result is set if control byte i of the group is c */
+PETSC_STATIC_INLINE unsigned PetscHashGroupMatch(const signed char *g,signed char c)
+{
+#if defined(PETSC_HASH_GROUP_USE_SSE2)
+  return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)g),_mm_set1_epi8(c)));
+#else
+  unsigned m = 0;
+  int      i;
+  for (i=0; i<PETSC_HASH_GROUP_WIDTH; i++) m |= (unsigned)(g[i] == c) << i;
+  return m;
+#endif
+}
+
+/* bit i of the result is set if slot i of the group is EMPTY or DELETED, the slots in use have a nonnegative control byte */
+PETSC_STATIC_INLINE unsigned PetscHashGroupMatchFree(const signed char *g)
+{
+#if defined(PETSC_HASH_GROUP_USE_SSE2)
+  return (unsigned)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)g));
+#else
+  unsigned m = 0;
+  int      i;
+  for (i=0; i<PETSC_HASH_GROUP_WIDTH; i++) m |= (unsigned)(g[i] < 0) << i;
+  return m;
+#endif
+}
+
+/* position of the lowest bit set in a nonzero mask */
+PETSC_STATIC_INLINE PetscInt PetscHashGroupFirst(unsigned m)
+{
+#if defined(__GNUC__)
+  return (PetscInt)__builtin_ctz(m);
+#else
+  PetscInt i = 0;
+  while (!(m & 1u)) {m >>= 1; i++;}
+  return i;
+#endif
+}
+
+/* control byte of a slot holding a key with hash h, the low bits of h give the first group to probe */
+#define PetscHashGroupH2(h) ((signed char)(((h) >> (8*sizeof(PetscHash_t)-7)) & 0x7f))
+
+/* smallest capacity in which n keys can be stored without growing */
+PETSC_STATIC_INLINE PetscInt PetscHashGroupCapacity(PetscInt n)
+{
+  PetscInt capacity = PETSC_HASH_GROUP_WIDTH;
+  while (capacity - capacity/8 < n) capacity *= 2;
+  return capacity;
+}
+
+/*
+   PETSC_HASH_GROUP_TABLE - The storage and probing shared by PETSC_HASH_SET_GROUP() and PETSC_HASH_MAP_GROUP(),
+   the values are only allocated if HasVals is 1
+*/
+#define PETSC_HASH_GROUP_TABLE(HashT, KeyType, ValType, HasVals, HashFunc, EqualFunc)               \
+                                                                                                    \
+typedef struct _n_Petsc##HashT {                                                                    \
+  signed char *ctrl;     /* capacity + PETSC_HASH_GROUP_WIDTH control bytes */                      \
+  KeyType     *keys;                                                                                \
+  ValType     *vals;                                                                                \
+  PetscInt     capacity; /* zero or a power of two */                                               \
+  PetscInt     size;     /* number of keys */                                                       \
+  PetscInt     growth;   /* number of EMPTY slots that can still be used before the table is rebuilt */ \
+} *Petsc##HashT;                                                                                    \
+                                                                                                    \
+PETSC_STATIC_INLINE PETSC_UNUSED                                                                    \
+void Petsc##HashT##SetCtrl_Private(Petsc##HashT ht,PetscInt i,signed char c)                        \
+{                                                                                                   \
+  ht->ctrl[i] = c;                                                                                  \
+  if (i < PETSC_HASH_GROUP_WIDTH) ht->ctrl[ht->capacity+i] = c;                                     \
+}                                                                                                   \
+                                                                                                    \
+/* slot of key, or -1; avail is set to the first EMPTY or DELETED slot of the probe sequence */     \
+PETSC_STATIC_INLINE PETSC_UNUSED                                                                    \
+PetscInt Petsc##HashT##Lookup_Private(Petsc##HashT ht,KeyType key,PetscHash_t h,PetscInt *avail)    \
+{                                                                                                   \
+  const PetscInt    mask = ht->capacity-1;                                                          \
+  const signed char h2   = PetscHashGroupH2(h);                                                     \
+  PetscInt          pos  = (PetscInt)h & mask,step = 0,i;                                           \
+  unsigned          m;                                                                              \
+  *avail = -1;                                                                                      \
+  if (!ht->capacity) return -1;                                                                     \
+  for (;;) {                                                                                        \
+    const signed char *g = ht->ctrl + pos;                                                          \
+    for (m = PetscHashGroupMatch(g,h2); m; m &= m-1) {                                              \
+      i = (pos + PetscHashGroupFirst(m)) & mask;                                                    \
+      if (EqualFunc(ht->keys[i],key)) return i;                                                     \
+    }                                                                                               \
+    if (*avail < 0 && (m = PetscHashGroupMatchFree(g))) *avail = (pos + PetscHashGroupFirst(m)) & mask; \
+    if (PetscHashGroupMatch(g,PETSC_HASH_GROUP_EMPTY)) return -1;                                   \
+    step += PETSC_HASH_GROUP_WIDTH;                                                                 \
+    pos   = (pos + step) & mask;                                                                    \
+  }                                                                                                 \
+}                                                                                                   \
+                                                                                                    \
+/* first EMPTY or DELETED slot of the probe sequence of h */                                        \
+PETSC_STATIC_INLINE PETSC_UNUSED                                                                    \
+PetscInt Petsc##HashT##FindFree_Private(Petsc##HashT ht,PetscHash_t h)                              \
+{                                                                                                   \
+  const PetscInt mask = ht->capacity-1;                                                             \
+  PetscInt       pos  = (PetscInt)h & mask,step = 0;                                                \
+  unsigned       m;                                                                                 \
+  while (!(m = PetscHashGroupMatchFree(ht->ctrl + pos))) {                                          \
+    step += PETSC_HASH_GROUP_WIDTH;                                                                 \
+    pos   = (pos + step) & mask;                                                                    \
+  }                                                                                                 \
+  return (pos + PetscHashGroupFirst(m)) & mask;                                                     \
+}                                                                                                   \
+                                                                                                    \
+/* moves the keys to a table of the given capacity, this also drops the DELETED slots */            \
+PETSC_STATIC_INLINE PETSC_UNUSED                                                                    \
+PetscErrorCode Petsc##HashT##Rehash_Private(Petsc##HashT ht,PetscInt capacity)                      \
+{                                                                                                   \
+  signed char    *ctrl = ht->ctrl;                                                                  \
+  KeyType        *keys = ht->keys;                                                                  \
+  ValType        *vals = ht->vals;                                                                  \
+  PetscInt       oldcapacity = ht->capacity,i,j;                                                    \
+  PetscErrorCode ierr;                                                                              \
+  PetscFunctionBegin;                                                                               \
+  ierr = PetscMalloc1(capacity+PETSC_HASH_GROUP_WIDTH,&ht->ctrl);CHKERRQ(ierr);                     \
+  ierr = PetscMalloc1(capacity,&ht->keys);CHKERRQ(ierr);                                            \
+  if (HasVals) {ierr = PetscMalloc1(capacity,&ht->vals);CHKERRQ(ierr);}                             \
+  memset(ht->ctrl,PETSC_HASH_GROUP_EMPTY,(size_t)(capacity+PETSC_HASH_GROUP_WIDTH));                \
+  ht->capacity = capacity;                                                                          \
+  ht->growth   = capacity - capacity/8 - ht->size;                                                  \
+  for (i=0; i<oldcapacity; i++) {                                                                   \
+    PetscHash_t h;                                                                                  \
+    if (ctrl[i] < 0) continue;                                                                      \
+    h = HashFunc(keys[i]);                                                                          \
+    j = Petsc##HashT##FindFree_Private(ht,h);                                                       \
+    Petsc##HashT##SetCtrl_Private(ht,j,PetscHashGroupH2(h));                                        \
+    ht->keys[j] = keys[i];                                                                          \
+    if (HasVals) ht->vals[j] = vals[i];                                                             \
+  }                                                                                                 \
+  ierr = PetscFree(ctrl);CHKERRQ(ierr);                                                             \
+  ierr = PetscFree(keys);CHKERRQ(ierr);                                                             \
+  ierr = PetscFree(vals);CHKERRQ(ierr);                                                             \
+  PetscFunctionReturn(0);                                                                           \
+}                                                                                                   \
+                                                                                                    \
+/* makes room for n more keys without another rehash */                                             \
+PETSC_STATIC_INLINE PETSC_UNUSED                                                                    \
+PetscErrorCode Petsc##HashT##Reserve_Private(Petsc##HashT ht,PetscInt n)                            \
+{                                                                                                   \
+  PetscInt       capacity;                                                                          \
+  PetscErrorCode ierr;                                                                              \
+  PetscFunctionBegin;                                                                               \
+  if (ht->growth >= n) PetscFunctionReturn(0);                                                      \
+  capacity = PetscHashGroupCapacity(ht->size + n);                                                  \
+  /* rebuild in place if dropping the DELETED slots leaves enough room, otherwise at least double */ \
+  if (capacity <= ht->capacity && ht->size + n <= ht->capacity/2) capacity = ht->capacity;          \
+  else capacity = PetscMax(capacity,2*ht->capacity);                                                \
+  ierr = Petsc##HashT##Rehash_Private(ht,capacity);CHKERRQ(ierr);                                   \
+  PetscFunctionReturn(0);                                                                           \
+}                                                                                                   \
+                                                                                                    \
+/* slot of key, which is added if missing; there must be room for one more key */                   \
+PETSC_STATIC_INLINE PETSC_UNUSED                                                                    \
+PetscInt Petsc##HashT##Insert_Private(Petsc##HashT ht,KeyType key,PetscHash_t h,PetscBool *missing) \
+{                                                                                                   \
+  PetscInt i,avail;                                                                                 \
+  i = Petsc##HashT##Lookup_Private(ht,key,h,&avail);                                                \
+  if (i >= 0) {*missing = PETSC_FALSE; return i;}                                                   \
+  if (avail < 0) avail = Petsc##HashT##FindFree_Private(ht,h);                                      \
+  if (ht->ctrl[avail] == PETSC_HASH_GROUP_EMPTY) ht->growth--;                                      \
+  Petsc##HashT##SetCtrl_Private(ht,avail,PetscHashGroupH2(h));                                      \
+  ht->keys[avail] = key;                                                                            \
+  ht->size++;                                                                                       \
+  *missing = PETSC_TRUE;                                                                            \
+  return avail;                                                                                     \
+}                                                                                                   \
+                                                                                                    \
+PETSC_STATIC_INLINE PETSC_UNUSED                                                                    \
+PetscErrorCode Petsc##HashT##Create(Petsc##HashT *ht)                                               \
+{                                                                                                   \
+  PetscErrorCode ierr;                                                                              \
+  PetscFunctionBegin;                                                                               \
+  PetscValidPointer(ht,1);                                                                          \
+  ierr = PetscNew(ht);CHKERRQ(ierr);                                                                \
+  PetscFunctionReturn(0);                                                                           \
+}                                                                                                   \
+                                                                                                    \
+PETSC_STATIC_INLINE PETSC_UNUSED                                                                    \
+PetscErrorCode Petsc##HashT##Reset(Petsc##HashT ht)                                                 \
+{                                                                                                   \
+  PetscErrorCode ierr;                                                                              \
+  PetscFunctionBegin;                                                                               \
+  PetscValidPointer(ht,1);                                                                          \
+  ierr = PetscFree(ht->ctrl);CHKERRQ(ierr);                                                         \
+  ierr = PetscFree(ht->keys);CHKERRQ(ierr);                                                         \
+  ierr = PetscFree(ht->vals);CHKERRQ(ierr);                                                         \
+  ht->capacity = ht->size = ht->growth = 0;                                                         \
+  PetscFunctionReturn(0);                                                                           \
+}                                                                                                   \
+                                                                                                    \
+PETSC_STATIC_INLINE PETSC_UNUSED                                                                    \
+PetscErrorCode Petsc##HashT##Destroy(Petsc##HashT *ht)                                              \
+{                                                                                                   \
+  PetscErrorCode ierr;                                                                              \
+  PetscFunctionBegin;                                                                               \
+  PetscValidPointer(ht,1);                                                                          \
+  if (!*ht) PetscFunctionReturn(0);                                                                 \
+  ierr = Petsc##HashT##Reset(*ht);CHKERRQ(ierr);                                                    \
+  ierr = PetscFree(*ht);CHKERRQ(ierr);                                                              \
+  PetscFunctionReturn(0);                                                                           \
+}                                                                                                   \
+                                                                                                    \
+PETSC_STATIC_INLINE PETSC_UNUSED                                                                    \
+PetscErrorCode Petsc##HashT##Clear(Petsc##HashT ht)                                                 \
+{                                                                                                   \
+  PetscFunctionBegin;                                                                               \
+  PetscValidPointer(ht,1);                                                                          \
+  if (!ht->capacity) PetscFunctionReturn(0);                                                        \
+  memset(ht->ctrl,PETSC_HASH_GROUP_EMPTY,(size_t)(ht->capacity+PETSC_HASH_GROUP_WIDTH));            \
+  ht->size   = 0;                                                                                   \
+  ht->growth = ht->capacity - ht->capacity/8;                                                       \
+  PetscFunctionReturn(0);                                                                           \
+}                                                                                                   \
+                                                                                                    \
+PETSC_STATIC_INLINE PETSC_UNUSED                                                                    \
+PetscErrorCode Petsc##HashT##Resize(Petsc##HashT ht,PetscInt nb)                                    \
+{                                                                                                   \
+  PetscErrorCode ierr;                                                                              \
+  PetscFunctionBegin;                                                                               \
+  PetscValidPointer(ht,1);                                                                          \
+  if (nb > ht->size) {ierr = Petsc##HashT##Reserve_Private(ht,nb - ht->size);CHKERRQ(ierr);}        \
+  PetscFunctionReturn(0);                                                                           \
+}                                                                                                   \
+                                                                                                    \
+PETSC_STATIC_INLINE PETSC_UNUSED                                                                    \
+PetscErrorCode Petsc##HashT##GetSize(Petsc##HashT ht,PetscInt *n)                                   \
+{                                                                                                   \
+  PetscFunctionBegin;                                                                               \
+  PetscValidPointer(ht,1);                                                                          \
+  PetscValidIntPointer(n,2);                                                                        \
+  *n = ht->size;                                                                                    \
+  PetscFunctionReturn(0);                                                                           \
+}                                                                                                   \
+                                                                                                    \
+PETSC_STATIC_INLINE PETSC_UNUSED                                                                    \
+PetscErrorCode Petsc##HashT##Has(Petsc##HashT ht,KeyType key,PetscBool *has)                        \
+{                                                                                                   \
+  PetscInt avail;                                                                                   \
+  PetscFunctionBeginHot;                                                                            \
+  PetscValidPointer(ht,1);                                                                          \
+  PetscValidPointer(has,3);                                                                         \
+  *has = Petsc##HashT##Lookup_Private(ht,key,HashFunc(key),&avail) >= 0 ? PETSC_TRUE : PETSC_FALSE; \
+  PetscFunctionReturn(0);                                                                           \
+}                                                                                                   \
+                                                                                                    \
+PETSC_STATIC_INLINE PETSC_UNUSED                                                                    \
+PetscErrorCode Petsc##HashT##HasMany(Petsc##HashT ht,PetscInt n,const KeyType keys[],PetscBool has[]) \
+{                                                                                                   \
+  PetscHash_t h[PETSC_HASH_GROUP_BATCH];                                                            \
+  PetscInt    b,i,nb,avail;                                                                         \
+  PetscFunctionBeginHot;                                                                            \
+  PetscValidPointer(ht,1);                                                                          \
+  if (!ht->size) {for (i=0; i<n; i++) has[i] = PETSC_FALSE; PetscFunctionReturn(0);}                \
+  for (b=0; b<n; b+=nb) {                                                                           \
+    nb = PetscMin(PETSC_HASH_GROUP_BATCH,n-b);                                                      \
+    for (i=0; i<nb; i++) {                                                                          \
+      h[i] = HashFunc(keys[b+i]);                                                                   \
+      PETSC_Prefetch(ht->ctrl + ((PetscInt)h[i] & (ht->capacity-1)),0,PETSC_PREFETCH_HINT_T0);      \
+    }                                                                                               \
+    for (i=0; i<nb; i++) has[b+i] = Petsc##HashT##Lookup_Private(ht,keys[b+i],h[i],&avail) >= 0 ? PETSC_TRUE : PETSC_FALSE; \
+  }                                                                                                 \
+  PetscFunctionReturn(0);                                                                           \
+}                                                                                                   \
+                                                                                                    \
+PETSC_STATIC_INLINE PETSC_UNUSED                                                                    \
+PetscErrorCode Petsc##HashT##Del(Petsc##HashT ht,KeyType key)                                       \
+{                                                                                                   \
+  PetscInt i,avail;                                                                                 \
+  PetscFunctionBeginHot;                                                                            \
+  PetscValidPointer(ht,1);                                                                          \
+  i = Petsc##HashT##Lookup_Private(ht,key,HashFunc(key),&avail);                                    \
+  if (i >= 0) {Petsc##HashT##SetCtrl_Private(ht,i,PETSC_HASH_GROUP_DELETED); ht->size--;}           \
+  PetscFunctionReturn(0);                                                                           \
+}                                                                                                   \
+
+/*MC
+  PETSC_HASH_SET_GROUP - Instantiate a PETSc hash table set type probed a group of slots at a time
+
+  Synopsis:
+  #include <petsc/private/hashgroup.h>
+  PETSC_HASH_SET_GROUP(HSetTG, KeyType, HashFunc, EqualFunc)
+
+  Input Parameters:
++ HSetTG - The hash table set type name suffix
+. KeyType - The type of entries
+. HashFunc - Routine or function-like macro computing hash values from entries
+- EqualFunc - Routine or function-like macro computing whether two values are equal
+
+  Notes:
+  The type has the interface of PETSC_HASH_SET() without Duplicate(), QueryDel() and the PetscHashIter iterators,
+  plus the bulk operations PetscHSetTGAddMany() and PetscHSetTGHasMany(). It is faster than PETSC_HASH_SET() for large
+  sets and for sets filled and queried from arrays.
+
+  Level: developer
+
+  Concepts: hash table, set
+
+.keywords: hash table, set
+.seealso: PETSC_HASH_SET(), PETSC_HASH_MAP_GROUP(), PetscHSetTGAddMany(), PetscHSetTGHasMany()
+M*/
+
+/*MC
+  PetscHSetTGAddMany - Adds the entries of an array to a hash table set
+
+  Synopsis:
+  #include <petsc/private/hashgroup.h>
+  PetscErrorCode PetscHSetTGAddMany(PetscHSetTG ht,PetscInt n,const KeyType keys[])
+
+  Input Parameters:
++ ht   - The hash table
+. n    - The number of entries
+- keys - The entries, which may be repeated
+
+  Notes:
+  The entries are hashed and their groups prefetched PETSC_HASH_GROUP_BATCH at a time, ahead of the insertions,
+  and the table grows at most once per batch.
+
+  Level: developer
+
+  Concepts: hash table, set
+
+.keywords: hash table, set, add
+.seealso: PetscHSetTGHasMany(), PetscHSetTGGetElems()
+M*/
+
+/*MC
+  PetscHSetTGHasMany - Queries whether the entries of an array are in a hash table set
+
+  Synopsis:
+  #include <petsc/private/hashgroup.h>
+  PetscErrorCode PetscHSetTGHasMany(PetscHSetTG ht,PetscInt n,const KeyType keys[],PetscBool has[])
+
+  Input Parameters:
++ ht   - The hash table
+. n    - The number of entries
+- keys - The entries
+
+  Output Parameter:
+. has  - Whether each entry is in the set
+
+  Level: developer
+
+  Concepts: hash table, set
+
+.keywords: hash table, set, search
+.seealso: PetscHSetTGAddMany()
+M*/
+
+#define PETSC_HASH_SET_GROUP(HashT, KeyType, HashFunc, EqualFunc)                                   \
+                                                                                                    \
+PETSC_HASH_GROUP_TABLE(HashT, KeyType, char, 0, HashFunc, EqualFunc)                                \
+                                                                                                    \
+PETSC_STATIC_INLINE PETSC_UNUSED                                                                    \
+PetscErrorCode Petsc##HashT##QueryAdd(Petsc##HashT ht,KeyType key,PetscBool *missing)               \
+{                                                                                                   \
+  PetscErrorCode ierr;                                                                              \
+  PetscFunctionBeginHot;                                                                            \
+  PetscValidPointer(ht,1);                                                                          \
+  PetscValidPointer(missing,3);                                                                     \
+  ierr = Petsc##HashT##Reserve_Private(ht,1);CHKERRQ(ierr);                                         \
+  (void)Petsc##HashT##Insert_Private(ht,key,HashFunc(key),missing);                                 \
+  PetscFunctionReturn(0);                                                                           \
+}                                                                                                   \
+                                                                                                    \
+PETSC_STATIC_INLINE PETSC_UNUSED                                                                    \
+PetscErrorCode Petsc##HashT##Add(Petsc##HashT ht,KeyType key)                                       \
+{                                                                                                   \
+  PetscBool      missing;                                                                           \
+  PetscErrorCode ierr;                                                                              \
+  PetscFunctionBeginHot;                                                                            \
+  ierr = Petsc##HashT##QueryAdd(ht,key,&missing);CHKERRQ(ierr);                                     \
+  PetscFunctionReturn(0);                                                                           \
+}                                                                                                   \
+                                                                                                    \
+PETSC_STATIC_INLINE PETSC_UNUSED                                                                    \
+PetscErrorCode Petsc##HashT##AddMany(Petsc##HashT ht,PetscInt n,const KeyType keys[])               \
+{                                                                                                   \
+  PetscHash_t    h[PETSC_HASH_GROUP_BATCH];                                                         \
+  PetscInt       b,i,nb;                                                                            \
+  PetscBool      missing;                                                                           \
+  PetscErrorCode ierr;                                                                              \
+  PetscFunctionBeginHot;                                                                            \
+  PetscValidPointer(ht,1);                                                                          \
+  for (b=0; b<n; b+=nb) {                                                                           \
+    nb   = PetscMin(PETSC_HASH_GROUP_BATCH,n-b);                                                    \
+    ierr = Petsc##HashT##Reserve_Private(ht,nb);CHKERRQ(ierr);                                      \
+    for (i=0; i<nb; i++) {                                                                          \
+      h[i] = HashFunc(keys[b+i]);                                                                   \
+      PETSC_Prefetch(ht->ctrl + ((PetscInt)h[i] & (ht->capacity-1)),0,PETSC_PREFETCH_HINT_T0);      \
+    }                                                                                               \
+    for (i=0; i<nb; i++) (void)Petsc##HashT##Insert_Private(ht,keys[b+i],h[i],&missing);            \
+  }                                                                                                 \
+  PetscFunctionReturn(0);                                                                           \
+}                                                                                                   \
+                                                                                                    \
+PETSC_STATIC_INLINE PETSC_UNUSED                                                                    \
+PetscErrorCode Petsc##HashT##GetElems(Petsc##HashT ht,PetscInt *off,KeyType array[])                \
+{                                                                                                   \
+  PetscInt i,pos;                                                                                   \
+  PetscFunctionBegin;                                                                               \
+  PetscValidPointer(ht,1);                                                                          \
+  PetscValidIntPointer(off,2);                                                                      \
+  pos = *off;                                                                                       \
+  for (i=0; i<ht->capacity; i++) if (ht->ctrl[i] >= 0) array[pos++] = ht->keys[i];                  \
+  *off = pos;                                                                                       \
+  PetscFunctionReturn(0);                                                                           \
+}                                                                                                   \
+
+/*MC
+  PETSC_HASH_MAP_GROUP - Instantiate a PETSc hash table map type probed a group of slots at a time
+
+  Synopsis:
+  #include <petsc/private/hashgroup.h>
+  PETSC_HASH_MAP_GROUP(HMapTG, KeyType, ValType, HashFunc, EqualFunc, DefaultValue)
+
+  Input Parameters:
++ HMapTG - The hash table map type name suffix
+. KeyType - The type of keys
+. ValType - The type of values
+. HashFunc - Routine or function-like macro computing hash values from keys
+. EqualFunc - Routine or function-like macro computing whether two values are equal
+- DefaultValue - Default value to use for queries in case of missing keys
+
+  Notes:
+  The type has the Create(), Destroy(), Reset(), Clear(), Resize(), GetSize(), Has(), Get(), Set(), Del() and
+  GetPairs() operations of PETSC_HASH_MAP(), plus the bulk operations PetscHMapTGGetMany() and PetscHMapTGSetMany().
+
+  Level: developer
+
+  Concepts: hash table, map
+
+.keywords: hash table, map
+.seealso: PETSC_HASH_MAP(), PETSC_HASH_SET_GROUP(), PetscHMapTGGetMany(), PetscHMapTGSetMany()
+M*/
+
+/*MC
+  PetscHMapTGGetMany - Gets the values of the keys of an array in a hash table map
+
+  Synopsis:
+  #include <petsc/private/hashgroup.h>
+  PetscErrorCode PetscHMapTGGetMany(PetscHMapTG ht,PetscInt n,const KeyType keys[],ValType vals[])
+
+  Input Parameters:
++ ht   - The hash table
+. n    - The number of keys
+- keys - The keys
+
+  Output Parameter:
+. vals - The values, the default value of the map for the missing keys
+
+  Level: developer
+
+  Concepts: hash table, map
+
+.keywords: hash table, map, get
+.seealso: PetscHMapTGSetMany()
+M*/
+
+/*MC
+  PetscHMapTGSetMany - Sets the values of the keys of an array in a hash table map
+
+  Synopsis:
+  #include <petsc/private/hashgroup.h>
+  PetscErrorCode PetscHMapTGSetMany(PetscHMapTG ht,PetscInt n,const KeyType keys[],const ValType vals[])
+
+  Input Parameters:
++ ht   - The hash table
+. n    - The number of keys
+. keys - The keys, if one is repeated the last value is kept
+- vals - The values
+
+  Level: developer
+
+  Concepts: hash table, map
+
+.keywords: hash table, map, set
+.seealso: PetscHMapTGGetMany()
+M*/
+
+#define PETSC_HASH_MAP_GROUP(HashT, KeyType, ValType, HashFunc, EqualFunc, DefaultValue)            \
+                                                                                                    \
+PETSC_HASH_GROUP_TABLE(HashT, KeyType, ValType, 1, HashFunc, EqualFunc)                             \
+                                                                                                    \
+PETSC_STATIC_INLINE PETSC_UNUSED                                                                    \
+PetscErrorCode Petsc##HashT##Get(Petsc##HashT ht,KeyType key,ValType *val)                          \
+{                                                                                                   \
+  PetscInt i,avail;                                                                                 \
+  PetscFunctionBeginHot;                                                                            \
+  PetscValidPointer(ht,1);                                                                          \
+  PetscValidPointer(val,3);                                                                         \
+  i    = Petsc##HashT##Lookup_Private(ht,key,HashFunc(key),&avail);                                 \
+  *val = i >= 0 ? ht->vals[i] : (DefaultValue);                                                     \
+  PetscFunctionReturn(0);                                                                           \
+}                                                                                                   \
+                                                                                                    \
+PETSC_STATIC_INLINE PETSC_UNUSED                                                                    \
+PetscErrorCode Petsc##HashT##Set(Petsc##HashT ht,KeyType key,ValType val)                           \
+{                                                                                                   \
+  PetscBool      missing;                                                                           \
+  PetscErrorCode ierr;                                                                              \
+  PetscFunctionBeginHot;                                                                            \
+  PetscValidPointer(ht,1);                                                                          \
+  ierr = Petsc##HashT##Reserve_Private(ht,1);CHKERRQ(ierr);                                         \
+  ht->vals[Petsc##HashT##Insert_Private(ht,key,HashFunc(key),&missing)] = val;                      \
+  PetscFunctionReturn(0);                                                                           \
+}                                                                                                   \
+                                                                                                    \
+PETSC_STATIC_INLINE PETSC_UNUSED                                                                    \
+PetscErrorCode Petsc##HashT##GetMany(Petsc##HashT ht,PetscInt n,const KeyType keys[],ValType vals[]) \
+{                                                                                                   \
+  PetscHash_t h[PETSC_HASH_GROUP_BATCH];                                                            \
+  PetscInt    b,i,j,nb,avail;                                                                       \
+  PetscFunctionBeginHot;                                                                            \
+  PetscValidPointer(ht,1);                                                                          \
+  if (!ht->size) {for (i=0; i<n; i++) vals[i] = (DefaultValue); PetscFunctionReturn(0);}            \
+  for (b=0; b<n; b+=nb) {                                                                           \
+    nb = PetscMin(PETSC_HASH_GROUP_BATCH,n-b);                                                      \
+    for (i=0; i<nb; i++) {                                                                          \
+      h[i] = HashFunc(keys[b+i]);                                                                   \
+      PETSC_Prefetch(ht->ctrl + ((PetscInt)h[i] & (ht->capacity-1)),0,PETSC_PREFETCH_HINT_T0);      \
+    }                                                                                               \
+    for (i=0; i<nb; i++) {                                                                          \
+      j         = Petsc##HashT##Lookup_Private(ht,keys[b+i],h[i],&avail);                           \
+      vals[b+i] = j >= 0 ? ht->vals[j] : (DefaultValue);                                            \
+    }                                                                                               \
+  }                                                                                                 \
+  PetscFunctionReturn(0);                                                                           \
+}                                                                                                   \
+                                                                                                    \
+PETSC_STATIC_INLINE PETSC_UNUSED                                                                    \
+PetscErrorCode Petsc##HashT##SetMany(Petsc##HashT ht,PetscInt n,const KeyType keys[],const ValType vals[]) \
+{                                                                                                   \
+  PetscHash_t    h[PETSC_HASH_GROUP_BATCH];                                                         \
+  PetscInt       b,i,nb;                                                                            \
+  PetscBool      missing;                                                                           \
+  PetscErrorCode ierr;                                                                              \
+  PetscFunctionBeginHot;                                                                            \
+  PetscValidPointer(ht,1);                                                                          \
+  for (b=0; b<n; b+=nb) {                                                                           \
+    nb   = PetscMin(PETSC_HASH_GROUP_BATCH,n-b);                                                    \
+    ierr = Petsc##HashT##Reserve_Private(ht,nb);CHKERRQ(ierr);                                      \
+    for (i=0; i<nb; i++) {                                                                          \
+      h[i] = HashFunc(keys[b+i]);                                                                   \
+      PETSC_Prefetch(ht->ctrl + ((PetscInt)h[i] & (ht->capacity-1)),0,PETSC_PREFETCH_HINT_T0);      \
+    }                                                                                               \
+    for (i=0; i<nb; i++) ht->vals[Petsc##HashT##Insert_Private(ht,keys[b+i],h[i],&missing)] = vals[b+i]; \
+  }                                                                                                 \
+  PetscFunctionReturn(0);                                                                           \
+}                                                                                                   \
+                                                                                                    \
+PETSC_STATIC_INLINE PETSC_UNUSED                                                                    \
+PetscErrorCode Petsc##HashT##GetPairs(Petsc##HashT ht,PetscInt *off,KeyType karray[],ValType varray[]) \
+{                                                                                                   \
+  PetscInt i,pos;                                                                                   \
+  PetscFunctionBegin;                                                                               \
+  PetscValidPointer(ht,1);                                                                          \
+  PetscValidIntPointer(off,2);                                                                      \
+  pos = *off;                                                                                       \
+  for (i=0; i<ht->capacity; i++) {                                                                  \
+    if (ht->ctrl[i] < 0) continue;                                                                  \
+    if (karray) karray[pos] = ht->keys[i];                                                          \
+    if (varray) varray[pos] = ht->vals[i];                                                          \
+    pos++;                                                                                          \
+  }                                                                                                 \
+  *off = pos;                                                                                       \
+  PetscFunctionReturn(0);                                                                           \
+}                                                                                                   \
+
+#endif /* _PETSC_HASHGROUP_H */
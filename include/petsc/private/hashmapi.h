@@ -2,7 +2,49 @@
 #define _PETSC_HASHMAPI_H
 
 #include <petsc/private/hashmap.h>
+#include <petsc/private/hashgroup.h>
 
 PETSC_HASH_MAP(HMapI, PetscInt, PetscInt, PetscHashInt, PetscHashEqual, -1)
 
+PETSC_HASH_MAP_GROUP(HMapIG, PetscInt, PetscInt, PetscHashInt, PetscHashEqual, -1)
+
+/*MC
+  PetscHMapIGGetPairsSorted - Get all the (key,value) pairs of a hash table map of integers in increasing key order
+
+  Synopsis:
+  #include <petsc/private/hashmapi.h>
+  PetscErrorCode PetscHMapIGGetPairsSorted(PetscHMapIG ht,PetscInt *off,PetscInt karray[],PetscInt varray[])
+
+  Input Parameters:
++ ht     - The hash table
+. off    - Input offset in array (usually zero)
+. karray - Array where to put hash table keys into
+- varray - Array where to put hash table values into
+
+  Output Parameter:
++ off    - Output offset in array (output offset = input offset + hash table size)
+. karray - Array filled with the hash table keys, sorted from the input offset on
+- varray - Array filled with the hash table values, in the order of the keys
+
+  Level: developer
+
+  Concepts: hash table, map
+
+.keywords: hash table, map, array, sort
+.seealso: PetscHMapIGGetPairs(), PetscSortIntWithArray()
+M*/
+PETSC_STATIC_INLINE PETSC_UNUSED
+PetscErrorCode PetscHMapIGGetPairsSorted(PetscHMapIG ht,PetscInt *off,PetscInt karray[],PetscInt varray[])
+{
+  PetscInt       start;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidIntPointer(off,2);
+  start = *off;
+  ierr  = PetscHMapIGGetPairs(ht,off,karray,varray);CHKERRQ(ierr);
+  ierr  = PetscSortIntWithArray(*off-start,karray+start,varray+start);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #endif /* _PETSC_HASHMAPI_H */
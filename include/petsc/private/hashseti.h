@@ -2,7 +2,47 @@
 #define _PETSC_HASHSETI_H
 
 #include <petsc/private/hashset.h>
+#include <petsc/private/hashgroup.h>
 
 PETSC_HASH_SET(HSetI, PetscInt, PetscHashInt, PetscHashEqual)
 
+PETSC_HASH_SET_GROUP(HSetIG, PetscInt, PetscHashInt, PetscHashEqual)
+
+/*MC
+  PetscHSetIGGetElemsSorted - Get all the entries of a hash table set of integers in increasing order
+
+  Synopsis:
+  #include <petsc/private/hashseti.h>
+  PetscErrorCode PetscHSetIGGetElemsSorted(PetscHSetIG ht,PetscInt *off,PetscInt array[])
+
+  Input Parameters:
++ ht    - The hash table
+. off   - Input offset in array (usually zero)
+- array - Array where to put hash table entries into
+
+  Output Parameter:
++ off   - Output offset in array (output offset = input offset + hash table size)
+- array - Array filled with the hash table entries, sorted from the input offset on
+
+  Level: developer
+
+  Concepts: hash table, set
+
+.keywords: hash table, set, array, sort
+.seealso: PetscHSetIGGetElems(), PetscSortInt()
+M*/
+PETSC_STATIC_INLINE PETSC_UNUSED
+PetscErrorCode PetscHSetIGGetElemsSorted(PetscHSetIG ht,PetscInt *off,PetscInt array[])
+{
+  PetscInt       start;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidIntPointer(off,2);
+  start = *off;
+  ierr  = PetscHSetIGGetElems(ht,off,array);CHKERRQ(ierr);
+  ierr  = PetscSortInt(*off-start,array+start);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #endif /* _PETSC_HASHSETI_H */
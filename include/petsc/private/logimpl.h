@@ -24,6 +24,14 @@ typedef struct _Action {
   int            id1, id2, id3; /* The ids of associated objects */
 } Action;
 
+/* The structure for timeline tracing, see PetscLogTraceJSONBegin() */
+typedef struct _TraceRecord {
+  PetscLogDouble time;          /* The time of occurence */
+  PetscLogEvent  event;         /* The event number */
+  int            stage;         /* The stage active when the record was made */
+  int            action;        /* ACTIONBEGIN or ACTIONEND */
+} TraceRecord;
+
 /* The structure for object logging */
 typedef struct _Object {
   PetscObject    obj;      /* The associated PetscObject */
@@ -50,6 +58,14 @@ PETSC_EXTERN const char    *petsc_traceblanks;
 PETSC_EXTERN char           petsc_tracespace[128];
 PETSC_EXTERN PetscLogDouble petsc_tracetime;
 
+PETSC_EXTERN TraceRecord   *petsc_traceRecords;
+PETSC_EXTERN int            petsc_maxTraceRecords;
+PETSC_EXTERN PetscInt64     petsc_numTraceRecords;
+
+/* Hardware counter logging, see PetscLogHWCountersBegin() */
+PETSC_EXTERN PetscBool      petsc_logHWCounters;
+PETSC_EXTERN PetscBool      petsc_logHWCountersFailed;
+
 #ifdef PETSC_USE_LOG
 
 PETSC_EXTERN PetscErrorCode PetscIntStackCreate(PetscIntStack *);
@@ -87,6 +103,13 @@ PETSC_EXTERN PetscErrorCode PetscLogEventBeginComplete(PetscLogEvent, int, Petsc
 PETSC_EXTERN PetscErrorCode PetscLogEventEndComplete(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject);
 PETSC_EXTERN PetscErrorCode PetscLogEventBeginTrace(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject);
 PETSC_EXTERN PetscErrorCode PetscLogEventEndTrace(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject);
+PETSC_EXTERN PetscErrorCode PetscLogEventBeginTraceJSON(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject);
+PETSC_EXTERN PetscErrorCode PetscLogEventEndTraceJSON(PetscLogEvent, int, PetscObject, PetscObject, PetscObject, PetscObject);
+PETSC_INTERN PetscErrorCode PetscLogHWCountersSubtract(PetscEventPerfInfo *);
+PETSC_INTERN PetscErrorCode PetscLogHWCountersAdd(PetscEventPerfInfo *);
+PETSC_INTERN PetscErrorCode PetscLogMallocSubtract(PetscEventPerfInfo *);
+PETSC_INTERN PetscErrorCode PetscLogMallocAdd(PetscEventPerfInfo *);
+PETSC_INTERN PetscErrorCode PetscLogMallocPopMaximumUsage(int,PetscEventPerfInfo *);
 
 /* Creation and destruction functions */
 PETSC_EXTERN PetscErrorCode PetscClassRegLogCreate(PetscClassRegLog *);
@@ -184,6 +184,12 @@ PETSC_EXTERN PetscErrorCode PetscObjectGetFortranCallback(PetscObject,PetscFortr
 
 PETSC_INTERN PetscErrorCode PetscCitationsInitialize(void);
 PETSC_INTERN PetscErrorCode PetscFreeMPIResources(void);
+PETSC_INTERN PetscErrorCode PetscMallocArenaUnwind(const char[]);
+/* the integer sorts use a radix sort instead of quicksort from this length */
+#if !defined(PETSC_SORT_RADIX_THRESHOLD)
+#define PETSC_SORT_RADIX_THRESHOLD 1024
+#endif
+PETSC_INTERN PetscErrorCode PetscSortIntRadix_Private(PetscInt,PetscInt[],PetscInt[],PetscInt[]);
 
 
 
@@ -821,11 +827,16 @@ typedef struct {
   PetscInt    maxops;       /* total amount of space we have for requests */
   PetscInt    numopsbegin;  /* number of requests that have been queued in */
   PetscInt    numopsend;    /* number of requests that have been gotten by user */
+  PetscInt    defer;        /* nesting depth of PetscCommDeferReductionsBegin() on this communicator */
+  PetscInt    numdeferred;  /* number of blocking reductions queued while deferring */
+  void        **results;    /* where each deferred value is written when the queue is flushed */
+  PetscInt    *resulttype;  /* how each deferred value is written, as a scalar, a real, or the square root of a real */
 } PetscSplitReduction;
 
 PETSC_EXTERN PetscErrorCode PetscSplitReductionGet(MPI_Comm,PetscSplitReduction**);
 PETSC_EXTERN PetscErrorCode PetscSplitReductionEnd(PetscSplitReduction*);
 PETSC_EXTERN PetscErrorCode PetscSplitReductionExtend(PetscSplitReduction*);
+PETSC_EXTERN PetscErrorCode PetscSplitReductionFlush(PetscSplitReduction*);
 
 #if !defined(PETSC_SKIP_SPINLOCK)
 #if defined(PETSC_HAVE_THREADSAFETY)
@@ -27,6 +27,10 @@ struct _PetscSFOps {
   PetscErrorCode (*ReduceEnd)(PetscSF,MPI_Datatype,const void*,void*,MPI_Op);
   PetscErrorCode (*FetchAndOpBegin)(PetscSF,MPI_Datatype,void*,const void*,void*,MPI_Op);
   PetscErrorCode (*FetchAndOpEnd)(PetscSF,MPI_Datatype,void*,const void *,void *,MPI_Op);
+  PetscErrorCode (*BcastMultiBegin)(PetscSF,PetscInt,const MPI_Datatype*,const void**,void**);
+  PetscErrorCode (*BcastMultiEnd)(PetscSF,PetscInt,const MPI_Datatype*,const void**,void**);
+  PetscErrorCode (*ReduceMultiBegin)(PetscSF,PetscInt,const MPI_Datatype*,const void**,void**,MPI_Op);
+  PetscErrorCode (*ReduceMultiEnd)(PetscSF,PetscInt,const MPI_Datatype*,const void**,void**,MPI_Op);
 };
 
 struct _p_PetscSF {
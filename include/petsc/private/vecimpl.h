@@ -137,9 +137,9 @@ struct _p_Vec {
   VecStash               stash,bstash; /* used for storing off-proc values during assembly */
   PetscBool              petscnative;  /* means the ->data starts with VECHEADER and can use VecGetArrayFast()*/
   PetscInt               lock;   /* vector is locked to read only */
+  void                   *spptr; /* data of the types derived from VECSEQ and VECMPI, e.g. the array on the GPU */
 #if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA)
   PetscOffloadFlag       valid_GPU_array;    /* indicates where the most recently modified vector data is (GPU or CPU) */
-  void                   *spptr; /* this is the special pointer to the array on the GPU */
 #endif
 };
 
@@ -210,6 +210,13 @@ PETSC_EXTERN PetscErrorCode VecLoad_Default(Vec, PetscViewer);
 
 PETSC_EXTERN PetscInt  NormIds[7];  /* map from NormType to IDs used to cache/retreive values of norms */
 
+PETSC_INTERN PetscInt       VecReductionsDeferred;  /* number of communicators on which the blocking reductions are deferred */
+PETSC_INTERN PetscErrorCode VecDotDeferred_Private(Vec,Vec,PetscScalar*,PetscBool*);
+PETSC_INTERN PetscErrorCode VecTDotDeferred_Private(Vec,Vec,PetscScalar*,PetscBool*);
+PETSC_INTERN PetscErrorCode VecMDotDeferred_Private(Vec,PetscInt,const Vec[],PetscScalar[],PetscBool*);
+PETSC_INTERN PetscErrorCode VecMTDotDeferred_Private(Vec,PetscInt,const Vec[],PetscScalar[],PetscBool*);
+PETSC_INTERN PetscErrorCode VecNormDeferred_Private(Vec,NormType,PetscReal*,PetscBool*);
+
 PETSC_INTERN PetscErrorCode VecStashCreate_Private(MPI_Comm,PetscInt,VecStash*);
 PETSC_INTERN PetscErrorCode VecStashDestroy_Private(VecStash*);
 PETSC_EXTERN PetscErrorCode VecStashExpand_Private(VecStash*,PetscInt);
@@ -99,6 +99,14 @@ typedef struct {
   MPI_Status             *sstatus,*rstatus;
   PetscInt               bs;
   PetscBool              contiq;
+  PetscMPIInt            sendtag;                   /* tag of the messages sent from this side */
+  MPI_Request            *zcrequests;               /* [n] requests of the messages sent directly from the vector array, NULL if no message is one contiguous run */
+#if defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES) /* these replace the point-to-point messages by one neighborhood collective */
+  PetscBool              neighbor;                  /* communicate with a neighborhood collective on neighcomm */
+  MPI_Comm               neighcomm;                 /* distributed graph communicator whose destinations are procs, used when sending from this side */
+  PetscMPIInt            *counts,*displs;           /* [n] number of scalars and their offset in values for each of procs */
+  MPI_Request            neighreq;                  /* request of the neighborhood collective sending from this side */
+#endif
 #if defined(PETSC_HAVE_MPI_WIN_CREATE_FEATURE)      /* these uses windows for communication only within each node */
   PetscMPIInt            msize,sharedcnt;           /* total to entries that are going to processes with the same shared memory space */
   PetscScalar            *sharedspace;              /* space each process puts data to be read from other processes; allocated by MPI */
@@ -158,7 +166,7 @@ PETSC_STATIC_INLINE PetscErrorCode VecScatterMemcpyPlanExecute_Pack(PetscInt i,c
     } else {
       for (j=xplan->copy_offsets[i]; j<xplan->copy_offsets[i+1]; j++) {
         len  = xplan->copy_lengths[j]/sizeof(PetscScalar);
-        xv   = x+xplan->copy_starts[i];
+        xv   = x+xplan->copy_starts[j];
         for (k=0; k<len; k++) y[k] += xv[k];
         y   += len;
       }
@@ -172,7 +180,7 @@ PETSC_STATIC_INLINE PetscErrorCode VecScatterMemcpyPlanExecute_Pack(PetscInt i,c
     } else {
       for (j=xplan->copy_offsets[i]; j<xplan->copy_offsets[i+1]; j++) {
         len  = xplan->copy_lengths[j]/sizeof(PetscScalar);
-        xv   = x+xplan->copy_starts[i];
+        xv   = x+xplan->copy_starts[j];
         for (k=0; k<len; k++) y[k] = PetscMax(y[k],xv[k]);
         y   += len;
       }
@@ -313,6 +321,7 @@ struct _p_VecScatter {
 
 PETSC_INTERN PetscErrorCode VecScatterCreate_Seq(VecScatter);
 PETSC_INTERN PetscErrorCode VecScatterCreate_MPI1(VecScatter);
+PETSC_INTERN PetscErrorCode VecScatterCreate_MPINeighbor(VecScatter);
 PETSC_INTERN PetscErrorCode VecScatterCreate_MPI3(VecScatter);
 PETSC_INTERN PetscErrorCode VecScatterCreate_MPI3Node(VecScatter);
 
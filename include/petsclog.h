@@ -119,6 +119,9 @@ typedef struct {
 #endif
 } PetscEventRegInfo;
 
+/* The number of hardware counters kept for each event and stage, see PetscLogHWCountersBegin() */
+#define PETSC_LOG_HW_COUNTERS 3
+
 typedef struct {
   int            id;            /* The integer identifying this event */
   PetscBool      active;        /* The flag to activate logging */
@@ -131,6 +134,10 @@ typedef struct {
   PetscLogDouble numMessages;   /* The number of messages in this event */
   PetscLogDouble messageLength; /* The total message lengths in this event */
   PetscLogDouble numReductions; /* The number of reductions in this event */
+  PetscLogDouble hwCounters[PETSC_LOG_HW_COUNTERS]; /* The cycles, instructions and last level cache misses in this event, see PetscLogHWCountersBegin() */
+  PetscLogDouble numMallocs;    /* The number of PetscMalloc() calls in this event */
+  PetscLogDouble mallocSpace;   /* The memory PetscMalloc()ed and not freed in this event */
+  PetscLogDouble mallocMax;     /* The largest increase of the PetscMalloc()ed memory during one call of this event */
 } PetscEventPerfInfo;
 
 typedef struct _n_PetscEventRegLog *PetscEventRegLog;
@@ -233,6 +240,9 @@ PETSC_EXTERN PetscErrorCode PetscLogDefaultBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogAllBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogNestedBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogTraceBegin(FILE *);
+PETSC_EXTERN PetscErrorCode PetscLogTraceJSONBegin(PetscInt);
+PETSC_EXTERN PetscErrorCode PetscLogHWCountersBegin(void);
+PETSC_EXTERN PetscErrorCode PetscLogHWCountersEnd(void);
 PETSC_EXTERN PetscErrorCode PetscLogActions(PetscBool);
 PETSC_EXTERN PetscErrorCode PetscLogObjects(PetscBool);
 PETSC_EXTERN PetscErrorCode PetscLogSetThreshold(PetscLogDouble,PetscLogDouble*);
@@ -243,6 +253,7 @@ PETSC_EXTERN PetscErrorCode PetscLogSet(PetscErrorCode (*)(int, int, PetscObject
 PETSC_EXTERN PetscErrorCode PetscLogView(PetscViewer);
 PETSC_EXTERN PetscErrorCode PetscLogViewFromOptions(void);
 PETSC_EXTERN PetscErrorCode PetscLogDump(const char[]);
+PETSC_EXTERN PetscErrorCode PetscLogTraceJSONDump(const char[]);
 
 /* Stage functions */
 PETSC_EXTERN PetscErrorCode PetscLogStageRegister(const char[],PetscLogStage*);
@@ -279,12 +290,14 @@ PETSC_EXTERN PetscLogDouble petsc_send_len;
 PETSC_EXTERN PetscLogDouble petsc_allreduce_ct;
 PETSC_EXTERN PetscLogDouble petsc_gather_ct;
 PETSC_EXTERN PetscLogDouble petsc_scatter_ct;
+PETSC_EXTERN PetscLogDouble petsc_allreduce_merged_ct;
 PETSC_EXTERN PetscLogDouble petsc_wait_ct;
 PETSC_EXTERN PetscLogDouble petsc_wait_any_ct;
 PETSC_EXTERN PetscLogDouble petsc_wait_all_ct;
 PETSC_EXTERN PetscLogDouble petsc_sum_of_waits_ct;
 
 PETSC_EXTERN PetscBool PetscLogSyncOn;  /* true if logging synchronization is enabled */
+PETSC_EXTERN PetscBool PetscLogMemory;  /* true if the PetscMalloc() calls and memory of each event are logged */
 
 #define PetscLogEventBegin(e,o1,o2,o3,o4) \
   (((PetscLogPLB && petsc_stageLog->stageInfo[petsc_stageLog->curStage].perfInfo.active && petsc_stageLog->stageInfo[petsc_stageLog->curStage].eventLog->eventInfo[e].active) ? \
@@ -462,6 +475,9 @@ PETSC_EXTERN PetscErrorCode PetscLogObjectState(PetscObject,const char[],...);
 #define PetscLogAllBegin()                 0
 #define PetscLogNestedBegin()              0
 #define PetscLogTraceBegin(file)           0
+#define PetscLogTraceJSONBegin(n)          0
+#define PetscLogHWCountersBegin()          0
+#define PetscLogHWCountersEnd()            0
 #define PetscLogActions(a)                 0
 #define PetscLogObjects(a)                 0
 #define PetscLogSetThreshold(a,b)          0
@@ -470,6 +486,7 @@ PETSC_EXTERN PetscErrorCode PetscLogObjectState(PetscObject,const char[],...);
 #define PetscLogView(viewer)               0
 #define PetscLogViewFromOptions()          0
 #define PetscLogDump(c)                    0
+#define PetscLogTraceJSONDump(c)           0
 
 #define PetscLogEventBegin(e,o1,o2,o3,o4)  0
 #define PetscLogEventEnd(e,o1,o2,o3,o4)    0
@@ -16,17 +16,21 @@ PETSC_EXTERN PetscClassId PETSCSF_CLASSID;
    Level: beginner
 
    Notes:
-    The two approaches provided are
-$     PETSCSFBASIC which uses MPI 1 message passing to perform the communication and
+    The approaches provided are
+$     PETSCSFBASIC which uses MPI 1 message passing to perform the communication,
 $     PETSCSFWINDOW which uses MPI 2 one-sided operations to perform the communication, this may be more efficient,
 $                   but may not be available for all MPI distributions. In particular OpenMPI has bugs in its one-sided
-$                   operations that prevent its use.
+$                   operations that prevent its use, and
+$     PETSCSFNODE which exchanges the data of the processes of a node through MPI 3 shared memory, and sends the data
+$                   between two nodes in one message between the first processes of the nodes. The option
+$                   -sf_node_split_size <n> splits the nodes in groups of n processes, for example one per socket.
 
 .seealso: PetscSFSetType(), PetscSF
 J*/
 typedef const char *PetscSFType;
 #define PETSCSFBASIC  "basic"
 #define PETSCSFWINDOW "window"
+#define PETSCSFNODE   "node"
 
 /*E
     PetscSFWindowSyncType - Type of synchronization for PETSCSFWINDOW
@@ -95,6 +99,11 @@ PETSC_EXTERN PetscErrorCode PetscSFReduceBegin(PetscSF,MPI_Datatype,const void*,
   PetscAttrMPIPointerWithType(3,2) PetscAttrMPIPointerWithType(4,2);
 PETSC_EXTERN PetscErrorCode PetscSFReduceEnd(PetscSF,MPI_Datatype,const void*,void*,MPI_Op)
   PetscAttrMPIPointerWithType(3,2) PetscAttrMPIPointerWithType(4,2);
+/* the same for several fields at once, with one message per neighbor */
+PETSC_EXTERN PetscErrorCode PetscSFBcastMultiBegin(PetscSF,PetscInt,const MPI_Datatype[],const void*[],void*[]);
+PETSC_EXTERN PetscErrorCode PetscSFBcastMultiEnd(PetscSF,PetscInt,const MPI_Datatype[],const void*[],void*[]);
+PETSC_EXTERN PetscErrorCode PetscSFReduceMultiBegin(PetscSF,PetscInt,const MPI_Datatype[],const void*[],void*[],MPI_Op);
+PETSC_EXTERN PetscErrorCode PetscSFReduceMultiEnd(PetscSF,PetscInt,const MPI_Datatype[],const void*[],void*[],MPI_Op);
 /* Atomically modifies (using provided operation) rootdata using leafdata from each leaf, value at root at time of modification is returned in leafupdate. */
 PETSC_EXTERN PetscErrorCode PetscSFFetchAndOpBegin(PetscSF,MPI_Datatype,void*,const void*,void*,MPI_Op)
   PetscAttrMPIPointerWithType(3,2) PetscAttrMPIPointerWithType(4,2) PetscAttrMPIPointerWithType(5,2);
@@ -1357,8 +1357,147 @@ M*/
 M*/
 #define PetscFree7(m1,m2,m3,m4,m5,m6,m7)   PetscFreeA(7,__LINE__,PETSC_FUNCTION_NAME,__FILE__,&(m1),&(m2),&(m3),&(m4),&(m5),&(m6),&(m7))
 
+/*MC
+   PetscMallocArenaPush - Starts a scope in which PetscMallocArena1() and friends take memory from an arena,
+   all of which is released at once by the matching PetscMallocArenaPop()
+
+   Synopsis:
+    #include <petscsys.h>
+   PetscErrorCode PetscMallocArenaPush(size_t size)
+
+   Not Collective
+
+   Input Parameter:
+.  size - an estimate of the number of bytes that will be allocated in the scope, or 0
+
+   Notes:
+   This is intended for the many short lived work arrays of setup routines: taking memory from the arena is a
+   pointer increment, freeing it costs nothing, and the memory of the outermost scope (up to 4 megabytes) is kept
+   for the next one, so repeated calls neither call malloc() nor touch new pages.
+
+   Memory obtained from the arena must not be passed to PetscFree() and must not be used after PetscMallocArenaPop().
+   Scopes may be nested, up to 32 deep; each pop releases only the memory of its own scope. A scope must be popped
+   in the function that pushed it; if that function returns an error first, PetscError() ends the scope.
+
+   Level: developer
+
+.seealso: PetscMallocArenaPop(), PetscMallocArenaA(), PetscMallocArena1(), PetscMallocA()
+
+  Concepts: memory allocation
+
+M*/
+#define PetscMallocArenaPush(size) PetscMallocArenaPushA((size_t)(size),PETSC_FUNCTION_NAME)
+
+/*MC
+   PetscMallocArena1 - Allocates an array of memory aligned to PETSC_MEMALIGN from the arena of the current PetscMallocArenaPush() scope
+
+   Synopsis:
+    #include <petscsys.h>
+   PetscErrorCode PetscMallocArena1(size_t m1,type **r1)
+
+   Not Collective
+
+   Input Parameter:
+.  m1 - number of elements to allocate  (may be zero)
+
+   Output Parameter:
+.  r1 - memory allocated
+
+   Notes:
+   The memory is released by PetscMallocArenaPop(); do not call PetscFree() on it.
+
+   Level: developer
+
+.seealso: PetscMallocArenaPush(), PetscMallocArenaPop(), PetscCallocArena1(), PetscMallocArena2(), PetscMalloc1()
+
+  Concepts: memory allocation
+
+M*/
+#define PetscMallocArena1(m1,r1) PetscMallocArenaA(1,PETSC_FALSE,__LINE__,PETSC_FUNCTION_NAME,__FILE__,(size_t)(m1)*sizeof(**(r1)),(r1))
+
+/*MC
+   PetscCallocArena1 - Allocates a cleared (zeroed) array of memory from the arena of the current PetscMallocArenaPush() scope
+
+   Synopsis:
+    #include <petscsys.h>
+   PetscErrorCode PetscCallocArena1(size_t m1,type **r1)
+
+   Not Collective
+
+   Input Parameter:
+.  m1 - number of elements to allocate  (may be zero)
+
+   Output Parameter:
+.  r1 - memory allocated
+
+   Level: developer
+
+.seealso: PetscMallocArenaPush(), PetscMallocArenaPop(), PetscMallocArena1(), PetscCalloc1()
+
+  Concepts: memory allocation
+
+M*/
+#define PetscCallocArena1(m1,r1) PetscMallocArenaA(1,PETSC_TRUE,__LINE__,PETSC_FUNCTION_NAME,__FILE__,(size_t)(m1)*sizeof(**(r1)),(r1))
+
+/*MC
+   PetscMallocArena2 - Allocates 2 arrays of memory from the arena of the current PetscMallocArenaPush() scope
+
+   Synopsis:
+    #include <petscsys.h>
+   PetscErrorCode PetscMallocArena2(size_t m1,type **r1,size_t m2,type **r2)
+
+   Not Collective
+
+   Input Parameter:
++  m1 - number of elements to allocate in 1st chunk  (may be zero)
+-  m2 - number of elements to allocate in 2nd chunk  (may be zero)
+
+   Output Parameter:
++  r1 - memory allocated in first chunk
+-  r2 - memory allocated in second chunk
+
+   Level: developer
+
+.seealso: PetscMallocArenaPush(), PetscMallocArenaPop(), PetscMallocArena1(), PetscMalloc2()
+
+  Concepts: memory allocation
+
+M*/
+#define PetscMallocArena2(m1,r1,m2,r2) PetscMallocArenaA(2,PETSC_FALSE,__LINE__,PETSC_FUNCTION_NAME,__FILE__,(size_t)(m1)*sizeof(**(r1)),(r1),(size_t)(m2)*sizeof(**(r2)),(r2))
+
+/*MC
+   PetscMallocArena3 - Allocates 3 arrays of memory from the arena of the current PetscMallocArenaPush() scope
+
+   Synopsis:
+    #include <petscsys.h>
+   PetscErrorCode PetscMallocArena3(size_t m1,type **r1,size_t m2,type **r2,size_t m3,type **r3)
+
+   Not Collective
+
+   Input Parameter:
++  m1 - number of elements to allocate in 1st chunk  (may be zero)
+.  m2 - number of elements to allocate in 2nd chunk  (may be zero)
+-  m3 - number of elements to allocate in 3rd chunk  (may be zero)
+
+   Output Parameter:
++  r1 - memory allocated in first chunk
+.  r2 - memory allocated in second chunk
+-  r3 - memory allocated in third chunk
+
+   Level: developer
+
+.seealso: PetscMallocArenaPush(), PetscMallocArenaPop(), PetscMallocArena2(), PetscMalloc3()
+
+  Concepts: memory allocation
+
+M*/
+#define PetscMallocArena3(m1,r1,m2,r2,m3,r3) PetscMallocArenaA(3,PETSC_FALSE,__LINE__,PETSC_FUNCTION_NAME,__FILE__,(size_t)(m1)*sizeof(**(r1)),(r1),(size_t)(m2)*sizeof(**(r2)),(r2),(size_t)(m3)*sizeof(**(r3)),(r3))
+
 PETSC_EXTERN PetscErrorCode PetscMallocA(int,PetscBool,int,const char *,const char *,size_t,void *,...);
 PETSC_EXTERN PetscErrorCode PetscFreeA(int,int,const char *,const char *,void *,...);
+PETSC_EXTERN PetscErrorCode PetscMallocArenaA(int,PetscBool,int,const char *,const char *,size_t,void *,...);
+PETSC_EXTERN PetscErrorCode PetscMallocArenaPushA(size_t,const char[]);
+PETSC_EXTERN PetscErrorCode PetscMallocArenaPop(void);
 PETSC_EXTERN PetscErrorCode (*PetscTrMalloc)(size_t,int,const char[],const char[],void**);
 PETSC_EXTERN PetscErrorCode (*PetscTrFree)(void*,int,const char[],const char[]);
 PETSC_EXTERN PetscErrorCode (*PetscTrRealloc)(size_t,int,const char[],const char[],void**);
@@ -1372,6 +1511,61 @@ PETSC_EXTERN PetscErrorCode PetscMallocClear(void);
 PETSC_EXTERN PetscErrorCode PetscMallocSetDRAM(void);
 PETSC_EXTERN PetscErrorCode PetscMallocResetDRAM(void);
 
+/*E
+    PetscMallocNUMAPolicy - Determines on which NUMA nodes the pages of large Vec and Mat arrays are placed
+
+   Level: intermediate
+
+$   PETSC_MALLOC_NUMA_DEFAULT - the policy of the process is used, for example the one set with numactl
+$   PETSC_MALLOC_NUMA_INTERLEAVE - the pages are spread round-robin over all the nodes the process may use
+$   PETSC_MALLOC_NUMA_FIRST_TOUCH - the default policy of the kernel, each page is placed on the node of the thread that first writes it; this removes a policy set on the array but not that of the process
+$   PETSC_MALLOC_NUMA_LOCAL - the pages are bound to the node the process runs on when the array is allocated, pages already written are moved there
+
+.seealso: PetscMallocSetNUMAPolicy(), PetscMallocNUMAPlace()
+E*/
+typedef enum {PETSC_MALLOC_NUMA_DEFAULT,PETSC_MALLOC_NUMA_INTERLEAVE,PETSC_MALLOC_NUMA_FIRST_TOUCH,PETSC_MALLOC_NUMA_LOCAL} PetscMallocNUMAPolicy;
+PETSC_EXTERN const char *const PetscMallocNUMAPolicies[];
+PETSC_EXTERN PetscErrorCode PetscMallocSetNUMAPolicy(PetscMallocNUMAPolicy,size_t);
+PETSC_EXTERN PetscErrorCode PetscMallocGetNUMAPolicy(PetscMallocNUMAPolicy*,size_t*);
+PETSC_EXTERN PetscErrorCode PetscMallocNUMAPlace(void*,size_t);
+PETSC_EXTERN PetscErrorCode PetscMallocNUMAViewFromOptions(const void*,size_t,const char[]);
+
+/*S
+    PetscThreadPoolKernel - A routine run by each thread of the thread pool with PetscThreadPoolRun()
+
+   Synopsis:
+   void kernel(PetscInt tid,PetscInt nthreads,void *ctx)
+
+   Level: developer
+
+.seealso: PetscThreadPoolRun(), PetscThreadPoolGetRange()
+S*/
+typedef void (*PetscThreadPoolKernel)(PetscInt,PetscInt,void*);
+PETSC_EXTERN PetscErrorCode PetscThreadPoolSetSize(PetscInt);
+PETSC_EXTERN PetscErrorCode PetscThreadPoolGetSize(PetscInt*);
+PETSC_EXTERN PetscErrorCode PetscThreadPoolRun(PetscThreadPoolKernel,void*);
+
+/*MC
+    PetscThreadPoolGetRange - Gives the part [start,end) of an array of length n processed by thread tid of nthreads
+
+   Synopsis:
+   #include <petscsys.h>
+   void PetscThreadPoolGetRange(PetscInt n,PetscInt tid,PetscInt nthreads,PetscInt *start,PetscInt *end)
+
+   Notes:
+   The parts have nearly equal lengths and, except for the end of the last one, start on multiples of 8 entries so
+   that two threads do not write to the same cache line. It may be called from a PetscThreadPoolKernel.
+
+   Level: developer
+
+.seealso: PetscThreadPoolRun()
+M*/
+PETSC_STATIC_INLINE void PetscThreadPoolGetRange(PetscInt n,PetscInt tid,PetscInt nthreads,PetscInt *start,PetscInt *end)
+{
+  *start = tid ? (PetscInt)(((PetscInt64)n*tid/nthreads) & ~(PetscInt64)7) : 0;
+  *end   = tid < nthreads-1 ? (PetscInt)(((PetscInt64)n*(tid+1)/nthreads) & ~(PetscInt64)7) : n;
+}
+
 /*
     PetscLogDouble variables are used to contain double precision numbers
   that are not used in the numerical computations, but rather in logging,
@@ -1387,6 +1581,9 @@ PETSC_EXTERN PetscErrorCode PetscMallocDump(FILE *);
 PETSC_EXTERN PetscErrorCode PetscMallocDumpLog(FILE *);
 PETSC_EXTERN PetscErrorCode PetscMallocGetCurrentUsage(PetscLogDouble *);
 PETSC_EXTERN PetscErrorCode PetscMallocGetMaximumUsage(PetscLogDouble *);
+PETSC_EXTERN PetscErrorCode PetscMallocGetCount(PetscLogDouble *);
+PETSC_EXTERN PetscErrorCode PetscMallocPushMaximumUsage(int);
+PETSC_EXTERN PetscErrorCode PetscMallocPopMaximumUsage(int,PetscLogDouble *);
 PETSC_EXTERN PetscErrorCode PetscMallocDebug(PetscBool);
 PETSC_EXTERN PetscErrorCode PetscMallocGetDebug(PetscBool*);
 PETSC_EXTERN PetscErrorCode PetscMallocValidate(int,const char[],const char[]);
@@ -103,6 +103,9 @@ typedef const char* VecType;
 #define VECSEQCUDA     "seqcuda"
 #define VECMPICUDA     "mpicuda"
 #define VECCUDA        "cuda"       /* seqcuda on one process and mpicuda on several */
+#define VECSEQSINGLE   "seqsingle"
+#define VECMPISINGLE   "mpisingle"
+#define VECSINGLE      "single"     /* seqsingle on one process and mpisingle on several */
 #define VECNEST        "nest"
 #define VECNODE        "node"       /* use on-node shared memory */
 
@@ -114,10 +117,11 @@ typedef const char* VecType;
 .seealso: VecScatterSetType(), VecScatter, VecScatterCreateWithData(), VecScatterDestroy()
 J*/
 typedef const char* VecScatterType;
-#define VECSCATTERSEQ       "seq"
-#define VECSCATTERMPI1      "mpi1"
-#define VECSCATTERMPI3      "mpi3"     /* use MPI3 on-node shared memory */
-#define VECSCATTERMPI3NODE  "mpi3node" /* use MPI3 on-node shared memory for vector type VECNODE */
+#define VECSCATTERSEQ         "seq"
+#define VECSCATTERMPI1        "mpi1"
+#define VECSCATTERMPINEIGHBOR "mpineighbor" /* use MPI3 neighborhood collectives on a distributed graph communicator */
+#define VECSCATTERMPI3        "mpi3"        /* use MPI3 on-node shared memory */
+#define VECSCATTERMPI3NODE    "mpi3node"    /* use MPI3 on-node shared memory for vector type VECNODE */
 
 /* Dynamic creation and loading functions */
 PETSC_EXTERN PetscFunctionList VecScatterList;
@@ -434,6 +438,30 @@ PETSC_EXTERN PetscErrorCode VecMDotEnd(Vec,PetscInt,const Vec[],PetscScalar[]);
 PETSC_EXTERN PetscErrorCode VecMTDotBegin(Vec,PetscInt,const Vec[],PetscScalar[]);
 PETSC_EXTERN PetscErrorCode VecMTDotEnd(Vec,PetscInt,const Vec[],PetscScalar[]);
 PETSC_EXTERN PetscErrorCode PetscCommSplitReductionBegin(MPI_Comm);
+PETSC_EXTERN PetscErrorCode PetscCommDeferReductionsBegin(MPI_Comm);
+PETSC_EXTERN PetscErrorCode PetscCommDeferReductionsEnd(MPI_Comm);
+PETSC_EXTERN PetscErrorCode PetscCommFlushDeferredReductions(MPI_Comm);
+
+/*S
+     VecProgram - A sequence of vector updates and reductions executed in one pass over the vectors
+
+   Level: advanced
+
+.seealso:  VecProgramCreate(), VecProgramAXPY(), VecProgramDot(), VecProgramBegin(), VecProgramEnd()
+S*/
+typedef struct _n_VecProgram* VecProgram;
+PETSC_EXTERN PetscErrorCode VecProgramCreate(VecProgram*);
+PETSC_EXTERN PetscErrorCode VecProgramDestroy(VecProgram*);
+PETSC_EXTERN PetscErrorCode VecProgramAXPY(VecProgram,Vec,PetscScalar,Vec);
+PETSC_EXTERN PetscErrorCode VecProgramAYPX(VecProgram,Vec,PetscScalar,Vec);
+PETSC_EXTERN PetscErrorCode VecProgramAXPBY(VecProgram,Vec,PetscScalar,PetscScalar,Vec);
+PETSC_EXTERN PetscErrorCode VecProgramAXPBYPCZ(VecProgram,Vec,PetscScalar,PetscScalar,PetscScalar,Vec,Vec);
+PETSC_EXTERN PetscErrorCode VecProgramWAXPY(VecProgram,Vec,PetscScalar,Vec,Vec);
+PETSC_EXTERN PetscErrorCode VecProgramDot(VecProgram,Vec,Vec,PetscScalar*);
+PETSC_EXTERN PetscErrorCode VecProgramTDot(VecProgram,Vec,Vec,PetscScalar*);
+PETSC_EXTERN PetscErrorCode VecProgramNorm(VecProgram,Vec,NormType,PetscReal*);
+PETSC_EXTERN PetscErrorCode VecProgramBegin(VecProgram);
+PETSC_EXTERN PetscErrorCode VecProgramEnd(VecProgram);
 
 
 typedef enum {VEC_IGNORE_OFF_PROC_ENTRIES,VEC_IGNORE_NEGATIVE_INDICES,VEC_SUBSET_OFF_PROC_ENTRIES} VecOption;
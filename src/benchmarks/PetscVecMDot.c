@@ -0,0 +1,54 @@
+#include <petscvec.h>
+#include <petsctime.h>
+
+/*
+   Prints the memory bandwidth reached by VecMDot() and VecMAXPY() with the nv vectors of a GMRES(nv) restart, to be
+   compared with the bandwidth measured by make streams. VecMDot() reads x and the nv vectors y[j]; VecMAXPY()
+   reads them and writes x.
+*/
+int main(int argc,char **argv)
+{
+  Vec            x,*y;
+  PetscScalar    *dots,*alpha;
+  PetscLogDouble t1,t2,tmdot,tmaxpy;
+  PetscInt       n = 1000000,nv = 30,its = 20,i,j;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,0,0);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nv",&nv,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-its",&its,NULL);CHKERRQ(ierr);
+
+  ierr = VecCreate(PETSC_COMM_SELF,&x);CHKERRQ(ierr);
+  ierr = VecSetSizes(x,n,n);CHKERRQ(ierr);
+  ierr = VecSetFromOptions(x);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(x,nv,&y);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nv,&dots,nv,&alpha);CHKERRQ(ierr);
+  ierr = VecSet(x,1.0);CHKERRQ(ierr);
+  for (j=0; j<nv; j++) {
+    ierr     = VecSet(y[j],1.0/(j+1));CHKERRQ(ierr);
+    alpha[j] = 1.e-3;
+  }
+
+  ierr = VecMDot(x,nv,y,dots);CHKERRQ(ierr);
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  for (i=0; i<its; i++) {ierr = VecMDot(x,nv,y,dots);CHKERRQ(ierr);}
+  ierr  = PetscTime(&t2);CHKERRQ(ierr);
+  tmdot = (t2-t1)/its;
+
+  ierr = VecMAXPY(x,nv,alpha,y);CHKERRQ(ierr);
+  ierr = PetscTime(&t1);CHKERRQ(ierr);
+  for (i=0; i<its; i++) {ierr = VecMAXPY(x,nv,alpha,y);CHKERRQ(ierr);}
+  ierr   = PetscTime(&t2);CHKERRQ(ierr);
+  tmaxpy = (t2-t1)/its;
+
+  ierr = PetscPrintf(PETSC_COMM_SELF,"VecMDot/VecMAXPY : n %D nv %D\n",n,nv);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF," VecMDot  Time %g Rate %g GB/s\n",tmdot,(nv+1.0)*n*sizeof(PetscScalar)/tmdot*1.e-9);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF," VecMAXPY Time %g Rate %g GB/s\n",tmaxpy,(nv+2.0)*n*sizeof(PetscScalar)/tmaxpy*1.e-9);CHKERRQ(ierr);
+
+  ierr = PetscFree2(dots,alpha);CHKERRQ(ierr);
+  ierr = VecDestroyVecs(nv,&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
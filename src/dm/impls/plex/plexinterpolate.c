@@ -279,7 +279,8 @@ static PetscErrorCode DMPlexInterpolateFaces_Internal(DM dm, PetscInt cellDepth,
   ++depth;
   ++cellDepth;
   cellDim -= depth - cellDepth;
-  ierr = PetscMalloc2(depth+1,&pStart,depth+1,&pEnd);CHKERRQ(ierr);
+  ierr = PetscMallocArenaPush(0);CHKERRQ(ierr);
+  ierr = PetscMallocArena2(depth+1,&pStart,depth+1,&pEnd);CHKERRQ(ierr);
   for (d = depth-1; d >= faceDepth; --d) {
     ierr = DMPlexGetDepthStratum(dm, d, &pStart[d+1], &pEnd[d+1]);CHKERRQ(ierr);
   }
@@ -309,7 +310,7 @@ static PetscErrorCode DMPlexInterpolateFaces_Internal(DM dm, PetscInt cellDepth,
       PetscInt *sizes, minv, maxv;
 
       /* count vertices of hybrid and non-hybrid faces */
-      ierr = PetscCalloc1(numCellFacesH, &sizes);CHKERRQ(ierr);
+      ierr = PetscCallocArena1(numCellFacesH, &sizes);CHKERRQ(ierr);
       for (cf = 0; cf < numCellFacesT; ++cf) { /* These are the non-hybrid faces */
         const PetscInt *cellFace = &cellFaces[-cf*faceSize];
         PetscInt       f;
@@ -331,7 +332,6 @@ static PetscErrorCode DMPlexInterpolateFaces_Internal(DM dm, PetscInt cellDepth,
       ierr = PetscSortInt(numCellFacesH - numCellFacesT, sizes);CHKERRQ(ierr);
       minv = sizes[0];
       maxv = sizes[PetscMax(numCellFacesH - numCellFacesT-1, 0)];
-      ierr = PetscFree(sizes);CHKERRQ(ierr);
       if (minv != maxv) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_SUP, "Different number of vertices for hybrid face %D != %D", minv, maxv);
       faceSizeAllH = minv;
     } else { /* the size of the faces in hybrid cells is the same */
@@ -648,9 +648,8 @@ static PetscErrorCode DMPlexInterpolateFaces_Internal(DM dm, PetscInt cellDepth,
     ierr = DMPlexRestoreRawFacesHybrid_Internal(dm, cellDim, coneSize, cone, &numCellFaces, &numCellFacesN, &faceSize, &cellFaces);CHKERRQ(ierr);
   }
   if (face != pEnd[faceDepth]) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Invalid number of faces %D should be %D", face-pStart[faceDepth], pEnd[faceDepth]-pStart[faceDepth]);
-  ierr = PetscFree2(pStart,pEnd);CHKERRQ(ierr);
+  ierr = PetscMallocArenaPop();CHKERRQ(ierr);
   ierr = PetscHashIJKLDestroy(&faceTable);CHKERRQ(ierr);
-  ierr = PetscFree2(pStart,pEnd);CHKERRQ(ierr);
   ierr = DMPlexSetHybridBounds(idm, cMax, fMax, eMax, vMax);CHKERRQ(ierr);
   ierr = DMPlexSymmetrize(idm);CHKERRQ(ierr);
   ierr = DMPlexStratify(idm);CHKERRQ(ierr);
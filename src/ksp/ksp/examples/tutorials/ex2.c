@@ -287,6 +287,15 @@ int main(int argc,char **args)
       nsize: 4
       args: -pc_type bjacobi -pc_bjacobi_blocks 4 -ksp_monitor_short -sub_pc_type jacobi -sub_ksp_type gmres
 
+   test:
+      suffix: gmres_single
+      nsize: 2
+      args: -ksp_monitor_short -ksp_gmres_single_precision_basis -ksp_gmres_restart 10 -ksp_rtol 1.e-10 -ksp_view
+
+   test:
+      suffix: fgmres_single
+      args: -ksp_monitor_short -ksp_type fgmres -ksp_gmres_single_precision_basis -ksp_gmres_restart 10 -ksp_rtol 1.e-10
+
    test:
       suffix: fbcgs
       args: -ksp_type fbcgs -pc_type ilu
@@ -25,10 +25,11 @@ PetscErrorCode KSPSolve_BCGS(KSP ksp)
 {
   PetscErrorCode ierr;
   PetscInt       i;
-  PetscScalar    rho,rhoold,alpha,beta,omega,omegaold,d1;
+  PetscScalar    rho,rhonew,rhoold,alpha,beta,omega,omegaold,d1;
   Vec            X,B,V,P,R,RP,T,S;
   PetscReal      dp    = 0.0,d2;
   KSP_BCGS       *bcgs = (KSP_BCGS*)ksp->data;
+  VecProgram     prog;
 
   PetscFunctionBegin;
   X  = ksp->vec_sol;
@@ -78,10 +79,21 @@ PetscErrorCode KSPSolve_BCGS(KSP ksp)
   omegaold = 1.0;
   ierr     = VecSet(P,0.0);CHKERRQ(ierr);
   ierr     = VecSet(V,0.0);CHKERRQ(ierr);
+  /* rp is r, so the first (r,rp) is the square of the norm already computed */
+  if (ksp->normtype != KSP_NORM_NONE) rhonew = dp*dp;
+  else {
+    ierr = VecDot(R,RP,&rhonew);CHKERRQ(ierr);
+  }
 
+  /* the updates of x and r at the end of an iteration are done in one pass over the vectors, together with the norm
+     of r and the (r,rp) of the next iteration; the program is kept in the context so that no early return leaks it */
+  if (!bcgs->prog) {
+    ierr = VecProgramCreate(&bcgs->prog);CHKERRQ(ierr);
+  }
+  prog = bcgs->prog;
   i=0;
   do {
-    ierr = VecDot(R,RP,&rho);CHKERRQ(ierr);       /*   rho <- (r,rp)      */
+    rho  = rhonew;                                /*   rho <- (r,rp)      */
     beta = (rho/rhoold) * (alpha/omegaold);
     ierr = VecAXPBYPCZ(P,1.0,-omegaold*beta,beta,R,V);CHKERRQ(ierr);  /* p <- r - omega * beta* v + beta * p */
     ierr = KSP_PCApplyBAorAB(ksp,P,V,T);CHKERRQ(ierr);  /*   v <- K p           */
@@ -116,11 +128,14 @@ PetscErrorCode KSPSolve_BCGS(KSP ksp)
       break;
     }
     omega = d1 / d2;                               /*   w <- (t's) / (t't) */
-    ierr  = VecAXPBYPCZ(X,alpha,omega,1.0,P,S);CHKERRQ(ierr); /* x <- alpha * p + omega * s + x */
-    ierr  = VecWAXPY(R,-omega,T,S);CHKERRQ(ierr);     /*   r <- s - w t       */
+    ierr  = VecProgramAXPBYPCZ(prog,X,alpha,omega,1.0,P,S);CHKERRQ(ierr); /* x <- alpha * p + omega * s + x */
+    ierr  = VecProgramWAXPY(prog,R,-omega,T,S);CHKERRQ(ierr);     /*   r <- s - w t       */
     if (ksp->normtype != KSP_NORM_NONE && ksp->chknorm < i+2) {
-      ierr = VecNorm(R,NORM_2,&dp);CHKERRQ(ierr);
+      ierr = VecProgramNorm(prog,R,NORM_2,&dp);CHKERRQ(ierr);
     }
+    ierr = VecProgramDot(prog,R,RP,&rhonew);CHKERRQ(ierr);
+    ierr = VecProgramBegin(prog);CHKERRQ(ierr);
+    ierr = VecProgramEnd(prog);CHKERRQ(ierr);
 
     rhoold   = rho;
     omegaold = omega;
@@ -178,6 +193,7 @@ PetscErrorCode KSPReset_BCGS(KSP ksp)
 
   PetscFunctionBegin;
   ierr = VecDestroy(&cg->guess);CHKERRQ(ierr);
+  ierr = VecProgramDestroy(&cg->prog);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
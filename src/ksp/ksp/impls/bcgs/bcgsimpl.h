@@ -9,7 +9,8 @@
 #include <petsc/private/kspimpl.h>        /*I "petscksp.h" I*/
 
 typedef struct {
-  Vec guess;   /* if using right preconditioning with nonzero initial guess must keep that around to "fix" solution */
+  Vec        guess;   /* if using right preconditioning with nonzero initial guess must keep that around to "fix" solution */
+  VecProgram prog;    /* the fused vector updates and reductions at the end of an iteration, only used by KSPBCGS */
 } KSP_BCGS;
 
 PETSC_INTERN PetscErrorCode KSPSetFromOptions_BCGS(PetscOptionItems *PetscOptionsObject,KSP);
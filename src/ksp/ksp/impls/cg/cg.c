@@ -61,6 +61,9 @@ static PetscErrorCode KSPSetUp_CG(KSP ksp)
   /* get work vectors needed by CG */
   if (cgP->singlereduction) nwork += 2;
   ierr = KSPSetWorkVecs(ksp,nwork);CHKERRQ(ierr);
+  if (!cgP->prog) {
+    ierr = VecProgramCreate(&cgP->prog);CHKERRQ(ierr);
+  }
 
   /*
      If user requested computations of eigenvalues then allocate work
@@ -102,6 +105,7 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
   KSP_CG         *cg;
   Mat            Amat,Pmat;
   PetscBool      diagonalscale;
+  VecProgram     prog;
 
   PetscFunctionBegin;
   ierr = PCGetDiagonalScale(ksp->pc,&diagonalscale);CHKERRQ(ierr);
@@ -162,6 +166,7 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
     KSPCheckDot(ksp,beta);
   }
 
+  prog = cg->prog;
   i = 0;
   do {
     ksp->its = i+1;
@@ -202,19 +207,23 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
     }
     a = beta/dpi;                                              /*     a = beta/p'w                     */
     if (eigs) d[i] = PetscSqrtReal(PetscAbsScalar(b))*e[i] + 1.0/a;
-    ierr = VecAXPY(X,a,P);CHKERRQ(ierr);                       /*     x <- x + ap                      */
-    ierr = VecAXPY(R,-a,W);CHKERRQ(ierr);                      /*     r <- r - aw                      */
+    /* the updates of x and r, and the unpreconditioned norm, are done in one pass over the vectors */
+    ierr = VecProgramAXPY(prog,X,a,P);CHKERRQ(ierr);           /*     x <- x + ap                      */
+    ierr = VecProgramAXPY(prog,R,-a,W);CHKERRQ(ierr);          /*     r <- r - aw                      */
+    if (ksp->normtype == KSP_NORM_UNPRECONDITIONED && ksp->chknorm < i+2) {
+      ierr = VecProgramNorm(prog,R,NORM_2,&dp);CHKERRQ(ierr);  /*     dp <- r'*r                       */
+    }
+    ierr = VecProgramBegin(prog);CHKERRQ(ierr);
+    ierr = VecProgramEnd(prog);CHKERRQ(ierr);
     if (ksp->normtype == KSP_NORM_PRECONDITIONED && ksp->chknorm < i+2) {
       ierr = KSP_PCApply(ksp,R,Z);CHKERRQ(ierr);               /*     z <- Br                          */
       ierr = VecNorm(Z,NORM_2,&dp);CHKERRQ(ierr);              /*     dp <- z'*z                       */
-    } else if (ksp->normtype == KSP_NORM_UNPRECONDITIONED && ksp->chknorm < i+2) {
-      ierr = VecNorm(R,NORM_2,&dp);CHKERRQ(ierr);              /*     dp <- r'*r                       */
     } else if (ksp->normtype == KSP_NORM_NATURAL) {
       ierr = KSP_PCApply(ksp,R,Z);CHKERRQ(ierr);               /*     z <- Br                          */
       ierr = VecXDot(Z,R,&beta);CHKERRQ(ierr);                 /*     beta <- r'*z                     */
       KSPCheckDot(ksp,beta);
       dp = PetscSqrtReal(PetscAbsScalar(beta));
-    } else {
+    } else if (ksp->normtype != KSP_NORM_UNPRECONDITIONED || ksp->chknorm >= i+2) {
       dp = 0.0;
     }
     ksp->rnorm = dp;
@@ -411,6 +420,19 @@ static PetscErrorCode KSPSolve_CG_SingleReduction(KSP ksp)
   PetscFunctionReturn(0);
 }
 
+/*
+     KSPReset_CG - Frees the vector program created in KSPSetUp_CG
+*/
+PetscErrorCode KSPReset_CG(KSP ksp)
+{
+  KSP_CG         *cg = (KSP_CG*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecProgramDestroy(&cg->prog);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*
      KSPDestroy_CG - Frees resources allocated in KSPSetup_CG and clears function
                      compositions from KSPCreate_CG. If adding your own KSP implementation,
@@ -582,6 +604,7 @@ PETSC_EXTERN PetscErrorCode KSPCreate_CG(KSP ksp)
   ksp->ops->setup          = KSPSetUp_CG;
   ksp->ops->solve          = KSPSolve_CG;
   ksp->ops->destroy        = KSPDestroy_CG;
+  ksp->ops->reset          = KSPReset_CG;
   ksp->ops->view           = KSPView_CG;
   ksp->ops->setfromoptions = KSPSetFromOptions_CG;
   ksp->ops->buildsolution  = KSPBuildSolutionDefault;
@@ -34,6 +34,7 @@ typedef struct {
   PetscReal   *ee,*dd;             /* work space for Lanczos algorithm */
 
   PetscBool singlereduction;          /* use variant of CG that combines both inner products */
+  VecProgram prog;                    /* the fused updates of x and r, only used by KSPCG */
 } KSP_CG;
 
 #endif
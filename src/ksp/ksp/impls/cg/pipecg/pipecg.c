@@ -1,6 +1,10 @@
 
 #include <petsc/private/kspimpl.h>
 
+typedef struct {
+  VecProgram prog;   /* the fused vector updates and reductions of an iteration */
+} KSP_PIPECG;
+
 /*
      KSPSetUp_PIPECG - Sets up the workspace needed by the PIPECG method.
 
@@ -9,11 +13,35 @@
 */
 static PetscErrorCode KSPSetUp_PIPECG(KSP ksp)
 {
+  KSP_PIPECG     *pipecg = (KSP_PIPECG*)ksp->data;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
   /* get work vectors needed by PIPECG */
   ierr = KSPSetWorkVecs(ksp,9);CHKERRQ(ierr);
+  if (!pipecg->prog) {
+    ierr = VecProgramCreate(&pipecg->prog);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPReset_PIPECG(KSP ksp)
+{
+  KSP_PIPECG     *pipecg = (KSP_PIPECG*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecProgramDestroy(&pipecg->prog);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPDestroy_PIPECG(KSP ksp)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = KSPReset_PIPECG(ksp);CHKERRQ(ierr);
+  ierr = KSPDestroyDefault(ksp);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -33,6 +61,8 @@ static PetscErrorCode  KSPSolve_PIPECG(KSP ksp)
   Vec            X,B,Z,P,W,Q,U,M,N,R,S;
   Mat            Amat,Pmat;
   PetscBool      diagonalscale;
+  KSP_PIPECG     *pipecg = (KSP_PIPECG*)ksp->data;
+  VecProgram     prog;
 
   PetscFunctionBegin;
   ierr = PCGetDiagonalScale(ksp->pc,&diagonalscale);CHKERRQ(ierr);
@@ -95,31 +125,27 @@ static PetscErrorCode  KSPSolve_PIPECG(KSP ksp)
   ierr       = (*ksp->converged)(ksp,0,dp,&ksp->reason,ksp->cnvP);CHKERRQ(ierr); /* test for convergence */
   if (ksp->reason) PetscFunctionReturn(0);
 
-  i = 0;
+  /* the vector updates at the end of an iteration are done in one pass over the vectors, together with the local
+     parts of the reductions at the beginning of the next iteration */
+  prog = pipecg->prog;
+  i    = 0;
   do {
     if (i > 0 && ksp->normtype == KSP_NORM_UNPRECONDITIONED) {
-      ierr = VecNormBegin(R,NORM_2,&dp);CHKERRQ(ierr);
+      ierr = VecProgramNorm(prog,R,NORM_2,&dp);CHKERRQ(ierr);
     } else if (i > 0 && ksp->normtype == KSP_NORM_PRECONDITIONED) {
-      ierr = VecNormBegin(U,NORM_2,&dp);CHKERRQ(ierr);
+      ierr = VecProgramNorm(prog,U,NORM_2,&dp);CHKERRQ(ierr);
     }
     if (!(i == 0 && ksp->normtype == KSP_NORM_NATURAL)) {
-      ierr = VecDotBegin(R,U,&gamma);CHKERRQ(ierr);
+      ierr = VecProgramDot(prog,R,U,&gamma);CHKERRQ(ierr);
     }
-    ierr = VecDotBegin(W,U,&delta);CHKERRQ(ierr);
+    ierr = VecProgramDot(prog,W,U,&delta);CHKERRQ(ierr);
+    ierr = VecProgramBegin(prog);CHKERRQ(ierr);
     ierr = PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)R));CHKERRQ(ierr);
 
     ierr = KSP_PCApply(ksp,W,M);CHKERRQ(ierr);           /*   m <- Bw       */
     ierr = KSP_MatMult(ksp,Amat,M,N);CHKERRQ(ierr);      /*   n <- Am       */
 
-    if (i > 0 && ksp->normtype == KSP_NORM_UNPRECONDITIONED) {
-      ierr = VecNormEnd(R,NORM_2,&dp);CHKERRQ(ierr);
-    } else if (i > 0 && ksp->normtype == KSP_NORM_PRECONDITIONED) {
-      ierr = VecNormEnd(U,NORM_2,&dp);CHKERRQ(ierr);
-    }
-    if (!(i == 0 && ksp->normtype == KSP_NORM_NATURAL)) {
-      ierr = VecDotEnd(R,U,&gamma);CHKERRQ(ierr);
-    }
-    ierr = VecDotEnd(W,U,&delta);CHKERRQ(ierr);
+    ierr = VecProgramEnd(prog);CHKERRQ(ierr);
 
     if (i > 0) {
       if (ksp->normtype == KSP_NORM_NATURAL) dp = PetscSqrtReal(PetscAbsScalar(gamma));
@@ -141,15 +167,15 @@ static PetscErrorCode  KSPSolve_PIPECG(KSP ksp)
     } else {
       beta  = gamma / gammaold;
       alpha = gamma / (delta - beta / alpha * gamma);
-      ierr  = VecAYPX(Z,beta,N);CHKERRQ(ierr);   /*     z <- n + beta * z   */
-      ierr  = VecAYPX(Q,beta,M);CHKERRQ(ierr);   /*     q <- m + beta * q   */
-      ierr  = VecAYPX(P,beta,U);CHKERRQ(ierr);   /*     p <- u + beta * p   */
-      ierr  = VecAYPX(S,beta,W);CHKERRQ(ierr);   /*     s <- w + beta * s   */
+      ierr  = VecProgramAYPX(prog,Z,beta,N);CHKERRQ(ierr);   /*     z <- n + beta * z   */
+      ierr  = VecProgramAYPX(prog,Q,beta,M);CHKERRQ(ierr);   /*     q <- m + beta * q   */
+      ierr  = VecProgramAYPX(prog,P,beta,U);CHKERRQ(ierr);   /*     p <- u + beta * p   */
+      ierr  = VecProgramAYPX(prog,S,beta,W);CHKERRQ(ierr);   /*     s <- w + beta * s   */
     }
-    ierr     = VecAXPY(X, alpha,P);CHKERRQ(ierr); /*     x <- x + alpha * p   */
-    ierr     = VecAXPY(U,-alpha,Q);CHKERRQ(ierr); /*     u <- u - alpha * q   */
-    ierr     = VecAXPY(W,-alpha,Z);CHKERRQ(ierr); /*     w <- w - alpha * z   */
-    ierr     = VecAXPY(R,-alpha,S);CHKERRQ(ierr); /*     r <- r - alpha * s   */
+    ierr     = VecProgramAXPY(prog,X, alpha,P);CHKERRQ(ierr); /*     x <- x + alpha * p   */
+    ierr     = VecProgramAXPY(prog,U,-alpha,Q);CHKERRQ(ierr); /*     u <- u - alpha * q   */
+    ierr     = VecProgramAXPY(prog,W,-alpha,Z);CHKERRQ(ierr); /*     w <- w - alpha * z   */
+    ierr     = VecProgramAXPY(prog,R,-alpha,S);CHKERRQ(ierr); /*     r <- r - alpha * s   */
     gammaold = gamma;
     i++;
     ksp->its = i;
@@ -162,6 +188,9 @@ static PetscErrorCode  KSPSolve_PIPECG(KSP ksp)
     /* } */
 
   } while (i<ksp->max_it);
+  /* the updates of the last iteration are still pending when the maximum number of iterations is reached */
+  ierr = VecProgramBegin(prog);CHKERRQ(ierr);
+  ierr = VecProgramEnd(prog);CHKERRQ(ierr);
   if (i >= ksp->max_it) ksp->reason = KSP_DIVERGED_ITS;
   PetscFunctionReturn(0);
 }
@@ -192,9 +221,13 @@ static PetscErrorCode  KSPSolve_PIPECG(KSP ksp)
 M*/
 PETSC_EXTERN PetscErrorCode KSPCreate_PIPECG(KSP ksp)
 {
+  KSP_PIPECG     *pipecg;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
+  ierr      = PetscNewLog(ksp,&pipecg);CHKERRQ(ierr);
+  ksp->data = (void*)pipecg;
+
   ierr = KSPSetSupportedNorm(ksp,KSP_NORM_UNPRECONDITIONED,PC_LEFT,2);CHKERRQ(ierr);
   ierr = KSPSetSupportedNorm(ksp,KSP_NORM_PRECONDITIONED,PC_LEFT,2);CHKERRQ(ierr);
   ierr = KSPSetSupportedNorm(ksp,KSP_NORM_NATURAL,PC_LEFT,2);CHKERRQ(ierr);
@@ -202,7 +235,8 @@ PETSC_EXTERN PetscErrorCode KSPCreate_PIPECG(KSP ksp)
 
   ksp->ops->setup          = KSPSetUp_PIPECG;
   ksp->ops->solve          = KSPSolve_PIPECG;
-  ksp->ops->destroy        = KSPDestroyDefault;
+  ksp->ops->destroy        = KSPDestroy_PIPECG;
+  ksp->ops->reset          = KSPReset_PIPECG;
   ksp->ops->view           = 0;
   ksp->ops->setfromoptions = 0;
   ksp->ops->buildsolution  = KSPBuildSolutionDefault;
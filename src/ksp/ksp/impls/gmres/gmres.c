@@ -71,7 +71,7 @@ PetscErrorCode    KSPSetUp_GMRES(KSP ksp)
   if (gmres->q_preallocate) {
     gmres->vv_allocated = VEC_OFFSET + 2 + max_k;
 
-    ierr = KSPCreateVecs(ksp,gmres->vv_allocated,&gmres->user_work[0],0,NULL);CHKERRQ(ierr);
+    ierr = KSPGMRESCreateBasisVecs_Private(ksp,gmres->vv_allocated,VEC_OFFSET,&gmres->user_work[0]);CHKERRQ(ierr);
     ierr = PetscLogObjectParents(ksp,gmres->vv_allocated,gmres->user_work[0]);CHKERRQ(ierr);
 
     gmres->mwork_alloc[0] = gmres->vv_allocated;
@@ -82,7 +82,7 @@ PetscErrorCode    KSPSetUp_GMRES(KSP ksp)
   } else {
     gmres->vv_allocated = 5;
 
-    ierr = KSPCreateVecs(ksp,5,&gmres->user_work[0],0,NULL);CHKERRQ(ierr);
+    ierr = KSPGMRESCreateBasisVecs_Private(ksp,5,VEC_OFFSET,&gmres->user_work[0]);CHKERRQ(ierr);
     ierr = PetscLogObjectParents(ksp,5,gmres->user_work[0]);CHKERRQ(ierr);
 
     gmres->mwork_alloc[0] = 5;
@@ -311,6 +311,8 @@ PetscErrorCode KSPDestroy_GMRES(KSP ksp)
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetHapTol_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetCGSRefinementType_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESGetCGSRefinementType_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetSinglePrecisionBasis_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESGetSinglePrecisionBasis_C",NULL);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 /*
@@ -363,7 +365,12 @@ static PetscErrorCode KSPGMRESBuildSoln(PetscScalar *nrs,Vec vs,Vec vdest,KSP ks
 
   /* Accumulate the correction to the solution of the preconditioned problem in TEMP */
   ierr = VecSet(VEC_TEMP,0.0);CHKERRQ(ierr);
-  ierr = VecMAXPY(VEC_TEMP,it+1,nrs,&VEC_VV(0));CHKERRQ(ierr);
+  if (gmres->singlebasis) {
+    /* the basis vectors are converted one at a time rather than all together by VecMAXPY() */
+    for (k=0; k<=it; k++) {ierr = VecAXPY(VEC_TEMP,nrs[k],VEC_VV(k));CHKERRQ(ierr);}
+  } else {
+    ierr = VecMAXPY(VEC_TEMP,it+1,nrs,&VEC_VV(0));CHKERRQ(ierr);
+  }
 
   ierr = KSPUnwindPreconditioner(ksp,VEC_TEMP,VEC_TEMP_MATOP);CHKERRQ(ierr);
   /* add solution to previous solution */
@@ -446,7 +453,7 @@ PetscErrorCode KSPGMRESGetNewVectors(KSP ksp,PetscInt it)
 
   gmres->vv_allocated += nalloc;
 
-  ierr = KSPCreateVecs(ksp,nalloc,&gmres->user_work[nwork],0,NULL);CHKERRQ(ierr);
+  ierr = KSPGMRESCreateBasisVecs_Private(ksp,nalloc,0,&gmres->user_work[nwork]);CHKERRQ(ierr);
   ierr = PetscLogObjectParents(ksp,nalloc,gmres->user_work[nwork]);CHKERRQ(ierr);
 
   gmres->mwork_alloc[nwork] = nalloc;
@@ -457,6 +464,39 @@ PetscErrorCode KSPGMRESGetNewVectors(KSP ksp,PetscInt it)
   PetscFunctionReturn(0);
 }
 
+/*
+   KSPGMRESCreateBasisVecs_Private - Creates n work vectors like KSPCreateVecs(); when the basis is stored in single
+   precision, all but the first nwork are of type VECSINGLE. The vectors are destroyed with VecDestroyVecs().
+*/
+PetscErrorCode KSPGMRESCreateBasisVecs_Private(KSP ksp,PetscInt n,PetscInt nwork,Vec **vecs)
+{
+  KSP_GMRES      *gmres = (KSP_GMRES*)ksp->data;
+  Vec            *work,v;
+  PetscInt       k,m,N,bs;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!gmres->singlebasis) {
+    ierr = KSPCreateVecs(ksp,n,vecs,0,NULL);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscMalloc1(n,vecs);CHKERRQ(ierr);
+  ierr = KSPCreateVecs(ksp,PetscMax(nwork,1),&work,0,NULL);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(work[0],&m);CHKERRQ(ierr);
+  ierr = VecGetSize(work[0],&N);CHKERRQ(ierr);
+  ierr = VecGetBlockSize(work[0],&bs);CHKERRQ(ierr);
+  ierr = VecCreate(PetscObjectComm((PetscObject)ksp),&v);CHKERRQ(ierr);
+  ierr = VecSetSizes(v,m,N);CHKERRQ(ierr);
+  ierr = VecSetBlockSize(v,bs);CHKERRQ(ierr);
+  ierr = VecSetType(v,VECSINGLE);CHKERRQ(ierr);
+  for (k=0; k<nwork; k++) (*vecs)[k] = work[k];
+  if (!nwork) {ierr = VecDestroy(&work[0]);CHKERRQ(ierr);}
+  ierr = PetscFree(work);CHKERRQ(ierr);
+  for (k=nwork; k<n; k++) {ierr = VecDuplicate(v,&(*vecs)[k]);CHKERRQ(ierr);}
+  ierr = VecDestroy(&v);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode KSPBuildSolution_GMRES(KSP ksp,Vec ptr,Vec *result)
 {
   KSP_GMRES      *gmres = (KSP_GMRES*)ksp->data;
@@ -513,6 +553,7 @@ PetscErrorCode KSPView_GMRES(KSP ksp,PetscViewer viewer)
   if (iascii) {
     ierr = PetscViewerASCIIPrintf(viewer,"  restart=%D, using %s\n",gmres->max_k,cstr);CHKERRQ(ierr);
     ierr = PetscViewerASCIIPrintf(viewer,"  happy breakdown tolerance %g\n",(double)gmres->haptol);CHKERRQ(ierr);
+    if (gmres->singlebasis) {ierr = PetscViewerASCIIPrintf(viewer,"  Krylov basis stored in single precision\n");CHKERRQ(ierr);}
   } else if (isstring) {
     ierr = PetscViewerStringSPrintf(viewer,"%s restart %D",cstr,gmres->max_k);CHKERRQ(ierr);
   }
@@ -568,7 +609,7 @@ PetscErrorCode KSPSetFromOptions_GMRES(PetscOptionItems *PetscOptionsObject,KSP
   PetscInt       restart;
   PetscReal      haptol;
   KSP_GMRES      *gmres = (KSP_GMRES*)ksp->data;
-  PetscBool      flg;
+  PetscBool      flg,set;
 
   PetscFunctionBegin;
   ierr = PetscOptionsHead(PetscOptionsObject,"KSP GMRES Options");CHKERRQ(ierr);
@@ -583,6 +624,8 @@ PetscErrorCode KSPSetFromOptions_GMRES(PetscOptionItems *PetscOptionsObject,KSP
   if (flg) {ierr = KSPGMRESSetOrthogonalization(ksp,KSPGMRESClassicalGramSchmidtOrthogonalization);CHKERRQ(ierr);}
   ierr = PetscOptionsBoolGroupEnd("-ksp_gmres_modifiedgramschmidt","Modified Gram-Schmidt (slow,more stable)","KSPGMRESSetOrthogonalization",&flg);CHKERRQ(ierr);
   if (flg) {ierr = KSPGMRESSetOrthogonalization(ksp,KSPGMRESModifiedGramSchmidtOrthogonalization);CHKERRQ(ierr);}
+  ierr = PetscOptionsBool("-ksp_gmres_single_precision_basis","Store the Krylov basis vectors in single precision","KSPGMRESSetSinglePrecisionBasis",gmres->singlebasis,&flg,&set);CHKERRQ(ierr);
+  if (set) {ierr = KSPGMRESSetSinglePrecisionBasis(ksp,flg);CHKERRQ(ierr);}
   ierr = PetscOptionsEnum("-ksp_gmres_cgs_refinement_type","Type of iterative refinement for classical (unmodified) Gram-Schmidt","KSPGMRESSetCGSRefinementType",
                           KSPGMRESCGSRefinementTypes,(PetscEnum)gmres->cgstype,(PetscEnum*)&gmres->cgstype,&flg);CHKERRQ(ierr);
   flg  = PETSC_FALSE;
@@ -738,6 +781,92 @@ PetscErrorCode  KSPGMRESGetCGSRefinementType(KSP ksp,KSPGMRESCGSRefinementType *
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode KSPGMRESSetSinglePrecisionBasis_GMRES(KSP ksp,PetscBool flg)
+{
+  KSP_GMRES *gmres = (KSP_GMRES*)ksp->data;
+
+  PetscFunctionBegin;
+#if defined(PETSC_USE_COMPLEX)
+  if (flg) SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_SUP,"Single precision Krylov basis is only available with real scalars");
+#endif
+  if (flg != gmres->singlebasis && ksp->setupstage != KSP_SETUP_NEW) SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ORDER,"Cannot change the precision of the Krylov basis after KSPSetUp(), call KSPReset() first");
+  gmres->singlebasis = flg;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode KSPGMRESGetSinglePrecisionBasis_GMRES(KSP ksp,PetscBool *flg)
+{
+  PetscFunctionBegin;
+  *flg = ((KSP_GMRES*)ksp->data)->singlebasis;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPGMRESSetSinglePrecisionBasis - Stores the Krylov basis vectors of GMRES and FGMRES in single precision
+
+   Logically Collective on KSP
+
+   Input Parameters:
++  ksp - the Krylov space context
+-  flg - PETSC_TRUE to store the basis in single precision
+
+  Options Database:
+.  -ksp_gmres_single_precision_basis <true,false>
+
+   Notes:
+   The basis vectors (and for FGMRES the preconditioned basis vectors) are of type VECSINGLE: the orthogonalization
+   is computed in PetscScalar, but reads and writes half as many bytes and the basis needs half the memory. The
+   basis vectors are only accurate to about 1e-7, so the residual estimated within a restart cycle may drift from the
+   true residual, which is recomputed in full precision at each restart; convergence to tight tolerances may then need
+   more iterations.
+
+   Must be called before KSPSetUp(). Only available with real scalars.
+
+   Level: intermediate
+
+.keywords: KSP, GMRES, single precision
+
+.seealso: KSPGMRESGetSinglePrecisionBasis(), KSPGMRESSetRestart(), KSPGMRESSetPreAllocateVectors(), VECSINGLE
+@*/
+PetscErrorCode KSPGMRESSetSinglePrecisionBasis(KSP ksp,PetscBool flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveBool(ksp,flg,2);
+  ierr = PetscTryMethod(ksp,"KSPGMRESSetSinglePrecisionBasis_C",(KSP,PetscBool),(ksp,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPGMRESGetSinglePrecisionBasis - Gets whether the Krylov basis vectors of GMRES and FGMRES are stored in single precision
+
+   Not Collective
+
+   Input Parameter:
+.  ksp - the Krylov space context
+
+   Output Parameter:
+.  flg - PETSC_TRUE if the basis is stored in single precision
+
+   Level: intermediate
+
+.keywords: KSP, GMRES, single precision
+
+.seealso: KSPGMRESSetSinglePrecisionBasis()
+@*/
+PetscErrorCode KSPGMRESGetSinglePrecisionBasis(KSP ksp,PetscBool *flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidPointer(flg,2);
+  ierr = PetscUseMethod(ksp,"KSPGMRESGetSinglePrecisionBasis_C",(KSP,PetscBool*),(ksp,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 
 /*@
    KSPGMRESSetRestart - Sets number of iterations at which GMRES, FGMRES and LGMRES restarts.
@@ -844,6 +973,7 @@ PetscErrorCode  KSPGMRESSetHapTol(KSP ksp,PetscReal tol)
 .   -ksp_gmres_modifiedgramschmidt - use modified Gram-Schmidt in the orthogonalization (more stable, but slower)
 .   -ksp_gmres_cgs_refinement_type <never,ifneeded,always> - determine if iterative refinement is used to increase the
                                    stability of the classical Gram-Schmidt  orthogonalization.
+.   -ksp_gmres_single_precision_basis - store the Krylov basis vectors in single precision, see KSPGMRESSetSinglePrecisionBasis()
 -   -ksp_gmres_krylov_monitor - plot the Krylov space generated
 
    Level: beginner
@@ -897,6 +1027,8 @@ PETSC_EXTERN PetscErrorCode KSPCreate_GMRES(KSP ksp)
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetHapTol_C",KSPGMRESSetHapTol_GMRES);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetCGSRefinementType_C",KSPGMRESSetCGSRefinementType_GMRES);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESGetCGSRefinementType_C",KSPGMRESGetCGSRefinementType_GMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetSinglePrecisionBasis_C",KSPGMRESSetSinglePrecisionBasis_GMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESGetSinglePrecisionBasis_C",KSPGMRESGetSinglePrecisionBasis_GMRES);CHKERRQ(ierr);
 
   gmres->haptol         = 1.0e-30;
   gmres->q_preallocate  = 0;
@@ -35,6 +35,7 @@
   Vec      *vecb;                                        /* holds the last full basis vectors of the Krylov subspace to compute (harmonic) Ritz pairs */ \
   PetscInt q_preallocate;    /* 0=don't preallocate space for work vectors */ \
   PetscInt delta_allocate;    /* number of vectors to preallocaate in each block if not preallocated */ \
+  PetscBool singlebasis;      /* the Krylov basis vectors are stored in single precision */ \
   PetscInt vv_allocated;      /* number of allocated gmres direction vectors */ \
   PetscInt vecs_allocated;                              /*   total number of vecs available */ \
   /* Since we may call the user "obtain_work_vectors" several times, we have to keep track of the pointers that it has returned */ \
@@ -61,6 +62,7 @@ PETSC_INTERN PetscErrorCode KSPComputeRitz_GMRES(KSP,PetscBool,PetscBool,PetscIn
 PETSC_INTERN PetscErrorCode KSPReset_GMRES(KSP);
 PETSC_INTERN PetscErrorCode KSPDestroy_GMRES(KSP);
 PETSC_INTERN PetscErrorCode KSPGMRESGetNewVectors(KSP,PetscInt);
+PETSC_INTERN PetscErrorCode KSPGMRESCreateBasisVecs_Private(KSP,PetscInt,PetscInt,Vec**);
 
 typedef PetscErrorCode (*FCN)(KSP,PetscInt); /* force argument to next function to not be extern C*/
 
@@ -72,6 +74,8 @@ PETSC_INTERN PetscErrorCode KSPGMRESSetOrthogonalization_GMRES(KSP,FCN);
 PETSC_INTERN PetscErrorCode KSPGMRESGetOrthogonalization_GMRES(KSP,FCN*);
 PETSC_INTERN PetscErrorCode KSPGMRESSetCGSRefinementType_GMRES(KSP,KSPGMRESCGSRefinementType);
 PETSC_INTERN PetscErrorCode KSPGMRESGetCGSRefinementType_GMRES(KSP,KSPGMRESCGSRefinementType*);
+PETSC_INTERN PetscErrorCode KSPGMRESSetSinglePrecisionBasis_GMRES(KSP,PetscBool);
+PETSC_INTERN PetscErrorCode KSPGMRESGetSinglePrecisionBasis_GMRES(KSP,PetscBool*);
 
 /* These macros are guarded because they are redefined by derived implementations */
 #if !defined(KSPGMRES_NO_MACROS)
@@ -569,17 +569,18 @@ static PetscErrorCode PCPatchGetGlobalDofs(PC pc, PetscSection dofSection[], Pet
    freedom in global concatenated numbering on those entities.
    For Vanka smoothing, this needs to do something special: ignore dofs of the
    constraint subspace on entities that aren't the base entity we're building the patch
-   around. */
-static PetscErrorCode PCPatchGetPointDofs(PC pc, PetscHSetI pts, PetscHSetI dofs, PetscInt base, PetscInt exclude_subspace)
+   around. The dofs are gathered in a buffer and added to the set in bulk. */
+static PetscErrorCode PCPatchGetPointDofs(PC pc, PetscHSetI pts, PetscHSetIG dofs, PetscInt base, PetscInt exclude_subspace)
 {
   PC_PATCH      *patch = (PC_PATCH *) pc->data;
   PetscHashIter  hi;
+  PetscInt       buf[256], nbuf = 0;
   PetscInt       ldof, loff;
   PetscInt       k, p;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  ierr = PetscHSetIClear(dofs);CHKERRQ(ierr);
+  ierr = PetscHSetIGClear(dofs);CHKERRQ(ierr);
   for (k = 0; k < patch->nsubspaces; ++k) {
     PetscInt subspaceOffset = patch->subspaceOffsets[k];
     PetscInt bs             = patch->bs[k];
@@ -591,8 +592,8 @@ static PetscErrorCode PCPatchGetPointDofs(PC pc, PetscHSetI pts, PetscHSetI dofs
       if (0 == ldof) continue;
       for (j = loff; j < ldof + loff; ++j) {
         for (l = 0; l < bs; ++l) {
-          PetscInt dof = bs*j + l + subspaceOffset;
-          ierr = PetscHSetIAdd(dofs, dof);CHKERRQ(ierr);
+          if (nbuf == 256) {ierr = PetscHSetIGAddMany(dofs, nbuf, buf);CHKERRQ(ierr); nbuf = 0;}
+          buf[nbuf++] = bs*j + l + subspaceOffset;
         }
       }
       continue; /* skip the other dofs of this subspace */
@@ -606,32 +607,33 @@ static PetscErrorCode PCPatchGetPointDofs(PC pc, PetscHSetI pts, PetscHSetI dofs
       if (0 == ldof) continue;
       for (j = loff; j < ldof + loff; ++j) {
         for (l = 0; l < bs; ++l) {
-          PetscInt dof = bs*j + l + subspaceOffset;
-          ierr = PetscHSetIAdd(dofs, dof);CHKERRQ(ierr);
+          if (nbuf == 256) {ierr = PetscHSetIGAddMany(dofs, nbuf, buf);CHKERRQ(ierr); nbuf = 0;}
+          buf[nbuf++] = bs*j + l + subspaceOffset;
         }
       }
     }
   }
+  ierr = PetscHSetIGAddMany(dofs, nbuf, buf);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
 /* Given two hash tables A and B, compute the keys in B that are not in A, and put them in C */
-static PetscErrorCode PCPatchComputeSetDifference_Private(PetscHSetI A, PetscHSetI B, PetscHSetI C)
+static PetscErrorCode PCPatchComputeSetDifference_Private(PetscHSetIG A, PetscHSetIG B, PetscHSetIG C)
 {
-  PetscHashIter  hi;
-  PetscInt       key;
-  PetscBool      flg;
+  PetscInt       *keys, n, off = 0, i;
+  PetscBool      *has;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  ierr = PetscHSetIClear(C);CHKERRQ(ierr);
-  PetscHashIterBegin(B, hi);
-  while (!PetscHashIterAtEnd(B, hi)) {
-    PetscHashIterGetKey(B, hi, key);
-    PetscHashIterNext(B, hi);
-    ierr = PetscHSetIHas(A, key, &flg);CHKERRQ(ierr);
-    if (!flg) {ierr = PetscHSetIAdd(C, key);CHKERRQ(ierr);}
-  }
+  ierr = PetscHSetIGClear(C);CHKERRQ(ierr);
+  ierr = PetscHSetIGGetSize(B, &n);CHKERRQ(ierr);
+  ierr = PetscMallocArenaPush(n*(sizeof(PetscInt)+sizeof(PetscBool)));CHKERRQ(ierr);
+  ierr = PetscMallocArena2(n, &keys, n, &has);CHKERRQ(ierr);
+  ierr = PetscHSetIGGetElems(B, &off, keys);CHKERRQ(ierr);
+  ierr = PetscHSetIGHasMany(A, n, keys, has);CHKERRQ(ierr);
+  for (i = 0, off = 0; i < n; ++i) if (!has[i]) keys[off++] = keys[i];
+  ierr = PetscHSetIGAddMany(C, off, keys);CHKERRQ(ierr);
+  ierr = PetscMallocArenaPop();CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -829,10 +831,14 @@ static PetscErrorCode PCPatchCreateCellPatchDiscretisationInfo(PC pc)
   DM              dm              = NULL;
   const PetscInt *bcNodes         = NULL;
   PetscHMapI      ht;
-  PetscHSetI      globalBcs;
+  PetscHSetIG     globalBcs;
   PetscInt        numBcs;
-  PetscHSetI      ownedpts, seenpts, owneddofs, seendofs, artificialbcs;
-  PetscInt        pStart, pEnd, p, i;
+  PetscHSetI      ownedpts, seenpts;
+  PetscHSetIG     owneddofs, seendofs, artificialbcs;
+  PetscInt       *cellDofs        = NULL;
+  PetscBool      *isGlobalBcDof   = NULL, *isArtificialBcDof = NULL;
+  PetscInt        maxCellDofs     = 0;
+  PetscInt        pStart, pEnd, p, k;
   PetscErrorCode  ierr;
 
   PetscFunctionBegin;
@@ -854,21 +860,24 @@ static PetscErrorCode PCPatchCreateCellPatchDiscretisationInfo(PC pc)
 
   /* Outside the patch loop, get the dofs that are globally-enforced Dirichlet
    conditions */
-  ierr = PetscHSetICreate(&globalBcs);CHKERRQ(ierr);
+  ierr = PetscHSetIGCreate(&globalBcs);CHKERRQ(ierr);
   ierr = ISGetIndices(patch->ghostBcNodes, &bcNodes); CHKERRQ(ierr);
   ierr = ISGetSize(patch->ghostBcNodes, &numBcs); CHKERRQ(ierr);
-  for (i = 0; i < numBcs; ++i) {
-    ierr = PetscHSetIAdd(globalBcs, bcNodes[i]);CHKERRQ(ierr); /* these are already in concatenated numbering */
-  }
+  ierr = PetscHSetIGAddMany(globalBcs, numBcs, bcNodes);CHKERRQ(ierr); /* these are already in concatenated numbering */
   ierr = ISRestoreIndices(patch->ghostBcNodes, &bcNodes); CHKERRQ(ierr);
   ierr = ISDestroy(&patch->ghostBcNodes); CHKERRQ(ierr); /* memory optimisation */
 
   /* Hash tables for artificial BC construction */
   ierr = PetscHSetICreate(&ownedpts);CHKERRQ(ierr);
   ierr = PetscHSetICreate(&seenpts);CHKERRQ(ierr);
-  ierr = PetscHSetICreate(&owneddofs);CHKERRQ(ierr);
-  ierr = PetscHSetICreate(&seendofs);CHKERRQ(ierr);
-  ierr = PetscHSetICreate(&artificialbcs);CHKERRQ(ierr);
+  ierr = PetscHSetIGCreate(&owneddofs);CHKERRQ(ierr);
+  ierr = PetscHSetIGCreate(&seendofs);CHKERRQ(ierr);
+  ierr = PetscHSetIGCreate(&artificialbcs);CHKERRQ(ierr);
+
+  /* The dofs of one cell are checked against the BC sets together; the work arrays of each patch come from the arena */
+  for (k = 0; k < patch->nsubspaces; ++k) maxCellDofs = PetscMax(maxCellDofs, patch->nodesPerCell[k]*patch->bs[k]);
+  ierr = PetscMallocArenaPush(0);CHKERRQ(ierr);
+  ierr = PetscMallocArena3(maxCellDofs, &cellDofs, maxCellDofs, &isGlobalBcDof, maxCellDofs, &isArtificialBcDof);CHKERRQ(ierr);
 
   ierr = ISGetIndices(cells, &cellsArray);CHKERRQ(ierr);
   ierr = ISGetIndices(points, &pointsArray);CHKERRQ(ierr);
@@ -889,60 +898,37 @@ static PetscErrorCode PCPatchCreateCellPatchDiscretisationInfo(PC pc)
     ierr = PCPatchGetPointDofs(pc, seenpts, seendofs, v, -1); CHKERRQ(ierr);
     ierr = PCPatchComputeSetDifference_Private(owneddofs, seendofs, artificialbcs); CHKERRQ(ierr);
     if (patch->viewPatches) {
-      PetscHSetI globalbcdofs;
-      PetscHashIter hi;
-      MPI_Comm comm = PetscObjectComm((PetscObject)pc);
+      PetscInt *viewDofs, nviewDofs, nseen;
+      MPI_Comm  comm = PetscObjectComm((PetscObject)pc);
 
-      ierr = PetscHSetICreate(&globalbcdofs);CHKERRQ(ierr);
+      ierr = PetscHSetIGGetSize(owneddofs, &nviewDofs);CHKERRQ(ierr);
+      ierr = PetscHSetIGGetSize(seendofs, &nseen);CHKERRQ(ierr);
+      ierr = PetscMallocArenaPush(0);CHKERRQ(ierr);
+      ierr = PetscMallocArena1(PetscMax(nviewDofs, nseen), &viewDofs);CHKERRQ(ierr);
       ierr = PetscSynchronizedPrintf(comm, "Patch %d: owned dofs:\n", v); CHKERRQ(ierr);
-      PetscHashIterBegin(owneddofs, hi);
-      while (!PetscHashIterAtEnd(owneddofs, hi)) {
-        PetscInt globalDof;
-
-        PetscHashIterGetKey(owneddofs, hi, globalDof);
-        PetscHashIterNext(owneddofs, hi);
-        ierr = PetscSynchronizedPrintf(comm, "%d ", globalDof); CHKERRQ(ierr);
-      }
+      nviewDofs = 0;
+      ierr = PetscHSetIGGetElemsSorted(owneddofs, &nviewDofs, viewDofs);CHKERRQ(ierr);
+      for (i = 0; i < nviewDofs; ++i) {ierr = PetscSynchronizedPrintf(comm, "%d ", viewDofs[i]); CHKERRQ(ierr);}
       ierr = PetscSynchronizedPrintf(comm, "\n"); CHKERRQ(ierr);
       ierr = PetscSynchronizedPrintf(comm, "Patch %d: seen dofs:\n", v); CHKERRQ(ierr);
-      PetscHashIterBegin(seendofs, hi);
-      while (!PetscHashIterAtEnd(seendofs, hi)) {
-        PetscInt globalDof;
+      nviewDofs = 0;
+      ierr = PetscHSetIGGetElemsSorted(seendofs, &nviewDofs, viewDofs);CHKERRQ(ierr);
+      for (i = 0; i < nviewDofs; ++i) {ierr = PetscSynchronizedPrintf(comm, "%d ", viewDofs[i]); CHKERRQ(ierr);}
+      ierr = PetscSynchronizedPrintf(comm, "\n"); CHKERRQ(ierr);
+      ierr = PetscSynchronizedPrintf(comm, "Patch %d: global BCs:\n", v);CHKERRQ(ierr);
+      for (i = 0; i < nviewDofs; ++i) {
         PetscBool flg;
 
-        PetscHashIterGetKey(seendofs, hi, globalDof);
-        PetscHashIterNext(seendofs, hi);
-        ierr = PetscSynchronizedPrintf(comm, "%d ", globalDof); CHKERRQ(ierr);
-
-        ierr = PetscHSetIHas(globalBcs, globalDof, &flg);CHKERRQ(ierr);
-        if (flg) {ierr = PetscHSetIAdd(globalbcdofs, globalDof);CHKERRQ(ierr);}
-      }
-      ierr = PetscSynchronizedPrintf(comm, "\n"); CHKERRQ(ierr);
-      ierr = PetscSynchronizedPrintf(comm, "Patch %d: global BCs:\n", v); CHKERRQ(ierr);
-      ierr = PetscHSetIGetSize(globalbcdofs, &numBcs);CHKERRQ(ierr);
-      if (numBcs > 0) {
-        PetscHashIterBegin(globalbcdofs, hi);
-        while (!PetscHashIterAtEnd(globalbcdofs, hi)) {
-          PetscInt globalDof;
-          PetscHashIterGetKey(globalbcdofs, hi, globalDof);
-          PetscHashIterNext(globalbcdofs, hi);
-          ierr = PetscSynchronizedPrintf(comm, "%d ", globalDof);CHKERRQ(ierr);
-        }
+        ierr = PetscHSetIGHas(globalBcs, viewDofs[i], &flg);CHKERRQ(ierr);
+        if (flg) {ierr = PetscSynchronizedPrintf(comm, "%d ", viewDofs[i]);CHKERRQ(ierr);}
       }
       ierr = PetscSynchronizedPrintf(comm, "\n");CHKERRQ(ierr);
       ierr = PetscSynchronizedPrintf(comm, "Patch %d: artificial BCs:\n", v);CHKERRQ(ierr);
-      ierr = PetscHSetIGetSize(artificialbcs, &numBcs);CHKERRQ(ierr);
-      if (numBcs > 0) {
-        PetscHashIterBegin(artificialbcs, hi);
-        while (!PetscHashIterAtEnd(artificialbcs, hi)) {
-          PetscInt globalDof;
-          PetscHashIterGetKey(artificialbcs, hi, globalDof);
-          PetscHashIterNext(artificialbcs, hi);
-          ierr = PetscSynchronizedPrintf(comm, "%d ", globalDof); CHKERRQ(ierr);
-        }
-      }
+      nviewDofs = 0;
+      ierr = PetscHSetIGGetElemsSorted(artificialbcs, &nviewDofs, viewDofs);CHKERRQ(ierr);
+      for (i = 0; i < nviewDofs; ++i) {ierr = PetscSynchronizedPrintf(comm, "%d ", viewDofs[i]); CHKERRQ(ierr);}
       ierr = PetscSynchronizedPrintf(comm, "\n\n"); CHKERRQ(ierr);
-      ierr = PetscHSetIDestroy(&globalbcdofs);CHKERRQ(ierr);
+      ierr = PetscMallocArenaPop();CHKERRQ(ierr);
     }
    for (k = 0; k < patch->nsubspaces; ++k) {
       const PetscInt *cellNodeMap    = patch->cellNodeMap[k];
@@ -962,31 +948,28 @@ static PetscErrorCode PCPatchCreateCellPatchDiscretisationInfo(PC pc)
           ierr = PetscSectionGetOffset(cellNumbering, c, &cell);CHKERRQ(ierr);
         }
         newCellsArray[i] = cell;
+        /* For each global dof, map it into contiguous local storage, looping over block size last. */
         for (j = 0; j < nodesPerCell; ++j) {
-          /* For each global dof, map it into contiguous local storage. */
-          const PetscInt globalDof = cellNodeMap[cell*nodesPerCell + j]*bs + subspaceOffset;
-          /* finally, loop over block size */
-          for (l = 0; l < bs; ++l) {
-            PetscInt  localDof;
-            PetscBool isGlobalBcDof, isArtificialBcDof;
-
-            /* first, check if this is either a globally enforced or locally enforced BC dof */
-            ierr = PetscHSetIHas(globalBcs, globalDof + l, &isGlobalBcDof);CHKERRQ(ierr);
-            ierr = PetscHSetIHas(artificialbcs, globalDof + l, &isArtificialBcDof);CHKERRQ(ierr);
-
-            /* if it's either, don't ever give it a local dof number */
-            if (isGlobalBcDof || isArtificialBcDof) {
-              dofsArray[globalIndex++] = -1; /* don't use this in assembly in this patch */
-            } else {
-              ierr = PetscHMapIGet(ht, globalDof + l, &localDof);CHKERRQ(ierr);
-              if (localDof == -1) {
-                localDof = localIndex++;
-                ierr = PetscHMapISet(ht, globalDof + l, localDof);CHKERRQ(ierr);
-              }
-              if ( globalIndex >= numDofs ) SETERRQ2(PETSC_COMM_WORLD, PETSC_ERR_ARG_OUTOFRANGE, "Found more dofs %D than expected %D", globalIndex+1, numDofs);
-              /* And store. */
-              dofsArray[globalIndex++] = localDof;
+          for (l = 0; l < bs; ++l) cellDofs[j*bs + l] = cellNodeMap[cell*nodesPerCell + j]*bs + subspaceOffset + l;
+        }
+        /* first, check if these are either globally enforced or locally enforced BC dofs */
+        ierr = PetscHSetIGHasMany(globalBcs, nodesPerCell*bs, cellDofs, isGlobalBcDof);CHKERRQ(ierr);
+        ierr = PetscHSetIGHasMany(artificialbcs, nodesPerCell*bs, cellDofs, isArtificialBcDof);CHKERRQ(ierr);
+        for (j = 0; j < nodesPerCell*bs; ++j) {
+          PetscInt localDof;
+
+          /* if it's either, don't ever give it a local dof number */
+          if (isGlobalBcDof[j] || isArtificialBcDof[j]) {
+            dofsArray[globalIndex++] = -1; /* don't use this in assembly in this patch */
+          } else {
+            ierr = PetscHMapIGet(ht, cellDofs[j], &localDof);CHKERRQ(ierr);
+            if (localDof == -1) {
+              localDof = localIndex++;
+              ierr = PetscHMapISet(ht, cellDofs[j], localDof);CHKERRQ(ierr);
             }
+            if ( globalIndex >= numDofs ) SETERRQ2(PETSC_COMM_WORLD, PETSC_ERR_ARG_OUTOFRANGE, "Found more dofs %D than expected %D", globalIndex+1, numDofs);
+            /* And store. */
+            dofsArray[globalIndex++] = localDof;
           }
         }
       }
@@ -996,6 +979,7 @@ static PetscErrorCode PCPatchCreateCellPatchDiscretisationInfo(PC pc)
     ierr = PetscSectionSetDof(gtolCounts, v, dof);CHKERRQ(ierr);
   }
   if (globalIndex != numDofs) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Expected number of dofs (%d) doesn't match found number (%d)", numDofs, globalIndex);
+  ierr = PetscMallocArenaPop();CHKERRQ(ierr);
   ierr = PetscSectionSetUp(gtolCounts);CHKERRQ(ierr);
   ierr = PetscSectionGetStorageSize(gtolCounts, &numGlobalDofs);CHKERRQ(ierr);
   ierr = PetscMalloc1(numGlobalDofs, &globalDofsArray);CHKERRQ(ierr);
@@ -1057,12 +1041,12 @@ static PetscErrorCode PCPatchCreateCellPatchDiscretisationInfo(PC pc)
       }
     }
 
-    ierr = PetscHSetIDestroy(&globalBcs);CHKERRQ(ierr);
+    ierr = PetscHSetIGDestroy(&globalBcs);CHKERRQ(ierr);
     ierr = PetscHSetIDestroy(&ownedpts);CHKERRQ(ierr);
     ierr = PetscHSetIDestroy(&seenpts);CHKERRQ(ierr);
-    ierr = PetscHSetIDestroy(&owneddofs);CHKERRQ(ierr);
-    ierr = PetscHSetIDestroy(&seendofs);CHKERRQ(ierr);
-    ierr = PetscHSetIDestroy(&artificialbcs);CHKERRQ(ierr);
+    ierr = PetscHSetIGDestroy(&owneddofs);CHKERRQ(ierr);
+    ierr = PetscHSetIGDestroy(&seendofs);CHKERRQ(ierr);
+    ierr = PetscHSetIGDestroy(&artificialbcs);CHKERRQ(ierr);
 
       /* At this point, we have a hash table ht built that maps globalDof -> localDof.
      We need to create the dof table laid out cellwise first, then by subspace,
@@ -1145,7 +1129,8 @@ static PetscErrorCode PCPatchZeroFillMatrix_Private(Mat mat, const PetscInt ncel
   PetscErrorCode  ierr;
 
   PetscFunctionBegin;
-  ierr = PetscCalloc1(ndof*ndof, &values);CHKERRQ(ierr);
+  ierr = PetscMallocArenaPush(ndof*ndof*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = PetscCallocArena1(ndof*ndof, &values);CHKERRQ(ierr);
   for (c = 0; c < ncell; ++c) {
     const PetscInt *idx = &dof[ndof*c];
     ierr = MatSetValues(mat, ndof, idx, ndof, idx, values, INSERT_VALUES);CHKERRQ(ierr);
@@ -1156,7 +1141,7 @@ static PetscErrorCode PCPatchZeroFillMatrix_Private(Mat mat, const PetscInt ncel
   }
   ierr = MatAssemblyBegin(mat, MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
   ierr = MatAssemblyEnd(mat, MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
-  ierr = PetscFree(values);CHKERRQ(ierr);
+  ierr = PetscMallocArenaPop();CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1196,7 +1181,8 @@ static PetscErrorCode PCPatchCreateMatrix_Private(PC pc, PetscInt point, Mat *ma
     if (point >= pEnd) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Operator point %D not in [%D, %D)\n", point, pStart, pEnd);CHKERRQ(ierr);
     ierr = PetscSectionGetDof(patch->cellCounts, point, &ncell);CHKERRQ(ierr);
     ierr = PetscSectionGetOffset(patch->cellCounts, point, &offset);CHKERRQ(ierr);
-    ierr = PetscCalloc1(rsize, &dnnz);CHKERRQ(ierr);
+    ierr = PetscMallocArenaPush(rsize*sizeof(PetscInt));CHKERRQ(ierr);
+    ierr = PetscCallocArena1(rsize, &dnnz);CHKERRQ(ierr);
     ierr = PetscLogEventBegin(PC_Patch_Prealloc, pc, 0, 0, 0);CHKERRQ(ierr);
     /* XXX: This uses N^2 bits to store the sparsity pattern on a
      * patch.  This is probably OK if the patches are not too big,
@@ -1219,7 +1205,7 @@ static PetscErrorCode PCPatchCreateMatrix_Private(PC pc, PetscInt point, Mat *ma
     }
     ierr = PetscBTDestroy(&bt);CHKERRQ(ierr);
     ierr = MatXAIJSetPreallocation(*mat, 1, dnnz, NULL, NULL, NULL);CHKERRQ(ierr);
-    ierr = PetscFree(dnnz);CHKERRQ(ierr);
+    ierr = PetscMallocArenaPop();CHKERRQ(ierr);
     ierr = PCPatchZeroFillMatrix_Private(*mat, ncell, patch->totalDofsPerCell, &dofsArray[offset*patch->totalDofsPerCell]);CHKERRQ(ierr);
     ierr = PetscLogEventEnd(PC_Patch_Prealloc, pc, 0, 0, 0);CHKERRQ(ierr);
     ierr = ISRestoreIndices(patch->dofs, &dofsArray);CHKERRQ(ierr);
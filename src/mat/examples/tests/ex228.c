@@ -0,0 +1,153 @@
+static char help[] = "Tests the multi-threaded MatMult(), MatMultAdd() and MatMultTranspose() of MATSEQAIJ against one thread.\n\
+  -m <rows>       : number of rows\n\
+  -bs <size>      : number of identical consecutive rows, so that inodes are used\n\
+  -empty <k>      : only every k-th group of rows has nonzeros, so that compressed rows are used\n\
+  -nthreads <n>   : number of threads of the pool\n\n";
+
+#include <petscmat.h>
+
+int main(int argc,char **args)
+{
+  Mat            A;
+  Vec            x,xt,b,bt,y[5],z[5];
+  PetscInt       m = 2000,bs = 1,empty = 0,nthreads = 4,i,j,k,g,ncols,cols[40];
+  PetscScalar    vals[40];
+  PetscReal      err,nrm;
+  PetscRandom    rand;
+  PetscBool      flg;
+  const char     *names[] = {"MatMult","MatMultAdd","MatMultAdd in place","MatMultTranspose","MatMultTransposeAdd"};
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-bs",&bs,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-empty",&empty,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nthreads",&nthreads,NULL);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+
+  /* rows of very different lengths, a few of them long, in groups of bs identical rows */
+  ierr = MatCreateSeqAIJ(PETSC_COMM_SELF,m,m+7,40,NULL,&A);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  for (i=0; i<m; i+=bs) {
+    g = i/bs;
+    if (empty && (g % empty)) continue;
+    ncols = (g % 17) ? 1 + g % 5 : 40;
+    for (k=0; k<ncols; k++) cols[k] = (i + 37*k) % (m+7);
+    for (j=i; j<PetscMin(i+bs,m); j++) {
+      for (k=0; k<ncols; k++) {ierr = PetscRandomGetValue(rand,&vals[k]);CHKERRQ(ierr);}
+      ierr = MatSetValues(A,1,&j,ncols,cols,vals,INSERT_VALUES);CHKERRQ(ierr);
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = MatCreateVecs(A,&x,&b);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&bt,&xt);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(b,rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(xt,rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(bt,rand);CHKERRQ(ierr);
+  for (k=0; k<5; k++) {
+    if (k < 3) {
+      ierr = VecDuplicate(b,&y[k]);CHKERRQ(ierr);
+      ierr = VecDuplicate(b,&z[k]);CHKERRQ(ierr);
+    } else {
+      ierr = VecDuplicate(bt,&y[k]);CHKERRQ(ierr);
+      ierr = VecDuplicate(bt,&z[k]);CHKERRQ(ierr);
+    }
+  }
+
+  /* the products with one thread, then with nthreads */
+  for (j=0; j<2; j++) {
+    Vec *w = j ? z : y;
+
+    ierr = PetscThreadPoolSetSize(j ? nthreads : 1);CHKERRQ(ierr);
+    ierr = VecSet(w[0],-1.0);CHKERRQ(ierr);
+    ierr = MatMult(A,x,w[0]);CHKERRQ(ierr);
+    ierr = MatMultAdd(A,x,b,w[1]);CHKERRQ(ierr);
+    ierr = VecCopy(b,w[2]);CHKERRQ(ierr);
+    ierr = MatMultAdd(A,x,w[2],w[2]);CHKERRQ(ierr);
+    ierr = VecSet(w[3],-1.0);CHKERRQ(ierr);
+    ierr = MatMultTranspose(A,xt,w[3]);CHKERRQ(ierr);
+    ierr = MatMultTransposeAdd(A,xt,bt,w[4]);CHKERRQ(ierr);
+  }
+  /* the products are computed in the same order by any number of threads, the transposes are only summed in another one */
+  for (k=0; k<5; k++) {
+    if (k < 3) {
+      ierr = VecEqual(y[k],z[k],&flg);CHKERRQ(ierr);
+    } else {
+      ierr = VecNorm(y[k],NORM_INFINITY,&nrm);CHKERRQ(ierr);
+      ierr = VecAXPY(z[k],-1.0,y[k]);CHKERRQ(ierr);
+      ierr = VecNorm(z[k],NORM_INFINITY,&err);CHKERRQ(ierr);
+      flg  = (PetscBool)(err <= 100*PETSC_MACHINE_EPSILON*PetscMax(nrm,1.0));
+    }
+    if (!flg) {ierr = PetscPrintf(PETSC_COMM_SELF,"%s differs\n",names[k]);CHKERRQ(ierr);}
+  }
+
+  /* the transpose is summed in a fixed order, so it is reproducible */
+  ierr = MatMultTranspose(A,xt,y[3]);CHKERRQ(ierr);
+  ierr = MatMultTranspose(A,xt,z[3]);CHKERRQ(ierr);
+  ierr = VecEqual(y[3],z[3],&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_SELF,"MatMultTranspose repeated differs\n");CHKERRQ(ierr);}
+
+  /* an assembly that only changes the values keeps the partition */
+  i    = 0;
+  ierr = MatSetValue(A,i,i,1.0,ADD_VALUES);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatMult(A,x,z[0]);CHKERRQ(ierr);
+  ierr = PetscThreadPoolSetSize(1);CHKERRQ(ierr);
+  ierr = MatMult(A,x,y[0]);CHKERRQ(ierr);
+  ierr = VecEqual(y[0],z[0],&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_SELF,"MatMult after assembly differs\n");CHKERRQ(ierr);}
+  ierr = PetscPrintf(PETSC_COMM_SELF,"Products compared\n");CHKERRQ(ierr);
+
+  for (k=0; k<5; k++) {
+    ierr = VecDestroy(&y[k]);CHKERRQ(ierr);
+    ierr = VecDestroy(&z[k]);CHKERRQ(ierr);
+  }
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = VecDestroy(&xt);CHKERRQ(ierr);
+  ierr = VecDestroy(&bt);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   testset:
+      requires: define(PETSC_HAVE_PTHREAD)
+      args: -mat_threads_min_nz 1000
+      output_file: output/ex228_1.out
+
+      test:
+         suffix: 1
+         args: -nthreads {{2 3 7}}
+
+      test:
+         suffix: inode
+         args: -bs 3
+
+      test:
+         suffix: noinode
+         args: -bs 3 -mat_no_inode
+
+      test:
+         suffix: cprow
+         args: -empty 3 -nthreads 5 -mat_no_inode
+
+      test:
+         suffix: cprow_inode
+         args: -empty 4 -bs 2
+
+   test:
+      suffix: reassembly
+      requires: define(PETSC_HAVE_PTHREAD) define(PETSC_USE_INFO)
+      args: -mat_threads_min_nz 1000 -nthreads 3 -info
+      filter: grep -c "Products split among"
+
+TEST*/
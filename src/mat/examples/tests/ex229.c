@@ -0,0 +1,112 @@
+static char help[] = "Tests MATSEQAIJMERGEPATH, converted from MATSEQAIJ with MatConvert(), on a matrix with a few very long rows.\n\
+  -m <rows>       : number of rows\n\
+  -long <n>       : number of nonzeros of the long rows\n\
+  -nthreads <n>   : number of threads of the pool\n\n";
+
+#include <petscmat.h>
+
+int main(int argc,char **args)
+{
+  Mat            A,B,C;
+  Vec            x,b,y,z;
+  PetscInt       m = 3000,nlong = 2500,nthreads = 3,i,k,ncols,*cols;
+  PetscScalar    *vals;
+  PetscRandom    rand;
+  PetscBool      flg;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-long",&nlong,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nthreads",&nthreads,NULL);CHKERRQ(ierr);
+  ierr = PetscThreadPoolSetSize(nthreads);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+
+  /* a few rows with nlong nonzeros, including two consecutive ones, some empty rows and the others short */
+  nlong = PetscMin(nlong,m);
+  ierr  = PetscMalloc2(nlong,&cols,nlong,&vals);CHKERRQ(ierr);
+  ierr  = MatCreateSeqAIJ(PETSC_COMM_SELF,m,m,5,NULL,&A);CHKERRQ(ierr);
+  ierr  = MatSetOption(A,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  for (i=0; i<m; i++) {
+    if (i == 1 || i == m/2 || i == m/2+1 || i == m-2) ncols = nlong;
+    else if (!(i % 11))                               ncols = 0;
+    else                                              ncols = 1 + i % 5;
+    for (k=0; k<ncols; k++) {
+      cols[k] = (i + 7*k) % m;
+      ierr    = PetscRandomGetValue(rand,&vals[k]);CHKERRQ(ierr);
+    }
+    ierr = MatSetValues(A,1,&i,ncols,cols,vals,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = PetscFree2(cols,vals);CHKERRQ(ierr);
+
+  ierr = MatConvert(A,MATSEQAIJMERGEPATH,MAT_INITIAL_MATRIX,&B);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)B,MATSEQAIJMERGEPATH,&flg);CHKERRQ(ierr);
+  if (!flg) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"MatConvert() did not give a MATSEQAIJMERGEPATH matrix");
+  ierr = MatDuplicate(B,MAT_COPY_VALUES,&C);CHKERRQ(ierr);
+
+  ierr = MatMultEqual(A,B,3,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_SELF,"MatMult differs\n");CHKERRQ(ierr);}
+  ierr = MatMultAddEqual(A,B,3,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_SELF,"MatMultAdd differs\n");CHKERRQ(ierr);}
+  ierr = MatMultEqual(A,C,3,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_SELF,"MatMult of the duplicate differs\n");CHKERRQ(ierr);}
+
+  /* MatMult() overwrites y, whatever it holds, and MatMultAdd() in place gives the same result */
+  ierr = MatCreateVecs(A,&x,&b);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+  ierr = VecSetRandom(b,rand);CHKERRQ(ierr);
+  ierr = VecDuplicate(b,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(b,&z);CHKERRQ(ierr);
+  ierr = VecSet(z,-1.0);CHKERRQ(ierr);
+  ierr = MatMult(B,x,y);CHKERRQ(ierr);
+  ierr = MatMult(B,x,z);CHKERRQ(ierr);
+  ierr = VecEqual(y,z,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_SELF,"MatMult into a nonzero vector differs\n");CHKERRQ(ierr);}
+  ierr = MatMultAdd(B,x,b,y);CHKERRQ(ierr);
+  ierr = VecCopy(b,z);CHKERRQ(ierr);
+  ierr = MatMultAdd(B,x,z,z);CHKERRQ(ierr);
+  ierr = VecEqual(y,z,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_SELF,"MatMultAdd in place differs\n");CHKERRQ(ierr);}
+
+  /* the tiles follow the size of the thread pool */
+  if (nthreads > 1) {
+    ierr = PetscThreadPoolSetSize(nthreads+2);CHKERRQ(ierr);
+    ierr = MatMultEqual(A,B,3,&flg);CHKERRQ(ierr);
+    if (!flg) {ierr = PetscPrintf(PETSC_COMM_SELF,"MatMult with more threads differs\n");CHKERRQ(ierr);}
+  }
+
+  /* and back to MATSEQAIJ */
+  ierr = MatConvert(B,MATSEQAIJ,MAT_INPLACE_MATRIX,&B);CHKERRQ(ierr);
+  ierr = MatMultEqual(A,B,3,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_SELF,"MatMult after conversion to MATSEQAIJ differs\n");CHKERRQ(ierr);}
+  ierr = PetscPrintf(PETSC_COMM_SELF,"Products compared\n");CHKERRQ(ierr);
+
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = MatDestroy(&C);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      args: -nthreads 1
+      output_file: output/ex229_1.out
+
+   test:
+      suffix: threads
+      requires: define(PETSC_HAVE_PTHREAD)
+      args: -nthreads {{2 3 8}} -long {{20 2500}}
+      output_file: output/ex229_1.out
+
+TEST*/
@@ -0,0 +1,186 @@
+static char help[] = "Tests -mat_seqaij_autotune, the choice of the subtype with the fastest MatMult() at the end of the assembly.\n\
+  -m <rows>       : number of local rows\n\
+  -test_aijfloat  : also assemble a MATAIJFLOAT matrix, which must keep its type\n\n";
+
+#include <petscmat.h>
+
+/* relative difference of the products of the autotuned matrix A and of the reference matrix R */
+static PetscErrorCode CheckMult(const char *name,Mat A,Mat R)
+{
+  Vec            x,y,z;
+  PetscReal      err,nrm;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatCreateVecs(A,&x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&z);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,NULL);CHKERRQ(ierr);
+  ierr = MatMult(A,x,y);CHKERRQ(ierr);
+  ierr = MatMult(R,x,z);CHKERRQ(ierr);
+  ierr = VecAXPY(y,-1.0,z);CHKERRQ(ierr);
+  ierr = VecNorm(y,NORM_INFINITY,&err);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_INFINITY,&nrm);CHKERRQ(ierr);
+  if (err > 1000*PETSC_MACHINE_EPSILON*PetscMax(nrm,1.0)) {
+    ierr = PetscPrintf(PetscObjectComm((PetscObject)A),"%s differs by %g\n",name,(double)err);CHKERRQ(ierr);
+  }
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* the type of the local diagonal block, which is the matrix itself on one process */
+static PetscErrorCode PrintBlockType(const char *when,Mat A)
+{
+  Mat            Ad = A;
+  PetscMPIInt    size;
+  MatType        type;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)A),&size);CHKERRQ(ierr);
+  if (size > 1) {
+    ierr = MatMPIAIJGetSeqAIJ(A,&Ad,NULL,NULL);CHKERRQ(ierr);
+  }
+  ierr = MatGetType(Ad,&type);CHKERRQ(ierr);
+  ierr = PetscPrintf(PetscObjectComm((PetscObject)A),"%s: %s\n",when,type);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* a five point Laplacian on a grid with 10 points per line and a few long rows, in both A and R if R is given */
+static PetscErrorCode SetValues(Mat A,Mat R,InsertMode mode)
+{
+  PetscInt       i,j,k,M,rstart,rend,cols[40];
+  PetscScalar    vals[40];
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatGetSize(A,&M,NULL);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) {
+    k = 0;
+    if (i >= 10)  {cols[k] = i-10; vals[k++] = -1.0;}
+    if (i >= 1)   {cols[k] = i-1;  vals[k++] = -1.0;}
+    cols[k] = i; vals[k++] = 4.0;
+    if (i+1 < M)  {cols[k] = i+1;  vals[k++] = -1.0;}
+    if (i+10 < M) {cols[k] = i+10; vals[k++] = -1.0;}
+    if (!(i % 97)) {
+      for (j=0; j<30; j++) {cols[k] = (i + 41*j + 13) % M; vals[k++] = 0.01*j;}
+    }
+    ierr = MatSetValues(A,1,&i,k,cols,vals,mode);CHKERRQ(ierr);
+    if (R) {ierr = MatSetValues(R,1,&i,k,cols,vals,mode);CHKERRQ(ierr);}
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  if (R) {
+    ierr = MatAssemblyBegin(R,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(R,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A,R,F;
+  PetscInt       m = 1000,i,j,rstart;
+  PetscScalar    v = 2.0;
+  PetscBool      aijfloat = PETSC_FALSE;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-test_aijfloat",&aijfloat,NULL);CHKERRQ(ierr);
+
+  /* the options of R have another prefix, so it is not autotuned */
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatCreate(PETSC_COMM_WORLD,&R);CHKERRQ(ierr);
+  ierr = MatSetOptionsPrefix(R,"ref_");CHKERRQ(ierr);
+  ierr = MatSetSizes(A,m,m,PETSC_DECIDE,PETSC_DECIDE);CHKERRQ(ierr);
+  ierr = MatSetSizes(R,m,m,PETSC_DECIDE,PETSC_DECIDE);CHKERRQ(ierr);
+  ierr = MatSetType(A,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSetType(R,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(A,40,NULL);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(R,40,NULL);CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocation(A,40,NULL,40,NULL);CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocation(R,40,NULL,40,NULL);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = MatSetOption(R,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+
+  ierr = SetValues(A,R,INSERT_VALUES);CHKERRQ(ierr);
+  ierr = PrintBlockType("First assembly",A);CHKERRQ(ierr);
+  ierr = CheckMult("First assembly",A,R);CHKERRQ(ierr);
+
+  /* the choice is kept while the nonzero structure does not change, even if the subtypes tried change */
+  ierr = PetscOptionsSetValue(NULL,"-mat_seqaij_autotune_types","seqaijcrl");CHKERRQ(ierr);
+  ierr = SetValues(A,R,ADD_VALUES);CHKERRQ(ierr);
+  ierr = PrintBlockType("Same nonzero structure",A);CHKERRQ(ierr);
+  ierr = CheckMult("Same nonzero structure",A,R);CHKERRQ(ierr);
+
+  /* a new nonzero in the diagonal block of each process runs the trials again */
+  ierr = MatGetOwnershipRange(A,&rstart,NULL);CHKERRQ(ierr);
+  i    = rstart;
+  j    = rstart + m/2;
+  ierr = MatSetValues(A,1,&i,1,&j,&v,INSERT_VALUES);CHKERRQ(ierr);
+  ierr = MatSetValues(R,1,&i,1,&j,&v,INSERT_VALUES);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(R,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(R,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = PrintBlockType("New nonzero",A);CHKERRQ(ierr);
+  ierr = CheckMult("New nonzero",A,R);CHKERRQ(ierr);
+
+  /* only MATSEQAIJ matrices are autotuned, the blocks of a MATAIJFLOAT matrix keep their single precision values */
+  if (aijfloat) {
+    ierr = MatCreate(PETSC_COMM_WORLD,&F);CHKERRQ(ierr);
+    ierr = MatSetSizes(F,m,m,PETSC_DECIDE,PETSC_DECIDE);CHKERRQ(ierr);
+    ierr = MatSetType(F,MATAIJFLOAT);CHKERRQ(ierr);
+    ierr = MatSeqAIJSetPreallocation(F,40,NULL);CHKERRQ(ierr);
+    ierr = MatMPIAIJSetPreallocation(F,40,NULL,40,NULL);CHKERRQ(ierr);
+    ierr = SetValues(F,NULL,INSERT_VALUES);CHKERRQ(ierr);
+    ierr = PrintBlockType("MATAIJFLOAT",F);CHKERRQ(ierr);
+    ierr = MatDestroy(&F);CHKERRQ(ierr);
+  }
+
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&R);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      args: -mat_seqaij_autotune -mat_seqaij_autotune_types seqaijperm
+
+   test:
+      suffix: 2
+      nsize: 2
+      args: -mat_seqaij_autotune -mat_seqaij_autotune_types seqaijsell -m 500
+
+   test:
+      suffix: all
+      args: -mat_seqaij_autotune -mat_seqaij_autotune_its 2 -info
+      filter: grep -c "Chose"
+
+   test:
+      suffix: all_2
+      nsize: 2
+      args: -mat_seqaij_autotune -mat_seqaij_autotune_its 2 -m 500 -info
+      filter: grep -c "Chose"
+
+   test:
+      suffix: aijfloat
+      requires: !complex
+      args: -mat_seqaij_autotune -mat_seqaij_autotune_types seqaijperm -m 500 -test_aijfloat
+      filter: grep MATAIJFLOAT
+
+   test:
+      suffix: aijfloat_2
+      nsize: 2
+      requires: !complex
+      args: -mat_seqaij_autotune -mat_seqaij_autotune_types seqaijperm -m 500 -test_aijfloat
+      filter: grep MATAIJFLOAT
+      output_file: output/ex230_aijfloat.out
+
+TEST*/
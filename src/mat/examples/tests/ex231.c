@@ -0,0 +1,225 @@
+static char help[] = "Tests MATAIJFLOAT, AIJ with single precision values, against MATAIJ.\n\
+  -m <rows>       : number of local rows\n\n";
+
+#include <petscmat.h>
+
+/* the values of B must be those of A rounded to single precision */
+static PetscErrorCode CheckRows(Mat A,Mat B)
+{
+  PetscInt          i,k,rstart,rend,na,nb;
+  const PetscInt    *ja,*jb;
+  const PetscScalar *va,*vb;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) {
+    ierr = MatGetRow(A,i,&na,&ja,&va);CHKERRQ(ierr);
+    ierr = MatGetRow(B,i,&nb,&jb,&vb);CHKERRQ(ierr);
+    if (na != nb) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Row %D has %D nonzeros instead of %D",i,nb,na);
+    for (k=0; k<na; k++) {
+      if (ja[k] != jb[k] || vb[k] != (PetscScalar)(float)va[k]) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Row %D differs in column %D",i,ja[k]);
+    }
+    ierr = MatRestoreRow(B,i,&nb,&jb,&vb);CHKERRQ(ierr);
+    ierr = MatRestoreRow(A,i,&na,&ja,&va);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* the local diagonal block of A, the matrix itself on one process */
+static PetscErrorCode GetDiagonalBlock(Mat A,Mat *Ad)
+{
+  PetscMPIInt    size;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *Ad  = A;
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)A),&size);CHKERRQ(ierr);
+  if (size > 1) {ierr = MatMPIAIJGetSeqAIJ(A,Ad,NULL,NULL);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+/* the values in the MATSEQAIJ storage of the diagonal block of B, which the factorizations use, must be rounded */
+static PetscErrorCode CheckStorage(const char *when,Mat B)
+{
+  Mat            Bd;
+  MatInfo        info;
+  PetscScalar    *v;
+  PetscInt       k;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = GetDiagonalBlock(B,&Bd);CHKERRQ(ierr);
+  ierr = MatGetInfo(Bd,MAT_LOCAL,&info);CHKERRQ(ierr);
+  ierr = MatSeqAIJGetArray(Bd,&v);CHKERRQ(ierr);
+  for (k=0; k<(PetscInt)info.nz_used; k++) {
+    if (v[k] != (PetscScalar)(float)v[k]) {
+      ierr = PetscPrintf(PETSC_COMM_SELF,"Values not rounded %s\n",when);CHKERRQ(ierr);
+      break;
+    }
+  }
+  ierr = MatSeqAIJRestoreArray(Bd,&v);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* scales the values of the diagonal block of A through its array */
+static PetscErrorCode ScaleArray(Mat A,PetscScalar alpha)
+{
+  Mat            Ad;
+  MatInfo        info;
+  PetscScalar    *v;
+  PetscInt       k;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = GetDiagonalBlock(A,&Ad);CHKERRQ(ierr);
+  ierr = MatGetInfo(Ad,MAT_LOCAL,&info);CHKERRQ(ierr);
+  ierr = MatSeqAIJGetArray(Ad,&v);CHKERRQ(ierr);
+  for (k=0; k<(PetscInt)info.nz_used; k++) v[k] *= alpha;
+  ierr = MatSeqAIJRestoreArray(Ad,&v);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* the products and the sweeps of B and of a MATAIJ copy of it, which has the same rounded values */
+static PetscErrorCode CheckOps(const char *when,Mat B,Vec b)
+{
+  Mat            R;
+  Vec            *y,*z;
+  PetscReal      err,nrm;
+  PetscBool      flg;
+  PetscInt       k;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatConvert(B,MATAIJ,MAT_INITIAL_MATRIX,&R);CHKERRQ(ierr);
+  ierr = MatMultEqual(R,B,3,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PetscObjectComm((PetscObject)B),"MatMult %s differs\n",when);CHKERRQ(ierr);}
+  ierr = MatMultAddEqual(R,B,3,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PetscObjectComm((PetscObject)B),"MatMultAdd %s differs\n",when);CHKERRQ(ierr);}
+  ierr = VecDuplicateVecs(b,2,&y);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(b,2,&z);CHKERRQ(ierr);
+  ierr = MatSOR(R,b,1.0,(MatSORType)(SOR_LOCAL_SYMMETRIC_SWEEP | SOR_ZERO_INITIAL_GUESS),0.0,2,1,y[0]);CHKERRQ(ierr);
+  ierr = MatSOR(B,b,1.0,(MatSORType)(SOR_LOCAL_SYMMETRIC_SWEEP | SOR_ZERO_INITIAL_GUESS),0.0,2,1,z[0]);CHKERRQ(ierr);
+  ierr = VecCopy(y[0],y[1]);CHKERRQ(ierr);
+  ierr = VecCopy(y[0],z[1]);CHKERRQ(ierr);
+  ierr = MatSOR(R,b,0.8,SOR_LOCAL_BACKWARD_SWEEP,0.0,1,2,y[1]);CHKERRQ(ierr);
+  ierr = MatSOR(B,b,0.8,SOR_LOCAL_BACKWARD_SWEEP,0.0,1,2,z[1]);CHKERRQ(ierr);
+  for (k=0; k<2; k++) {
+    ierr = VecNorm(y[k],NORM_INFINITY,&nrm);CHKERRQ(ierr);
+    ierr = VecAXPY(z[k],-1.0,y[k]);CHKERRQ(ierr);
+    ierr = VecNorm(z[k],NORM_INFINITY,&err);CHKERRQ(ierr);
+    if (err > 1000*PETSC_MACHINE_EPSILON*PetscMax(nrm,1.0)) {
+      ierr = PetscPrintf(PetscObjectComm((PetscObject)B),"MatSOR %s %s differs by %g\n",k ? "backward" : "symmetric",when,(double)err);CHKERRQ(ierr);
+    }
+  }
+  ierr = VecDestroyVecs(2,&y);CHKERRQ(ierr);
+  ierr = VecDestroyVecs(2,&z);CHKERRQ(ierr);
+  ierr = MatDestroy(&R);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A,B,Bd;
+  Vec            b;
+  PetscInt       m = 1000,M,i,j,k,rstart,rend,cols[6];
+  PetscScalar    vals[6],*v;
+  PetscRandom    rand;
+  PetscBool      flg;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetInterval(rand,-1.0,1.0);CHKERRQ(ierr);
+
+  /* a perturbed five point Laplacian on a grid with 10 points per line, the first row coupled to the last one */
+  ierr = MatCreateAIJ(PETSC_COMM_WORLD,m,m,PETSC_DETERMINE,PETSC_DETERMINE,6,NULL,6,NULL,&A);CHKERRQ(ierr);
+  ierr = MatGetSize(A,&M,NULL);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) {
+    k = 0;
+    if (i >= 10)  cols[k++] = i-10;
+    if (i >= 1)   cols[k++] = i-1;
+    if (i+1 < M)  cols[k++] = i+1;
+    if (i+10 < M) cols[k++] = i+10;
+    if (!i)       cols[k++] = M-1;
+    if (i == M-1) cols[k++] = 0;
+    for (j=0; j<k; j++) {ierr = PetscRandomGetValue(rand,&vals[j]);CHKERRQ(ierr);}
+    cols[k] = i; vals[k++] = 5.0 + vals[0]/3.0;
+    ierr = MatSetValues(A,1,&i,k,cols,vals,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = MatConvert(A,MATAIJFLOAT,MAT_INITIAL_MATRIX,&B);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompareAny((PetscObject)B,&flg,MATSEQAIJFLOAT,MATMPIAIJFLOAT,"");CHKERRQ(ierr);
+  if (!flg) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"MatConvert() did not give a MATAIJFLOAT matrix");
+  ierr = CheckStorage("after MatConvert()",B);CHKERRQ(ierr);
+
+  ierr = MatCreateVecs(A,NULL,&b);CHKERRQ(ierr);
+  ierr = VecSetRandom(b,rand);CHKERRQ(ierr);
+  ierr = CheckOps("after MatConvert()",B,b);CHKERRQ(ierr);
+  ierr = CheckRows(A,B);CHKERRQ(ierr);
+
+  /* new values are rounded again */
+  ierr = MatScale(A,1.0/3.0);CHKERRQ(ierr);
+  ierr = MatScale(B,1.0/3.0);CHKERRQ(ierr);
+  ierr = CheckOps("after MatScale()",B,b);CHKERRQ(ierr);
+  ierr = MatShift(A,1.0/7.0);CHKERRQ(ierr);
+  ierr = MatShift(B,1.0/7.0);CHKERRQ(ierr);
+  ierr = CheckOps("after MatShift()",B,b);CHKERRQ(ierr);
+
+  /* the values are rounded by the assembly, MatSeqAIJRestoreArray() and MatRetrieveValues(), before any product */
+  vals[0] = 1.0/3.0;
+  ierr    = MatSetValues(A,1,&rstart,1,&rstart,vals,ADD_VALUES);CHKERRQ(ierr);
+  ierr    = MatSetValues(B,1,&rstart,1,&rstart,vals,ADD_VALUES);CHKERRQ(ierr);
+  ierr    = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr    = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr    = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr    = MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr    = CheckStorage("after the assembly",B);CHKERRQ(ierr);
+  ierr    = ScaleArray(A,1.0/3.0);CHKERRQ(ierr);
+  ierr    = ScaleArray(B,1.0/3.0);CHKERRQ(ierr);
+  ierr    = CheckStorage("after MatSeqAIJRestoreArray()",B);CHKERRQ(ierr);
+  /* the values stored are not rounded, they are changed through the array before it is restored */
+  ierr = GetDiagonalBlock(B,&Bd);CHKERRQ(ierr);
+  ierr = MatSetOption(Bd,MAT_NEW_NONZERO_LOCATIONS,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = MatSeqAIJGetArray(Bd,&v);CHKERRQ(ierr);
+  v[0] = 1.0/3.0;
+  ierr = MatStoreValues(Bd);CHKERRQ(ierr);
+  ierr = MatSeqAIJRestoreArray(Bd,&v);CHKERRQ(ierr);
+  ierr = MatRetrieveValues(Bd);CHKERRQ(ierr);
+  ierr = CheckStorage("after MatRetrieveValues()",B);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Compared with MATAIJ\n");CHKERRQ(ierr);
+
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   build:
+      requires: !complex
+
+   test:
+      suffix: 1
+      args: -mat_seqaijfloat_short_indices {{0 1}}
+      output_file: output/ex231_1.out
+
+   test:
+      suffix: 2
+      nsize: 2
+      args: -m 500
+      output_file: output/ex231_1.out
+
+   test:
+      suffix: wide
+      args: -m 70000 -info
+      filter: grep -c "as [04] byte offsets"
+
+TEST*/
@@ -0,0 +1,124 @@
+static char help[] = "Tests MATSEQAIJOFFSET, converted from MATSEQAIJ with MatConvert(), against MATSEQAIJ.\n\
+  -m <rows>       : number of rows\n\
+  -nx <points>    : number of points per line of the grid\n\n";
+
+#include <petscmat.h>
+
+/* the products and the sweeps of A and B */
+static PetscErrorCode CheckOps(const char *when,Mat A,Mat B,Vec b)
+{
+  Vec            *y,*z;
+  PetscReal      err,nrm;
+  PetscBool      flg;
+  PetscInt       k;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatMultEqual(A,B,3,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_SELF,"MatMult %s differs\n",when);CHKERRQ(ierr);}
+  ierr = MatMultAddEqual(A,B,3,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_SELF,"MatMultAdd %s differs\n",when);CHKERRQ(ierr);}
+  ierr = VecDuplicateVecs(b,2,&y);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(b,2,&z);CHKERRQ(ierr);
+  ierr = MatSOR(A,b,1.0,(MatSORType)(SOR_SYMMETRIC_SWEEP | SOR_ZERO_INITIAL_GUESS),0.0,2,1,y[0]);CHKERRQ(ierr);
+  ierr = MatSOR(B,b,1.0,(MatSORType)(SOR_SYMMETRIC_SWEEP | SOR_ZERO_INITIAL_GUESS),0.0,2,1,z[0]);CHKERRQ(ierr);
+  ierr = VecCopy(y[0],y[1]);CHKERRQ(ierr);
+  ierr = VecCopy(y[0],z[1]);CHKERRQ(ierr);
+  ierr = MatSOR(A,b,0.8,SOR_BACKWARD_SWEEP,0.1,1,2,y[1]);CHKERRQ(ierr);
+  ierr = MatSOR(B,b,0.8,SOR_BACKWARD_SWEEP,0.1,1,2,z[1]);CHKERRQ(ierr);
+  for (k=0; k<2; k++) {
+    ierr = VecNorm(y[k],NORM_INFINITY,&nrm);CHKERRQ(ierr);
+    ierr = VecAXPY(z[k],-1.0,y[k]);CHKERRQ(ierr);
+    ierr = VecNorm(z[k],NORM_INFINITY,&err);CHKERRQ(ierr);
+    if (err > 1000*PETSC_MACHINE_EPSILON*PetscMax(nrm,1.0)) {
+      ierr = PetscPrintf(PETSC_COMM_SELF,"MatSOR %s %s differs by %g\n",k ? "backward" : "symmetric",when,(double)err);CHKERRQ(ierr);
+    }
+  }
+  ierr = VecDestroyVecs(2,&y);CHKERRQ(ierr);
+  ierr = VecDestroyVecs(2,&z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A,B,C;
+  Vec            b;
+  PetscInt       m = 1000,nx = 10,i,j,k,cols[5];
+  PetscScalar    vals[5],v = 0.5;
+  PetscRandom    rand;
+  PetscBool      flg;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nx",&nx,NULL);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetInterval(rand,-1.0,1.0);CHKERRQ(ierr);
+
+  /* a perturbed five point Laplacian on a grid with nx points per line, with some empty rows */
+  ierr = MatCreateSeqAIJ(PETSC_COMM_SELF,m,m,5,NULL,&A);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  for (i=0; i<m; i++) {
+    if (i % 37 == 5) continue;
+    k = 0;
+    if (i >= nx)  cols[k++] = i-nx;
+    if (i >= 1)   cols[k++] = i-1;
+    if (i+1 < m)  cols[k++] = i+1;
+    if (i+nx < m) cols[k++] = i+nx;
+    for (j=0; j<k; j++) {ierr = PetscRandomGetValue(rand,&vals[j]);CHKERRQ(ierr);}
+    cols[k] = i; vals[k++] = 5.0;
+    ierr = MatSetValues(A,1,&i,k,cols,vals,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  /* a diagonal for the sweeps in the empty rows */
+  ierr = MatShift(A,1.0);CHKERRQ(ierr);
+
+  ierr = MatConvert(A,MATSEQAIJOFFSET,MAT_INITIAL_MATRIX,&B);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)B,MATSEQAIJOFFSET,&flg);CHKERRQ(ierr);
+  if (!flg) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"MatConvert() did not give a MATSEQAIJOFFSET matrix");
+
+  ierr = MatCreateVecs(A,NULL,&b);CHKERRQ(ierr);
+  ierr = VecSetRandom(b,rand);CHKERRQ(ierr);
+  ierr = CheckOps("after MatConvert()",A,B,b);CHKERRQ(ierr);
+  ierr = MatDuplicate(B,MAT_COPY_VALUES,&C);CHKERRQ(ierr);
+  ierr = CheckOps("of the duplicate",A,C,b);CHKERRQ(ierr);
+
+  /* a nonzero far from the diagonal widens the offsets */
+  i    = m/2;
+  j    = m-1;
+  ierr = MatSetValues(A,1,&i,1,&j,&v,INSERT_VALUES);CHKERRQ(ierr);
+  ierr = MatSetValues(B,1,&i,1,&j,&v,INSERT_VALUES);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = CheckOps("after a new nonzero",A,B,b);CHKERRQ(ierr);
+
+  /* and back to MATSEQAIJ */
+  ierr = MatConvert(B,MATSEQAIJ,MAT_INPLACE_MATRIX,&B);CHKERRQ(ierr);
+  ierr = CheckOps("after conversion to MATSEQAIJ",A,B,b);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF,"Compared with MATSEQAIJ\n");CHKERRQ(ierr);
+
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = MatDestroy(&C);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      args: -info
+      filter: grep -E "byte offsets|Compared|differs"
+
+   test:
+      suffix: 2
+      args: -m 140000 -nx 200 -info
+      filter: grep -E "byte offsets|Compared|differs" | sed -e "s/as [04] byte/as 4 or 0 byte/"
+
+TEST*/
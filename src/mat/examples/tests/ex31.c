@@ -15,6 +15,7 @@ int main(int argc,char **args)
   PetscMPIInt    rank,size;
   PetscErrorCode ierr;
   PetscViewer    viewer;
+  PetscBool      mpiio = PETSC_FALSE;
 #if defined(PETSC_USE_LOG)
   PetscLogEvent MATRIX_GENERATE,MATRIX_READ;
 #endif
@@ -24,6 +25,7 @@ int main(int argc,char **args)
   ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
   ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-mpiio",&mpiio,NULL);CHKERRQ(ierr);
   N    = m*n;
 
   /* PART 1:  Generate matrix, then write it in binary format */
@@ -51,6 +53,7 @@ int main(int argc,char **args)
 
   ierr = PetscPrintf(PETSC_COMM_WORLD,"writing matrix in binary to matrix.dat ...\n");CHKERRQ(ierr);
   ierr = PetscViewerBinaryOpen(PETSC_COMM_WORLD,"matrix.dat",FILE_MODE_WRITE,&viewer);CHKERRQ(ierr);
+  if (mpiio) {ierr = PetscViewerBinarySetUseMPIIO(viewer,PETSC_TRUE);CHKERRQ(ierr);}
   ierr = MatView(C,viewer);CHKERRQ(ierr);
   ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
   ierr = MatDestroy(&C);CHKERRQ(ierr);
@@ -65,6 +68,7 @@ int main(int argc,char **args)
   ierr = PetscLogEventBegin(MATRIX_READ,0,0,0,0);CHKERRQ(ierr);
   ierr = PetscPrintf(PETSC_COMM_WORLD,"reading matrix in binary from matrix.dat ...\n");CHKERRQ(ierr);
   ierr = PetscViewerBinaryOpen(PETSC_COMM_WORLD,"matrix.dat",FILE_MODE_READ,&viewer);CHKERRQ(ierr);
+  if (mpiio) {ierr = PetscViewerBinarySetUseMPIIO(viewer,PETSC_TRUE);CHKERRQ(ierr);}
   ierr = MatCreate(PETSC_COMM_WORLD,&C);CHKERRQ(ierr);
   ierr = MatLoad(C,viewer);CHKERRQ(ierr);
   ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
@@ -86,4 +90,25 @@ int main(int argc,char **args)
    test:
       filter: grep -v "MPI processes"
 
+   test:
+      suffix: mpiio
+      nsize: 3
+      requires: define(PETSC_HAVE_MPIIO)
+      args: -mpiio
+      filter: grep -v "MPI processes"
+
+   test:
+      suffix: mpiio_seq
+      requires: define(PETSC_HAVE_MPIIO)
+      args: -mpiio
+      filter: grep -v "MPI processes"
+      output_file: output/ex31_1.out
+
+   test:
+      suffix: mmap
+      requires: define(PETSC_HAVE_MMAP)
+      args: -viewer_binary_mmap
+      filter: grep -v "MPI processes"
+      output_file: output/ex31_1.out
+
 TEST*/
@@ -0,0 +1,158 @@
+#include <../src/mat/impls/aij/mpi/mpiaij.h>
+/*@C
+   MatCreateMPIAIJFloat - Creates a sparse parallel matrix whose local
+   portions are stored as SEQAIJFLOAT matrices (a matrix class that inherits
+   from SEQAIJ but reads its values in single precision in the products).  The same
+   guidelines that apply to MPIAIJ matrices for preallocating the matrix
+   storage apply here as well.
+
+      Collective on MPI_Comm
+
+   Input Parameters:
++  comm - MPI communicator
+.  m - number of local rows (or PETSC_DECIDE to have calculated if M is given)
+           This value should be the same as the local size used in creating the
+           y vector for the matrix-vector product y = Ax.
+.  n - This value should be the same as the local size used in creating the
+       x vector for the matrix-vector product y = Ax. (or PETSC_DECIDE to have
+       calculated if N is given) For square matrices n is almost always m.
+.  M - number of global rows (or PETSC_DETERMINE to have calculated if m is given)
+.  N - number of global columns (or PETSC_DETERMINE to have calculated if n is given)
+.  d_nz  - number of nonzeros per row in DIAGONAL portion of local submatrix
+           (same value is used for all local rows)
+.  d_nnz - array containing the number of nonzeros in the various rows of the
+           DIAGONAL portion of the local submatrix (possibly different for each row)
+           or NULL, if d_nz is used to specify the nonzero structure.
+           The size of this array is equal to the number of local rows, i.e 'm'.
+.  o_nz  - number of nonzeros per row in the OFF-DIAGONAL portion of local
+           submatrix (same value is used for all local rows).
+-  o_nnz - array containing the number of nonzeros in the various rows of the
+           OFF-DIAGONAL portion of the local submatrix (possibly different for
+           each row) or NULL, if o_nz is used to specify the nonzero
+           structure. The size of this array is equal to the number
+           of local rows, i.e 'm'.
+
+   Output Parameter:
+.  A - the matrix
+
+   Notes:
+   If the *_nnz parameter is given then the *_nz parameter is ignored
+
+   When calling this routine with a single process communicator, a matrix of
+   type SEQAIJFLOAT is returned.  If a matrix of type MPIAIJFLOAT is desired
+   for this type of communicator, use the construction mechanism:
+     MatCreate(...,&A); MatSetType(A,MPIAIJFLOAT); MatMPIAIJSetPreallocation(A,...);
+
+   The values are rounded to single precision, see MATSEQAIJFLOAT. Only available for real scalars.
+
+   Options Database Keys:
+.  -mat_seqaijfloat_short_indices <true> - read the column indices of the local portions as 1, 2 or 4 byte offsets when they fit
+
+   Level: intermediate
+
+.keywords: matrix, sparse, parallel, single precision
+
+.seealso: MatCreate(), MatCreateMPIAIJ(), MatSetValues(), MATSEQAIJFLOAT, MATMPIAIJFLOAT
+@*/
+PetscErrorCode  MatCreateMPIAIJFloat(MPI_Comm comm,PetscInt m,PetscInt n,PetscInt M,PetscInt N,PetscInt d_nz,const PetscInt d_nnz[],PetscInt o_nz,const PetscInt o_nnz[],Mat *A)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    size;
+
+  PetscFunctionBegin;
+  ierr = MatCreate(comm,A);CHKERRQ(ierr);
+  ierr = MatSetSizes(*A,m,n,M,N);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  if (size > 1) {
+    ierr = MatSetType(*A,MATMPIAIJFLOAT);CHKERRQ(ierr);
+    ierr = MatMPIAIJSetPreallocation(*A,d_nz,d_nnz,o_nz,o_nnz);CHKERRQ(ierr);
+  } else {
+    ierr = MatSetType(*A,MATSEQAIJFLOAT);CHKERRQ(ierr);
+    ierr = MatSeqAIJSetPreallocation(*A,d_nz,d_nnz);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJFloat(Mat,MatType,MatReuse,Mat*);
+
+PetscErrorCode  MatMPIAIJSetPreallocation_MPIAIJFloat(Mat B,PetscInt d_nz,const PetscInt d_nnz[],PetscInt o_nz,const PetscInt o_nnz[])
+{
+  Mat_MPIAIJ     *b = (Mat_MPIAIJ*)B->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatMPIAIJSetPreallocation_MPIAIJ(B,d_nz,d_nnz,o_nz,o_nnz);CHKERRQ(ierr);
+  ierr = MatConvert_SeqAIJ_SeqAIJFloat(b->A, MATSEQAIJFLOAT, MAT_INPLACE_MATRIX, &b->A);CHKERRQ(ierr);
+  ierr = MatConvert_SeqAIJ_SeqAIJFloat(b->B, MATSEQAIJFLOAT, MAT_INPLACE_MATRIX, &b->B);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJFloat(Mat A,MatType type,MatReuse reuse,Mat *newmat)
+{
+  PetscErrorCode ierr;
+  Mat            B = *newmat;
+  Mat_MPIAIJ     *b;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) {
+    ierr = MatDuplicate(A,MAT_COPY_VALUES,&B);CHKERRQ(ierr);
+  }
+
+  /* the local portions of a matrix that is already preallocated are converted here, the others at the preallocation */
+  b = (Mat_MPIAIJ*)B->data;
+  if (b->A) {
+    ierr = MatConvert_SeqAIJ_SeqAIJFloat(b->A, MATSEQAIJFLOAT, MAT_INPLACE_MATRIX, &b->A);CHKERRQ(ierr);
+  }
+  if (b->B) {
+    ierr = MatConvert_SeqAIJ_SeqAIJFloat(b->B, MATSEQAIJFLOAT, MAT_INPLACE_MATRIX, &b->B);CHKERRQ(ierr);
+  }
+  ierr = PetscObjectChangeTypeName((PetscObject) B, MATMPIAIJFLOAT);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMPIAIJSetPreallocation_C",MatMPIAIJSetPreallocation_MPIAIJFloat);CHKERRQ(ierr);
+  *newmat = B;
+  PetscFunctionReturn(0);
+}
+
+PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJFloat(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSetType(A,MATMPIAIJ);CHKERRQ(ierr);
+  ierr = MatConvert_MPIAIJ_MPIAIJFloat(A,MATMPIAIJFLOAT,MAT_INPLACE_MATRIX,&A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   MATMPIAIJFLOAT - MATMPIAIJFLOAT = "mpiaijfloat" - A MATMPIAIJ matrix whose diagonal and off-diagonal portions are
+   MATSEQAIJFLOAT matrices, so MatMult(), MatMultAdd() and the local sweeps of MatSOR() read the values in single
+   precision and accumulate in PetscScalar precision.
+
+   Options Database Keys:
++  -mat_type mpiaijfloat - sets the matrix type to MATMPIAIJFLOAT during a call to MatSetFromOptions()
+-  -mat_seqaijfloat_short_indices <true> - read the column indices of the local portions as 1, 2 or 4 byte offsets when they fit
+
+   Notes:
+   Only available for real scalars.
+
+  Level: intermediate
+
+.seealso: MatCreateMPIAIJFloat(), MATSEQAIJFLOAT, MATAIJFLOAT
+M*/
+
+/*MC
+   MATAIJFLOAT - MATAIJFLOAT = "aijfloat" - A matrix type to be used for sparse matrices whose values only need
+   single precision, such as the matrices from which preconditioners are built.
+
+   This matrix type is identical to MATSEQAIJFLOAT when constructed with a single process communicator,
+   and MATMPIAIJFLOAT otherwise.  As a result, for single process communicators,
+   MatSeqAIJSetPreallocation() is supported, and similarly MatMPIAIJSetPreallocation() is supported
+   for communicators controlling multiple processes.  It is recommended that you call both of
+   the above preallocation routines for simplicity.
+
+   Options Database Keys:
+. -mat_type aijfloat - sets the matrix type to "aijfloat" during a call to MatSetFromOptions()
+
+  Level: intermediate
+
+.seealso: MatCreateMPIAIJFloat(), MATSEQAIJFLOAT, MATMPIAIJFLOAT
+M*/
@@ -61,6 +61,7 @@ typedef struct {
   VecScatter Mvctx,Mvctx_mpi1;     /* scatter context for vector */
   PetscBool  Mvctx_mpi1_flg;       /* if true, additional Mvctx_mpi1 is requested for mat-mat ops, default false */
   PetscBool  roworiented;          /* if true, row-oriented input, default true */
+  PetscBool  autotune;             /* -mat_seqaij_autotune with the prefix of this matrix, given to both blocks */
 
   /* The following variables are for MatGetRow() */
   PetscInt    *rowindices;         /* column indices for row */
@@ -542,11 +542,9 @@ PetscErrorCode MatView_SeqAIJ_Binary(Mat A,PetscViewer viewer)
   Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
   PetscErrorCode ierr;
   PetscInt       i,*col_lens;
-  int            fd;
   FILE           *file;
 
   PetscFunctionBegin;
-  ierr = PetscViewerBinaryGetDescriptor(viewer,&fd);CHKERRQ(ierr);
   ierr = PetscMalloc1(4+A->rmap->n,&col_lens);CHKERRQ(ierr);
 
   col_lens[0] = MAT_FILE_CLASSID;
@@ -558,14 +556,15 @@ PetscErrorCode MatView_SeqAIJ_Binary(Mat A,PetscViewer viewer)
   for (i=0; i<A->rmap->n; i++) {
     col_lens[4+i] = a->i[i+1] - a->i[i];
   }
-  ierr = PetscBinaryWrite(fd,col_lens,4+A->rmap->n,PETSC_INT,PETSC_TRUE);CHKERRQ(ierr);
+  /* the viewer writes with MPI-IO if it uses it, with the file descriptor otherwise */
+  ierr = PetscViewerBinaryWrite(viewer,col_lens,4+A->rmap->n,PETSC_INT,PETSC_TRUE);CHKERRQ(ierr);
   ierr = PetscFree(col_lens);CHKERRQ(ierr);
 
   /* store column indices (zero start index) */
-  ierr = PetscBinaryWrite(fd,a->j,a->nz,PETSC_INT,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryWrite(viewer,a->j,a->nz,PETSC_INT,PETSC_FALSE);CHKERRQ(ierr);
 
   /* store nonzero values */
-  ierr = PetscBinaryWrite(fd,a->a,a->nz,PETSC_SCALAR,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryWrite(viewer,a->a,a->nz,PETSC_SCALAR,PETSC_FALSE);CHKERRQ(ierr);
 
   ierr = PetscViewerBinaryGetInfoPointer(viewer,&file);CHKERRQ(ierr);
   if (file) {
@@ -975,6 +974,7 @@ PetscErrorCode MatView_SeqAIJ(Mat A,PetscViewer viewer)
     ierr = MatView_SeqAIJ_Draw(A,viewer);CHKERRQ(ierr);
   }
   ierr = MatView_SeqAIJ_Inode(A,viewer);CHKERRQ(ierr);
+  ierr = MatView_SeqAIJ_Autotune(A,viewer);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1039,6 +1039,7 @@ PetscErrorCode MatAssemblyEnd_SeqAIJ(Mat A,MatAssemblyType mode)
   }
   ierr = MatAssemblyEnd_SeqAIJ_Inode(A,mode);CHKERRQ(ierr);
   ierr = MatSeqAIJInvalidateDiagonal(A);CHKERRQ(ierr);
+  ierr = MatSeqAIJThreadsSetUp_Private(A);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1088,6 +1089,11 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
 #if defined(PETSC_USE_LOG)
   PetscLogObjectState((PetscObject)A,"Rows=%D, Cols=%D, NZ=%D",A->rmap->n,A->cmap->n,a->nz);
 #endif
+  if (a->i) {
+    ierr = PetscMallocNUMAViewFromOptions(a->a,a->i[A->rmap->n]*sizeof(PetscScalar),"MatSeqAIJ values");CHKERRQ(ierr);
+    ierr = PetscMallocNUMAViewFromOptions(a->j,a->i[A->rmap->n]*sizeof(PetscInt),"MatSeqAIJ column indices");CHKERRQ(ierr);
+    ierr = PetscMallocNUMAViewFromOptions(a->i,(A->rmap->n+1)*sizeof(PetscInt),"MatSeqAIJ row offsets");CHKERRQ(ierr);
+  }
   ierr = MatSeqXAIJFreeAIJ(A,&a->a,&a->j,&a->i);CHKERRQ(ierr);
   ierr = ISDestroy(&a->row);CHKERRQ(ierr);
   ierr = ISDestroy(&a->col);CHKERRQ(ierr);
@@ -1104,6 +1110,7 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   ierr = PetscFree(a->matmult_abdense);CHKERRQ(ierr);
 
   ierr = MatDestroy_SeqAIJ_Inode(A);CHKERRQ(ierr);
+  ierr = MatSeqAIJThreadsDestroy_Private(A);CHKERRQ(ierr);
   ierr = PetscFree(A->data);CHKERRQ(ierr);
 
   ierr = PetscObjectChangeTypeName((PetscObject)A,0);CHKERRQ(ierr);
@@ -1113,6 +1120,12 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatConvert_seqaij_seqsbaij_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatConvert_seqaij_seqbaij_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatConvert_seqaij_seqaijperm_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatConvert_seqaij_seqaijmergepath_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatConvert_seqaij_seqaijoffset_C",NULL);CHKERRQ(ierr);
+#if !defined(PETSC_USE_COMPLEX)
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatConvert_seqaij_seqaijfloat_C",NULL);CHKERRQ(ierr);
+#endif
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatSeqAIJAutotune_C",NULL);CHKERRQ(ierr);
 #if defined(PETSC_HAVE_ELEMENTAL)
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatConvert_seqaij_elemental_C",NULL);CHKERRQ(ierr);
 #endif
@@ -1237,8 +1250,14 @@ PetscErrorCode MatMultTransposeAdd_SeqAIJ(Mat A,Vec xx,Vec zz,Vec yy)
   Mat_CompressedRow cprow    = a->compressedrow;
   PetscBool         usecprow = cprow.use;
 #endif
+  PetscBool         threads;
 
   PetscFunctionBegin;
+  ierr = MatSeqAIJUseThreads_Private(A,&threads);CHKERRQ(ierr);
+  if (threads) {
+    ierr = MatMultTransposeAdd_SeqAIJThreads(A,xx,zz,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   if (zz != yy) {ierr = VecCopy(zz,yy);CHKERRQ(ierr);}
   ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
@@ -1294,13 +1313,18 @@ PetscErrorCode MatMult_SeqAIJ(Mat A,Vec xx,Vec yy)
   const PetscInt    *aj,*ii,*ridx=NULL;
   PetscInt          n,i;
   PetscScalar       sum;
-  PetscBool         usecprow=a->compressedrow.use;
+  PetscBool         usecprow=a->compressedrow.use,threads;
 
 #if defined(PETSC_HAVE_PRAGMA_DISJOINT)
 #pragma disjoint(*x,*y,*aa)
 #endif
 
   PetscFunctionBegin;
+  ierr = MatSeqAIJUseThreads_Private(A,&threads);CHKERRQ(ierr);
+  if (threads) {
+    ierr = MatMult_SeqAIJThreads(A,xx,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
   ii   = a->i;
@@ -1450,9 +1474,14 @@ PetscErrorCode MatMultAdd_SeqAIJ(Mat A,Vec xx,Vec yy,Vec zz)
   const PetscInt    *aj,*ii,*ridx=NULL;
   PetscInt          m = A->rmap->n,n,i;
   PetscScalar       sum;
-  PetscBool         usecprow=a->compressedrow.use;
+  PetscBool         usecprow=a->compressedrow.use,threads;
 
   PetscFunctionBegin;
+  ierr = MatSeqAIJUseThreads_Private(A,&threads);CHKERRQ(ierr);
+  if (threads) {
+    ierr = MatMultAdd_SeqAIJThreads(A,xx,yy,zz);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
   if (usecprow) { /* use compressed row format */
@@ -3707,7 +3736,10 @@ PetscErrorCode  MatSeqAIJSetPreallocation_SeqAIJ(Mat B,PetscInt nz,const PetscIn
     } else {
       ierr = PetscMalloc3(nz,&b->a,nz,&b->j,B->rmap->n+1,&b->i);CHKERRQ(ierr);
       ierr = PetscLogObjectMemory((PetscObject)B,(B->rmap->n+1)*sizeof(PetscInt)+nz*(sizeof(PetscScalar)+sizeof(PetscInt)));CHKERRQ(ierr);
+      ierr = PetscMallocNUMAPlace(b->a,nz*sizeof(PetscScalar));CHKERRQ(ierr);
     }
+    ierr = PetscMallocNUMAPlace(b->j,nz*sizeof(PetscInt));CHKERRQ(ierr);
+    ierr = PetscMallocNUMAPlace(b->i,(B->rmap->n+1)*sizeof(PetscInt));CHKERRQ(ierr);
     b->i[0] = 0;
     for (i=1; i<B->rmap->n+1; i++) {
       b->i[i] = b->i[i-1] + b->imax[i-1];
@@ -3937,11 +3969,21 @@ PETSC_INTERN PetscErrorCode MatMatMult_SeqDense_SeqAIJ(Mat A,Mat B,MatReuse scal
    based on compressed sparse row format.
 
    Options Database Keys:
-. -mat_type seqaij - sets the matrix type to "seqaij" during a call to MatSetFromOptions()
++ -mat_type seqaij - sets the matrix type to "seqaij" during a call to MatSetFromOptions()
+. -mat_seqaij_autotune - at the end of the assembly, converts the matrix to the subtype with the fastest MatMult()
+. -mat_seqaij_autotune_types <seqaij,seqaijperm,...> - the subtypes tried, by default seqaij, seqaijperm, seqaijsell, seqaijmergepath, seqaijoffset and seqaijmkl; seqaijcrl may also be given
+- -mat_seqaij_autotune_its <10> - the number of products timed for each subtype
+
+   Notes:
+   With -mat_seqaij_autotune a few products are timed with each subtype after every final assembly that changed the
+   nonzero structure, and the matrix is left in the fastest one; the choice is shown by MatView() with
+   PETSC_VIEWER_ASCII_INFO and the time of the trials by the MatAutotune event of -log_view. Only MATSEQAIJ matrices
+   are tuned, other subtypes are left as they are. The blocks of MATMPIAIJ matrices are tuned separately on each
+   process, when the option is given with the prefix of the MATMPIAIJ matrix.
 
   Level: beginner
 
-.seealso: MatCreateSeqAIJ(), MatSetFromOptions(), MatSetType(), MatCreate(), MatType
+.seealso: MatCreateSeqAIJ(), MatSetFromOptions(), MatSetType(), MatCreate(), MatType, MatSeqAIJSetType()
 M*/
 
 /*MC
@@ -4127,6 +4169,11 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqbaij_C",MatConvert_SeqAIJ_SeqBAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqaijperm_C",MatConvert_SeqAIJ_SeqAIJPERM);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqaijsell_C",MatConvert_SeqAIJ_SeqAIJSELL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqaijmergepath_C",MatConvert_SeqAIJ_SeqAIJMergePath);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqaijoffset_C",MatConvert_SeqAIJ_SeqAIJOffset);CHKERRQ(ierr);
+#if !defined(PETSC_USE_COMPLEX)
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqaijfloat_C",MatConvert_SeqAIJ_SeqAIJFloat);CHKERRQ(ierr);
+#endif
 #if defined(PETSC_HAVE_MKL_SPARSE)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaij_seqaijmkl_C",MatConvert_SeqAIJ_SeqAIJMKL);CHKERRQ(ierr);
 #endif
@@ -4155,6 +4202,7 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultNumeric_seqdense_seqaij_C",MatMatMultNumeric_SeqDense_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatPtAP_is_seqaij_C",MatPtAP_IS_XAIJ);CHKERRQ(ierr);
   ierr = MatCreate_SeqAIJ_Inode(B);CHKERRQ(ierr);
+  ierr = MatCreate_SeqAIJ_Autotune(B);CHKERRQ(ierr);
   ierr = PetscObjectChangeTypeName((PetscObject)B,MATSEQAIJ);CHKERRQ(ierr);
   ierr = MatSeqAIJSetTypeFromOptions(B);CHKERRQ(ierr);  /* this allows changing the matrix subtype to say MATSEQAIJPERM */
   PetscFunctionReturn(0);
@@ -4194,6 +4242,9 @@ PetscErrorCode MatDuplicateNoCreate_SeqAIJ(Mat C,Mat A,MatDuplicateOption cpvalu
   if (mallocmatspace) {
     ierr = PetscMalloc3(a->i[m],&c->a,a->i[m],&c->j,m+1,&c->i);CHKERRQ(ierr);
     ierr = PetscLogObjectMemory((PetscObject)C, a->i[m]*(sizeof(PetscScalar)+sizeof(PetscInt))+(m+1)*sizeof(PetscInt));CHKERRQ(ierr);
+    ierr = PetscMallocNUMAPlace(c->a,a->i[m]*sizeof(PetscScalar));CHKERRQ(ierr);
+    ierr = PetscMallocNUMAPlace(c->j,a->i[m]*sizeof(PetscInt));CHKERRQ(ierr);
+    ierr = PetscMallocNUMAPlace(c->i,(m+1)*sizeof(PetscInt));CHKERRQ(ierr);
 
     c->singlemalloc = PETSC_TRUE;
 
@@ -4246,6 +4297,7 @@ PetscErrorCode MatDuplicateNoCreate_SeqAIJ(Mat C,Mat A,MatDuplicateOption cpvalu
   }
   c->nonzerorowcnt = a->nonzerorowcnt;
   C->nonzerostate  = A->nonzerostate;
+  c->autotune      = a->autotune;
 
   ierr = MatDuplicate_SeqAIJ_Inode(A,cpvalues,&C);CHKERRQ(ierr);
   ierr = PetscFunctionListDuplicate(((PetscObject)A)->qlist,&((PetscObject)C)->qlist);CHKERRQ(ierr);
@@ -4272,10 +4324,12 @@ PetscErrorCode MatLoad_SeqAIJ(Mat newMat, PetscViewer viewer)
   Mat_SeqAIJ     *a;
   PetscErrorCode ierr;
   PetscInt       i,sum,nz,header[4],*rowlengths = 0,M,N,rows,cols;
-  int            fd;
   PetscMPIInt    size;
   MPI_Comm       comm;
   PetscInt       bs = newMat->rmap->bs;
+  PetscInt       *mi,*mj;
+  PetscScalar    *ma;
+  PetscContainer mapping,ic;
 
   PetscFunctionBegin;
   /* force binary viewer to load .info file if it has not yet done so */
@@ -4290,8 +4344,8 @@ PetscErrorCode MatLoad_SeqAIJ(Mat newMat, PetscViewer viewer)
   if (bs < 0) bs = 1;
   ierr = MatSetBlockSize(newMat,bs);CHKERRQ(ierr);
 
-  ierr = PetscViewerBinaryGetDescriptor(viewer,&fd);CHKERRQ(ierr);
-  ierr = PetscBinaryRead(fd,header,4,PETSC_INT);CHKERRQ(ierr);
+  /* the viewer reads with MPI-IO if it uses it, with the file descriptor otherwise */
+  ierr = PetscViewerBinaryRead(viewer,header,4,NULL,PETSC_INT);CHKERRQ(ierr);
   if (header[0] != MAT_FILE_CLASSID) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"not matrix object in file");
   M = header[1]; N = header[2]; nz = header[3];
 
@@ -4299,7 +4353,7 @@ PetscErrorCode MatLoad_SeqAIJ(Mat newMat, PetscViewer viewer)
 
   /* read in row lengths */
   ierr = PetscMalloc1(M,&rowlengths);CHKERRQ(ierr);
-  ierr = PetscBinaryRead(fd,rowlengths,M,PETSC_INT);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryRead(viewer,rowlengths,M,NULL,PETSC_INT);CHKERRQ(ierr);
 
   /* check if sum of rowlengths is same as nz */
   for (i=0,sum=0; i< M; i++) sum +=rowlengths[i];
@@ -4316,13 +4370,44 @@ PetscErrorCode MatLoad_SeqAIJ(Mat newMat, PetscViewer viewer)
     }
     if (M != rows ||  N != cols) SETERRQ4(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED, "Matrix in file of different length (%D, %D) than the input matrix (%D, %D)",M,N,rows,cols);
   }
-  ierr = MatSeqAIJSetPreallocation_SeqAIJ(newMat,0,rowlengths);CHKERRQ(ierr);
-  a    = (Mat_SeqAIJ*)newMat->data;
+  ierr = PetscViewerBinaryReadMapped(viewer,nz,PETSC_INT,(void**)&mj,&mapping);CHKERRQ(ierr);
+  if (mj) {
+    /* keep the column indices, and the values when they are aligned, in the memory mapped file */
+    ierr = MatSeqAIJSetPreallocation_SeqAIJ(newMat,MAT_SKIP_ALLOCATION,NULL);CHKERRQ(ierr);
+    a    = (Mat_SeqAIJ*)newMat->data;
+    ierr = PetscObjectCompose((PetscObject)newMat,"MatLoad_SeqAIJ_mapping",(PetscObject)mapping);CHKERRQ(ierr);
+    ierr = PetscViewerBinaryReadMapped(viewer,nz,PETSC_SCALAR,(void**)&ma,&mapping);CHKERRQ(ierr);
+    a->free_a = PETSC_FALSE;
+    if (!ma) {
+      ierr = PetscMalloc1(nz,&ma);CHKERRQ(ierr);
+      ierr = PetscViewerBinaryRead(viewer,ma,nz,NULL,PETSC_SCALAR);CHKERRQ(ierr);
+      a->free_a = PETSC_TRUE;
+    }
+    ierr = PetscMalloc2(M,&a->imax,M,&a->ilen);CHKERRQ(ierr);
+    ierr = PetscMalloc1(M+1,&mi);CHKERRQ(ierr);
+    ierr = PetscContainerCreate(PETSC_COMM_SELF,&ic);CHKERRQ(ierr);
+    ierr = PetscContainerSetPointer(ic,mi);CHKERRQ(ierr);
+    ierr = PetscContainerSetUserDestroy(ic,PetscContainerUserDestroyDefault);CHKERRQ(ierr);
+    ierr = PetscObjectCompose((PetscObject)newMat,"MatLoad_SeqAIJ_i",(PetscObject)ic);CHKERRQ(ierr);
+    ierr = PetscContainerDestroy(&ic);CHKERRQ(ierr);
+    ierr = PetscMemcpy(a->imax,rowlengths,M*sizeof(PetscInt));CHKERRQ(ierr);
+
+    a->i            = mi;
+    a->j            = mj;
+    a->a            = ma;
+    a->singlemalloc = PETSC_FALSE;
+    a->free_ij      = PETSC_FALSE;
+    a->maxnz        = nz;
+    ierr = MatSetOption(newMat,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_TRUE);CHKERRQ(ierr);
+  } else {
+    ierr = MatSeqAIJSetPreallocation_SeqAIJ(newMat,0,rowlengths);CHKERRQ(ierr);
+    a    = (Mat_SeqAIJ*)newMat->data;
 
-  ierr = PetscBinaryRead(fd,a->j,nz,PETSC_INT);CHKERRQ(ierr);
+    ierr = PetscViewerBinaryRead(viewer,a->j,nz,NULL,PETSC_INT);CHKERRQ(ierr);
 
-  /* read in nonzero values */
-  ierr = PetscBinaryRead(fd,a->a,nz,PETSC_SCALAR);CHKERRQ(ierr);
+    /* read in nonzero values */
+    ierr = PetscViewerBinaryRead(viewer,a->a,nz,NULL,PETSC_SCALAR);CHKERRQ(ierr);
+  }
 
   /* set matrix "i" values */
   a->i[0] = 0;
@@ -4743,6 +4828,11 @@ PetscErrorCode  MatSeqAIJRegisterAll(void)
   ierr = MatSeqAIJRegister(MATSEQAIJCRL,      MatConvert_SeqAIJ_SeqAIJCRL);CHKERRQ(ierr);
   ierr = MatSeqAIJRegister(MATSEQAIJPERM,     MatConvert_SeqAIJ_SeqAIJPERM);CHKERRQ(ierr);
   ierr = MatSeqAIJRegister(MATSEQAIJSELL,     MatConvert_SeqAIJ_SeqAIJSELL);CHKERRQ(ierr);
+  ierr = MatSeqAIJRegister(MATSEQAIJMERGEPATH,MatConvert_SeqAIJ_SeqAIJMergePath);CHKERRQ(ierr);
+  ierr = MatSeqAIJRegister(MATSEQAIJOFFSET,   MatConvert_SeqAIJ_SeqAIJOffset);CHKERRQ(ierr);
+#if !defined(PETSC_USE_COMPLEX)
+  ierr = MatSeqAIJRegister(MATSEQAIJFLOAT,    MatConvert_SeqAIJ_SeqAIJFloat);CHKERRQ(ierr);
+#endif
 #if defined(PETSC_HAVE_MKL_SPARSE)
   ierr = MatSeqAIJRegister(MATSEQAIJMKL,      MatConvert_SeqAIJ_SeqAIJMKL);CHKERRQ(ierr);
 #endif
@@ -97,19 +97,50 @@ typedef struct {
   PetscObjectState mat_nonzerostate;               /* non-zero state when inodes were checked for */
 } Mat_SeqAIJ_Inode;
 
+/* Partition of the rows among the threads of the pool for the multi-threaded products, see aijthreads.c */
+typedef struct {
+  PetscInt         nthreads;       /* number of threads of the partition, 0 if it has not been computed */
+  PetscObjectState nonzerostate;   /* nonzero state of the matrix when it was computed */
+  PetscBool        inode;          /* if the inodes were partitioned */
+  PetscBool        compressedrow;  /* if the compressed rows were partitioned */
+  PetscInt         *row;           /* thread t has the rows, or the compressed rows, row[t] to row[t+1]-1 */
+  PetscInt         *yrow;          /* the entries yrow[t] to yrow[t+1]-1 of the result of MatMult() belong to thread t */
+  PetscInt         *node;          /* with inodes, thread t has the inodes node[t] to node[t+1]-1 ... */
+  PetscInt         *noderow;       /* ... that start at row noderow[t] */
+  PetscInt         *col;           /* the rows of thread t only have columns col[2t] to col[2t+1]-1 */
+  PetscInt         *workoff;       /* thread t > 0 sums its part of MatMultTranspose() in work[workoff[t]-col[2t]+c] */
+  PetscScalar      *work;
+  PetscErrorCode   *ierr;          /* the error of each thread in the last product */
+} Mat_SeqAIJThreads;
+
+/* Subtype with the fastest MatMult() chosen by timed trials at the end of the assembly, see aijautotune.c */
+typedef struct {
+  PetscBool        use;            /* set with -mat_seqaij_autotune */
+  PetscObjectState nonzerostate;   /* nonzero state of the matrix when the subtype was chosen */
+  MatType          type;           /* the chosen subtype, NULL if the trials have not been run */
+  PetscLogDouble   time;           /* its time for one MatMult() in the trials */
+} Mat_SeqAIJAutotune;
+
 PETSC_INTERN PetscErrorCode MatView_SeqAIJ_Inode(Mat,PetscViewer);
 PETSC_INTERN PetscErrorCode MatAssemblyEnd_SeqAIJ_Inode(Mat,MatAssemblyType);
 PETSC_INTERN PetscErrorCode MatDestroy_SeqAIJ_Inode(Mat);
 PETSC_INTERN PetscErrorCode MatCreate_SeqAIJ_Inode(Mat);
 PETSC_INTERN PetscErrorCode MatSetOption_SeqAIJ_Inode(Mat,MatOption,PetscBool);
+PETSC_INTERN PetscErrorCode MatView_SeqAIJ_Autotune(Mat,PetscViewer);
+PETSC_INTERN PetscErrorCode MatCreate_SeqAIJ_Autotune(Mat);
+PETSC_INTERN PetscErrorCode MatSeqAIJSetAutotune_Private(Mat,PetscBool);
 PETSC_INTERN PetscErrorCode MatDuplicate_SeqAIJ_Inode(Mat,MatDuplicateOption,Mat*);
 PETSC_INTERN PetscErrorCode MatDuplicateNoCreate_SeqAIJ(Mat,Mat,MatDuplicateOption,PetscBool);
 PETSC_INTERN PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode_inplace(Mat,Mat,const MatFactorInfo*);
 PETSC_INTERN PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat,Mat,const MatFactorInfo*);
+PETSC_INTERN PetscErrorCode MatMultInodes_SeqAIJ_Private(Mat,PetscInt,PetscInt,PetscInt,const PetscScalar[],PetscScalar[]);
+PETSC_INTERN PetscErrorCode MatMultAddInodes_SeqAIJ_Private(Mat,PetscInt,PetscInt,PetscInt,const PetscScalar[],const PetscScalar[],PetscScalar[]);
 
 typedef struct {
   SEQAIJHEADER(MatScalar);
   Mat_SeqAIJ_Inode inode;
+  Mat_SeqAIJThreads threads;
+  Mat_SeqAIJAutotune autotune;
   MatScalar        *saved_values;             /* location for stashing nonzero values of matrix */
 
   PetscScalar *idiag,*mdiag,*ssor_work;       /* inverse of diagonal entries, diagonal values and workspace for Eisenstat trick */
@@ -225,6 +256,8 @@ PETSC_INTERN PetscErrorCode MatCholeskyFactorNumeric_SeqAIJ_inplace(Mat,Mat,cons
 PETSC_INTERN PetscErrorCode MatCholeskyFactorNumeric_SeqAIJ(Mat,Mat,const MatFactorInfo*);
 PETSC_INTERN PetscErrorCode MatDuplicate_SeqAIJ(Mat,MatDuplicateOption,Mat*);
 PETSC_INTERN PetscErrorCode MatCopy_SeqAIJ(Mat,Mat,MatStructure);
+PETSC_INTERN PetscErrorCode MatRetrieveValues_SeqAIJ(Mat);
+PETSC_INTERN PetscErrorCode MatSeqAIJRestoreArray_SeqAIJ(Mat,PetscScalar*[]);
 PETSC_INTERN PetscErrorCode MatMissingDiagonal_SeqAIJ(Mat,PetscBool*,PetscInt*);
 PETSC_INTERN PetscErrorCode MatMarkDiagonal_SeqAIJ(Mat);
 PETSC_INTERN PetscErrorCode MatFindZeroDiagonals_SeqAIJ_Private(Mat,PetscInt*,PetscInt**);
@@ -234,6 +267,14 @@ PETSC_INTERN PetscErrorCode MatMultAdd_SeqAIJ(Mat A,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatMultTranspose_SeqAIJ(Mat A,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatMultTransposeAdd_SeqAIJ(Mat A,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSOR_SeqAIJ(Mat,Vec,PetscReal,MatSORType,PetscReal,PetscInt,PetscInt,Vec);
+PETSC_INTERN PetscErrorCode MatInvertDiagonal_SeqAIJ(Mat,PetscScalar,PetscScalar);
+
+PETSC_INTERN PetscErrorCode MatSeqAIJThreadsSetUp_Private(Mat);
+PETSC_INTERN PetscErrorCode MatSeqAIJThreadsDestroy_Private(Mat);
+PETSC_INTERN PetscErrorCode MatSeqAIJUseThreads_Private(Mat,PetscBool*);
+PETSC_INTERN PetscErrorCode MatMult_SeqAIJThreads(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatMultAdd_SeqAIJThreads(Mat,Vec,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatMultTransposeAdd_SeqAIJThreads(Mat,Vec,Vec,Vec);
 
 PETSC_INTERN PetscErrorCode MatSetOption_SeqAIJ(Mat,MatOption,PetscBool);
 
@@ -352,6 +393,9 @@ PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_Elemental(Mat,MatType,MatReuse,Mat
 PETSC_INTERN PetscErrorCode MatConvert_AIJ_HYPRE(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJPERM(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJSELL(Mat,MatType,MatReuse,Mat*);
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJMergePath(Mat,MatType,MatReuse,Mat*);
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJOffset(Mat,MatType,MatReuse,Mat*);
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJFloat(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJMKL(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJViennaCL(Mat,MatType,MatReuse,Mat*);
 PETSC_INTERN PetscErrorCode MatReorderForNonzeroDiagonal_SeqAIJ(Mat,PetscReal,IS,IS);
@@ -0,0 +1,165 @@
+/*
+   Choice of the MATSEQAIJ subtype with the fastest MatMult() for the matrix at hand, enabled with -mat_seqaij_autotune.
+
+   At the end of each final assembly that changed the nonzero structure the matrix is converted in place to each of
+  the candidate subtypes, which all keep the SeqAIJ storage and only add their own data for the products, a few
+  products are timed and the matrix is left in the fastest subtype. The choice is kept until the nonzero structure
+  changes, so assemblies that only change the values do not repeat the trials.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <petsctime.h>
+
+/* the subtypes that may be tried; MATSEQAIJCRL, which cannot be duplicated, only when asked for */
+static MatType MatSeqAIJAutotuneTypes[] = {MATSEQAIJ,MATSEQAIJPERM,MATSEQAIJSELL,MATSEQAIJMERGEPATH,MATSEQAIJOFFSET,
+#if defined(PETSC_HAVE_MKL_SPARSE)
+                                           MATSEQAIJMKL,
+#endif
+                                           MATSEQAIJCRL};
+static PetscInt MatSeqAIJAutotuneNDefault = sizeof(MatSeqAIJAutotuneTypes)/sizeof(MatType) - 1;
+
+/* converts A in place to the subtype, from any of the candidate subtypes */
+static PetscErrorCode MatSeqAIJAutotuneSetType_Private(Mat A,MatType type)
+{
+  PetscErrorCode ierr,(*conv)(Mat,MatType,MatReuse,Mat*);
+  PetscBool      flg;
+  char           convname[256];
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)A,type,&flg);CHKERRQ(ierr);
+  if (flg) PetscFunctionReturn(0);
+  ierr = PetscObjectTypeCompare((PetscObject)A,MATSEQAIJ,&flg);CHKERRQ(ierr);
+  if (!flg) {
+    /* not MatConvert(), which falls back to creating a new matrix */
+    ierr = PetscSNPrintf(convname,sizeof(convname),"MatConvert_%s_seqaij_C",((PetscObject)A)->type_name);CHKERRQ(ierr);
+    ierr = PetscObjectQueryFunction((PetscObject)A,convname,&conv);CHKERRQ(ierr);
+    if (!conv) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP,"Cannot convert a %s matrix in place to MATSEQAIJ",((PetscObject)A)->type_name);
+    ierr = (*conv)(A,MATSEQAIJ,MAT_INPLACE_MATRIX,&A);CHKERRQ(ierr);
+  }
+  ierr = MatSeqAIJSetType(A,type);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSeqAIJAutotune_SeqAIJ(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+  Vec            x,y;
+  MatType        types[sizeof(MatSeqAIJAutotuneTypes)/sizeof(MatType)],best = NULL;
+  char           *names[sizeof(MatSeqAIJAutotuneTypes)/sizeof(MatType)];
+  PetscInt       ntypes = sizeof(MatSeqAIJAutotuneTypes)/sizeof(MatType),nnames = ntypes,its = 10,i,k;
+  PetscLogDouble t0,t1,time,besttime = 0.0;
+  PetscBool      flg;
+
+  PetscFunctionBegin;
+  if (!a->autotune.use || A->factortype || !a->nz) PetscFunctionReturn(0);
+  if (a->autotune.type && a->autotune.nonzerostate == A->nonzerostate) PetscFunctionReturn(0);
+  /* only a MATSEQAIJ matrix, or one left in a subtype by earlier trials, the other subtypes are kept */
+  ierr = PetscObjectTypeCompare((PetscObject)A,a->autotune.type ? a->autotune.type : MATSEQAIJ,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscObjectTypeCompare((PetscObject)A,MATSEQAIJ,&flg);CHKERRQ(ierr);}
+  if (!flg) {
+    ierr = PetscInfo1(A,"Not autotuning a %s matrix\n",((PetscObject)A)->type_name);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+
+  ierr = PetscOptionsGetInt(((PetscObject)A)->options,((PetscObject)A)->prefix,"-mat_seqaij_autotune_its",&its,NULL);CHKERRQ(ierr);
+  its  = PetscMax(its,1);
+  ierr = PetscOptionsGetStringArray(((PetscObject)A)->options,((PetscObject)A)->prefix,"-mat_seqaij_autotune_types",names,&nnames,&flg);CHKERRQ(ierr);
+  if (flg) {
+    for (i=0; i<nnames; i++) {
+      for (k=0; k<ntypes; k++) {
+        ierr = PetscStrcmp(names[i],MatSeqAIJAutotuneTypes[k],&flg);CHKERRQ(ierr);
+        if (flg) break;
+      }
+      if (k == ntypes) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_UNKNOWN_TYPE,"Cannot autotune with the Mat type %s",names[i]);
+      types[i] = MatSeqAIJAutotuneTypes[k];
+      ierr     = PetscFree(names[i]);CHKERRQ(ierr);
+    }
+    ntypes = nnames;
+  } else {
+    ntypes = MatSeqAIJAutotuneNDefault;
+    for (i=0; i<ntypes; i++) types[i] = MatSeqAIJAutotuneTypes[i];
+  }
+
+  ierr = PetscLogEventBegin(MAT_Autotune,A,0,0,0);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&x,&y);CHKERRQ(ierr);
+  ierr = VecSet(x,1.0);CHKERRQ(ierr);
+  for (i=0; i<ntypes; i++) {
+    ierr = MatSeqAIJAutotuneSetType_Private(A,types[i]);CHKERRQ(ierr);
+    /* the first product is not timed, it may set up the data of the subtype and bring the matrix into the cache */
+    ierr = (*A->ops->mult)(A,x,y);CHKERRQ(ierr);
+    ierr = PetscTime(&t0);CHKERRQ(ierr);
+    for (k=0; k<its; k++) {
+      ierr = (*A->ops->mult)(A,x,y);CHKERRQ(ierr);
+    }
+    ierr = PetscTime(&t1);CHKERRQ(ierr);
+    time = (t1 - t0)/its;
+    ierr = PetscInfo2(A,"MatMult() with %s: %g seconds\n",types[i],time);CHKERRQ(ierr);
+    if (!best || time < besttime) {
+      best     = types[i];
+      besttime = time;
+    }
+  }
+  ierr = MatSeqAIJAutotuneSetType_Private(A,best);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(MAT_Autotune,A,0,0,0);CHKERRQ(ierr);
+
+  a->autotune.type         = best;
+  a->autotune.time         = besttime;
+  a->autotune.nonzerostate = A->nonzerostate;
+  ierr = PetscInfo1(A,"Chose %s for MatMult()\n",best);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatView_SeqAIJ_Autotune(Mat A,PetscViewer viewer)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode    ierr;
+  PetscBool         iascii;
+  PetscViewerFormat format;
+
+  PetscFunctionBegin;
+  if (!a->autotune.type) PetscFunctionReturn(0);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
+    if (format == PETSC_VIEWER_ASCII_INFO_DETAIL || format == PETSC_VIEWER_ASCII_INFO) {
+      ierr = PetscViewerASCIIPrintf(viewer,"autotuned MatMult(): using %s, %g seconds per product in the trials\n",a->autotune.type,a->autotune.time);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/* turns the trials on or off, for the blocks of MATMPIAIJ matrices which have no prefix of their own */
+PetscErrorCode MatSeqAIJSetAutotune_Private(Mat A,PetscBool use)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (a->autotune.use == use) PetscFunctionReturn(0);
+  a->autotune.use = use;
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatSeqAIJAutotune_C",use ? MatSeqAIJAutotune_SeqAIJ : NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* called from MatCreate_SeqAIJ(); MatAssemblyEnd() runs the trials through the composed function */
+PetscErrorCode MatCreate_SeqAIJ_Autotune(Mat B)
+{
+  Mat_SeqAIJ     *b = (Mat_SeqAIJ*)B->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  b->autotune.use          = PETSC_FALSE;
+  b->autotune.nonzerostate = 0;
+  b->autotune.type         = NULL;
+  b->autotune.time         = 0.0;
+
+  ierr = PetscOptionsBegin(PetscObjectComm((PetscObject)B),((PetscObject)B)->prefix,"Options for SEQAIJ matrix","Mat");CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-mat_seqaij_autotune","Choose the subtype with the fastest MatMult() at the end of the assembly","None",b->autotune.use,&b->autotune.use,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  if (b->autotune.use) {
+    ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqAIJAutotune_C",MatSeqAIJAutotune_SeqAIJ);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
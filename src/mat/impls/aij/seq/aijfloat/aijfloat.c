@@ -0,0 +1,333 @@
+/*
+  Defines the MATSEQAIJFLOAT matrix class, a MATSEQAIJ whose MatMult(), MatMultAdd() and MatSOR() read the values in
+  single precision and accumulate in PetscScalar precision.
+
+  These operations are limited by the memory bandwidth and the values are most of the data they read, so reading them
+  as float nearly halves the traffic. The column indices are also read as the offsets of MATSEQAIJOFFSET, in 1, 2 or 4
+  bytes from the first column of the row, which cuts most of the rest of it.
+
+  The single precision values are copied from the MATSEQAIJ storage, whose values are rounded to them at the same time
+  so that every operation uses the same matrix; they are kept for the operations that are not redefined here, such as
+  the factorizations. The copy is made at the end of each assembly, by MatSeqAIJRestoreArray() and MatRetrieveValues(),
+  and, for the other operations that change the values such as MatScale(), the first time one of the operations is
+  used after the change.
+*/
+
+#include <../src/mat/impls/aij/seq/aijoffset/aijoffset.h>
+
+typedef struct {
+  PetscObjectState state;         /* state of the matrix when the values were copied */
+  PetscObjectState nonzerostate;  /* nonzero state of the matrix when the values were allocated */
+  PetscBool        shortindices;  /* use the column offsets, set with -mat_seqaijfloat_short_indices */
+  float            *a;            /* the values */
+  Mat_SeqAIJOffset o;             /* the column offsets, of width 0 without them */
+} Mat_SeqAIJFloat;
+
+/* copies the values of the MATSEQAIJ storage to single precision if they changed, and rounds them */
+static PetscErrorCode MatSeqAIJFloatSetUp_Private(Mat A)
+{
+  Mat_SeqAIJ      *a  = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJFloat *af = (Mat_SeqAIJFloat*)A->spptr;
+  PetscInt        k,nz = a->i[A->rmap->n];
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  if (af->state == ((PetscObject)A)->state) PetscFunctionReturn(0);
+  if (af->nonzerostate != A->nonzerostate) {
+    ierr = PetscFree(af->a);CHKERRQ(ierr);
+    ierr = PetscMalloc1(nz,&af->a);CHKERRQ(ierr);
+    if (af->shortindices) {ierr = MatSeqAIJOffsetSetUp_Private(A,&af->o);CHKERRQ(ierr);}
+    ierr = PetscInfo1(A,"Values in single precision, %s column indices\n",af->o.width ? "offset" : "full");CHKERRQ(ierr);
+    af->nonzerostate = A->nonzerostate;
+  }
+  for (k=0; k<nz; k++) {
+    af->a[k] = (float)PetscRealPart(a->a[k]);
+    a->a[k]  = af->a[k];
+  }
+  a->idiagvalid  = PETSC_FALSE;
+  a->ibdiagvalid = PETSC_FALSE;
+  af->state      = ((PetscObject)A)->state;
+  PetscFunctionReturn(0);
+}
+
+/* the product of the entries k0 to k1-1, which are in row i, with x */
+PETSC_STATIC_INLINE PetscScalar MatSeqAIJFloatDot_Private(Mat A,PetscInt i,PetscInt k0,PetscInt k1,const PetscScalar *x)
+{
+  Mat_SeqAIJ      *a  = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJFloat *af = (Mat_SeqAIJFloat*)A->spptr;
+  PetscScalar     sum;
+
+  MatSeqAIJOffsetDot(sum,&af->o,a->j,af->a,i,k0,k1,x);
+  return sum;
+}
+
+PetscErrorCode MatMult_SeqAIJFloat(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJFloat   *af;
+  const PetscScalar *x;
+  PetscScalar       *y;
+  const PetscInt    *ai = a->i,*aj = a->j;
+  PetscInt          i,m = A->rmap->n;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJFloatSetUp_Private(A);CHKERRQ(ierr);
+  af   = (Mat_SeqAIJFloat*)A->spptr;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
+  for (i=0; i<m; i++) MatSeqAIJOffsetDot(y[i],&af->o,aj,af->a,i,ai[i],ai[i+1],x);
+  ierr = PetscLogFlops(2.0*a->nz - a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMultAdd_SeqAIJFloat(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJFloat   *af;
+  const PetscScalar *x;
+  PetscScalar       *y,*z,sum;
+  const PetscInt    *ai = a->i,*aj = a->j;
+  PetscInt          i,m = A->rmap->n;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJFloatSetUp_Private(A);CHKERRQ(ierr);
+  af   = (Mat_SeqAIJFloat*)A->spptr;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  for (i=0; i<m; i++) {
+    MatSeqAIJOffsetDot(sum,&af->o,aj,af->a,i,ai[i],ai[i+1],x);
+    z[i] = y[i] + sum;
+  }
+  ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* the sweeps of MatSOR_SeqAIJ() with the single precision values; the other variants use the MATSEQAIJ storage, whose values are the same */
+PetscErrorCode MatSOR_SeqAIJFloat(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscReal fshift,PetscInt its,PetscInt lits,Vec xx)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJFloatSetUp_Private(A);CHKERRQ(ierr);
+  ierr = MatSOR_SeqAIJ_Dot(A,bb,omega,flag,fshift,its,lits,xx,MatSeqAIJFloatDot_Private);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* the values are those of the MATSEQAIJ storage once they have been rounded */
+PetscErrorCode MatGetRow_SeqAIJFloat(Mat A,PetscInt row,PetscInt *nz,PetscInt **idx,PetscScalar **v)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (v) {ierr = MatSeqAIJFloatSetUp_Private(A);CHKERRQ(ierr);}
+  ierr = MatGetRow_SeqAIJ(A,row,nz,idx,v);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* copies and rounds the values now, so that the factorizations of MATSEQAIJ use the rounded ones as well */
+static PetscErrorCode MatSeqAIJFloatRound_Private(Mat A)
+{
+  Mat_SeqAIJFloat *af = (Mat_SeqAIJFloat*)A->spptr;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  af->state = -1;
+  ierr = MatSeqAIJFloatSetUp_Private(A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatAssemblyEnd_SeqAIJFloat(Mat A,MatAssemblyType mode)
+{
+  Mat_SeqAIJ      *a  = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJFloat *af = (Mat_SeqAIJFloat*)A->spptr;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  if (mode == MAT_FLUSH_ASSEMBLY) PetscFunctionReturn(0);
+  /* the rows are not grouped in inodes, so that the single precision products are used */
+  a->inode.use = PETSC_FALSE;
+  ierr = MatAssemblyEnd_SeqAIJ(A,mode);CHKERRQ(ierr);
+  ierr = MatSeqAIJFloatRound_Private(A);CHKERRQ(ierr);
+  /* MatAssemblyEnd() increases the state once this returns */
+  af->state++;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSeqAIJRestoreArray_SeqAIJFloat(Mat A,PetscScalar *array[])
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJRestoreArray_SeqAIJ(A,array);CHKERRQ(ierr);
+  ierr = MatSeqAIJFloatRound_Private(A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatRetrieveValues_SeqAIJFloat(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatRetrieveValues_SeqAIJ(A);CHKERRQ(ierr);
+  ierr = MatSeqAIJFloatRound_Private(A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatDestroy_SeqAIJFloat(Mat A)
+{
+  Mat_SeqAIJFloat *af = (Mat_SeqAIJFloat*)A->spptr;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  /* If MatHeaderMerge() was used, then this matrix will not have an spptr */
+  if (af) {
+    ierr = PetscFree(af->a);CHKERRQ(ierr);
+    ierr = MatSeqAIJOffsetReset_Private(&af->o);CHKERRQ(ierr);
+    ierr = PetscFree(A->spptr);CHKERRQ(ierr);
+  }
+  ierr = PetscObjectChangeTypeName((PetscObject)A,MATSEQAIJ);CHKERRQ(ierr);
+  ierr = MatDestroy_SeqAIJ(A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJFloat_SeqAIJ(Mat A,MatType type,MatReuse reuse,Mat *newmat)
+{
+  Mat             B = *newmat;
+  Mat_SeqAIJFloat *af;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  /* the MATSEQAIJ matrix has the values of the operations, even if they changed after the last rounding */
+  if (A->assembled) {ierr = MatSeqAIJFloatSetUp_Private(A);CHKERRQ(ierr);}
+  if (reuse == MAT_INITIAL_MATRIX) {
+    ierr = MatDuplicate(A,MAT_COPY_VALUES,&B);CHKERRQ(ierr);
+  }
+  af = (Mat_SeqAIJFloat*)B->spptr;
+
+  /* Reset the original function pointers */
+  B->ops->assemblyend = MatAssemblyEnd_SeqAIJ;
+  B->ops->destroy     = MatDestroy_SeqAIJ;
+  B->ops->mult        = MatMult_SeqAIJ;
+  B->ops->multadd     = MatMultAdd_SeqAIJ;
+  B->ops->sor         = MatSOR_SeqAIJ;
+  B->ops->getrow      = MatGetRow_SeqAIJ;
+
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaijfloat_seqaij_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqAIJRestoreArray_C",MatSeqAIJRestoreArray_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatRetrieveValues_C",MatRetrieveValues_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMult_seqdense_seqaijfloat_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultSymbolic_seqdense_seqaijfloat_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultNumeric_seqdense_seqaijfloat_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatPtAP_is_seqaijfloat_C",NULL);CHKERRQ(ierr);
+
+  ierr = PetscFree(af->a);CHKERRQ(ierr);
+  ierr = MatSeqAIJOffsetReset_Private(&af->o);CHKERRQ(ierr);
+  ierr = PetscFree(B->spptr);CHKERRQ(ierr);
+
+  ierr = PetscObjectChangeTypeName((PetscObject)B,MATSEQAIJ);CHKERRQ(ierr);
+  *newmat = B;
+  PetscFunctionReturn(0);
+}
+
+/* This function prototype is needed in MatConvert_SeqAIJ_SeqAIJFloat(), below. */
+PETSC_INTERN PetscErrorCode MatPtAP_IS_XAIJ(Mat,Mat,MatReuse,PetscReal,Mat*);
+
+/* MatConvert_SeqAIJ_SeqAIJFloat converts a SeqAIJ matrix into a
+ * SeqAIJFloat matrix.  This routine is called by the MatCreate_SeqAIJFloat()
+ * routine, but can also be used to convert an assembled SeqAIJ matrix
+ * into a SeqAIJFloat one. */
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJFloat(Mat A,MatType type,MatReuse reuse,Mat *newmat)
+{
+  Mat             B = *newmat;
+  Mat_SeqAIJ      *b;
+  Mat_SeqAIJFloat *af;
+  PetscBool       sametype;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) {
+    ierr = MatDuplicate(A,MAT_COPY_VALUES,&B);CHKERRQ(ierr);
+  }
+  ierr = PetscObjectTypeCompare((PetscObject)A,type,&sametype);CHKERRQ(ierr);
+  if (sametype) PetscFunctionReturn(0);
+
+  ierr     = PetscNewLog(B,&af);CHKERRQ(ierr);
+  b        = (Mat_SeqAIJ*)B->data;
+  B->spptr = (void*)af;
+
+  af->state          = -1;
+  af->nonzerostate   = -1;
+  af->shortindices   = PETSC_TRUE;
+  af->o.nonzerostate = -1;
+  ierr = PetscObjectOptionsBegin((PetscObject)B);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-mat_seqaijfloat_short_indices","Read the column indices as 1, 2 or 4 byte offsets when they fit","None",af->shortindices,&af->shortindices,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+
+  /* Disable the inode routines so that the single precision ones are used; MatAssemblyEnd_SeqAIJFloat() does it as well */
+  b->inode.use = PETSC_FALSE;
+
+  B->ops->assemblyend = MatAssemblyEnd_SeqAIJFloat;
+  B->ops->destroy     = MatDestroy_SeqAIJFloat;
+  B->ops->mult        = MatMult_SeqAIJFloat;
+  B->ops->multadd     = MatMultAdd_SeqAIJFloat;
+  B->ops->sor         = MatSOR_SeqAIJFloat;
+  B->ops->getrow      = MatGetRow_SeqAIJFloat;
+
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaijfloat_seqaij_C",MatConvert_SeqAIJFloat_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqAIJRestoreArray_C",MatSeqAIJRestoreArray_SeqAIJFloat);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatRetrieveValues_C",MatRetrieveValues_SeqAIJFloat);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMult_seqdense_seqaijfloat_C",MatMatMult_SeqDense_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultSymbolic_seqdense_seqaijfloat_C",MatMatMultSymbolic_SeqDense_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultNumeric_seqdense_seqaijfloat_C",MatMatMultNumeric_SeqDense_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatPtAP_is_seqaijfloat_C",MatPtAP_IS_XAIJ);CHKERRQ(ierr);
+
+  ierr = PetscObjectChangeTypeName((PetscObject)B,MATSEQAIJFLOAT);CHKERRQ(ierr);
+  if (B->assembled) {ierr = MatSeqAIJFloatRound_Private(B);CHKERRQ(ierr);}
+  *newmat = B;
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   MATSEQAIJFLOAT - MATSEQAIJFLOAT = "seqaijfloat" - A MATSEQAIJ matrix whose values are rounded to single precision
+   and read in single precision by MatMult(), MatMultAdd() and MatSOR(), which accumulate in PetscScalar precision.
+
+   This is meant for matrices that do not need full precision, such as the matrix from which a preconditioner is
+   built or the operator of a smoother, and whose products are limited by the memory bandwidth. The column indices are
+   read as offsets from the first column of the row, in the smallest of 1, 2 or 4 bytes that holds the largest span of
+   a row, as by MATSEQAIJOFFSET. MatGetRow() and the operations of MATSEQAIJ, such as the factorizations, use the same rounded values in
+   the MATSEQAIJ storage, which is kept. The inodes are not used.
+
+   Since the MATSEQAIJ storage is kept, the memory footprint grows instead of shrinking: each nonzero takes 12 bytes
+   for its values, 8 in double and 4 in single precision, plus its column index and its offset. Only the traffic of the operations above is reduced.
+
+   Options Database Keys:
++  -mat_type seqaijfloat - sets the matrix type to MATSEQAIJFLOAT during a call to MatSetFromOptions()
+.  -mat_seqaij_type seqaijfloat - makes the sequential AIJ matrices default to MATSEQAIJFLOAT
+-  -mat_seqaijfloat_short_indices <true> - read the column indices as 1, 2 or 4 byte offsets when they fit
+
+   Notes:
+   A MATSEQAIJ matrix can be converted with MatConvert(A,MATSEQAIJFLOAT,MAT_INPLACE_MATRIX,&A). The values are rounded
+   by the conversion, at the end of each assembly, by MatSeqAIJRestoreArray() and MatRetrieveValues(); values changed
+   by other operations, such as MatScale(), are rounded the first time one of the operations above is used. Converting
+   the matrix back to MATSEQAIJ does not restore them. Only available for real scalars.
+
+   Level: intermediate
+
+.seealso: MatCreate(), MatConvert(), MATSEQAIJ, MATSEQAIJOFFSET, MATMPIAIJFLOAT, MATAIJFLOAT
+M*/
+
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJFloat(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSetType(A,MATSEQAIJ);CHKERRQ(ierr);
+  ierr = MatConvert_SeqAIJ_SeqAIJFloat(A,MATSEQAIJFLOAT,MAT_INPLACE_MATRIX,&A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,291 @@
+/*
+  Defines the MATSEQAIJMERGEPATH matrix class, a MATSEQAIJ whose MatMult() and MatMultAdd() split the work among the
+  threads of the pool along the merge path of the row ends and the nonzeros.
+
+  The work of a product is the m row ends plus the nonzeros, and each thread gets a tile of exactly 1/nthreads of it,
+  whatever the lengths of the rows. A row may then be cut between tiles, even several of them for a very long row: the
+  thread that ends the row writes it and the others keep the sum of their part of it in carry[], which is added at the
+  end in the order of the tiles, so the results do not vary from run to run.
+*/
+
+#include <../src/mat/impls/aij/seq/aij.h>
+
+typedef struct {
+  PetscObjectState nonzerostate; /* nonzero state of the matrix when the tiles were computed */
+  PetscInt         ntiles;       /* number of tiles, the size of the thread pool, 0 if they have not been computed */
+  PetscInt         *tilerow;     /* tile t starts in row tilerow[t] ... */
+  PetscInt         *tilenz;      /* ... at the nonzero tilenz[t], the tile ntiles is the end of the matrix */
+  PetscScalar      *carry;       /* the sum of the part of the row tilerow[t+1] in tile t */
+} Mat_SeqAIJMergePath;
+
+typedef struct {
+  Mat               A;
+  const PetscScalar *x;
+  const PetscScalar *y;          /* the vector added by MatMultAdd(), NULL for MatMult() */
+  PetscScalar       *z;          /* the result */
+} MatMergePathCtx;
+
+/*
+   The point of the merge path of the row ends ai[1..m] and the nonzeros 0..nz-1 on the diagonal d: the rows whose end
+   is before it, and the nonzeros before it
+*/
+static void MatMergePathSearch_Private(PetscInt d,PetscInt m,const PetscInt ai[],PetscInt *row,PetscInt *nz)
+{
+  PetscInt lo = PetscMax(d-ai[m],0),hi = PetscMin(d,m),mid;
+
+  while (lo < hi) {
+    mid = lo + (hi-lo)/2;
+    if (ai[mid+1] <= d-mid-1) lo = mid+1;
+    else                      hi = mid;
+  }
+  *row = lo;
+  *nz  = d - lo;
+}
+
+static PetscErrorCode MatSeqAIJMergePathSetUp_Private(Mat A)
+{
+  Mat_SeqAIJ          *a  = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJMergePath *mp = (Mat_SeqAIJMergePath*)A->spptr;
+  PetscInt            m   = A->rmap->n,ntiles,t;
+  PetscInt64          total;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscThreadPoolGetSize(&ntiles);CHKERRQ(ierr);
+  if (mp->ntiles == ntiles && mp->nonzerostate == A->nonzerostate) PetscFunctionReturn(0);
+  ierr  = PetscFree3(mp->tilerow,mp->tilenz,mp->carry);CHKERRQ(ierr);
+  ierr  = PetscMalloc3(ntiles+1,&mp->tilerow,ntiles+1,&mp->tilenz,ntiles,&mp->carry);CHKERRQ(ierr);
+  total = (PetscInt64)m + a->i[m];
+  for (t=0; t<=ntiles; t++) {
+    MatMergePathSearch_Private((PetscInt)(total*t/ntiles),m,a->i,&mp->tilerow[t],&mp->tilenz[t]);
+  }
+  mp->ntiles       = ntiles;
+  mp->nonzerostate = A->nonzerostate;
+  ierr = PetscInfo2(A,"Merge path of %D rows and nonzeros split into %D tiles\n",(PetscInt)total,ntiles);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static void MatMergePathKernel_Private(PetscInt tid,PetscInt nthreads,void *vctx)
+{
+  MatMergePathCtx     *ctx = (MatMergePathCtx*)vctx;
+  Mat_SeqAIJ          *a   = (Mat_SeqAIJ*)ctx->A->data;
+  Mat_SeqAIJMergePath *mp  = (Mat_SeqAIJMergePath*)ctx->A->spptr;
+  const PetscScalar   *x   = ctx->x,*y = ctx->y;
+  PetscScalar         *z   = ctx->z,sum;
+  const PetscInt      *ai  = a->i,*aj;
+  const MatScalar     *aa;
+  PetscInt            row  = mp->tilerow[tid],rowend = mp->tilerow[tid+1],k = mp->tilenz[tid],n;
+
+  /* the rows that end in the tile, the first one may have been started by the previous tiles */
+  for (; row<rowend; row++) {
+    n   = ai[row+1] - k;
+    aj  = a->j + k;
+    aa  = a->a + k;
+    sum = y ? y[row] : 0.0;
+    PetscSparseDensePlusDot(sum,x,aa,aj,n);
+    z[row] = sum;
+    k      = ai[row+1];
+  }
+  /* the start of the row ended by the next tiles */
+  n   = mp->tilenz[tid+1] - k;
+  aj  = a->j + k;
+  aa  = a->a + k;
+  sum = 0.0;
+  PetscSparseDensePlusDot(sum,x,aa,aj,n);
+  mp->carry[tid] = sum;
+}
+
+static PetscErrorCode MatMergePathRun_Private(MatMergePathCtx *ctx)
+{
+  Mat                 A   = ctx->A;
+  Mat_SeqAIJMergePath *mp;
+  PetscInt            t;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJMergePathSetUp_Private(A);CHKERRQ(ierr);
+  mp   = (Mat_SeqAIJMergePath*)A->spptr;
+  ierr = PetscThreadPoolRun(MatMergePathKernel_Private,ctx);CHKERRQ(ierr);
+  for (t=0; t<mp->ntiles; t++) {
+    if (mp->tilerow[t+1] < A->rmap->n) ctx->z[mp->tilerow[t+1]] += mp->carry[t];
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMult_SeqAIJMergePath(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqAIJ      *a = (Mat_SeqAIJ*)A->data;
+  MatMergePathCtx ctx;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ctx.A = A;
+  ctx.y = NULL;
+  ierr  = VecGetArrayRead(xx,&ctx.x);CHKERRQ(ierr);
+  ierr  = VecGetArray(yy,&ctx.z);CHKERRQ(ierr);
+  ierr  = MatMergePathRun_Private(&ctx);CHKERRQ(ierr);
+  ierr  = VecRestoreArrayRead(xx,&ctx.x);CHKERRQ(ierr);
+  ierr  = VecRestoreArray(yy,&ctx.z);CHKERRQ(ierr);
+  ierr  = PetscLogFlops(2.0*a->nz - a->nonzerorowcnt);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMultAdd_SeqAIJMergePath(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqAIJ      *a = (Mat_SeqAIJ*)A->data;
+  MatMergePathCtx ctx;
+  PetscScalar     *y;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ctx.A = A;
+  ierr  = VecGetArrayRead(xx,&ctx.x);CHKERRQ(ierr);
+  ierr  = VecGetArrayPair(yy,zz,&y,&ctx.z);CHKERRQ(ierr);
+  ctx.y = y;
+  ierr  = MatMergePathRun_Private(&ctx);CHKERRQ(ierr);
+  ierr  = VecRestoreArrayRead(xx,&ctx.x);CHKERRQ(ierr);
+  ierr  = VecRestoreArrayPair(yy,zz,&y,&ctx.z);CHKERRQ(ierr);
+  ierr  = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatAssemblyEnd_SeqAIJMergePath(Mat A,MatAssemblyType mode)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (mode == MAT_FLUSH_ASSEMBLY) PetscFunctionReturn(0);
+  /* the rows are not grouped in inodes, so that the merge path products are used */
+  a->inode.use = PETSC_FALSE;
+  ierr = MatAssemblyEnd_SeqAIJ(A,mode);CHKERRQ(ierr);
+  ierr = MatSeqAIJMergePathSetUp_Private(A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatDestroy_SeqAIJMergePath(Mat A)
+{
+  Mat_SeqAIJMergePath *mp = (Mat_SeqAIJMergePath*)A->spptr;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  /* If MatHeaderMerge() was used, then this matrix will not have an spptr */
+  if (mp) {
+    ierr = PetscFree3(mp->tilerow,mp->tilenz,mp->carry);CHKERRQ(ierr);
+    ierr = PetscFree(A->spptr);CHKERRQ(ierr);
+  }
+  ierr = PetscObjectChangeTypeName((PetscObject)A,MATSEQAIJ);CHKERRQ(ierr);
+  ierr = MatDestroy_SeqAIJ(A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJMergePath_SeqAIJ(Mat A,MatType type,MatReuse reuse,Mat *newmat)
+{
+  Mat                 B = *newmat;
+  Mat_SeqAIJMergePath *mp;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) {
+    ierr = MatDuplicate(A,MAT_COPY_VALUES,&B);CHKERRQ(ierr);
+  }
+  mp = (Mat_SeqAIJMergePath*)B->spptr;
+
+  /* Reset the original function pointers */
+  B->ops->assemblyend = MatAssemblyEnd_SeqAIJ;
+  B->ops->destroy     = MatDestroy_SeqAIJ;
+  B->ops->mult        = MatMult_SeqAIJ;
+  B->ops->multadd     = MatMultAdd_SeqAIJ;
+
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaijmergepath_seqaij_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMult_seqdense_seqaijmergepath_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultSymbolic_seqdense_seqaijmergepath_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultNumeric_seqdense_seqaijmergepath_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatPtAP_is_seqaijmergepath_C",NULL);CHKERRQ(ierr);
+
+  ierr = PetscFree3(mp->tilerow,mp->tilenz,mp->carry);CHKERRQ(ierr);
+  ierr = PetscFree(B->spptr);CHKERRQ(ierr);
+
+  ierr = PetscObjectChangeTypeName((PetscObject)B,MATSEQAIJ);CHKERRQ(ierr);
+  *newmat = B;
+  PetscFunctionReturn(0);
+}
+
+/* This function prototype is needed in MatConvert_SeqAIJ_SeqAIJMergePath(), below. */
+PETSC_INTERN PetscErrorCode MatPtAP_IS_XAIJ(Mat,Mat,MatReuse,PetscReal,Mat*);
+
+/* MatConvert_SeqAIJ_SeqAIJMergePath converts a SeqAIJ matrix into a
+ * SeqAIJMergePath matrix.  This routine is called by the MatCreate_SeqAIJMergePath()
+ * routine, but can also be used to convert an assembled SeqAIJ matrix
+ * into a SeqAIJMergePath one. */
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJMergePath(Mat A,MatType type,MatReuse reuse,Mat *newmat)
+{
+  Mat                 B = *newmat;
+  Mat_SeqAIJ          *b;
+  Mat_SeqAIJMergePath *mp;
+  PetscBool           sametype;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) {
+    ierr = MatDuplicate(A,MAT_COPY_VALUES,&B);CHKERRQ(ierr);
+  }
+  ierr = PetscObjectTypeCompare((PetscObject)A,type,&sametype);CHKERRQ(ierr);
+  if (sametype) PetscFunctionReturn(0);
+
+  ierr     = PetscNewLog(B,&mp);CHKERRQ(ierr);
+  b        = (Mat_SeqAIJ*)B->data;
+  B->spptr = (void*)mp;
+
+  /* Disable the inode routines so that the merge path ones are used; MatAssemblyEnd_SeqAIJMergePath() does it as well */
+  b->inode.use = PETSC_FALSE;
+
+  B->ops->assemblyend = MatAssemblyEnd_SeqAIJMergePath;
+  B->ops->destroy     = MatDestroy_SeqAIJMergePath;
+  B->ops->mult        = MatMult_SeqAIJMergePath;
+  B->ops->multadd     = MatMultAdd_SeqAIJMergePath;
+
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaijmergepath_seqaij_C",MatConvert_SeqAIJMergePath_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMult_seqdense_seqaijmergepath_C",MatMatMult_SeqDense_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultSymbolic_seqdense_seqaijmergepath_C",MatMatMultSymbolic_SeqDense_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultNumeric_seqdense_seqaijmergepath_C",MatMatMultNumeric_SeqDense_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatPtAP_is_seqaijmergepath_C",MatPtAP_IS_XAIJ);CHKERRQ(ierr);
+
+  ierr    = PetscObjectChangeTypeName((PetscObject)B,MATSEQAIJMERGEPATH);CHKERRQ(ierr);
+  *newmat = B;
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   MATSEQAIJMERGEPATH - MATSEQAIJMERGEPATH = "seqaijmergepath" - A MATSEQAIJ matrix whose MatMult() and MatMultAdd()
+   give each thread of the thread pool exactly the same share of the rows and nonzeros, cutting long rows between threads.
+
+   This is meant for matrices whose rows have very different numbers of nonzeros, such as those of graphs with a power
+   law degree distribution, where splitting whole rows among the threads leaves most of them waiting for the one with
+   the longest rows. The matrix is stored as a MATSEQAIJ, plus two integers per thread that give the start of the part
+   of each thread, computed at the end of the assembly with a binary search on the merge path of the row ends and the
+   nonzeros. The inodes are not used. Any other operation is the one of MATSEQAIJ.
+
+   Options Database Keys:
++  -mat_type seqaijmergepath - sets the matrix type to MATSEQAIJMERGEPATH during a call to MatSetFromOptions()
+-  -mat_seqaij_type seqaijmergepath - makes the sequential AIJ matrices default to MATSEQAIJMERGEPATH
+
+   Notes:
+   A MATSEQAIJ matrix can be converted with MatConvert(A,MATSEQAIJMERGEPATH,MAT_INPLACE_MATRIX,&A). The number of
+   threads is set with PetscThreadPoolSetSize() or -thread_pool_size; with one thread, the products are those of the
+   compressed row storage.
+
+   Level: intermediate
+
+.seealso: MatCreate(), MatConvert(), MATSEQAIJ, MATSEQAIJSELL, MATSEQAIJPERM, PetscThreadPoolSetSize()
+M*/
+
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJMergePath(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSetType(A,MATSEQAIJ);CHKERRQ(ierr);
+  ierr = MatConvert_SeqAIJ_SeqAIJMergePath(A,MATSEQAIJMERGEPATH,MAT_INPLACE_MATRIX,&A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,275 @@
+/*
+  Defines the MATSEQAIJOFFSET matrix class, a MATSEQAIJ whose MatMult(), MatMultAdd() and MatSOR() read the column
+  indices as offsets from the first column of each row, in 1, 2 or 4 bytes.
+
+  These operations are limited by the memory bandwidth, and with 64 bit indices a nonzero costs 8 bytes of value and
+  8 bytes of column index. The columns of a row of a banded matrix, such as those of finite elements or DMDA, are
+  close to each other, so that the offsets of all the rows fit in the smallest of 1, 2 or 4 bytes that holds the
+  largest span of a row; with the first column of each row this takes a nonzero toward 9 or 10 bytes. The offsets are
+  made the first time one of the operations is used after the nonzero structure changes. The column indices of the
+  MATSEQAIJ storage are kept for the other operations.
+*/
+
+#include <../src/mat/impls/aij/seq/aijoffset/aijoffset.h>
+
+/* makes the offsets of A in o if its nonzero structure changed */
+PetscErrorCode MatSeqAIJOffsetSetUp_Private(Mat A,Mat_SeqAIJOffset *o)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscInt       i,k,m = A->rmap->n,nz = a->i[A->rmap->n],*ai = a->i,*aj = a->j,span = 0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (o->nonzerostate == A->nonzerostate) PetscFunctionReturn(0);
+  ierr = PetscFree2(o->jbase,o->oj);CHKERRQ(ierr);
+  for (i=0; i<m; i++) {
+    if (ai[i+1] > ai[i]) span = PetscMax(span,aj[ai[i+1]-1] - aj[ai[i]]);
+  }
+  /* 4 byte offsets only save anything with 64 bit indices */
+  if (span <= 255) o->width = 1;
+  else if (span <= 65535) o->width = 2;
+  else if (sizeof(PetscInt) > 4 && (PetscInt64)span <= 4294967295LL) o->width = 4;
+  else o->width = 0;
+  ierr = PetscMalloc2(m,&o->jbase,o->width*nz,&o->oj);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)A,m*sizeof(PetscInt)+o->width*nz);CHKERRQ(ierr);
+  for (i=0; i<m; i++) {
+    o->jbase[i] = ai[i+1] > ai[i] ? aj[ai[i]] : 0;
+    switch (o->width) {
+    case 1:
+      for (k=ai[i]; k<ai[i+1]; k++) o->oj[k] = (unsigned char)(aj[k] - o->jbase[i]);
+      break;
+    case 2:
+      for (k=ai[i]; k<ai[i+1]; k++) ((unsigned short*)o->oj)[k] = (unsigned short)(aj[k] - o->jbase[i]);
+      break;
+    case 4:
+      for (k=ai[i]; k<ai[i+1]; k++) ((unsigned int*)o->oj)[k] = (unsigned int)(aj[k] - o->jbase[i]);
+      break;
+    }
+  }
+  ierr = PetscInfo2(A,"Column indices as %D byte offsets, largest span of a row %D\n",o->width,span);CHKERRQ(ierr);
+  o->nonzerostate = A->nonzerostate;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSeqAIJOffsetReset_Private(Mat_SeqAIJOffset *o)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree2(o->jbase,o->oj);CHKERRQ(ierr);
+  o->nonzerostate = -1;
+  o->width        = 0;
+  PetscFunctionReturn(0);
+}
+
+/* the product of the entries k0 to k1-1, which are in row i, with x */
+PETSC_STATIC_INLINE PetscScalar MatSeqAIJOffsetDot_Private(Mat A,PetscInt i,PetscInt k0,PetscInt k1,const PetscScalar *x)
+{
+  Mat_SeqAIJ       *a  = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJOffset *ao = (Mat_SeqAIJOffset*)A->spptr;
+  PetscScalar      sum;
+
+  MatSeqAIJOffsetDot(sum,ao,a->j,a->a,i,k0,k1,x);
+  return sum;
+}
+
+PetscErrorCode MatMult_SeqAIJOffset(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJOffset  *ao = (Mat_SeqAIJOffset*)A->spptr;
+  const PetscScalar *x;
+  PetscScalar       *y;
+  const MatScalar   *aa = a->a;
+  const PetscInt    *ai = a->i,*aj = a->j;
+  PetscInt          i,m = A->rmap->n;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJOffsetSetUp_Private(A,ao);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
+  for (i=0; i<m; i++) MatSeqAIJOffsetDot(y[i],ao,aj,aa,i,ai[i],ai[i+1],x);
+  ierr = PetscLogFlops(2.0*a->nz - a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMultAdd_SeqAIJOffset(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJOffset  *ao = (Mat_SeqAIJOffset*)A->spptr;
+  const PetscScalar *x;
+  PetscScalar       *y,*z;
+  const MatScalar   *aa = a->a;
+  const PetscInt    *ai = a->i,*aj = a->j;
+  PetscScalar       sum;
+  PetscInt          i,m = A->rmap->n;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJOffsetSetUp_Private(A,ao);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  for (i=0; i<m; i++) {
+    MatSeqAIJOffsetDot(sum,ao,aj,aa,i,ai[i],ai[i+1],x);
+    z[i] = y[i] + sum;
+  }
+  ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* the sweeps of MatSOR_SeqAIJ() with the offsets */
+PetscErrorCode MatSOR_SeqAIJOffset(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscReal fshift,PetscInt its,PetscInt lits,Vec xx)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJOffsetSetUp_Private(A,(Mat_SeqAIJOffset*)A->spptr);CHKERRQ(ierr);
+  ierr = MatSOR_SeqAIJ_Dot(A,bb,omega,flag,fshift,its,lits,xx,MatSeqAIJOffsetDot_Private);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatAssemblyEnd_SeqAIJOffset(Mat A,MatAssemblyType mode)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (mode == MAT_FLUSH_ASSEMBLY) PetscFunctionReturn(0);
+  /* the rows are not grouped in inodes, so that the operations with the offsets are used */
+  a->inode.use = PETSC_FALSE;
+  ierr = MatAssemblyEnd_SeqAIJ(A,mode);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatDestroy_SeqAIJOffset(Mat A)
+{
+  Mat_SeqAIJOffset *ao = (Mat_SeqAIJOffset*)A->spptr;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  /* If MatHeaderMerge() was used, then this matrix will not have an spptr */
+  if (ao) {
+    ierr = MatSeqAIJOffsetReset_Private(ao);CHKERRQ(ierr);
+    ierr = PetscFree(A->spptr);CHKERRQ(ierr);
+  }
+  ierr = PetscObjectChangeTypeName((PetscObject)A,MATSEQAIJ);CHKERRQ(ierr);
+  ierr = MatDestroy_SeqAIJ(A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJOffset_SeqAIJ(Mat A,MatType type,MatReuse reuse,Mat *newmat)
+{
+  Mat              B = *newmat;
+  Mat_SeqAIJOffset *ao;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) {
+    ierr = MatDuplicate(A,MAT_COPY_VALUES,&B);CHKERRQ(ierr);
+  }
+  ao = (Mat_SeqAIJOffset*)B->spptr;
+
+  /* Reset the original function pointers */
+  B->ops->assemblyend = MatAssemblyEnd_SeqAIJ;
+  B->ops->destroy     = MatDestroy_SeqAIJ;
+  B->ops->mult        = MatMult_SeqAIJ;
+  B->ops->multadd     = MatMultAdd_SeqAIJ;
+  B->ops->sor         = MatSOR_SeqAIJ;
+
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaijoffset_seqaij_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMult_seqdense_seqaijoffset_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultSymbolic_seqdense_seqaijoffset_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultNumeric_seqdense_seqaijoffset_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatPtAP_is_seqaijoffset_C",NULL);CHKERRQ(ierr);
+
+  ierr = MatSeqAIJOffsetReset_Private(ao);CHKERRQ(ierr);
+  ierr = PetscFree(B->spptr);CHKERRQ(ierr);
+
+  ierr = PetscObjectChangeTypeName((PetscObject)B,MATSEQAIJ);CHKERRQ(ierr);
+  *newmat = B;
+  PetscFunctionReturn(0);
+}
+
+/* This function prototype is needed in MatConvert_SeqAIJ_SeqAIJOffset(), below. */
+PETSC_INTERN PetscErrorCode MatPtAP_IS_XAIJ(Mat,Mat,MatReuse,PetscReal,Mat*);
+
+/* MatConvert_SeqAIJ_SeqAIJOffset converts a SeqAIJ matrix into a
+ * SeqAIJOffset matrix.  This routine is called by the MatCreate_SeqAIJOffset()
+ * routine, but can also be used to convert an assembled SeqAIJ matrix
+ * into a SeqAIJOffset one. */
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJOffset(Mat A,MatType type,MatReuse reuse,Mat *newmat)
+{
+  Mat              B = *newmat;
+  Mat_SeqAIJ       *b;
+  Mat_SeqAIJOffset *ao;
+  PetscBool        sametype;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) {
+    ierr = MatDuplicate(A,MAT_COPY_VALUES,&B);CHKERRQ(ierr);
+  }
+  ierr = PetscObjectTypeCompare((PetscObject)A,type,&sametype);CHKERRQ(ierr);
+  if (sametype) PetscFunctionReturn(0);
+
+  ierr     = PetscNewLog(B,&ao);CHKERRQ(ierr);
+  b        = (Mat_SeqAIJ*)B->data;
+  B->spptr = (void*)ao;
+
+  ao->nonzerostate = -1;
+
+  /* Disable the inode routines so that the offsets are used; MatAssemblyEnd_SeqAIJOffset() does it as well */
+  b->inode.use = PETSC_FALSE;
+
+  B->ops->assemblyend = MatAssemblyEnd_SeqAIJOffset;
+  B->ops->destroy     = MatDestroy_SeqAIJOffset;
+  B->ops->mult        = MatMult_SeqAIJOffset;
+  B->ops->multadd     = MatMultAdd_SeqAIJOffset;
+  B->ops->sor         = MatSOR_SeqAIJOffset;
+
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaijoffset_seqaij_C",MatConvert_SeqAIJOffset_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMult_seqdense_seqaijoffset_C",MatMatMult_SeqDense_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultSymbolic_seqdense_seqaijoffset_C",MatMatMultSymbolic_SeqDense_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatMatMultNumeric_seqdense_seqaijoffset_C",MatMatMultNumeric_SeqDense_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatPtAP_is_seqaijoffset_C",MatPtAP_IS_XAIJ);CHKERRQ(ierr);
+
+  ierr    = PetscObjectChangeTypeName((PetscObject)B,MATSEQAIJOFFSET);CHKERRQ(ierr);
+  *newmat = B;
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   MATSEQAIJOFFSET - MATSEQAIJOFFSET = "seqaijoffset" - A MATSEQAIJ matrix whose MatMult(), MatMultAdd() and MatSOR()
+   read the column indices as offsets from the first column of each row, stored in 1, 2 or 4 bytes.
+
+   The width of the offsets is the smallest that holds the largest span of a row, from its first to its last column,
+   so this is meant for banded matrices, such as those from finite elements or DMDA, whose products are limited by the
+   memory bandwidth. The offsets are made the first time one of these operations is used after the nonzero structure
+   changes; the MATSEQAIJ storage is kept for the other operations. The inodes are not used.
+
+   Options Database Keys:
++  -mat_type seqaijoffset - sets the matrix type to MATSEQAIJOFFSET during a call to MatSetFromOptions()
+-  -mat_seqaij_type seqaijoffset - makes the sequential AIJ matrices, including the blocks of MATMPIAIJ matrices, default to MATSEQAIJOFFSET
+
+   Notes:
+   An assembled MATSEQAIJ matrix can be converted with MatConvert(A,MATSEQAIJOFFSET,MAT_INPLACE_MATRIX,&A).
+   The width is reported with -info.
+
+   Level: intermediate
+
+.seealso: MatCreate(), MatConvert(), MATSEQAIJ, MATSEQAIJFLOAT
+M*/
+
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJOffset(Mat A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSetType(A,MATSEQAIJ);CHKERRQ(ierr);
+  ierr = MatConvert_SeqAIJ_SeqAIJOffset(A,MATSEQAIJOFFSET,MAT_INPLACE_MATRIX,&A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
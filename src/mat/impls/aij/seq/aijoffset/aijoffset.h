@@ -0,0 +1,130 @@
+#if !defined(__AIJOFFSET_H)
+#define __AIJOFFSET_H
+
+#include <../src/mat/impls/aij/seq/aij.h>
+
+/* The column indices of a MATSEQAIJ matrix as offsets from the first column of each row, used by MATSEQAIJOFFSET and MATSEQAIJFLOAT */
+typedef struct {
+  PetscObjectState nonzerostate;  /* nonzero state of the matrix when the offsets were made */
+  PetscInt         width;         /* bytes per offset, 1, 2 or 4; 0 if a span does not fit and aj[] is used */
+  PetscInt         *jbase;        /* the first column of each row */
+  unsigned char    *oj;           /* the column of each nonzero minus the first column of its row, width bytes each */
+} Mat_SeqAIJOffset;
+
+PETSC_INTERN PetscErrorCode MatSeqAIJOffsetSetUp_Private(Mat,Mat_SeqAIJOffset*);
+PETSC_INTERN PetscErrorCode MatSeqAIJOffsetReset_Private(Mat_SeqAIJOffset*);
+
+/* sum = the product of the entries k0 to k1-1, which are in row i and whose values are v[], with x */
+#define MatSeqAIJOffsetDot(sum,o,aj,v,i,k0,k1,x) do {                  \
+    const PetscScalar *_xi = (o)->width ? (x) + (o)->jbase[i] : (x);  \
+    PetscInt          _k;                                              \
+    (sum) = 0.0;                                                       \
+    switch ((o)->width) {                                              \
+    case 1: {                                                          \
+      const unsigned char *_oj = (o)->oj;                              \
+      for (_k=(k0); _k<(k1); _k++) (sum) += (v)[_k]*_xi[_oj[_k]];      \
+    } break;                                                           \
+    case 2: {                                                          \
+      const unsigned short *_oj = (const unsigned short*)(o)->oj;      \
+      for (_k=(k0); _k<(k1); _k++) (sum) += (v)[_k]*_xi[_oj[_k]];      \
+    } break;                                                           \
+    case 4: {                                                          \
+      const unsigned int *_oj = (const unsigned int*)(o)->oj;          \
+      for (_k=(k0); _k<(k1); _k++) (sum) += (v)[_k]*_xi[_oj[_k]];      \
+    } break;                                                           \
+    default:                                                           \
+      for (_k=(k0); _k<(k1); _k++) (sum) += (v)[_k]*(x)[(aj)[_k]];     \
+    }                                                                  \
+  } while (0)
+
+/*
+   The sweeps of MatSOR_SeqAIJ() with dot(A,i,k0,k1,x), the product of the entries k0 to k1-1 of row i with x, for the
+   subtypes that only change how the rows are read; the variants that do not sweep the rows use MatSOR_SeqAIJ().
+*/
+PETSC_STATIC_INLINE PetscErrorCode MatSOR_SeqAIJ_Dot(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscReal fshift,PetscInt its,PetscInt lits,Vec xx,PetscScalar (*dot)(Mat,PetscInt,PetscInt,PetscInt,const PetscScalar*))
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar       *x,sum,*t;
+  const MatScalar   *idiag,*mdiag;
+  const PetscScalar *b,*xb;
+  const PetscInt    *ai = a->i,*diag;
+  PetscInt          m = A->rmap->n,i;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (flag == SOR_APPLY_UPPER || flag == SOR_APPLY_LOWER || (flag & SOR_EISENSTAT)) {
+    ierr = MatSOR_SeqAIJ(A,bb,omega,flag,fshift,its,lits,xx);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  its = its*lits;
+
+  if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
+  if (!a->idiagvalid) {ierr = MatInvertDiagonal_SeqAIJ(A,omega,fshift);CHKERRQ(ierr);}
+  a->fshift = fshift;
+  a->omega  = omega;
+
+  diag  = a->diag;
+  t     = a->ssor_work;
+  idiag = a->idiag;
+  mdiag = a->mdiag;
+
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  if (flag & SOR_ZERO_INITIAL_GUESS) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i=0; i<m; i++) {
+        sum  = b[i] - dot(A,i,ai[i],diag[i],x);
+        t[i] = sum;
+        x[i] = sum*idiag[i];
+      }
+      xb   = t;
+      ierr = PetscLogFlops(a->nz);CHKERRQ(ierr);
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i=m-1; i>=0; i--) {
+        sum = xb[i] - dot(A,i,diag[i]+1,ai[i+1],x);
+        if (xb == b) {
+          x[i] = sum*idiag[i];
+        } else {
+          x[i] = (1-omega)*x[i] + sum*idiag[i];  /* omega in idiag */
+        }
+      }
+      ierr = PetscLogFlops(a->nz);CHKERRQ(ierr); /* assumes 1/2 in upper */
+    }
+    its--;
+  }
+  while (its--) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i=0; i<m; i++) {
+        sum  = b[i] - dot(A,i,ai[i],diag[i],x);
+        t[i] = sum;             /* save application of the lower-triangular part */
+        sum -= dot(A,i,diag[i]+1,ai[i+1],x);
+        x[i] = (1. - omega)*x[i] + sum*idiag[i]; /* omega in idiag */
+      }
+      xb   = t;
+      ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i=m-1; i>=0; i--) {
+        if (xb == b) {
+          /* whole matrix (no checkpointing available) */
+          sum  = b[i] - dot(A,i,ai[i],ai[i+1],x);
+          x[i] = (1. - omega)*x[i] + (sum + mdiag[i]*x[i])*idiag[i];
+        } else { /* lower-triangular part has been saved, so only apply upper-triangular */
+          sum  = xb[i] - dot(A,i,diag[i]+1,ai[i+1],x);
+          x[i] = (1. - omega)*x[i] + sum*idiag[i];  /* omega in idiag */
+        }
+      }
+      if (xb == b) {
+        ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+      } else {
+        ierr = PetscLogFlops(a->nz);CHKERRQ(ierr); /* assumes 1/2 in upper */
+      }
+    }
+  }
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#endif
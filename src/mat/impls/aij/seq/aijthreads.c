@@ -0,0 +1,318 @@
+/*
+   Multi-threaded MatMult(), MatMultAdd() and MatMultTranspose() for MATSEQAIJ, used when the matrix has at least
+  MatSeqAIJThreadsMinNz nonzeros and the thread pool has more than one thread.
+
+   The rows, the compressed rows or the inodes are split at the end of the assembly into one contiguous part per
+  thread with about the same number of nonzeros, so the threads do the same amount of work even when the rows are of
+  very different lengths. The partition is kept in Mat_SeqAIJ and recomputed only when the nonzero structure or the
+  size of the pool changes.
+
+   For the transpose, every thread but the first adds its rows into its own work array, which only covers the columns
+  used by its rows; the arrays are then summed into the result by columns, in a fixed order, so there are no atomic
+  operations and the results do not vary from run to run.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+
+/* set with -mat_threads_min_nz in MatInitializePackage() */
+PetscInt MatSeqAIJThreadsMinNz = 50000;
+
+typedef enum {MAT_THREADS_MULT,MAT_THREADS_MULTADD,MAT_THREADS_MULTTRANSPOSE,MAT_THREADS_SUMTRANSPOSE} MatThreadsOp;
+
+typedef struct {
+  MatThreadsOp      op;
+  Mat               A;
+  const PetscScalar *x;
+  const PetscScalar *y;          /* the vector added by MatMultAdd() */
+  PetscScalar       *z;          /* the result */
+} MatThreadsCtx;
+
+static void MatSeqAIJThreadsKernel_Private(PetscInt tid,PetscInt nthreads,void *vctx)
+{
+  MatThreadsCtx     *ctx = (MatThreadsCtx*)vctx;
+  Mat               A    = ctx->A;
+  Mat_SeqAIJ        *a   = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJThreads *th  = &a->threads;
+  const PetscScalar *x   = ctx->x,*y = ctx->y;
+  PetscScalar       *z   = ctx->z,*w,sum,alpha;
+  const PetscInt    *ii  = a->i,*ridx = NULL,*aj;
+  const MatScalar   *aa;
+  PetscInt          r0   = th->row[tid],r1 = th->row[tid+1],y0 = th->yrow[tid],y1 = th->yrow[tid+1];
+  PetscInt          i,j,n,s,c0,c1,lo,hi;
+
+  th->ierr[tid] = 0;
+  if (a->compressedrow.use) {
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+  }
+  switch (ctx->op) {
+  case MAT_THREADS_MULT:
+    if (th->inode) {
+      th->ierr[tid] = MatMultInodes_SeqAIJ_Private(A,th->node[tid],th->node[tid+1],th->noderow[tid],x,z);
+    } else if (ridx) {
+      /* the rows between the compressed rows of the thread are zeroed by the same thread */
+      if (y1 > y0) memset(z+y0,0,(y1-y0)*sizeof(PetscScalar));
+      for (i=r0; i<r1; i++) {
+        n   = ii[i+1] - ii[i];
+        aj  = a->j + ii[i];
+        aa  = a->a + ii[i];
+        sum = 0.0;
+        PetscSparseDensePlusDot(sum,x,aa,aj,n);
+        z[ridx[i]] = sum;
+      }
+    } else {
+      for (i=r0; i<r1; i++) {
+        n   = ii[i+1] - ii[i];
+        aj  = a->j + ii[i];
+        aa  = a->a + ii[i];
+        sum = 0.0;
+        PetscSparseDensePlusDot(sum,x,aa,aj,n);
+        z[i] = sum;
+      }
+    }
+    break;
+  case MAT_THREADS_MULTADD:
+    if (th->inode) {
+      th->ierr[tid] = MatMultAddInodes_SeqAIJ_Private(A,th->node[tid],th->node[tid+1],th->noderow[tid],x,y,z);
+    } else if (ridx) {
+      if (z != y && y1 > y0) memcpy(z+y0,y+y0,(y1-y0)*sizeof(PetscScalar));
+      for (i=r0; i<r1; i++) {
+        n   = ii[i+1] - ii[i];
+        aj  = a->j + ii[i];
+        aa  = a->a + ii[i];
+        sum = y[ridx[i]];
+        PetscSparseDensePlusDot(sum,x,aa,aj,n);
+        z[ridx[i]] = sum;
+      }
+    } else {
+      for (i=r0; i<r1; i++) {
+        n   = ii[i+1] - ii[i];
+        aj  = a->j + ii[i];
+        aa  = a->a + ii[i];
+        sum = y[i];
+        PetscSparseDensePlusDot(sum,x,aa,aj,n);
+        z[i] = sum;
+      }
+    }
+    break;
+  case MAT_THREADS_MULTTRANSPOSE:
+    /* the first thread adds directly to the result, the others to their work array */
+    if (tid) {
+      c0 = th->col[2*tid];
+      c1 = th->col[2*tid+1];
+      w  = th->work + th->workoff[tid] - c0;
+      if (c1 > c0) memset(w+c0,0,(c1-c0)*sizeof(PetscScalar));
+    } else w = z;
+    for (i=r0; i<r1; i++) {
+      n     = ii[i+1] - ii[i];
+      aj    = a->j + ii[i];
+      aa    = a->a + ii[i];
+      alpha = ridx ? x[ridx[i]] : x[i];
+      for (j=0; j<n; j++) w[aj[j]] += alpha*aa[j];
+    }
+    break;
+  case MAT_THREADS_SUMTRANSPOSE:
+    PetscThreadPoolGetRange(A->cmap->n,tid,nthreads,&c0,&c1);
+    for (s=1; s<nthreads; s++) {
+      lo = PetscMax(c0,th->col[2*s]);
+      hi = PetscMin(c1,th->col[2*s+1]);
+      w  = th->work + th->workoff[s] - th->col[2*s];
+      for (i=lo; i<hi; i++) z[i] += w[i];
+    }
+    break;
+  }
+}
+
+/* runs the kernel on the pool and returns the error of the first thread that failed */
+static PetscErrorCode MatSeqAIJThreadsRun_Private(MatThreadsCtx *ctx)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)ctx->A->data;
+  PetscInt       t;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscThreadPoolRun(MatSeqAIJThreadsKernel_Private,ctx);CHKERRQ(ierr);
+  for (t=0; t<a->threads.nthreads; t++) {
+    ierr = a->threads.ierr[t];CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSeqAIJThreadsDestroy_Private(Mat A)
+{
+  Mat_SeqAIJ        *a  = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJThreads *th = &a->threads;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree7(th->row,th->yrow,th->node,th->noderow,th->col,th->workoff,th->ierr);CHKERRQ(ierr);
+  ierr = PetscFree(th->work);CHKERRQ(ierr);
+  th->nthreads = 0;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Splits the matrix among the threads of the pool, called at the end of MatAssemblyEnd_SeqAIJ(). The cost of a row is
+   its number of nonzeros plus one for the result, and each thread gets the rows up to the first one past its share of
+   the total cost. The partition is kept while the nonzero structure, the size of the pool and the use of inodes and
+   compressed rows do not change, so assemblies that only change the values do not redo it.
+*/
+PetscErrorCode MatSeqAIJThreadsSetUp_Private(Mat A)
+{
+  Mat_SeqAIJ        *a  = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJThreads *th = &a->threads;
+  PetscInt          nthreads,m,t,r,k,row,c,cmin,cmax;
+  const PetscInt    *ii,*ns;
+  PetscInt64        total,target;
+  PetscBool         inode = (a->inode.use && a->inode.size) ? PETSC_TRUE : PETSC_FALSE;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscThreadPoolGetSize(&nthreads);CHKERRQ(ierr);
+  if (A->structure_only || a->nz < MatSeqAIJThreadsMinNz || nthreads < 2) {
+    if (th->nthreads) {ierr = MatSeqAIJThreadsDestroy_Private(A);CHKERRQ(ierr);}
+    PetscFunctionReturn(0);
+  }
+  if (th->nthreads == nthreads && th->nonzerostate == A->nonzerostate && th->inode == inode && th->compressedrow == a->compressedrow.use) PetscFunctionReturn(0);
+  ierr = MatSeqAIJThreadsDestroy_Private(A);CHKERRQ(ierr);
+  ierr = PetscMalloc7(nthreads+1,&th->row,nthreads+1,&th->yrow,nthreads+1,&th->node,nthreads+1,&th->noderow,2*nthreads,&th->col,nthreads+1,&th->workoff,nthreads,&th->ierr);CHKERRQ(ierr);
+
+  /* rows, or compressed rows, used by MatMult() without inodes and by MatMultTranspose() */
+  if (a->compressedrow.use) {
+    m  = a->compressedrow.nrows;
+    ii = a->compressedrow.i;
+  } else {
+    m  = A->rmap->n;
+    ii = a->i;
+  }
+  total      = (PetscInt64)(ii[m] - ii[0]) + m;
+  th->row[0] = 0;
+  for (t=1,r=0; t<nthreads; t++) {
+    target = total*t/nthreads;
+    while (r < m && (PetscInt64)(ii[r] - ii[0]) + r < target) r++;
+    th->row[t] = r;
+  }
+  th->row[nthreads] = m;
+  for (t=0; t<=nthreads; t++) {
+    if (!a->compressedrow.use || !t) th->yrow[t] = th->row[t];
+    else if (th->row[t] < m)         th->yrow[t] = a->compressedrow.rindex[th->row[t]];
+    else                             th->yrow[t] = A->rmap->n;
+  }
+
+  /* the columns of the rows of each thread, the part of the result of MatMultTranspose() it adds to */
+  th->workoff[0] = th->workoff[1] = 0;
+  for (t=0; t<nthreads; t++) {
+    cmin = A->cmap->n;
+    cmax = -1;
+    for (k=ii[th->row[t]]; k<ii[th->row[t+1]]; k++) {
+      c    = a->j[k];
+      cmin = PetscMin(cmin,c);
+      cmax = PetscMax(cmax,c);
+    }
+    if (cmax < 0) cmin = cmax = 0;
+    else cmax++;
+    th->col[2*t]   = cmin;
+    th->col[2*t+1] = cmax;
+    if (t) th->workoff[t+1] = th->workoff[t] + cmax - cmin;
+  }
+
+  /* inodes, used by MatMult() and MatMultAdd() when the matrix uses them */
+  th->inode = inode;
+  if (th->inode) {
+    m  = A->rmap->n;
+    ns = a->inode.size;
+    total          = (PetscInt64)a->i[m] + m;
+    th->node[0]    = 0;
+    th->noderow[0] = 0;
+    for (t=1,k=0,row=0; t<nthreads; t++) {
+      target = total*t/nthreads;
+      while (k < a->inode.node_count && (PetscInt64)a->i[row] + row < target) row += ns[k++];
+      th->node[t]    = k;
+      th->noderow[t] = row;
+    }
+    th->node[nthreads]    = a->inode.node_count;
+    th->noderow[nthreads] = m;
+  }
+  th->compressedrow = a->compressedrow.use;
+  th->nonzerostate  = A->nonzerostate;
+  th->nthreads      = nthreads;
+  ierr = PetscInfo2(A,"Products split among %D threads%s\n",nthreads,th->inode ? " by inodes" : "");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* tells if the products with A are multi-threaded, updating the partition if the structure or the pool has changed */
+PetscErrorCode MatSeqAIJUseThreads_Private(Mat A,PetscBool *flg)
+{
+  Mat_SeqAIJ        *a  = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJThreads *th = &a->threads;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJThreadsSetUp_Private(A);CHKERRQ(ierr);
+  *flg = th->nthreads ? PETSC_TRUE : PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMult_SeqAIJThreads(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  MatThreadsCtx  ctx;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ctx.op = MAT_THREADS_MULT;
+  ctx.A  = A;
+  ctx.y  = NULL;
+  ierr = VecGetArrayRead(xx,&ctx.x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&ctx.z);CHKERRQ(ierr);
+  ierr = MatSeqAIJThreadsRun_Private(&ctx);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&ctx.x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&ctx.z);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz - a->nonzerorowcnt);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMultAdd_SeqAIJThreads(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  MatThreadsCtx  ctx;
+  PetscScalar    *y;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ctx.op = MAT_THREADS_MULTADD;
+  ctx.A  = A;
+  ierr   = VecGetArrayRead(xx,&ctx.x);CHKERRQ(ierr);
+  ierr   = VecGetArrayPair(yy,zz,&y,&ctx.z);CHKERRQ(ierr);
+  ctx.y  = y;
+  ierr   = MatSeqAIJThreadsRun_Private(&ctx);CHKERRQ(ierr);
+  ierr   = VecRestoreArrayRead(xx,&ctx.x);CHKERRQ(ierr);
+  ierr   = VecRestoreArrayPair(yy,zz,&y,&ctx.z);CHKERRQ(ierr);
+  ierr   = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMultTransposeAdd_SeqAIJThreads(Mat A,Vec xx,Vec zz,Vec yy)
+{
+  Mat_SeqAIJ        *a  = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJThreads *th = &a->threads;
+  MatThreadsCtx     ctx;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (zz != yy) {ierr = VecCopy(zz,yy);CHKERRQ(ierr);}
+  if (!th->work && th->workoff[th->nthreads]) {
+    ierr = PetscMalloc1(th->workoff[th->nthreads],&th->work);CHKERRQ(ierr);
+  }
+  ctx.A = A;
+  ctx.y = NULL;
+  ierr  = VecGetArrayRead(xx,&ctx.x);CHKERRQ(ierr);
+  ierr  = VecGetArray(yy,&ctx.z);CHKERRQ(ierr);
+  ctx.op = MAT_THREADS_MULTTRANSPOSE;
+  ierr   = MatSeqAIJThreadsRun_Private(&ctx);CHKERRQ(ierr);
+  ctx.op = MAT_THREADS_SUMTRANSPOSE;
+  ierr   = MatSeqAIJThreadsRun_Private(&ctx);CHKERRQ(ierr);
+  ierr   = VecRestoreArrayRead(xx,&ctx.x);CHKERRQ(ierr);
+  ierr   = VecRestoreArray(yy,&ctx.z);CHKERRQ(ierr);
+  ierr   = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -149,6 +149,36 @@ PetscErrorCode MatMult_AIJCRL(Mat A,Vec xx,Vec yy)
 }
 
 
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJCRL_SeqAIJ(Mat A,MatType type,MatReuse reuse,Mat *newmat)
+{
+  PetscErrorCode ierr;
+  Mat            B = *newmat;
+  Mat_AIJCRL     *aijcrl;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) {
+    ierr = MatDuplicate_SeqAIJ(A,MAT_COPY_VALUES,&B);CHKERRQ(ierr);
+  }
+  aijcrl = (Mat_AIJCRL*)B->spptr;
+
+  /* Reset the original function pointers. */
+  B->ops->duplicate   = MatDuplicate_SeqAIJ;
+  B->ops->assemblyend = MatAssemblyEnd_SeqAIJ;
+  B->ops->destroy     = MatDestroy_SeqAIJ;
+  B->ops->mult        = MatMult_SeqAIJ;
+
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaijcrl_seqaij_C",NULL);CHKERRQ(ierr);
+
+  /* Free everything in the Mat_AIJCRL data structure. */
+  if (aijcrl) {
+    ierr = PetscFree2(aijcrl->acols,aijcrl->icols);CHKERRQ(ierr);
+  }
+  ierr    = PetscFree(B->spptr);CHKERRQ(ierr);
+  ierr    = PetscObjectChangeTypeName((PetscObject)B,MATSEQAIJ);CHKERRQ(ierr);
+  *newmat = B;
+  PetscFunctionReturn(0);
+}
+
 /* MatConvert_SeqAIJ_SeqAIJCRL converts a SeqAIJ matrix into a
  * SeqAIJCRL matrix.  This routine is called by the MatCreate_SeqAIJCRL()
  * routine, but can also be used to convert an assembled SeqAIJ matrix
@@ -176,6 +206,8 @@ PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJCRL(Mat A,MatType type,MatRe
   B->ops->destroy     = MatDestroy_SeqAIJCRL;
   B->ops->mult        = MatMult_AIJCRL;
 
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_seqaijcrl_seqaij_C",MatConvert_SeqAIJCRL_SeqAIJ);CHKERRQ(ierr);
+
   /* If A has already been assembled, compute the permutation. */
   if (A->assembled) {
     ierr = MatSeqAIJCRL_create_aijcrl(B);CHKERRQ(ierr);
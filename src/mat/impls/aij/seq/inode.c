@@ -373,35 +373,30 @@ static PetscErrorCode MatRestoreColumnIJ_SeqAIJ_Inode(Mat A,PetscInt oshift,Pets
 
 /* ----------------------------------------------------------- */
 
-static PetscErrorCode MatMult_SeqAIJ_Inode(Mat A,Vec xx,Vec yy)
+/*
+   Multiplies the inodes node0 to node1-1, whose first row is row0, putting the results in y[]; without
+   PetscFunctionBegin and error messages since it is also run by the threads of aijthreads.c
+*/
+PetscErrorCode MatMultInodes_SeqAIJ_Private(Mat A,PetscInt node0,PetscInt node1,PetscInt row0,const PetscScalar x[],PetscScalar y[])
 {
   Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
   PetscScalar       sum1,sum2,sum3,sum4,sum5,tmp0,tmp1;
-  PetscScalar       *y;
-  const PetscScalar *x;
   const MatScalar   *v1,*v2,*v3,*v4,*v5;
-  PetscErrorCode    ierr;
-  PetscInt          i1,i2,n,i,row,node_max,nsz,sz,nonzerorow=0;
+  PetscInt          i1,i2,n,i,row,nsz,sz;
   const PetscInt    *idx,*ns,*ii;
 
 #if defined(PETSC_HAVE_PRAGMA_DISJOINT)
 #pragma disjoint(*x,*y,*v1,*v2,*v3,*v4,*v5)
 #endif
 
-  PetscFunctionBegin;
-  if (!a->inode.size) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_COR,"Missing Inode Structure");
-  node_max = a->inode.node_count;
-  ns       = a->inode.size;     /* Node Size array */
-  ierr     = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
-  ierr     = VecGetArray(yy,&y);CHKERRQ(ierr);
-  idx      = a->j;
-  v1       = a->a;
-  ii       = a->i;
+  ns  = a->inode.size;     /* Node Size array */
+  idx = a->j + a->i[row0];
+  v1  = a->a + a->i[row0];
+  ii  = a->i + row0;
 
-  for (i = 0,row = 0; i< node_max; ++i) {
+  for (i = node0,row = row0; i< node1; ++i) {
     nsz         = ns[i];
     n           = ii[1] - ii[0];
-    nonzerorow += (n>0)*nsz;
     ii         += nsz;
     PetscPrefetchBlock(idx+nsz*n,n,0,PETSC_PREFETCH_HINT_NTA);    /* Prefetch the indices for the block row after the current one */
     PetscPrefetchBlock(v1+nsz*n,nsz*n,0,PETSC_PREFETCH_HINT_NTA); /* Prefetch the values for the block row after the current one  */
@@ -553,41 +548,54 @@ static PetscErrorCode MatMult_SeqAIJ_Inode(Mat A,Vec xx,Vec yy)
       idx    +=4*sz;
       break;
     default:
-      SETERRQ(PETSC_COMM_SELF,PETSC_ERR_COR,"Node size not yet supported");
+      return PETSC_ERR_COR;
     }
   }
+  return 0;
+}
+
+static PetscErrorCode MatMult_SeqAIJ_Inode(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar       *y;
+  const PetscScalar *x;
+  PetscBool         threads;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (!a->inode.size) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_COR,"Missing Inode Structure");
+  ierr = MatSeqAIJUseThreads_Private(A,&threads);CHKERRQ(ierr);
+  if (threads) {
+    ierr = MatMult_SeqAIJThreads(A,xx,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
+  ierr = MatMultInodes_SeqAIJ_Private(A,0,a->inode.node_count,0,x,y);
+  if (ierr) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_COR,"Node size not yet supported");
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
-  ierr = PetscLogFlops(2.0*a->nz - nonzerorow);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz - a->nonzerorowcnt);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 /* ----------------------------------------------------------- */
-/* Almost same code as the MatMult_SeqAIJ_Inode() */
-static PetscErrorCode MatMultAdd_SeqAIJ_Inode(Mat A,Vec xx,Vec zz,Vec yy)
+/* Almost same code as the MatMultInodes_SeqAIJ_Private(), y[] and z[] may be the same array */
+PetscErrorCode MatMultAddInodes_SeqAIJ_Private(Mat A,PetscInt node0,PetscInt node1,PetscInt row0,const PetscScalar x[],const PetscScalar z[],PetscScalar y[])
 {
   Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
   PetscScalar       sum1,sum2,sum3,sum4,sum5,tmp0,tmp1;
   const MatScalar   *v1,*v2,*v3,*v4,*v5;
-  const PetscScalar *x;
-  PetscScalar       *y,*z,*zt;
-  PetscErrorCode    ierr;
-  PetscInt          i1,i2,n,i,row,node_max,nsz,sz;
+  const PetscScalar *zt;
+  PetscInt          i1,i2,n,i,row,nsz,sz;
   const PetscInt    *idx,*ns,*ii;
 
-  PetscFunctionBegin;
-  if (!a->inode.size) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_COR,"Missing Inode Structure");
-  node_max = a->inode.node_count;
-  ns       = a->inode.size;     /* Node Size array */
+  ns  = a->inode.size;     /* Node Size array */
+  zt  = z + row0;
+  idx = a->j + a->i[row0];
+  v1  = a->a + a->i[row0];
+  ii  = a->i + row0;
 
-  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
-  ierr = VecGetArrayPair(zz,yy,&z,&y);CHKERRQ(ierr);
-  zt = z;
-
-  idx = a->j;
-  v1  = a->a;
-  ii  = a->i;
-
-  for (i = 0,row = 0; i< node_max; ++i) {
+  for (i = node0,row = row0; i< node1; ++i) {
     nsz = ns[i];
     n   = ii[1] - ii[0];
     ii += nsz;
@@ -739,9 +747,31 @@ static PetscErrorCode MatMultAdd_SeqAIJ_Inode(Mat A,Vec xx,Vec zz,Vec yy)
       idx    +=4*sz;
       break;
     default:
-      SETERRQ(PETSC_COMM_SELF,PETSC_ERR_COR,"Node size not yet supported");
+      return PETSC_ERR_COR;
     }
   }
+  return 0;
+}
+
+static PetscErrorCode MatMultAdd_SeqAIJ_Inode(Mat A,Vec xx,Vec zz,Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  const PetscScalar *x;
+  PetscScalar       *y,*z;
+  PetscBool         threads;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (!a->inode.size) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_COR,"Missing Inode Structure");
+  ierr = MatSeqAIJUseThreads_Private(A,&threads);CHKERRQ(ierr);
+  if (threads) {
+    ierr = MatMultAdd_SeqAIJThreads(A,xx,zz,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayPair(zz,yy,&z,&y);CHKERRQ(ierr);
+  ierr = MatMultAddInodes_SeqAIJ_Private(A,0,a->inode.node_count,0,x,z,y);
+  if (ierr) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_COR,"Node size not yet supported");
   ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecRestoreArrayPair(zz,yy,&z,&y);CHKERRQ(ierr);
   ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
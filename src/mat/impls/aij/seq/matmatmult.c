@@ -535,7 +535,8 @@ PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Heap(Mat A,Mat B,PetscReal fill,
   current_space = free_space;
 
   ierr = PetscHeapCreate(a->rmax,&h);CHKERRQ(ierr);
-  ierr = PetscMalloc1(a->rmax,&bb);CHKERRQ(ierr);
+  ierr = PetscMallocArenaPush(a->rmax*sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = PetscMallocArena1(a->rmax,&bb);CHKERRQ(ierr);
 
   /* Determine ci and cj */
   for (i=0; i<am; i++) {
@@ -575,7 +576,7 @@ PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Heap(Mat A,Mat B,PetscReal fill,
       ierr = PetscHeapPop(h,&j,&col);CHKERRQ(ierr);
     }
   }
-  ierr = PetscFree(bb);CHKERRQ(ierr);
+  ierr = PetscMallocArenaPop();CHKERRQ(ierr);
   ierr = PetscHeapDestroy(&h);CHKERRQ(ierr);
 
   /* Column indices are in the list of free space */
@@ -644,7 +645,8 @@ PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_BTHeap(Mat A,Mat B,PetscReal fil
   current_space = free_space;
 
   ierr = PetscHeapCreate(a->rmax,&h);CHKERRQ(ierr);
-  ierr = PetscMalloc1(a->rmax,&bb);CHKERRQ(ierr);
+  ierr = PetscMallocArenaPush(a->rmax*sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = PetscMallocArena1(a->rmax,&bb);CHKERRQ(ierr);
   ierr = PetscBTCreate(bn,&bt);CHKERRQ(ierr);
 
   /* Determine ci and cj */
@@ -695,7 +697,7 @@ PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_BTHeap(Mat A,Mat B,PetscReal fil
       ierr = PetscBTMemzero(bn,bt);CHKERRQ(ierr);
     }
   }
-  ierr = PetscFree(bb);CHKERRQ(ierr);
+  ierr = PetscMallocArenaPop();CHKERRQ(ierr);
   ierr = PetscHeapDestroy(&h);CHKERRQ(ierr);
   ierr = PetscBTDestroy(&bt);CHKERRQ(ierr);
 
@@ -1024,8 +1026,8 @@ PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ(Mat A,Mat B,PetscReal fill,Mat *
   /* Initial FreeSpace size is fill*(nnz(A)+nnz(B)) */
   ierr = PetscSegBufferCreate(sizeof(PetscInt),(PetscInt)(fill*(ai[am]+bi[bm])),&seg);CHKERRQ(ierr);
   ierr = PetscSegBufferCreate(sizeof(PetscInt),100,&segrow);CHKERRQ(ierr);
-  ierr = PetscMalloc1(bn,&seen);CHKERRQ(ierr);
-  ierr = PetscMemzero(seen,bn*sizeof(char));CHKERRQ(ierr);
+  ierr = PetscMallocArenaPush(bn*sizeof(char));CHKERRQ(ierr);
+  ierr = PetscCallocArena1(bn,&seen);CHKERRQ(ierr);
 
   /* Determine ci and cj */
   for (i=0; i<am; i++) {
@@ -1053,7 +1055,7 @@ PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ(Mat A,Mat B,PetscReal fill,Mat *
     for (j=0; j<packlen; j++) seen[crow[j]] = 0;
   }
   ierr = PetscSegBufferDestroy(&segrow);CHKERRQ(ierr);
-  ierr = PetscFree(seen);CHKERRQ(ierr);
+  ierr = PetscMallocArenaPop();CHKERRQ(ierr);
 
   /* Column indices are in the segmented buffer */
   ierr = PetscSegBufferExtractAlloc(seg,&cj);CHKERRQ(ierr);
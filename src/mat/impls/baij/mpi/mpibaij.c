@@ -3411,18 +3411,15 @@ static PetscErrorCode MatDuplicate_MPIBAIJ(Mat matin,MatDuplicateOption cpvalues
 PetscErrorCode MatLoad_MPIBAIJ(Mat newmat,PetscViewer viewer)
 {
   PetscErrorCode ierr;
-  int            fd;
   PetscInt       i,nz,j,rstart,rend;
   PetscScalar    *vals,*buf;
   MPI_Comm       comm;
-  MPI_Status     status;
-  PetscMPIInt    rank,size,maxnz;
-  PetscInt       header[4],*rowlengths = 0,M,N,m,*rowners,*cols;
-  PetscInt       *locrowlens = NULL,*procsnz = NULL,*browners = NULL;
-  PetscInt       jj,*mycols,*ibuf,bs = newmat->rmap->bs,Mbs,mbs,extra_rows,mmax;
-  PetscMPIInt    tag    = ((PetscObject)viewer)->tag;
+  PetscMPIInt    rank,size;
+  PetscInt       header[4],M,N,m,*rowners;
+  PetscInt       *locrowlens = NULL,*browners = NULL;
+  PetscInt       jj,*mycols,*ibuf,bs = newmat->rmap->bs,Mbs,mbs,extra_rows;
   PetscInt       *dlens = NULL,*odlens = NULL,*mask = NULL,*masked1 = NULL,*masked2 = NULL,rowcount,odcount;
-  PetscInt       dcount,kmax,k,nzcount,tmp,mend;
+  PetscInt       dcount,kmax,k,nzcount,tmp,mend,nzend;
 
   PetscFunctionBegin;
   /* force binary viewer to load .info file if it has not yet done so */
@@ -3435,13 +3432,9 @@ PetscErrorCode MatLoad_MPIBAIJ(Mat newmat,PetscViewer viewer)
 
   ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
   ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
-  ierr = PetscViewerBinaryGetDescriptor(viewer,&fd);CHKERRQ(ierr);
-  if (!rank) {
-    ierr = PetscBinaryRead(fd,(char*)header,4,PETSC_INT);CHKERRQ(ierr);
-    if (header[0] != MAT_FILE_CLASSID) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"not matrix object");
-    if (header[3] < 0) SETERRQ(PetscObjectComm((PetscObject)newmat),PETSC_ERR_FILE_UNEXPECTED,"Matrix stored in special format on disk, cannot load as MPIAIJ");
-  }
-  ierr = MPI_Bcast(header+1,3,MPIU_INT,0,comm);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryRead(viewer,header,4,NULL,PETSC_INT);CHKERRQ(ierr);
+  if (header[0] != MAT_FILE_CLASSID) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"not matrix object");
+  if (header[3] < 0) SETERRQ(PetscObjectComm((PetscObject)newmat),PETSC_ERR_FILE_UNEXPECTED,"Matrix stored in special format on disk, cannot load as MPIAIJ");
   M    = header[1]; N = header[2];
 
   /* If global sizes are set, check if they are consistent with that given in the file */
@@ -3473,94 +3466,29 @@ PetscErrorCode MatLoad_MPIBAIJ(Mat newmat,PetscViewer viewer)
   ierr = PetscMalloc2(size+1,&rowners,size+1,&browners);CHKERRQ(ierr);
   ierr = MPI_Allgather(&mbs,1,MPIU_INT,rowners+1,1,MPIU_INT,comm);CHKERRQ(ierr);
 
-  /* process 0 needs enough room for process with most rows */
-  if (!rank) {
-    mmax = rowners[1];
-    for (i=2; i<=size; i++) {
-      mmax = PetscMax(mmax,rowners[i]);
-    }
-    mmax*=bs;
-  } else mmax = -1;             /* unused, but compiler warns anyway */
-
   rowners[0] = 0;
   for (i=2; i<=size; i++) rowners[i] += rowners[i-1];
   for (i=0; i<=size; i++) browners[i] = rowners[i]*bs;
   rstart = rowners[rank];
   rend   = rowners[rank+1];
 
-  /* distribute row lengths to all processors */
+  /* each process reads the row lengths of its own rows; the padding rows of the last process are not on the disk */
   ierr = PetscMalloc1(m,&locrowlens);CHKERRQ(ierr);
-  if (!rank) {
-    mend = m;
-    if (size == 1) mend = mend - extra_rows;
-    ierr = PetscBinaryRead(fd,locrowlens,mend,PETSC_INT);CHKERRQ(ierr);
-    for (j=mend; j<m; j++) locrowlens[j] = 1;
-    ierr = PetscMalloc1(mmax,&rowlengths);CHKERRQ(ierr);
-    ierr = PetscCalloc1(size,&procsnz);CHKERRQ(ierr);
-    for (j=0; j<m; j++) {
-      procsnz[0] += locrowlens[j];
-    }
-    for (i=1; i<size; i++) {
-      mend = browners[i+1] - browners[i];
-      if (i == size-1) mend = mend - extra_rows;
-      ierr = PetscBinaryRead(fd,rowlengths,mend,PETSC_INT);CHKERRQ(ierr);
-      for (j=mend; j<browners[i+1] - browners[i]; j++) rowlengths[j] = 1;
-      /* calculate the number of nonzeros on each processor */
-      for (j=0; j<browners[i+1]-browners[i]; j++) {
-        procsnz[i] += rowlengths[j];
-      }
-      ierr = MPI_Send(rowlengths,browners[i+1]-browners[i],MPIU_INT,i,tag,comm);CHKERRQ(ierr);
-    }
-    ierr = PetscFree(rowlengths);CHKERRQ(ierr);
-  } else {
-    ierr = MPI_Recv(locrowlens,m,MPIU_INT,0,tag,comm,&status);CHKERRQ(ierr);
-  }
+  mend = m;
+  if (rank == size-1) mend -= extra_rows;
+  ierr = PetscViewerBinaryReadAll(viewer,locrowlens,mend,browners[rank],M,PETSC_INT);CHKERRQ(ierr);
+  for (j=mend; j<m; j++) locrowlens[j] = 1;
 
-  if (!rank) {
-    /* determine max buffer needed and allocate it */
-    maxnz = procsnz[0];
-    for (i=1; i<size; i++) {
-      maxnz = PetscMax(maxnz,procsnz[i]);
-    }
-    ierr = PetscMalloc1(maxnz,&cols);CHKERRQ(ierr);
-
-    /* read in my part of the matrix column indices  */
-    nz     = procsnz[0];
-    ierr   = PetscMalloc1(nz+1,&ibuf);CHKERRQ(ierr);
-    mycols = ibuf;
-    if (size == 1) nz -= extra_rows;
-    ierr = PetscBinaryRead(fd,mycols,nz,PETSC_INT);CHKERRQ(ierr);
-    if (size == 1) {
-      for (i=0; i< extra_rows; i++) mycols[nz+i] = M+i;
-    }
-
-    /* read in every ones (except the last) and ship off */
-    for (i=1; i<size-1; i++) {
-      nz   = procsnz[i];
-      ierr = PetscBinaryRead(fd,cols,nz,PETSC_INT);CHKERRQ(ierr);
-      ierr = MPI_Send(cols,nz,MPIU_INT,i,tag,comm);CHKERRQ(ierr);
-    }
-    /* read in the stuff for the last proc */
-    if (size != 1) {
-      nz   = procsnz[size-1] - extra_rows;  /* the extra rows are not on the disk */
-      ierr = PetscBinaryRead(fd,cols,nz,PETSC_INT);CHKERRQ(ierr);
-      for (i=0; i<extra_rows; i++) cols[nz+i] = M+i;
-      ierr = MPI_Send(cols,nz+extra_rows,MPIU_INT,size-1,tag,comm);CHKERRQ(ierr);
-    }
-    ierr = PetscFree(cols);CHKERRQ(ierr);
-  } else {
-    /* determine buffer space needed for message */
-    nz = 0;
-    for (i=0; i<m; i++) {
-      nz += locrowlens[i];
-    }
-    ierr   = PetscMalloc1(nz+1,&ibuf);CHKERRQ(ierr);
-    mycols = ibuf;
-    /* receive message of column indices*/
-    ierr = MPI_Recv(mycols,nz,MPIU_INT,0,tag,comm,&status);CHKERRQ(ierr);
-    ierr = MPI_Get_count(&status,MPIU_INT,&maxnz);CHKERRQ(ierr);
-    if (maxnz != nz) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"something is wrong with file");
+  /* read in my part of the matrix column indices */
+  nz = 0;
+  for (i=0; i<m; i++) {
+    nz += locrowlens[i];
   }
+  nzend  = nz - (m - mend);
+  ierr   = PetscMalloc1(nz+1,&ibuf);CHKERRQ(ierr);
+  mycols = ibuf;
+  ierr   = PetscViewerBinaryReadAll(viewer,mycols,nzend,PETSC_DETERMINE,header[3],PETSC_INT);CHKERRQ(ierr);
+  for (i=0; i<m-mend; i++) mycols[nzend+i] = M+i;
 
   /* loop over local rows, determining number of off diagonal entries */
   ierr     = PetscMalloc2(rend-rstart,&dlens,rend-rstart,&odlens);CHKERRQ(ierr);
@@ -3593,60 +3521,21 @@ PetscErrorCode MatLoad_MPIBAIJ(Mat newmat,PetscViewer viewer)
   ierr = MatSetSizes(newmat,m,m,M+extra_rows,N+extra_rows);CHKERRQ(ierr);
   ierr = MatMPIBAIJSetPreallocation(newmat,bs,0,dlens,0,odlens);CHKERRQ(ierr);
 
-  if (!rank) {
-    ierr = PetscMalloc1(maxnz+1,&buf);CHKERRQ(ierr);
-    /* read in my part of the matrix numerical values  */
-    nz     = procsnz[0];
-    vals   = buf;
-    mycols = ibuf;
-    if (size == 1) nz -= extra_rows;
-    ierr = PetscBinaryRead(fd,vals,nz,PETSC_SCALAR);CHKERRQ(ierr);
-    if (size == 1) {
-      for (i=0; i< extra_rows; i++) vals[nz+i] = 1.0;
-    }
-
-    /* insert into matrix */
-    jj = rstart*bs;
-    for (i=0; i<m; i++) {
-      ierr    = MatSetValues_MPIBAIJ(newmat,1,&jj,locrowlens[i],mycols,vals,INSERT_VALUES);CHKERRQ(ierr);
-      mycols += locrowlens[i];
-      vals   += locrowlens[i];
-      jj++;
-    }
-    /* read in other processors (except the last one) and ship out */
-    for (i=1; i<size-1; i++) {
-      nz   = procsnz[i];
-      vals = buf;
-      ierr = PetscBinaryRead(fd,vals,nz,PETSC_SCALAR);CHKERRQ(ierr);
-      ierr = MPIULong_Send(vals,nz,MPIU_SCALAR,i,((PetscObject)newmat)->tag,comm);CHKERRQ(ierr);
-    }
-    /* the last proc */
-    if (size != 1) {
-      nz   = procsnz[i] - extra_rows;
-      vals = buf;
-      ierr = PetscBinaryRead(fd,vals,nz,PETSC_SCALAR);CHKERRQ(ierr);
-      for (i=0; i<extra_rows; i++) vals[nz+i] = 1.0;
-      ierr = MPIULong_Send(vals,nz+extra_rows,MPIU_SCALAR,size-1,((PetscObject)newmat)->tag,comm);CHKERRQ(ierr);
-    }
-    ierr = PetscFree(procsnz);CHKERRQ(ierr);
-  } else {
-    /* receive numeric values */
-    ierr = PetscMalloc1(nz+1,&buf);CHKERRQ(ierr);
-
-    /* receive message of values*/
-    vals   = buf;
-    mycols = ibuf;
-    ierr   = MPIULong_Recv(vals,nz,MPIU_SCALAR,0,((PetscObject)newmat)->tag,comm);CHKERRQ(ierr);
+  /* read in my part of the matrix numerical values */
+  ierr = PetscMalloc1(nz+1,&buf);CHKERRQ(ierr);
+  vals = buf;
+  ierr = PetscViewerBinaryReadAll(viewer,vals,nzend,PETSC_DETERMINE,header[3],PETSC_SCALAR);CHKERRQ(ierr);
+  for (i=0; i<m-mend; i++) vals[nzend+i] = 1.0;
 
-    /* insert into matrix */
-    jj = rstart*bs;
-    for (i=0; i<m; i++) {
-      ierr    = MatSetValues_MPIBAIJ(newmat,1,&jj,locrowlens[i],mycols,vals,INSERT_VALUES);CHKERRQ(ierr);
-      mycols += locrowlens[i];
-      vals   += locrowlens[i];
-      jj++;
-    }
+  /* insert into matrix */
+  jj = rstart*bs;
+  for (i=0; i<m; i++) {
+    ierr    = MatSetValues_MPIBAIJ(newmat,1,&jj,locrowlens[i],mycols,vals,INSERT_VALUES);CHKERRQ(ierr);
+    mycols += locrowlens[i];
+    vals   += locrowlens[i];
+    jj++;
   }
+
   ierr = PetscFree(locrowlens);CHKERRQ(ierr);
   ierr = PetscFree(buf);CHKERRQ(ierr);
   ierr = PetscFree(ibuf);CHKERRQ(ierr);
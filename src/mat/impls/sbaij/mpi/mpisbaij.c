@@ -2628,14 +2628,12 @@ PetscErrorCode MatLoad_MPISBAIJ(Mat newmat,PetscViewer viewer)
   PetscInt       i,nz,j,rstart,rend;
   PetscScalar    *vals,*buf;
   MPI_Comm       comm;
-  MPI_Status     status;
-  PetscMPIInt    rank,size,tag = ((PetscObject)viewer)->tag,*sndcounts = 0,*browners,maxnz,*rowners,mmbs;
-  PetscInt       header[4],*rowlengths = 0,M,N,m,*cols,*locrowlens;
-  PetscInt       *procsnz = 0,jj,*mycols,*ibuf;
-  PetscInt       bs = newmat->rmap->bs,Mbs,mbs,extra_rows;
+  PetscMPIInt    rank,size,*browners,*rowners,mmbs;
+  PetscInt       header[4],M,N,m,*locrowlens;
+  PetscInt       jj,*mycols,*ibuf;
+  PetscInt       bs = newmat->rmap->bs,Mbs,mbs,extra_rows,mend,nzend;
   PetscInt       *dlens,*odlens,*mask,*masked1,*masked2,rowcount,odcount;
   PetscInt       dcount,kmax,k,nzcount,tmp;
-  int            fd;
 
   PetscFunctionBegin;
   /* force binary viewer to load .info file if it has not yet done so */
@@ -2648,14 +2646,9 @@ PetscErrorCode MatLoad_MPISBAIJ(Mat newmat,PetscViewer viewer)
 
   ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
   ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
-  ierr = PetscViewerBinaryGetDescriptor(viewer,&fd);CHKERRQ(ierr);
-  if (!rank) {
-    ierr = PetscBinaryRead(fd,(char*)header,4,PETSC_INT);CHKERRQ(ierr);
-    if (header[0] != MAT_FILE_CLASSID) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"not matrix object");
-    if (header[3] < 0) SETERRQ(PetscObjectComm((PetscObject)newmat),PETSC_ERR_FILE_UNEXPECTED,"Matrix stored in special format, cannot load as MPISBAIJ");
-  }
-
-  ierr = MPI_Bcast(header+1,3,MPIU_INT,0,comm);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryRead(viewer,header,4,NULL,PETSC_INT);CHKERRQ(ierr);
+  if (header[0] != MAT_FILE_CLASSID) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"not matrix object");
+  if (header[3] < 0) SETERRQ(PetscObjectComm((PetscObject)newmat),PETSC_ERR_FILE_UNEXPECTED,"Matrix stored in special format, cannot load as MPISBAIJ");
   M    = header[1];
   N    = header[2];
 
@@ -2694,73 +2687,23 @@ PetscErrorCode MatLoad_MPISBAIJ(Mat newmat,PetscViewer viewer)
   rstart = rowners[rank];
   rend   = rowners[rank+1];
 
-  /* distribute row lengths to all processors */
-  ierr = PetscMalloc1((rend-rstart)*bs,&locrowlens);CHKERRQ(ierr);
-  if (!rank) {
-    ierr = PetscMalloc1(M+extra_rows,&rowlengths);CHKERRQ(ierr);
-    ierr = PetscBinaryRead(fd,rowlengths,M,PETSC_INT);CHKERRQ(ierr);
-    for (i=0; i<extra_rows; i++) rowlengths[M+i] = 1;
-    ierr = PetscMalloc1(size,&sndcounts);CHKERRQ(ierr);
-    for (i=0; i<size; i++) sndcounts[i] = browners[i+1] - browners[i];
-    ierr = MPI_Scatterv(rowlengths,sndcounts,browners,MPIU_INT,locrowlens,(rend-rstart)*bs,MPIU_INT,0,comm);CHKERRQ(ierr);
-    ierr = PetscFree(sndcounts);CHKERRQ(ierr);
-  } else {
-    ierr = MPI_Scatterv(0,0,0,MPIU_INT,locrowlens,(rend-rstart)*bs,MPIU_INT,0,comm);CHKERRQ(ierr);
-  }
-
-  if (!rank) {   /* procs[0] */
-    /* calculate the number of nonzeros on each processor */
-    ierr = PetscMalloc1(size,&procsnz);CHKERRQ(ierr);
-    ierr = PetscMemzero(procsnz,size*sizeof(PetscInt));CHKERRQ(ierr);
-    for (i=0; i<size; i++) {
-      for (j=rowners[i]*bs; j< rowners[i+1]*bs; j++) {
-        procsnz[i] += rowlengths[j];
-      }
-    }
-    ierr = PetscFree(rowlengths);CHKERRQ(ierr);
-
-    /* determine max buffer needed and allocate it */
-    maxnz = 0;
-    for (i=0; i<size; i++) {
-      maxnz = PetscMax(maxnz,procsnz[i]);
-    }
-    ierr = PetscMalloc1(maxnz,&cols);CHKERRQ(ierr);
-
-    /* read in my part of the matrix column indices  */
-    nz     = procsnz[0];
-    ierr   = PetscMalloc1(nz,&ibuf);CHKERRQ(ierr);
-    mycols = ibuf;
-    if (size == 1) nz -= extra_rows;
-    ierr = PetscBinaryRead(fd,mycols,nz,PETSC_INT);CHKERRQ(ierr);
-    if (size == 1) {
-      for (i=0; i< extra_rows; i++) mycols[nz+i] = M+i;
-    }
+  /* each process reads the row lengths of its own rows; the padding rows of the last process are not on the disk */
+  ierr = PetscMalloc1(m,&locrowlens);CHKERRQ(ierr);
+  mend = m;
+  if (rank == size-1) mend -= extra_rows;
+  ierr = PetscViewerBinaryReadAll(viewer,locrowlens,mend,browners[rank],M,PETSC_INT);CHKERRQ(ierr);
+  for (j=mend; j<m; j++) locrowlens[j] = 1;
 
-    /* read in every ones (except the last) and ship off */
-    for (i=1; i<size-1; i++) {
-      nz   = procsnz[i];
-      ierr = PetscBinaryRead(fd,cols,nz,PETSC_INT);CHKERRQ(ierr);
-      ierr = MPI_Send(cols,nz,MPIU_INT,i,tag,comm);CHKERRQ(ierr);
-    }
-    /* read in the stuff for the last proc */
-    if (size != 1) {
-      nz   = procsnz[size-1] - extra_rows;  /* the extra rows are not on the disk */
-      ierr = PetscBinaryRead(fd,cols,nz,PETSC_INT);CHKERRQ(ierr);
-      for (i=0; i<extra_rows; i++) cols[nz+i] = M+i;
-      ierr = MPI_Send(cols,nz+extra_rows,MPIU_INT,size-1,tag,comm);CHKERRQ(ierr);
-    }
-    ierr = PetscFree(cols);CHKERRQ(ierr);
-  } else {  /* procs[i], i>0 */
-    /* determine buffer space needed for message */
-    nz = 0;
-    for (i=0; i<m; i++) nz += locrowlens[i];
-    ierr   = PetscMalloc1(nz,&ibuf);CHKERRQ(ierr);
-    mycols = ibuf;
-    /* receive message of column indices*/
-    ierr = MPI_Recv(mycols,nz,MPIU_INT,0,tag,comm,&status);CHKERRQ(ierr);
-    ierr = MPI_Get_count(&status,MPIU_INT,&maxnz);CHKERRQ(ierr);
-    if (maxnz != nz) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"something is wrong with file");
+  /* read in my part of the matrix column indices */
+  nz = 0;
+  for (i=0; i<m; i++) {
+    nz += locrowlens[i];
   }
+  nzend  = nz - (m - mend);
+  ierr   = PetscMalloc1(nz+1,&ibuf);CHKERRQ(ierr);
+  mycols = ibuf;
+  ierr   = PetscViewerBinaryReadAll(viewer,mycols,nzend,PETSC_DETERMINE,header[3],PETSC_INT);CHKERRQ(ierr);
+  for (i=0; i<m-mend; i++) mycols[nzend+i] = M+i;
 
   /* loop over local rows, determining number of off diagonal entries */
   ierr     = PetscMalloc2(rend-rstart,&dlens,rend-rstart,&odlens);CHKERRQ(ierr);
@@ -2797,63 +2740,19 @@ PetscErrorCode MatLoad_MPISBAIJ(Mat newmat,PetscViewer viewer)
   ierr = MatMPISBAIJSetPreallocation(newmat,bs,0,dlens,0,odlens);CHKERRQ(ierr);
   ierr = MatSetOption(newmat,MAT_IGNORE_LOWER_TRIANGULAR,PETSC_TRUE);CHKERRQ(ierr);
 
-  if (!rank) {
-    ierr = PetscMalloc1(maxnz,&buf);CHKERRQ(ierr);
-    /* read in my part of the matrix numerical values  */
-    nz     = procsnz[0];
-    vals   = buf;
-    mycols = ibuf;
-    if (size == 1) nz -= extra_rows;
-    ierr = PetscBinaryRead(fd,vals,nz,PETSC_SCALAR);CHKERRQ(ierr);
-    if (size == 1) {
-      for (i=0; i< extra_rows; i++) vals[nz+i] = 1.0;
-    }
-
-    /* insert into matrix */
-    jj = rstart*bs;
-    for (i=0; i<m; i++) {
-      ierr    = MatSetValues(newmat,1,&jj,locrowlens[i],mycols,vals,INSERT_VALUES);CHKERRQ(ierr);
-      mycols += locrowlens[i];
-      vals   += locrowlens[i];
-      jj++;
-    }
+  /* read in my part of the matrix numerical values */
+  ierr = PetscMalloc1(nz+1,&buf);CHKERRQ(ierr);
+  vals = buf;
+  ierr = PetscViewerBinaryReadAll(viewer,vals,nzend,PETSC_DETERMINE,header[3],PETSC_SCALAR);CHKERRQ(ierr);
+  for (i=0; i<m-mend; i++) vals[nzend+i] = 1.0;
 
-    /* read in other processors (except the last one) and ship out */
-    for (i=1; i<size-1; i++) {
-      nz   = procsnz[i];
-      vals = buf;
-      ierr = PetscBinaryRead(fd,vals,nz,PETSC_SCALAR);CHKERRQ(ierr);
-      ierr = MPI_Send(vals,nz,MPIU_SCALAR,i,((PetscObject)newmat)->tag,comm);CHKERRQ(ierr);
-    }
-    /* the last proc */
-    if (size != 1) {
-      nz   = procsnz[i] - extra_rows;
-      vals = buf;
-      ierr = PetscBinaryRead(fd,vals,nz,PETSC_SCALAR);CHKERRQ(ierr);
-      for (i=0; i<extra_rows; i++) vals[nz+i] = 1.0;
-      ierr = MPI_Send(vals,nz+extra_rows,MPIU_SCALAR,size-1,((PetscObject)newmat)->tag,comm);CHKERRQ(ierr);
-    }
-    ierr = PetscFree(procsnz);CHKERRQ(ierr);
-
-  } else {
-    /* receive numeric values */
-    ierr = PetscMalloc1(nz,&buf);CHKERRQ(ierr);
-
-    /* receive message of values*/
-    vals   = buf;
-    mycols = ibuf;
-    ierr   = MPI_Recv(vals,nz,MPIU_SCALAR,0,((PetscObject)newmat)->tag,comm,&status);CHKERRQ(ierr);
-    ierr   = MPI_Get_count(&status,MPIU_SCALAR,&maxnz);CHKERRQ(ierr);
-    if (maxnz != nz) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"something is wrong with file");
-
-    /* insert into matrix */
-    jj = rstart*bs;
-    for (i=0; i<m; i++) {
-      ierr    = MatSetValues_MPISBAIJ(newmat,1,&jj,locrowlens[i],mycols,vals,INSERT_VALUES);CHKERRQ(ierr);
-      mycols += locrowlens[i];
-      vals   += locrowlens[i];
-      jj++;
-    }
+  /* insert into matrix */
+  jj = rstart*bs;
+  for (i=0; i<m; i++) {
+    ierr    = MatSetValues_MPISBAIJ(newmat,1,&jj,locrowlens[i],mycols,vals,INSERT_VALUES);CHKERRQ(ierr);
+    mycols += locrowlens[i];
+    vals   += locrowlens[i];
+    jj++;
   }
 
   ierr = PetscFree(locrowlens);CHKERRQ(ierr);
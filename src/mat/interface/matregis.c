@@ -26,6 +26,12 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJPERM(Mat);
 
 PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJSELL(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJSELL(Mat);
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJMergePath(Mat);
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJOffset(Mat);
+#if !defined(PETSC_USE_COMPLEX)
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJFloat(Mat);
+PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJFloat(Mat);
+#endif
 
 #if defined PETSC_HAVE_MKL_SPARSE
 PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJMKL(Mat);
@@ -108,6 +114,15 @@ PetscErrorCode  MatRegisterAll(void)
   ierr = MatRegister(MATMPIAIJSELL,     MatCreate_MPIAIJSELL);CHKERRQ(ierr);
   ierr = MatRegister(MATSEQAIJSELL,     MatCreate_SeqAIJSELL);CHKERRQ(ierr);
 
+  ierr = MatRegister(MATSEQAIJMERGEPATH,MatCreate_SeqAIJMergePath);CHKERRQ(ierr);
+  ierr = MatRegister(MATSEQAIJOFFSET,   MatCreate_SeqAIJOffset);CHKERRQ(ierr);
+
+#if !defined(PETSC_USE_COMPLEX)
+  ierr = MatRegisterRootName(MATAIJFLOAT,MATSEQAIJFLOAT,MATMPIAIJFLOAT);CHKERRQ(ierr);
+  ierr = MatRegister(MATMPIAIJFLOAT,    MatCreate_MPIAIJFloat);CHKERRQ(ierr);
+  ierr = MatRegister(MATSEQAIJFLOAT,    MatCreate_SeqAIJFloat);CHKERRQ(ierr);
+#endif
+
 #if defined PETSC_HAVE_MKL_SPARSE
   ierr = MatRegisterRootName(MATAIJMKL, MATSEQAIJMKL,MATMPIAIJMKL);CHKERRQ(ierr);
   ierr = MatRegister(MATMPIAIJMKL,      MatCreate_MPIAIJMKL);CHKERRQ(ierr);
@@ -34,7 +34,7 @@ PetscLogEvent MAT_Applypapt, MAT_Applypapt_numeric, MAT_Applypapt_symbolic, MAT_
 PetscLogEvent MAT_GetMultiProcBlock;
 PetscLogEvent MAT_CUSPARSECopyToGPU, MAT_SetValuesBatch;
 PetscLogEvent MAT_ViennaCLCopyToGPU;
-PetscLogEvent MAT_Merge,MAT_Residual,MAT_SetRandom;
+PetscLogEvent MAT_Merge,MAT_Residual,MAT_SetRandom,MAT_Autotune;
 PetscLogEvent MATCOLORING_Apply,MATCOLORING_Comm,MATCOLORING_Local,MATCOLORING_ISCreate,MATCOLORING_SetUp,MATCOLORING_Weights;
 
 const char *const MatFactorTypes[] = {"NONE","LU","CHOLESKY","ILU","ICC","ILUDT","MatFactorType","MAT_FACTOR_",0};
@@ -995,9 +995,11 @@ PetscErrorCode MatView(Mat mat,PetscViewer viewer)
   if (size == 1 && format == PETSC_VIEWER_LOAD_BALANCE) PetscFunctionReturn(0);
   ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERBINARY,&ibinary);CHKERRQ(ierr);
   if (ibinary) {
-    PetscBool mpiio;
+    PetscBool mpiio,isseqaij,ismpiaij;
     ierr = PetscViewerBinaryGetUseMPIIO(viewer,&mpiio);CHKERRQ(ierr);
-    if (mpiio) SETERRQ(PetscObjectComm((PetscObject)viewer),PETSC_ERR_SUP,"PETSc matrix viewers do not support using MPI-IO, turn off that flag");
+    ierr = PetscObjectBaseTypeCompare((PetscObject)mat,MATSEQAIJ,&isseqaij);CHKERRQ(ierr);
+    ierr = PetscObjectBaseTypeCompare((PetscObject)mat,MATMPIAIJ,&ismpiaij);CHKERRQ(ierr);
+    if (mpiio && !isseqaij && !ismpiaij) SETERRQ(PetscObjectComm((PetscObject)viewer),PETSC_ERR_SUP,"Only MATSEQAIJ and MATMPIAIJ matrix viewers support using MPI-IO, turn off that flag");
   }
 
   ierr = PetscLogEventBegin(MAT_View,mat,viewer,0,0);CHKERRQ(ierr);
@@ -5361,6 +5363,10 @@ PetscErrorCode MatAssemblyEnd(Mat mat,MatAssemblyType type)
     mat->valid_GPU_matrix = PETSC_OFFLOAD_CPU;
   }
 #endif
+  /* with -mat_seqaij_autotune, also for the blocks of parallel matrices */
+  if (type == MAT_FINAL_ASSEMBLY) {
+    ierr = PetscTryMethod(mat,"MatSeqAIJAutotune_C",(Mat),(mat));CHKERRQ(ierr);
+  }
   if (inassm == 1 && type != MAT_FLUSH_ASSEMBLY) {
     ierr = MatViewFromOptions(mat,NULL,"-mat_view");CHKERRQ(ierr);
 
@@ -7,6 +7,12 @@
 #if defined(PETSC_HAVE_IO_H)
 #include <io.h>
 #endif
+#if defined(PETSC_HAVE_MMAP)
+#include <sys/mman.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#endif
 
 typedef struct  {
   int           fdes;                 /* file descriptor, ignored if using MPI IO */
@@ -27,6 +33,8 @@ typedef struct  {
   PetscBool     skipheader;           /* don't write header, only raw data */
   PetscBool     matlabheaderwritten;  /* if format is PETSC_VIEWER_BINARY_MATLAB has the MATLAB .info header been written yet */
   PetscBool     setfromoptionscalled;
+  PetscBool     usemmap;              /* let PetscViewerBinaryReadMapped() return pointers into a mapping of the file */
+  PetscContainer mapping;             /* private mapping of the whole file, created on first use */
 } PetscViewer_Binary;
 
 static PetscErrorCode PetscViewerGetSubViewer_Binary(PetscViewer viewer,MPI_Comm comm,PetscViewer *outviewer)
@@ -44,6 +52,8 @@ static PetscErrorCode PetscViewerGetSubViewer_Binary(PetscViewer viewer,MPI_Comm
     ierr = PetscViewerCreate(PETSC_COMM_SELF,outviewer);CHKERRQ(ierr);
     ierr = PetscViewerSetType(*outviewer,PETSCVIEWERBINARY);CHKERRQ(ierr);
     ierr = PetscMemcpy((*outviewer)->data,vbinary,sizeof(PetscViewer_Binary));CHKERRQ(ierr);
+    ((PetscViewer_Binary*)(*outviewer)->data)->usemmap = PETSC_FALSE;
+    ((PetscViewer_Binary*)(*outviewer)->data)->mapping = NULL;
     (*outviewer)->setupcalled = PETSC_TRUE;
   } else {
     *outviewer = NULL;
@@ -633,6 +643,84 @@ PetscErrorCode PetscViewerBinaryGetSkipHeader(PetscViewer viewer,PetscBool  *ski
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode PetscViewerBinarySetUseMMap_Binary(PetscViewer viewer,PetscBool flg)
+{
+  PetscViewer_Binary *vbinary = (PetscViewer_Binary*)viewer->data;
+
+  PetscFunctionBegin;
+  vbinary->usemmap = flg;
+  PetscFunctionReturn(0);
+}
+
+/*@
+    PetscViewerBinarySetUseMMap - Lets objects loaded from a binary viewer keep their data in a private memory
+        mapping of the file instead of copying it into newly allocated arrays
+
+    Logically Collective on PetscViewer
+
+    Input Parameters:
++   viewer - PetscViewer context, obtained from PetscViewerBinaryOpen()
+-   flg - PETSC_TRUE to use the mapping
+
+    Options Database:
+.   -viewer_binary_mmap - use the mapping
+
+    Level: advanced
+
+    Notes:
+    This only has an effect on one process, for files opened with FILE_MODE_READ without MPI-IO; it is ignored on
+    systems without mmap(). Currently MatLoad() for MATSEQAIJ and VecLoad() for VECSEQ and VECMPI vectors use the mapping.
+    The mapping replaces the array of a vector loaded this way, so VecPlaceArray() and VecResetArray() can be used with it
+    as with any other vector.
+
+.seealso: PetscViewerBinaryOpen(), PetscViewerBinaryGetUseMMap(), PetscViewerBinaryReadMapped()
+@*/
+PetscErrorCode PetscViewerBinarySetUseMMap(PetscViewer viewer,PetscBool flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,1);
+  ierr = PetscTryMethod(viewer,"PetscViewerBinarySetUseMMap_C",(PetscViewer,PetscBool),(viewer,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscViewerBinaryGetUseMMap_Binary(PetscViewer viewer,PetscBool *flg)
+{
+  PetscViewer_Binary *vbinary = (PetscViewer_Binary*)viewer->data;
+
+  PetscFunctionBegin;
+  *flg = vbinary->usemmap;
+  PetscFunctionReturn(0);
+}
+
+/*@
+    PetscViewerBinaryGetUseMMap - Returns PETSC_TRUE if objects loaded from the binary viewer may keep their data
+        in a memory mapping of the file
+
+    Not Collective
+
+    Input Parameter:
+.   viewer - PetscViewer context, obtained from PetscViewerBinaryOpen()
+
+    Output Parameter:
+.   flg - PETSC_TRUE if the mapping is used
+
+    Level: advanced
+
+.seealso: PetscViewerBinaryOpen(), PetscViewerBinarySetUseMMap(), PetscViewerBinaryReadMapped()
+@*/
+PetscErrorCode PetscViewerBinaryGetUseMMap(PetscViewer viewer,PetscBool *flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,1);
+  *flg = PETSC_FALSE;
+  ierr = PetscTryMethod(viewer,"PetscViewerBinaryGetUseMMap_C",(PetscViewer,PetscBool*),(viewer,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode PetscViewerBinaryGetInfoPointer_Binary(PetscViewer viewer,FILE **file)
 {
   PetscViewer_Binary *vbinary = (PetscViewer_Binary*)viewer->data;
@@ -697,6 +785,8 @@ static PetscErrorCode PetscViewerFileClose_Binary(PetscViewer v)
 
   PetscFunctionBegin;
   ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)v),&rank);CHKERRQ(ierr);
+  /* objects loaded from the mapping keep their own reference to it */
+  ierr = PetscContainerDestroy(&vbinary->mapping);CHKERRQ(ierr);
   if ((!rank || vbinary->btype == FILE_MODE_READ) && vbinary->fdes) {
     close(vbinary->fdes);
     if (!rank && vbinary->storecompressed) {
@@ -952,6 +1042,325 @@ PetscErrorCode PetscViewerBinaryWrite(PetscViewer viewer,void *data,PetscInt cou
   PetscFunctionReturn(0);
 }
 
+#if defined(PETSC_HAVE_MPIIO)
+static PetscErrorCode PetscViewerBinaryWriteReadAllMPIIO(PetscViewer viewer,void *data,PetscInt count,PetscInt start,PetscInt total,PetscDataType dtype,PetscBool write)
+{
+  PetscViewer_Binary *vbinary = (PetscViewer_Binary*)viewer->data;
+  PetscErrorCode     ierr;
+  MPI_File           mfdes;
+  MPI_Datatype       mdtype;
+  PetscMPIInt        cnt;
+  MPI_Status         status;
+  MPI_Aint           ul,dsize;
+
+  PetscFunctionBegin;
+  mfdes = vbinary->mfdes;
+  ierr = PetscMPIIntCast(count,&cnt);CHKERRQ(ierr);
+  ierr = PetscDataTypeToMPIDataType(dtype,&mdtype);CHKERRQ(ierr);
+  ierr = MPI_Type_get_extent(mdtype,&ul,&dsize);CHKERRQ(ierr);
+  /* each process sets its own view at the start of its segment so that the collective call is fully parallel */
+  ierr = MPI_File_set_view(mfdes,vbinary->moff + (MPI_Offset)start*dsize,mdtype,mdtype,(char*)"native",MPI_INFO_NULL);CHKERRQ(ierr);
+  if (write) {
+    ierr = MPIU_File_write_all(mfdes,data,cnt,mdtype,&status);CHKERRQ(ierr);
+  } else {
+    ierr = MPIU_File_read_all(mfdes,data,cnt,mdtype,&status);CHKERRQ(ierr);
+  }
+  vbinary->moff += (MPI_Offset)total*dsize;
+  PetscFunctionReturn(0);
+}
+#endif
+
+/*@C
+   PetscViewerBinaryReadAll - Reads a distributed array from a binary file, each process gets its own contiguous segment
+
+   Collective on MPI_Comm
+
+   Input Parameters:
++  viewer - the binary viewer
+.  data - location to receive this process's segment
+.  count - number of items of data to read on this process
+.  start - global index (in units of dtype) of this process's first item, or PETSC_DETERMINE
+.  total - total number of items of data stored in the file across all processes, or PETSC_DETERMINE
+-  dtype - type of data to read
+
+   Level: developer
+
+   Notes:
+   The segments must be stored in the file in process rank order, one after the other, starting at the
+   current position in the file; after the call the file position is advanced past all total items.
+   If start is PETSC_DETERMINE it is computed from a prefix sum of the counts, if total is PETSC_DETERMINE it
+   is the sum of the counts; both must be passed consistently on all processes.
+
+   When the viewer uses MPI-IO (see PetscViewerBinarySetUseMPIIO()) every process reads its segment directly
+   from the file with a single collective read, otherwise the first process reads each segment in turn and
+   sends it to its owner.
+
+   Concepts: binary files
+
+.seealso: PetscViewerBinaryRead(), PetscViewerBinaryWriteAll(), PetscViewerBinaryOpen(), PetscViewerBinarySetUseMPIIO(), VecLoad(), MatLoad()
+@*/
+PetscErrorCode PetscViewerBinaryReadAll(PetscViewer viewer,void *data,PetscInt count,PetscInt start,PetscInt total,PetscDataType dtype)
+{
+  PetscErrorCode     ierr;
+  PetscViewer_Binary *vbinary = (PetscViewer_Binary*)viewer->data;
+  MPI_Comm           comm;
+  PetscMPIInt        rank,size,tag,i;
+  MPI_Datatype       mdtype;
+  PetscInt           *counts,maxcount;
+  size_t             dsize;
+  void               *work;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,1);
+  ierr = PetscViewerSetUp(viewer);CHKERRQ(ierr);
+  ierr = PetscObjectGetComm((PetscObject)viewer,&comm);CHKERRQ(ierr);
+  if (start == PETSC_DETERMINE) {
+    ierr   = MPI_Scan(&count,&start,1,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);
+    start -= count;
+  }
+  if (total == PETSC_DETERMINE) {
+    ierr = MPIU_Allreduce(&count,&total,1,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);
+  }
+#if defined(PETSC_HAVE_MPIIO)
+  if (vbinary->usempiio) {
+    ierr = PetscViewerBinaryWriteReadAllMPIIO(viewer,data,count,start,total,dtype,PETSC_FALSE);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  ierr = PetscDataTypeToMPIDataType(dtype,&mdtype);CHKERRQ(ierr);
+  ierr = PetscObjectGetNewTag((PetscObject)viewer,&tag);CHKERRQ(ierr);
+  if (!rank) {
+    ierr = PetscMalloc1(size,&counts);CHKERRQ(ierr);
+    ierr = MPI_Gather(&count,1,MPIU_INT,counts,1,MPIU_INT,0,comm);CHKERRQ(ierr);
+    ierr = PetscBinaryRead(vbinary->fdes,data,count,dtype);CHKERRQ(ierr);
+    maxcount = 0;
+    for (i=1; i<size; i++) maxcount = PetscMax(maxcount,counts[i]);
+    ierr = PetscDataTypeGetSize(dtype,&dsize);CHKERRQ(ierr);
+    ierr = PetscMalloc(maxcount*dsize,&work);CHKERRQ(ierr);
+    for (i=1; i<size; i++) {
+      ierr = PetscBinaryRead(vbinary->fdes,work,counts[i],dtype);CHKERRQ(ierr);
+      ierr = MPIULong_Send(work,counts[i],mdtype,i,tag,comm);CHKERRQ(ierr);
+    }
+    ierr = PetscFree(work);CHKERRQ(ierr);
+    ierr = PetscFree(counts);CHKERRQ(ierr);
+  } else {
+    ierr = MPI_Gather(&count,1,MPIU_INT,NULL,1,MPIU_INT,0,comm);CHKERRQ(ierr);
+    ierr = MPIULong_Recv(data,count,mdtype,0,tag,comm);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscViewerBinaryWriteAll - Writes a distributed array to a binary file, each process provides its own contiguous segment
+
+   Collective on MPI_Comm
+
+   Input Parameters:
++  viewer - the binary viewer
+.  data - this process's segment
+.  count - number of items of data to write from this process
+.  start - global index (in units of dtype) of this process's first item, or PETSC_DETERMINE
+.  total - total number of items of data written across all processes, or PETSC_DETERMINE
+-  dtype - type of data to write
+
+   Level: developer
+
+   Notes:
+   The segments are stored in the file in process rank order, one after the other, starting at the current
+   position in the file; the resulting file is identical to the one obtained by writing the concatenated array
+   from the first process with PetscViewerBinaryWrite(). See PetscViewerBinaryReadAll() for the meaning of
+   PETSC_DETERMINE.
+
+   When the viewer uses MPI-IO every process writes its segment with a single collective write, otherwise the
+   segments are sent to the first process (honoring PetscViewerBinarySetFlowControl()) which writes them in turn.
+
+   Because byte-swapping may be done on the values in data it cannot be declared const, it is restored on return.
+
+   Concepts: binary files
+
+.seealso: PetscViewerBinaryWrite(), PetscViewerBinaryReadAll(), PetscViewerBinaryOpen(), PetscViewerBinarySetUseMPIIO(), VecView(), MatView()
+@*/
+PetscErrorCode PetscViewerBinaryWriteAll(PetscViewer viewer,void *data,PetscInt count,PetscInt start,PetscInt total,PetscDataType dtype)
+{
+  PetscErrorCode     ierr;
+  PetscViewer_Binary *vbinary = (PetscViewer_Binary*)viewer->data;
+  MPI_Comm           comm;
+  PetscMPIInt        rank,size,tag,i;
+  MPI_Datatype       mdtype;
+  PetscInt           *counts,maxcount,message_count,flowcontrolcount;
+  size_t             dsize;
+  void               *work;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,1);
+  ierr = PetscViewerSetUp(viewer);CHKERRQ(ierr);
+  ierr = PetscObjectGetComm((PetscObject)viewer,&comm);CHKERRQ(ierr);
+  if (start == PETSC_DETERMINE) {
+    ierr   = MPI_Scan(&count,&start,1,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);
+    start -= count;
+  }
+  if (total == PETSC_DETERMINE) {
+    ierr = MPIU_Allreduce(&count,&total,1,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);
+  }
+#if defined(PETSC_HAVE_MPIIO)
+  if (vbinary->usempiio) {
+    ierr = PetscViewerBinaryWriteReadAllMPIIO(viewer,data,count,start,total,dtype,PETSC_TRUE);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  ierr = PetscDataTypeToMPIDataType(dtype,&mdtype);CHKERRQ(ierr);
+  ierr = PetscObjectGetNewTag((PetscObject)viewer,&tag);CHKERRQ(ierr);
+  ierr = PetscViewerFlowControlStart(viewer,&message_count,&flowcontrolcount);CHKERRQ(ierr);
+  if (!rank) {
+    ierr = PetscMalloc1(size,&counts);CHKERRQ(ierr);
+    ierr = MPI_Gather(&count,1,MPIU_INT,counts,1,MPIU_INT,0,comm);CHKERRQ(ierr);
+    ierr = PetscBinaryWrite(vbinary->fdes,data,count,dtype,PETSC_FALSE);CHKERRQ(ierr);
+    maxcount = 0;
+    for (i=1; i<size; i++) maxcount = PetscMax(maxcount,counts[i]);
+    ierr = PetscDataTypeGetSize(dtype,&dsize);CHKERRQ(ierr);
+    ierr = PetscMalloc(maxcount*dsize,&work);CHKERRQ(ierr);
+    for (i=1; i<size; i++) {
+      ierr = PetscViewerFlowControlStepMaster(viewer,i,&message_count,flowcontrolcount);CHKERRQ(ierr);
+      ierr = MPIULong_Recv(work,counts[i],mdtype,i,tag,comm);CHKERRQ(ierr);
+      ierr = PetscBinaryWrite(vbinary->fdes,work,counts[i],dtype,PETSC_TRUE);CHKERRQ(ierr);
+    }
+    ierr = PetscViewerFlowControlEndMaster(viewer,&message_count);CHKERRQ(ierr);
+    ierr = PetscFree(work);CHKERRQ(ierr);
+    ierr = PetscFree(counts);CHKERRQ(ierr);
+  } else {
+    ierr = MPI_Gather(&count,1,MPIU_INT,NULL,1,MPIU_INT,0,comm);CHKERRQ(ierr);
+    ierr = PetscViewerFlowControlStepWorker(viewer,rank,&message_count);CHKERRQ(ierr);
+    ierr = MPIULong_Send(data,count,mdtype,0,tag,comm);CHKERRQ(ierr);
+    ierr = PetscViewerFlowControlEndWorker(viewer,&message_count);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+#if defined(PETSC_HAVE_MMAP)
+typedef struct {
+  void   *addr;
+  size_t len;
+} PetscViewerBinary_Mapping;
+
+static PetscErrorCode PetscViewerBinaryMappingDestroy_Private(void *ctx)
+{
+  PetscViewerBinary_Mapping *map = (PetscViewerBinary_Mapping*)ctx;
+  PetscErrorCode            ierr;
+
+  PetscFunctionBegin;
+  if (map->len && munmap(map->addr,map->len)) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SYS,"munmap() failed, errno %d",errno);
+  ierr = PetscFree(map);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
+/*@C
+   PetscViewerBinaryReadMapped - Returns a pointer to the next items of a binary file, taken directly from a
+   memory mapping of the file rather than copied into a user buffer
+
+   Not Collective
+
+   Input Parameters:
++  viewer - the binary viewer, on a single process
+.  num - number of items to read
+-  dtype - type of the items, PETSC_INT, PETSC_SCALAR or PETSC_REAL
+
+   Output Parameters:
++  data - pointer to the items in the mapping, or NULL if the data could not be mapped
+-  mapping - the container that owns the mapping, the caller should compose it with (or otherwise reference) any
+             object that keeps data
+
+   Level: developer
+
+   Notes:
+   This returns NULL and leaves the file position unchanged unless the viewer was set to use memory mapping with
+   PetscViewerBinarySetUseMMap() or -viewer_binary_mmap, is on one process, is opened for reading without MPI-IO,
+   and the items are suitably aligned in the file; the caller must then fall back to PetscViewerBinaryRead().
+
+   The mapping is private: the items may be modified, which copies the touched pages and never alters the file.
+   On little-endian machines the items are byte-swapped in place when they are returned, so only big-endian
+   machines share the pages with the file system cache.
+
+.seealso: PetscViewerBinarySetUseMMap(), PetscViewerBinaryRead(), PetscContainerCreate(), PetscObjectCompose()
+@*/
+PetscErrorCode PetscViewerBinaryReadMapped(PetscViewer viewer,PetscInt num,PetscDataType dtype,void **data,PetscContainer *mapping)
+{
+#if defined(PETSC_HAVE_MMAP)
+  PetscViewer_Binary        *vbinary = (PetscViewer_Binary*)viewer->data;
+  PetscViewerBinary_Mapping *map;
+  PetscErrorCode            ierr;
+  PetscBool                 isbinary;
+  PetscMPIInt               size;
+  size_t                    dsize,align;
+  off_t                     off;
+  struct stat               st;
+  char                      *p;
+#endif
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,1);
+  PetscValidPointer(data,4);
+  PetscValidPointer(mapping,5);
+  *data    = NULL;
+  *mapping = NULL;
+#if defined(PETSC_HAVE_MMAP)
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERBINARY,&isbinary);CHKERRQ(ierr);
+  if (!isbinary) PetscFunctionReturn(0);
+  ierr = PetscViewerSetUp(viewer);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)viewer),&size);CHKERRQ(ierr);
+  if (!vbinary->usemmap || size > 1 || vbinary->btype != FILE_MODE_READ) PetscFunctionReturn(0);
+#if defined(PETSC_HAVE_MPIIO)
+  if (vbinary->usempiio) PetscFunctionReturn(0);
+#endif
+  if (dtype != PETSC_INT && dtype != PETSC_SCALAR && dtype != PETSC_REAL) PetscFunctionReturn(0);
+#if defined(PETSC_USE_REAL___FLOAT128)
+  /* PetscBinaryRead() may convert from double precision on the fly */
+  if (dtype != PETSC_INT) PetscFunctionReturn(0);
+#endif
+
+  if (!vbinary->mapping) {
+    if (fstat(vbinary->fdes,&st)) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_FILE_READ,"fstat() failed on binary file, errno %d",errno);
+    ierr = PetscNew(&map);CHKERRQ(ierr);
+    map->len = (size_t)st.st_size;
+    if (map->len) {
+      map->addr = mmap(NULL,map->len,PROT_READ|PROT_WRITE,MAP_PRIVATE,vbinary->fdes,0);
+      if (map->addr == MAP_FAILED) {
+        ierr = PetscFree(map);CHKERRQ(ierr);
+        ierr = PetscInfo1(viewer,"mmap() failed with errno %d, reading binary file without the mapping\n",errno);CHKERRQ(ierr);
+        vbinary->usemmap = PETSC_FALSE;
+        PetscFunctionReturn(0);
+      }
+    }
+    ierr = PetscContainerCreate(PETSC_COMM_SELF,&vbinary->mapping);CHKERRQ(ierr);
+    ierr = PetscContainerSetPointer(vbinary->mapping,map);CHKERRQ(ierr);
+    ierr = PetscContainerSetUserDestroy(vbinary->mapping,PetscViewerBinaryMappingDestroy_Private);CHKERRQ(ierr);
+  }
+  ierr = PetscContainerGetPointer(vbinary->mapping,(void**)&map);CHKERRQ(ierr);
+
+  ierr  = PetscDataTypeGetSize(dtype,&dsize);CHKERRQ(ierr);
+  align = (dtype == PETSC_INT) ? dsize : sizeof(PetscReal);
+  off   = lseek(vbinary->fdes,0,SEEK_CUR);
+  if (off < 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_FILE_READ,"lseek() failed on binary file, errno %d",errno);
+  if ((size_t)off + num*dsize > map->len) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_FILE_READ,"Read past end of file");
+  p = (char*)map->addr + off;
+  if ((size_t)p % align) {
+    ierr = PetscInfo2(viewer,"Data at file offset %D is not aligned to %D bytes, cannot use the mapping\n",(PetscInt)off,(PetscInt)align);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#if !defined(PETSC_WORDS_BIGENDIAN)
+  ierr = PetscByteSwap(p,dtype,num);CHKERRQ(ierr);
+#endif
+  if (lseek(vbinary->fdes,(off_t)(num*dsize),SEEK_CUR) < 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_FILE_READ,"lseek() failed on binary file, errno %d",errno);
+  *data    = (void*)p;
+  *mapping = vbinary->mapping;
+#endif
+  PetscFunctionReturn(0);
+}
+
 /*@C
    PetscViewerBinaryWriteStringArray - writes to a binary file, only from the first process an array of strings
 
@@ -1388,6 +1797,7 @@ static PetscErrorCode PetscViewerSetFromOptions_Binary(PetscOptionItems *PetscOp
 #elif defined(PETSC_HAVE_MPIUNI)
   ierr = PetscOptionsBool("-viewer_binary_mpiio","Use MPI-IO functionality to write/read binary file","PetscViewerBinarySetUseMPIIO",PETSC_FALSE,NULL,NULL);CHKERRQ(ierr);  
 #endif
+  ierr = PetscOptionsBool("-viewer_binary_mmap","Load data directly from a memory mapping of the binary file","PetscViewerBinarySetUseMMap",binary->usemmap,&binary->usemmap,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsTail();CHKERRQ(ierr);
   binary->setfromoptionscalled = PETSC_TRUE;
   PetscFunctionReturn(0);
@@ -1400,7 +1810,7 @@ static PetscErrorCode PetscViewerSetFromOptions_Binary(PetscOptionItems *PetscOp
 .seealso:  PetscViewerBinaryOpen(), PETSC_VIEWER_STDOUT_(),PETSC_VIEWER_STDOUT_SELF, PETSC_VIEWER_STDOUT_WORLD, PetscViewerCreate(), PetscViewerASCIIOpen(),
            PetscViewerMatlabOpen(), VecView(), DMView(), PetscViewerMatlabPutArray(), PETSCVIEWERASCII, PETSCVIEWERMATLAB, PETSCVIEWERDRAW,
            PetscViewerFileSetName(), PetscViewerFileSetMode(), PetscViewerFormat, PetscViewerType, PetscViewerSetType(),
-           PetscViewerBinaryGetUseMPIIO(), PetscViewerBinarySetUseMPIIO()
+           PetscViewerBinaryGetUseMPIIO(), PetscViewerBinarySetUseMPIIO(), PetscViewerBinarySetUseMMap()
 
   Level: beginner
 
@@ -1429,6 +1839,8 @@ PETSC_EXTERN PetscErrorCode PetscViewerCreate_Binary(PetscViewer v)
   vbinary->skipoptions     = PETSC_TRUE;
   vbinary->skipheader      = PETSC_FALSE;
   vbinary->setfromoptionscalled = PETSC_FALSE;
+  vbinary->usemmap         = PETSC_FALSE;
+  vbinary->mapping         = NULL;
   v->ops->getsubviewer     = PetscViewerGetSubViewer_Binary;
   v->ops->restoresubviewer = PetscViewerRestoreSubViewer_Binary;
   v->ops->read             = PetscViewerBinaryRead;
@@ -1447,6 +1859,8 @@ PETSC_EXTERN PetscErrorCode PetscViewerCreate_Binary(PetscViewer v)
   ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerBinaryGetSkipInfo_C",PetscViewerBinaryGetSkipInfo_Binary);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerBinarySetSkipInfo_C",PetscViewerBinarySetSkipInfo_Binary);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerBinaryGetInfoPointer_C",PetscViewerBinaryGetInfoPointer_Binary);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerBinarySetUseMMap_C",PetscViewerBinarySetUseMMap_Binary);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerBinaryGetUseMMap_C",PetscViewerBinaryGetUseMMap_Binary);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerFileSetName_C",PetscViewerFileSetName_Binary);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerFileSetMode_C",PetscViewerFileSetMode_Binary);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerFileGetMode_C",PetscViewerFileGetMode_Binary);CHKERRQ(ierr);
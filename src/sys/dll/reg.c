@@ -4,6 +4,7 @@
     dynamic libraries for many of the PETSc objects (including, e.g., KSP and PC).
 */
 #include <petsc/private/petscimpl.h>           /*I "petscsys.h" I*/
+#include <petsc/private/hashmap.h>
 #include <petscviewer.h>
 
 /*
@@ -163,11 +164,22 @@ PETSC_INTERN PetscErrorCode PetscFinalize_DynamicLibraries(void)
 
 
 /* ------------------------------------------------------------------------------*/
+PETSC_HASH_MAP(HMapFL, const char*, PetscFunctionList, kh_str_hash_func, kh_str_hash_equal, NULL)
+
+/*
+   Lists with at least this many entries are indexed by a hash table from the names to the entries, so finding a
+   composed function (as in MatMatMult(), MatConvert() or PCFieldSplit) does not compare the name against every entry
+*/
+#define PETSC_FUNCTIONLIST_HASH_MIN 8
+
 struct _n_PetscFunctionList {
   void              (*routine)(void);    /* the routine */
   char              *name;               /* string to identify routine */
   PetscFunctionList next;                /* next pointer */
   PetscFunctionList next_list;           /* used to maintain list of all lists for freeing */
+  PetscFunctionList tail;                /* last entry of the list, only set in the first entry */
+  PetscInt          n;                   /* number of entries in the list, only set in the first entry */
+  PetscHMapFL       map;                 /* names to entries for long lists, only set in the first entry */
 };
 
 /*
@@ -175,6 +187,31 @@ struct _n_PetscFunctionList {
 */
 static PetscFunctionList dlallhead = 0;
 
+/*
+   PetscFunctionListFindEntry - Finds the entry with the given name, NULL if there is none
+*/
+static PetscErrorCode PetscFunctionListFindEntry(PetscFunctionList fl,const char name[],PetscFunctionList *entry)
+{
+  PetscErrorCode ierr;
+  PetscBool      flg;
+
+  PetscFunctionBegin;
+  *entry = NULL;
+  if (!fl) PetscFunctionReturn(0);
+  if (fl->map) {
+    ierr = PetscHMapFLGet(fl->map,name,entry);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  for (; fl; fl=fl->next) {
+    ierr = PetscStrcmp(name,fl->name,&flg);CHKERRQ(ierr);
+    if (flg) {
+      *entry = fl;
+      PetscFunctionReturn(0);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
 /*MC
    PetscFunctionListAdd - Given a routine and a string id, saves that routine in the
    specified registry.
@@ -214,6 +251,8 @@ PETSC_EXTERN PetscErrorCode PetscFunctionListAdd_Private(PetscFunctionList *fl,c
     ierr           = PetscStrallocpy(name,&entry->name);CHKERRQ(ierr);
     entry->routine = fnc;
     entry->next    = 0;
+    entry->tail    = entry;
+    entry->n       = 1;
     *fl            = entry;
 
 #if defined(PETSC_USE_DEBUG)
@@ -230,24 +269,25 @@ PETSC_EXTERN PetscErrorCode PetscFunctionListAdd_Private(PetscFunctionList *fl,c
 
   } else {
     /* search list to see if it is already there */
-    ne = *fl;
-    while (ne) {
-      PetscBool founddup;
-
-      ierr = PetscStrcmp(ne->name,name,&founddup);CHKERRQ(ierr);
-      if (founddup) { /* found duplicate */
-        ne->routine = fnc;
-        PetscFunctionReturn(0);
-      }
-      if (ne->next) ne = ne->next;
-      else break;
+    ierr = PetscFunctionListFindEntry(*fl,name,&ne);CHKERRQ(ierr);
+    if (ne) { /* found duplicate */
+      ne->routine = fnc;
+      PetscFunctionReturn(0);
     }
     /* create new entry and add to end of list */
-    ierr           = PetscNew(&entry);CHKERRQ(ierr);
-    ierr           = PetscStrallocpy(name,&entry->name);CHKERRQ(ierr);
-    entry->routine = fnc;
-    entry->next    = 0;
-    ne->next       = entry;
+    ierr              = PetscNew(&entry);CHKERRQ(ierr);
+    ierr              = PetscStrallocpy(name,&entry->name);CHKERRQ(ierr);
+    entry->routine    = fnc;
+    entry->next       = 0;
+    (*fl)->tail->next = entry;
+    (*fl)->tail       = entry;
+    (*fl)->n++;
+    if ((*fl)->map) {
+      ierr = PetscHMapFLSet((*fl)->map,entry->name,entry);CHKERRQ(ierr);
+    } else if ((*fl)->n >= PETSC_FUNCTIONLIST_HASH_MIN) {
+      ierr = PetscHMapFLCreate(&(*fl)->map);CHKERRQ(ierr);
+      for (ne=*fl; ne; ne=ne->next) {ierr = PetscHMapFLSet((*fl)->map,ne->name,ne);CHKERRQ(ierr);}
+    }
   }
   PetscFunctionReturn(0);
 }
@@ -285,6 +325,7 @@ PetscErrorCode  PetscFunctionListDestroy(PetscFunctionList *fl)
   }
 
   /* free this list */
+  ierr  = PetscHMapFLDestroy(&(*fl)->map);CHKERRQ(ierr);
   entry = *fl;
   while (entry) {
     next  = entry->next;
@@ -335,22 +376,13 @@ PetscErrorCode  PetscFunctionListPrintAll(void)
 M*/
 PETSC_EXTERN PetscErrorCode PetscFunctionListFind_Private(PetscFunctionList fl,const char name[],void (**r)(void))
 {
-  PetscFunctionList entry = fl;
+  PetscFunctionList entry;
   PetscErrorCode    ierr;
-  PetscBool         flg;
 
   PetscFunctionBegin;
   if (!name) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_NULL,"Trying to find routine with null name");
-
-  *r = 0;
-  while (entry) {
-    ierr = PetscStrcmp(name,entry->name,&flg);CHKERRQ(ierr);
-    if (flg) {
-      *r   = entry->routine;
-      PetscFunctionReturn(0);
-    }
-    entry = entry->next;
-  }
+  ierr = PetscFunctionListFindEntry(fl,name,&entry);CHKERRQ(ierr);
+  *r   = entry ? entry->routine : NULL;
   PetscFunctionReturn(0);
 }
 
@@ -366,6 +366,9 @@ PetscErrorCode PetscError(MPI_Comm comm,int line,const char *func,const char *fi
   if (!eh) ierr = PetscTraceBackErrorHandler(comm,line,func,file,n,p,lbuf,0);
   else     ierr = (*eh->handler)(comm,line,func,file,n,p,lbuf,eh->ctx);
 
+  /* the error is returned from func, end the PetscMallocArenaPush() scopes it left open */
+  PetscMallocArenaUnwind(func);
+
   /*
       If this is called from the main() routine we call MPI_Abort() instead of
     return to allow the parallel program to be properly shutdown.
@@ -3,20 +3,58 @@ static char help[] = "Tests timing PetscSortInt().\n\n";
 
 #include <petscsys.h>
 
+/* writes a trace with an event whose name needs escaping and checks the JSON file on the first process */
+static PetscErrorCode CheckTraceJSON(void)
+{
+  const char     fname[] = "ex12_check.json";
+  int            event;
+  char           *buf;
+  size_t         n,i;
+  PetscBool      ctrl = PETSC_FALSE;
+  FILE           *fd;
+  PetscMPIInt    rank;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLogEventRegister("Trace \"check\"\t\\\n",0,&event);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(event,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(event,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscLogTraceJSONDump(fname);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  if (rank) PetscFunctionReturn(0);
+  ierr = PetscMalloc1(65536,&buf);CHKERRQ(ierr);
+  ierr = PetscFOpen(PETSC_COMM_SELF,fname,"r",&fd);CHKERRQ(ierr);
+  n      = fread(buf,1,65535,fd);
+  buf[n] = 0;
+  ierr = PetscFClose(PETSC_COMM_SELF,fd);CHKERRQ(ierr);
+  /* records are separated by newlines, which JSON allows outside of strings */
+  for (i=0; i<n; i++) if ((unsigned char)buf[i] < 0x20 && buf[i] != '\n') ctrl = PETSC_TRUE;
+  ierr = PetscPrintf(PETSC_COMM_SELF,"Control characters: %s\n",ctrl ? "found" : "none");CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF,"Trace events: %s\n",strstr(buf,"{\"traceEvents\":[") ? "yes" : "no");CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF,"Escaped name: %s\n",strstr(buf,"\"name\":\"Trace \\\"check\\\"\\t\\\\\\n\"") ? "yes" : "no");CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF,"Begin and end: %s\n",strstr(buf,"\"ph\":\"B\"") && strstr(buf,"\"ph\":\"E\"") ? "yes" : "no");CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF,"Second process: %s\n",strstr(buf,"\"pid\":1,") ? "yes" : "no");CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF,"Time unit: %s\n",strstr(buf,"\"displayTimeUnit\":\"ms\"}") ? "yes" : "no");CHKERRQ(ierr);
+  ierr = PetscFree(buf);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 int main(int argc,char **argv)
 {
   PetscInt       i,n = 1000,*values;
+  char           *work;
   int            event;
   PetscRandom    rand;
   PetscReal      value;
   PetscErrorCode ierr;
-  PetscBool      values_view=PETSC_FALSE;
+  PetscBool      values_view=PETSC_FALSE,trace_check=PETSC_FALSE;
   PetscMPIInt    rank;
 
   ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
   ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
   ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsGetBool(NULL,0,"-values_view",&values_view,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,0,"-trace_check",&trace_check,NULL);CHKERRQ(ierr);
 
   ierr = PetscRandomCreate(PETSC_COMM_SELF,&rand);CHKERRQ(ierr);
   ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
@@ -36,12 +74,16 @@ int main(int argc,char **argv)
     values[i] = (PetscInt)(n*value + 2.0);
   }
   ierr = PetscSortInt(n,values);CHKERRQ(ierr);
+  /* kept after the event, for -log_view_memory */
+  ierr = PetscMalloc1(n,&work);CHKERRQ(ierr);
   ierr = PetscLogEventEnd(event,0,0,0,0);CHKERRQ(ierr);
 
   for (i=1; i<n; i++) {
     if (values[i] < values[i-1]) SETERRQ(PETSC_COMM_SELF,1,"Values not sorted");
     if (values_view && !rank) {ierr = PetscPrintf(PETSC_COMM_SELF,"%D %D\n",i,values[i]);CHKERRQ(ierr);}
   }
+  if (trace_check) {ierr = CheckTraceJSON();CHKERRQ(ierr);}
+  ierr = PetscFree(work);CHKERRQ(ierr);
   ierr = PetscFree(values);CHKERRQ(ierr);
   ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
 
@@ -56,4 +98,17 @@ int main(int argc,char **argv)
    test:
       args: -values_view
 
+   test:
+      suffix: trace_json
+      nsize: 2
+      requires: define(PETSC_USE_LOG)
+      args: -log_trace_json ex12_trace.json -log_trace_json_size 8 -trace_check
+
+   test:
+      suffix: log_view_memory
+      nsize: 2
+      requires: define(PETSC_USE_LOG)
+      args: -log_view -log_view_memory -malloc 0
+      filter: grep -E "Count +Kept +Peak$|^Sort " | tr -s " " | rev | cut -d " " -f 1-3 | rev
+
 TEST*/
@@ -0,0 +1,97 @@
+static char help[] = "Tests the integer sorts with companion arrays on short and long arrays with negative and repeated keys.\n\n";
+
+#include <petscsys.h>
+
+/* checks that key[] is sorted and that a[] (the original positions) still matches it */
+static PetscErrorCode CheckSorted(const char name[],PetscInt n,const PetscInt key[],const PetscInt a[],const PetscInt orig[])
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+  for (i=0; i<n; i++) {
+    if (i && key[i] < key[i-1]) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_PLIB,"%s: keys not sorted at %D of %D",name,i,n);
+    if (a && orig[a[i]] != key[i]) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_PLIB,"%s: companion array does not follow the keys at %D of %D",name,i,n);
+  }
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscInt       i,n = 5000,range = 100,*orig,*key,*a,*b,*idx;
+  PetscScalar    *s;
+  PetscInt       *data;
+  PetscInt       work[2];
+  PetscRandom    rand;
+  PetscReal      value;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-range",&range,NULL);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = PetscMalloc6(n,&orig,n,&key,n,&a,n,&b,n,&idx,n,&s);CHKERRQ(ierr);
+  ierr = PetscMalloc1(2*n,&data);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    ierr    = PetscRandomGetValueReal(rand,&value);CHKERRQ(ierr);
+    orig[i] = (PetscInt)(range*(value - 0.5));
+  }
+
+  ierr = PetscMemcpy(key,orig,n*sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = PetscSortInt(n,key);CHKERRQ(ierr);
+  ierr = CheckSorted("PetscSortInt",n,key,NULL,orig);CHKERRQ(ierr);
+
+  ierr = PetscMemcpy(key,orig,n*sizeof(PetscInt));CHKERRQ(ierr);
+  for (i=0; i<n; i++) a[i] = i;
+  ierr = PetscSortIntWithArray(n,key,a);CHKERRQ(ierr);
+  ierr = CheckSorted("PetscSortIntWithArray",n,key,a,orig);CHKERRQ(ierr);
+
+  ierr = PetscMemcpy(key,orig,n*sizeof(PetscInt));CHKERRQ(ierr);
+  for (i=0; i<n; i++) {a[i] = i; b[i] = -i;}
+  ierr = PetscSortIntWithArrayPair(n,key,a,b);CHKERRQ(ierr);
+  ierr = CheckSorted("PetscSortIntWithArrayPair",n,key,a,orig);CHKERRQ(ierr);
+  for (i=0; i<n; i++) if (b[i] != -a[i]) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"PetscSortIntWithArrayPair: second companion array does not follow the keys at %D",i);
+
+  ierr = PetscMemcpy(key,orig,n*sizeof(PetscInt));CHKERRQ(ierr);
+  for (i=0; i<n; i++) s[i] = (PetscReal)i;
+  ierr = PetscSortIntWithScalarArray(n,key,s);CHKERRQ(ierr);
+  for (i=0; i<n; i++) a[i] = (PetscInt)PetscRealPart(s[i]);
+  ierr = CheckSorted("PetscSortIntWithScalarArray",n,key,a,orig);CHKERRQ(ierr);
+
+  ierr = PetscMemcpy(key,orig,n*sizeof(PetscInt));CHKERRQ(ierr);
+  for (i=0; i<n; i++) {data[2*i] = i; data[2*i+1] = orig[i];}
+  ierr = PetscSortIntWithDataArray(n,key,data,2*sizeof(PetscInt),work);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    a[i] = data[2*i];
+    if (data[2*i+1] != key[i]) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"PetscSortIntWithDataArray: data does not follow the keys at %D",i);
+  }
+  ierr = CheckSorted("PetscSortIntWithDataArray",n,key,a,orig);CHKERRQ(ierr);
+
+  for (i=0; i<n; i++) idx[i] = i;
+  ierr = PetscSortIntWithPermutation(n,orig,idx);CHKERRQ(ierr);
+  for (i=0; i<n; i++) key[i] = orig[idx[i]];
+  ierr = CheckSorted("PetscSortIntWithPermutation",n,key,idx,orig);CHKERRQ(ierr);
+
+  ierr = PetscFree6(orig,key,a,b,idx,s);CHKERRQ(ierr);
+  ierr = PetscFree(data);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      args: -n 100
+      output_file: output/ex44_1.out
+
+   test:
+      suffix: radix
+      output_file: output/ex44_1.out
+
+   test:
+      suffix: radix_wide
+      args: -n 20000 -range 2000000000
+      output_file: output/ex44_1.out
+
+TEST*/
@@ -0,0 +1,141 @@
+static char help[] = "Tests the group-probed integer hash set and map against PetscHSetI with random insertions and deletions.\n\n";
+
+#include <petsc/private/hashseti.h>
+#include <petsc/private/hashmapi.h>
+#include <petscsys.h>
+
+#define PetscAssert(expr) do {            \
+if (PetscUnlikely(!(expr)))               \
+  SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB, \
+           "Assertion: `%s' failed.",     \
+           PetscStringize(expr));         \
+} while(0)
+
+int main(int argc,char **argv)
+{
+  PetscHSetI     ref;
+  PetscHSetIG    ht;
+  PetscHMapIG    hm;
+  PetscInt       i,k,n,m,off,val,N = 10000,range = 3000,*keys,*vals,*elems,*refelems;
+  PetscBool      has,missing,*hasmany;
+  PetscRandom    rand;
+  PetscReal      r;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-N",&N,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-range",&range,NULL);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = PetscMalloc5(N,&keys,N,&vals,N,&hasmany,N+range,&elems,N+range,&refelems);CHKERRQ(ierr);
+
+  /* single entry operations on an empty table */
+  ierr = PetscHSetIGCreate(&ht);CHKERRQ(ierr);
+  ierr = PetscHSetIGHas(ht,42,&has);CHKERRQ(ierr);
+  PetscAssert(has == PETSC_FALSE);
+  ierr = PetscHSetIGDel(ht,42);CHKERRQ(ierr);
+  ierr = PetscHSetIGQueryAdd(ht,42,&missing);CHKERRQ(ierr);
+  PetscAssert(missing == PETSC_TRUE);
+  ierr = PetscHSetIGQueryAdd(ht,42,&missing);CHKERRQ(ierr);
+  PetscAssert(missing == PETSC_FALSE);
+  ierr = PetscHSetIGDel(ht,42);CHKERRQ(ierr);
+  ierr = PetscHSetIGGetSize(ht,&n);CHKERRQ(ierr);
+  PetscAssert(n == 0);
+  ierr = PetscHSetIGHas(ht,42,&has);CHKERRQ(ierr);
+  PetscAssert(has == PETSC_FALSE);
+
+  /* random insertions, single and in bulk, and deletions, checked against PetscHSetI */
+  ierr = PetscHSetICreate(&ref);CHKERRQ(ierr);
+  for (k=0; k<4; k++) {
+    for (i=0; i<N; i++) {
+      ierr    = PetscRandomGetValueReal(rand,&r);CHKERRQ(ierr);
+      keys[i] = (PetscInt)(range*(r - 0.5));
+    }
+    if (k % 2) {
+      ierr = PetscHSetIGAddMany(ht,N,keys);CHKERRQ(ierr);
+    } else {
+      for (i=0; i<N; i++) {ierr = PetscHSetIGAdd(ht,keys[i]);CHKERRQ(ierr);}
+    }
+    for (i=0; i<N; i++) {ierr = PetscHSetIAdd(ref,keys[i]);CHKERRQ(ierr);}
+    for (i=0; i<N; i+=3) {
+      ierr = PetscHSetIGDel(ht,keys[i]+1);CHKERRQ(ierr);
+      ierr = PetscHSetIDel(ref,keys[i]+1);CHKERRQ(ierr);
+    }
+    ierr = PetscHSetIGGetSize(ht,&n);CHKERRQ(ierr);
+    ierr = PetscHSetIGetSize(ref,&m);CHKERRQ(ierr);
+    PetscAssert(n == m);
+    off  = 0;
+    ierr = PetscHSetIGGetElemsSorted(ht,&off,elems);CHKERRQ(ierr);
+    PetscAssert(off == n);
+    off  = 0;
+    ierr = PetscHSetIGetElems(ref,&off,refelems);CHKERRQ(ierr);
+    ierr = PetscSortInt(off,refelems);CHKERRQ(ierr);
+    for (i=0; i<n; i++) PetscAssert(elems[i] == refelems[i]);
+    for (i=0; i<N; i++) keys[i] += range/2;
+    ierr = PetscHSetIGHasMany(ht,N,keys,hasmany);CHKERRQ(ierr);
+    for (i=0; i<N; i++) {
+      ierr = PetscHSetIHas(ref,keys[i],&has);CHKERRQ(ierr);
+      PetscAssert(hasmany[i] == has);
+    }
+  }
+  ierr = PetscHSetIGClear(ht);CHKERRQ(ierr);
+  ierr = PetscHSetIGGetSize(ht,&n);CHKERRQ(ierr);
+  PetscAssert(n == 0);
+  ierr = PetscHSetIGHasMany(ht,N,keys,hasmany);CHKERRQ(ierr);
+  for (i=0; i<N; i++) PetscAssert(hasmany[i] == PETSC_FALSE);
+  ierr = PetscHSetIGResize(ht,4*N);CHKERRQ(ierr);
+  ierr = PetscHSetIGAddMany(ht,N,keys);CHKERRQ(ierr);
+  ierr = PetscHSetIGHasMany(ht,N,keys,hasmany);CHKERRQ(ierr);
+  for (i=0; i<N; i++) PetscAssert(hasmany[i] == PETSC_TRUE);
+  ierr = PetscHSetIGDestroy(&ht);CHKERRQ(ierr);
+  PetscAssert(ht == NULL);
+  ierr = PetscHSetIDestroy(&ref);CHKERRQ(ierr);
+
+  /* the map keeps the last value set for each key */
+  ierr = PetscHMapIGCreate(&hm);CHKERRQ(ierr);
+  ierr = PetscHMapIGGet(hm,7,&val);CHKERRQ(ierr);
+  PetscAssert(val == -1);
+  for (i=0; i<N; i++) {keys[i] = 2*(i % (N/2+1)); vals[i] = i;}
+  ierr = PetscHMapIGSetMany(hm,N/2,keys,vals);CHKERRQ(ierr);
+  for (i=N/2; i<N; i++) {ierr = PetscHMapIGSet(hm,keys[i],vals[i]);CHKERRQ(ierr);}
+  ierr = PetscHMapIGGetSize(hm,&n);CHKERRQ(ierr);
+  PetscAssert(n == PetscMin(N,N/2+1));
+  for (i=0; i<N; i++) keys[i] = i;
+  ierr = PetscHMapIGGetMany(hm,N,keys,vals);CHKERRQ(ierr);
+  for (i=0; i<N; i++) {
+    ierr = PetscHMapIGGet(hm,i,&val);CHKERRQ(ierr);
+    PetscAssert(val == vals[i]);
+    if (i % 2 || i/2 > N/2) PetscAssert(val == -1);
+    else PetscAssert(val == (i/2 + N/2+1 < N ? i/2 + N/2+1 : i/2));
+  }
+  off  = 0;
+  ierr = PetscHMapIGGetPairsSorted(hm,&off,elems,refelems);CHKERRQ(ierr);
+  PetscAssert(off == n);
+  for (i=0; i<n; i++) {
+    PetscAssert(elems[i] == 2*i);
+    ierr = PetscHMapIGDel(hm,elems[i]);CHKERRQ(ierr);
+    ierr = PetscHMapIGGet(hm,elems[i],&val);CHKERRQ(ierr);
+    PetscAssert(val == -1);
+  }
+  ierr = PetscHMapIGGetSize(hm,&n);CHKERRQ(ierr);
+  PetscAssert(n == 0);
+  ierr = PetscHMapIGDestroy(&hm);CHKERRQ(ierr);
+
+  ierr = PetscFree5(keys,vals,hasmany,elems,refelems);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      args: -N 100 -range 60
+      output_file: output/ex45_1.out
+
+   test:
+      suffix: large
+      args: -N 50000 -range 100000
+      output_file: output/ex45_1.out
+
+TEST*/
@@ -0,0 +1,57 @@
+static char help[] = "Tests finding, replacing and duplicating the entries of long PetscFunctionLists.\n\n";
+
+#include <petscsys.h>
+
+static void F0(void) {}
+static void F1(void) {}
+
+int main(int argc,char **argv)
+{
+  PetscFunctionList fl = NULL,dl = NULL;
+  PetscInt          i,n = 100,nfound = 0;
+  char              name[64];
+  void              (*f)(void);
+  PetscErrorCode    ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    ierr = PetscSNPrintf(name,sizeof(name),"MatConvert_seqaij_type%D_C",i);CHKERRQ(ierr);
+    ierr = PetscFunctionListAdd(&fl,name,i % 2 ? F1 : F0);CHKERRQ(ierr);
+  }
+  /* replace some entries and remove others, the list must not grow */
+  for (i=0; i<n; i+=3) {
+    ierr = PetscSNPrintf(name,sizeof(name),"MatConvert_seqaij_type%D_C",i);CHKERRQ(ierr);
+    ierr = PetscFunctionListAdd(&fl,name,i % 2 ? F0 : NULL);CHKERRQ(ierr);
+  }
+  ierr = PetscFunctionListDuplicate(fl,&dl);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    ierr = PetscSNPrintf(name,sizeof(name),"MatConvert_seqaij_type%D_C",i);CHKERRQ(ierr);
+    ierr = PetscFunctionListFind(dl,name,&f);CHKERRQ(ierr);
+    if (i % 3 == 0) {
+      if (f != (i % 2 ? F0 : NULL)) {ierr = PetscPrintf(PETSC_COMM_SELF,"Wrong replaced entry %D\n",i);CHKERRQ(ierr);}
+    } else {
+      if (f != (i % 2 ? F1 : F0)) {ierr = PetscPrintf(PETSC_COMM_SELF,"Wrong entry %D\n",i);CHKERRQ(ierr);}
+    }
+    if (f) nfound++;
+  }
+  ierr = PetscFunctionListFind(dl,"MatConvert_seqaij_type_C",&f);CHKERRQ(ierr);
+  if (f) {ierr = PetscPrintf(PETSC_COMM_SELF,"Found an entry that was not added\n");CHKERRQ(ierr);}
+  ierr = PetscPrintf(PETSC_COMM_SELF,"Found %D functions\n",nfound);CHKERRQ(ierr);
+  ierr = PetscFunctionListView(dl,NULL);CHKERRQ(ierr);
+  ierr = PetscFunctionListDestroy(&dl);CHKERRQ(ierr);
+  ierr = PetscFunctionListDestroy(&fl);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      args: -n 12
+
+   test:
+      suffix: 2
+      args: -n 5
+
+TEST*/
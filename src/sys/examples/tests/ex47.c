@@ -0,0 +1,94 @@
+static char help[] = "Tests PetscMallocArenaPush(), PetscMallocArenaPop() and the arena allocations, nested and on errors.\n\n";
+
+#include <petscsys.h>
+
+/* leaves its scope open by returning an error, PetscError() must end it */
+static PetscErrorCode Fail(PetscInt n)
+{
+  PetscInt       *a;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMallocArenaPush(0);CHKERRQ(ierr);
+  ierr = PetscMallocArena1(n,&a);CHKERRQ(ierr);
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_USER,"Error inside an arena scope");
+  PetscFunctionReturn(0);
+}
+
+/* calls Fail() inside its own scope, the scopes of both are ended when the error is returned */
+static PetscErrorCode FailNested(PetscInt n)
+{
+  PetscInt       *a;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMallocArenaPush(0);CHKERRQ(ierr);
+  ierr = PetscMallocArena1(n,&a);CHKERRQ(ierr);
+  ierr = Fail(n);CHKERRQ(ierr);
+  ierr = PetscMallocArenaPop();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscInt       n = 1000,i,*a,*b,*c;
+  PetscScalar    *z;
+  PetscLogDouble mem0,mem1;
+  PetscBool      ok = PETSC_TRUE;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+
+  /* an inner scope that needs a new chunk releases only its own memory */
+  ierr = PetscMallocArenaPush(n*sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = PetscMallocArena1(n,&a);CHKERRQ(ierr);
+  for (i=0; i<n; i++) a[i] = i;
+  ierr = PetscMallocArenaPush(0);CHKERRQ(ierr);
+  ierr = PetscMallocArena2(n,&b,100*n,&c);CHKERRQ(ierr);
+  for (i=0; i<n; i++) b[i] = -1;
+  for (i=0; i<100*n; i++) c[i] = -1;
+  ierr = PetscMallocArenaPop();CHKERRQ(ierr);
+  ierr = PetscCallocArena1(n,&z);CHKERRQ(ierr);
+  for (i=0; i<n; i++) if (a[i] != i || z[i] != 0.0) ok = PETSC_FALSE;
+  if ((char*)z < (char*)(a+n) && (char*)a < (char*)(z+n)) ok = PETSC_FALSE;
+  ierr = PetscMallocArenaPop();CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF,"Nested scopes: %s\n",ok ? "ok" : "overwritten");CHKERRQ(ierr);
+
+  /* a scope too large to be kept is released by the outermost pop */
+  ierr = PetscMallocGetCurrentUsage(&mem0);CHKERRQ(ierr);
+  ierr = PetscMallocArenaPush(0);CHKERRQ(ierr);
+  ierr = PetscMallocArena1(2097152,&a);CHKERRQ(ierr);
+  ierr = PetscMallocArenaPop();CHKERRQ(ierr);
+  ierr = PetscMallocGetCurrentUsage(&mem1);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF,"Large scope released: %s\n",mem1 <= mem0 ? "yes" : "no");CHKERRQ(ierr);
+
+  /* more failing calls than the scopes may be nested, each error ends the scopes left open */
+  ierr = PetscPushErrorHandler(PetscReturnErrorHandler,NULL);CHKERRQ(ierr);
+  for (i=0; i<40; i++) {
+    ierr = i % 2 ? Fail(n) : FailNested(n);
+    if (ierr != PETSC_ERR_USER) ok = PETSC_FALSE;
+  }
+  ierr = PetscMallocArenaPop();
+  if (!ierr) ok = PETSC_FALSE;
+  ierr = PetscPopErrorHandler();CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF,"Scopes ended on errors: %s\n",ok ? "yes" : "no");CHKERRQ(ierr);
+
+  /* the arena is still usable */
+  ierr = PetscMallocArenaPush(0);CHKERRQ(ierr);
+  ierr = PetscMallocArena1(n,&a);CHKERRQ(ierr);
+  ierr = PetscMallocArenaPop();CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+
+   test:
+      suffix: 2
+      args: -n 100000
+      output_file: output/ex47_1.out
+
+TEST*/
@@ -80,6 +80,7 @@ PetscLogDouble petsc_sum_of_waits_ct = 0.0;  /* The total number of waits */
 PetscLogDouble petsc_allreduce_ct    = 0.0;  /* The number of reductions */
 PetscLogDouble petsc_gather_ct       = 0.0;  /* The number of gathers and gathervs */
 PetscLogDouble petsc_scatter_ct      = 0.0;  /* The number of scatters and scattervs */
+PetscLogDouble petsc_allreduce_merged_ct = 0.0;  /* The number of reductions saved by merging deferred vector reductions */
 
 /* Logging functions */
 PetscErrorCode (*PetscLogPHC)(PetscObject) = NULL;
@@ -93,6 +94,11 @@ int              petsc_tracelevel            = 0;
 const char       *petsc_traceblanks          = "                                                                                                    ";
 char             petsc_tracespace[128]       = " ";
 PetscLogDouble   petsc_tracetime             = 0.0;
+
+/* Timeline tracing variables */
+TraceRecord      *petsc_traceRecords         = NULL;
+int              petsc_maxTraceRecords       = 0;
+PetscInt64       petsc_numTraceRecords       = 0;
 static PetscBool PetscLogInitializeCalled = PETSC_FALSE;
 
 PETSC_INTERN PetscErrorCode PetscLogInitialize(void)
@@ -134,8 +140,12 @@ PETSC_INTERN PetscErrorCode PetscLogFinalize(void)
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
+  ierr = PetscLogHWCountersEnd();CHKERRQ(ierr);
   ierr = PetscFree(petsc_actions);CHKERRQ(ierr);
   ierr = PetscFree(petsc_objects);CHKERRQ(ierr);
+  ierr = PetscFree(petsc_traceRecords);CHKERRQ(ierr);
+  petsc_maxTraceRecords = 0;
+  petsc_numTraceRecords = 0;
   ierr = PetscLogNestedEnd();CHKERRQ(ierr);
   ierr = PetscLogSet(NULL, NULL);CHKERRQ(ierr);
 
@@ -171,6 +181,7 @@ PETSC_INTERN PetscErrorCode PetscLogFinalize(void)
   petsc_allreduce_ct          = 0.0;
   petsc_gather_ct             = 0.0;
   petsc_scatter_ct            = 0.0;
+  petsc_allreduce_merged_ct   = 0.0;
   PETSC_LARGEST_EVENT         = PETSC_EVENT;
   PetscLogPHC                 = NULL;
   PetscLogPHD                 = NULL;
@@ -318,6 +329,47 @@ PetscErrorCode  PetscLogTraceBegin(FILE *file)
   PetscFunctionReturn(0);
 }
 
+/*@
+  PetscLogTraceJSONBegin - Activates timeline tracing. Every time a PETSc event
+  begins or ends a time stamped record is kept, and PetscLogTraceJSONDump() writes them
+  as a timeline that can be viewed with chrome://tracing or https://ui.perfetto.dev
+
+  Logically Collective on PETSC_COMM_WORLD
+
+  Input Parameter:
+. size - The number of records kept on each process, or PETSC_DEFAULT
+
+  Options Database Keys:
++ -log_trace_json [filename] - Activates PetscLogTraceJSONBegin() and calls PetscLogTraceJSONDump() in PetscFinalize()
+- -log_trace_json_size <size> - The number of records kept on each process
+
+  Notes:
+  The records are kept in a ring buffer of fixed size, so the cost of an event is a few stores and memory use is
+  bounded; once the buffer is full only the most recent records are kept.
+
+  The usual per event summary is still collected, so this may be combined with -log_view (but not with its
+  ascii_xml format), but not with -log_all, -log_trace or -log_mpe.
+
+  Level: intermediate
+
+.seealso: PetscLogTraceJSONDump(), PetscLogTraceBegin(), PetscLogDefaultBegin(), PetscLogView()
+@*/
+PetscErrorCode  PetscLogTraceJSONBegin(PetscInt size)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (size == PETSC_DEFAULT) size = 100000;
+  if (size < 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Number of trace records %D must be positive",size);
+  ierr = PetscFree(petsc_traceRecords);CHKERRQ(ierr);
+  ierr = PetscMalloc1(size,&petsc_traceRecords);CHKERRQ(ierr);
+  petsc_maxTraceRecords = (int)size;
+  petsc_numTraceRecords = 0;
+
+  ierr = PetscLogSet(PetscLogEventBeginTraceJSON, PetscLogEventEndTraceJSON);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
   PetscLogActions - Determines whether actions are logged for the graphical viewer.
 
@@ -1134,6 +1186,143 @@ PetscErrorCode  PetscLogDump(const char sname[])
   PetscFunctionReturn(0);
 }
 
+/* JSON strings cannot contain quotes, backslashes or control characters unescaped */
+static PetscErrorCode PetscLogTraceJSONPrintName_Private(FILE *fd,const char name[])
+{
+  PetscErrorCode ierr;
+  size_t         i;
+  unsigned char  c;
+  char           s[2] = {0,0};
+
+  PetscFunctionBegin;
+  for (i=0; name[i]; i++) {
+    c = (unsigned char)name[i];
+    if (c == '"' || c == '\\' || c < 0x20) break;
+  }
+  if (!name[i]) {
+    ierr = PetscFPrintf(PETSC_COMM_SELF,fd,"%s",name);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  for (i=0; name[i]; i++) {
+    c = (unsigned char)name[i];
+    switch (c) {
+    case '"':  ierr = PetscFPrintf(PETSC_COMM_SELF,fd,"\\\"");CHKERRQ(ierr); break;
+    case '\\': ierr = PetscFPrintf(PETSC_COMM_SELF,fd,"\\\\");CHKERRQ(ierr); break;
+    case '\b': ierr = PetscFPrintf(PETSC_COMM_SELF,fd,"\\b");CHKERRQ(ierr); break;
+    case '\f': ierr = PetscFPrintf(PETSC_COMM_SELF,fd,"\\f");CHKERRQ(ierr); break;
+    case '\n': ierr = PetscFPrintf(PETSC_COMM_SELF,fd,"\\n");CHKERRQ(ierr); break;
+    case '\r': ierr = PetscFPrintf(PETSC_COMM_SELF,fd,"\\r");CHKERRQ(ierr); break;
+    case '\t': ierr = PetscFPrintf(PETSC_COMM_SELF,fd,"\\t");CHKERRQ(ierr); break;
+    default:
+      if (c < 0x20) {ierr = PetscFPrintf(PETSC_COMM_SELF,fd,"\\u%04x",(unsigned int)c);CHKERRQ(ierr);}
+      else {
+        s[0] = (char)c;
+        ierr = PetscFPrintf(PETSC_COMM_SELF,fd,"%s",s);CHKERRQ(ierr);
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscLogTraceJSONDump - Writes the records collected since PetscLogTraceJSONBegin() on all processes to a
+  single file in the Chrome trace event format, with one timeline (pid) per MPI rank
+
+  Collective on PETSC_COMM_WORLD
+
+  Input Parameter:
+. name - an optional file name, the default is Trace.json
+
+  Notes:
+  Times are in microseconds since PetscInitialize(). Event and stage names are taken from the first process,
+  so all processes must register events in the same order, as is required by PetscLogView().
+
+  An end record whose begin record was overwritten in the ring buffer is dropped.
+
+  Level: intermediate
+
+.seealso: PetscLogTraceJSONBegin(), PetscLogDump(), PetscLogView()
+@*/
+PetscErrorCode  PetscLogTraceJSONDump(const char sname[])
+{
+  PetscStageLog  stageLog;
+  MPI_Comm       comm;
+  PetscMPIInt    rank,size,p,tag,cnt,len;
+  TraceRecord    *records = NULL;
+  int            *depth,numEvents,first = 1,i,start,n,maxn = 0;
+  char           fname[PETSC_MAX_PATH_LEN];
+  FILE           *fd = NULL;
+  MPI_Status     status;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!petsc_traceRecords) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Must call PetscLogTraceJSONBegin() first");
+  ierr = PetscCommDuplicate(PETSC_COMM_WORLD,&comm,&tag);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  if (petsc_numTraceRecords > petsc_maxTraceRecords) {
+    ierr = PetscInfo1(NULL,"Trace ring buffer overflowed, the oldest %lld records were dropped\n",(long long)(petsc_numTraceRecords - petsc_maxTraceRecords));CHKERRQ(ierr);
+    n     = petsc_maxTraceRecords;
+    start = (int)(petsc_numTraceRecords % petsc_maxTraceRecords);
+  } else {
+    n     = (int)petsc_numTraceRecords;
+    start = 0;
+  }
+  ierr = MPI_Reduce(&n,&maxn,1,MPI_INT,MPI_MAX,0,comm);CHKERRQ(ierr);
+  if (rank) {
+    /* send the records oldest first */
+    ierr = MPI_Send(&n,1,MPI_INT,0,tag,comm);CHKERRQ(ierr);
+    ierr = PetscMPIIntCast((n-start)*sizeof(TraceRecord),&len);CHKERRQ(ierr);
+    ierr = MPI_Send(petsc_traceRecords+start,len,MPI_BYTE,0,tag,comm);CHKERRQ(ierr);
+    ierr = PetscMPIIntCast(start*sizeof(TraceRecord),&len);CHKERRQ(ierr);
+    ierr = MPI_Send(petsc_traceRecords,len,MPI_BYTE,0,tag,comm);CHKERRQ(ierr);
+    ierr = PetscCommDestroy(&comm);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+
+  ierr = PetscFixFilename(sname && sname[0] ? sname : "Trace.json",fname);CHKERRQ(ierr);
+  ierr = PetscFOpen(PETSC_COMM_SELF,fname,"w",&fd);CHKERRQ(ierr);
+  if (!fd) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_FILE_OPEN,"Cannot open file: %s",fname);
+  ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
+  numEvents = stageLog->eventLog->numEvents;
+  ierr = PetscMalloc2(maxn,&records,numEvents,&depth);CHKERRQ(ierr);
+  ierr = PetscFPrintf(PETSC_COMM_SELF,fd,"{\"traceEvents\":[\n");CHKERRQ(ierr);
+  for (p=0; p<size; p++) {
+    if (!p) {
+      ierr = PetscMemcpy(records,petsc_traceRecords+start,(n-start)*sizeof(TraceRecord));CHKERRQ(ierr);
+      ierr = PetscMemcpy(records+(n-start),petsc_traceRecords,start*sizeof(TraceRecord));CHKERRQ(ierr);
+      cnt  = n;
+    } else {
+      ierr = MPI_Recv(&cnt,1,MPI_INT,p,tag,comm,&status);CHKERRQ(ierr);
+      ierr = MPI_Recv(records,(int)(cnt*sizeof(TraceRecord)),MPI_BYTE,p,tag,comm,&status);CHKERRQ(ierr);
+      ierr = MPI_Get_count(&status,MPI_BYTE,&len);CHKERRQ(ierr);
+      ierr = MPI_Recv((char*)records+len,(int)(cnt*sizeof(TraceRecord))-len,MPI_BYTE,p,tag,comm,&status);CHKERRQ(ierr);
+    }
+    ierr = PetscMemzero(depth,numEvents*sizeof(int));CHKERRQ(ierr);
+    for (i=0; i<cnt; i++) {
+      TraceRecord *r = &records[i];
+
+      if (r->event < 0 || r->event >= numEvents) continue;
+      if (r->action == ACTIONBEGIN) depth[r->event]++;
+      else if (depth[r->event]) depth[r->event]--;
+      else continue;
+      ierr  = PetscFPrintf(PETSC_COMM_SELF,fd,"%s{\"name\":\"",first ? "" : ",\n");CHKERRQ(ierr);
+      first = 0;
+      ierr  = PetscLogTraceJSONPrintName_Private(fd,stageLog->eventLog->eventInfo[r->event].name);CHKERRQ(ierr);
+      ierr  = PetscFPrintf(PETSC_COMM_SELF,fd,"\",\"cat\":\"");CHKERRQ(ierr);
+      if (r->stage >= 0 && r->stage < stageLog->numStages) {
+        ierr = PetscLogTraceJSONPrintName_Private(fd,stageLog->stageInfo[r->stage].name);CHKERRQ(ierr);
+      }
+      ierr = PetscFPrintf(PETSC_COMM_SELF,fd,"\",\"ph\":\"%s\",\"ts\":%.3f,\"pid\":%d,\"tid\":0}",r->action == ACTIONBEGIN ? "B" : "E",r->time*1.e6,p);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscFPrintf(PETSC_COMM_SELF,fd,"\n],\"displayTimeUnit\":\"ms\"}\n");CHKERRQ(ierr);
+  ierr = PetscFClose(PETSC_COMM_SELF,fd);CHKERRQ(ierr);
+  ierr = PetscFree2(records,depth);CHKERRQ(ierr);
+  ierr = PetscCommDestroy(&comm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*
   PetscLogView_Detailed - Each process prints the times for its own events
 
@@ -1245,6 +1434,69 @@ static PetscErrorCode PetscLogViewWarnDebugging(MPI_Comm comm,FILE *fd)
 #endif
 }
 
+/*
+   PetscLogViewHWCounters_Private - Prints the hardware counters collected with PetscLogHWCountersBegin(). The memory traffic
+   is estimated from the last level cache misses, one cache line per miss.
+*/
+static PetscErrorCode PetscLogViewHWCounters_Private(MPI_Comm comm,FILE *fd,PetscStageLog stageLog,int numStages,const PetscBool localStageUsed[],const PetscBool stageVisible[])
+{
+  const int            lineSize = 64;
+  PetscEventPerfInfo   *perfInfo,zeroInfo;
+  PetscLogDouble       local[PETSC_LOG_HW_COUNTERS+1],tot[PETSC_LOG_HW_COUNTERS+1],maxt,bytes;
+  const char           *name;
+  int                  stage,localNumEvents,numEvents,event,i;
+  PetscBool            flg[2],active[2];
+  PetscErrorCode       ierr;
+
+  PetscFunctionBegin;
+  flg[0] = petsc_logHWCounters;
+  flg[1] = petsc_logHWCountersFailed;
+  ierr = MPIU_Allreduce(flg,active,2,MPIU_BOOL,MPI_LOR,comm);CHKERRQ(ierr);
+  if (!active[0]) {
+    if (active[1]) {
+      ierr = PetscFPrintf(comm,fd,"------------------------------------------------------------------------------------------------------------------------\n\n");CHKERRQ(ierr);
+      ierr = PetscFPrintf(comm,fd,"Hardware counters were requested with -log_hw_counters but are not available, run with -info for the reason\n\n");CHKERRQ(ierr);
+    }
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscEventPerfInfoClear(&zeroInfo);CHKERRQ(ierr);
+  ierr = PetscFPrintf(comm,fd,"------------------------------------------------------------------------------------------------------------------------\n\n");CHKERRQ(ierr);
+  ierr = PetscFPrintf(comm,fd,"Hardware counters summed over all processes, memory traffic estimated as %d bytes per last level cache miss:\n\n",lineSize);CHKERRQ(ierr);
+  ierr = PetscFPrintf(comm,fd,"Event                Cycles     Instr   IPC  LLC Miss      GB/s Flop/Byte\n");CHKERRQ(ierr);
+  for (stage = 0; stage < numStages; stage++) {
+    if (!stageVisible[stage]) continue;
+    ierr = PetscFPrintf(comm,fd,"\n--- Event Stage %d: %s\n\n",stage,localStageUsed[stage] ? stageLog->stageInfo[stage].name : "Unknown");CHKERRQ(ierr);
+    if (localStageUsed[stage]) localNumEvents = stageLog->stageInfo[stage].eventLog->numEvents;
+    else localNumEvents = 0;
+    ierr = MPIU_Allreduce(&localNumEvents,&numEvents,1,MPI_INT,MPI_MAX,comm);CHKERRQ(ierr);
+    /* event -1 is the whole stage */
+    for (event = -1; event < numEvents; event++) {
+      perfInfo = &zeroInfo;
+      name     = "";
+      if (localStageUsed[stage]) {
+        if (event < 0) {
+          perfInfo = &stageLog->stageInfo[stage].perfInfo;
+          name     = "Stage total";
+        } else if (event < localNumEvents && !stageLog->stageInfo[stage].eventLog->eventInfo[event].depth) {
+          perfInfo = &stageLog->stageInfo[stage].eventLog->eventInfo[event];
+          name     = stageLog->eventLog->eventInfo[event].name;
+        }
+      }
+      for (i=0; i<PETSC_LOG_HW_COUNTERS; i++) local[i] = perfInfo->hwCounters[i];
+      local[PETSC_LOG_HW_COUNTERS] = perfInfo->flops;
+      /* CANNOT use MPIU_Allreduce() since it might fail the line number check */
+      ierr = MPI_Allreduce(local,tot,PETSC_LOG_HW_COUNTERS+1,MPIU_PETSCLOGDOUBLE,MPI_SUM,comm);CHKERRQ(ierr);
+      ierr = MPI_Allreduce(&perfInfo->time,&maxt,1,MPIU_PETSCLOGDOUBLE,MPI_MAX,comm);CHKERRQ(ierr);
+      if (tot[0] == 0.0) continue;
+      bytes = lineSize*tot[2];
+      ierr = PetscFPrintf(comm,fd,"%-16s %9.3e %9.3e %5.2f %9.3e %9.3e %9.3e\n",name,tot[0],tot[1],tot[1]/tot[0],tot[2],
+                          maxt > 0.0 ? bytes/maxt/1.0e9 : 0.0,bytes > 0.0 ? tot[PETSC_LOG_HW_COUNTERS]/bytes : 0.0);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscFPrintf(comm,fd,"\n");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
 {
   FILE               *fd;
@@ -1262,6 +1514,7 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
   PetscLogDouble     fracStageTime, fracStageFlops, fracStageMess, fracStageMessLen, fracStageRed;
   PetscLogDouble     min, max, tot, ratio, avg, x, y;
   PetscLogDouble     minf, maxf, totf, ratf, mint, maxt, tott, ratt, ratC, totm, totml, totr;
+  PetscLogDouble     mallocs, mallocSpace, mallocMax;
   PetscMPIInt        minC, maxC;
   PetscMPIInt        size, rank;
   PetscBool          *localStageUsed,    *stageUsed;
@@ -1372,6 +1625,10 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
   ierr = MPIU_Allreduce(&red,          &tot, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
   if (min != 0.0) ratio = max/min; else ratio = 0.0;
   ierr = PetscFPrintf(comm, fd, "MPI Reductions:       %5.3e   %7.3f\n", max, ratio);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&petsc_allreduce_merged_ct, &max, 1, MPIU_PETSCLOGDOUBLE, MPI_MAX, comm);CHKERRQ(ierr);
+  if (max > 0.0) {
+    ierr = PetscFPrintf(comm, fd, "MPI Reductions Merged: %5.3e\n", max);CHKERRQ(ierr);
+  }
   numReductions = red; /* wrong because uses count from process zero */
   ierr = PetscFPrintf(comm, fd, "\nFlop counting convention: 1 flop = 1 real number operation of type (multiply/divide/add/subtract)\n");CHKERRQ(ierr);
   ierr = PetscFPrintf(comm, fd, "                            e.g., VecAXPY() for real vectors of length N --> 2N flop\n");CHKERRQ(ierr);
@@ -1403,8 +1660,11 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
     ierr = MPIU_Allreduce(localStageVisible, stageVisible, numStages, MPIU_BOOL, MPI_LAND, comm);CHKERRQ(ierr);
     for (stage = 0; stage < numStages; stage++) {
       if (stageUsed[stage]) {
-        ierr = PetscFPrintf(comm, fd, "\nSummary of Stages:   ----- Time ------  ----- Flop ------  --- Messages ---  -- Message Lengths --  -- Reductions --\n");CHKERRQ(ierr);
-        ierr = PetscFPrintf(comm, fd, "                        Avg     %%Total     Avg     %%Total    Count   %%Total     Avg         %%Total    Count   %%Total \n");CHKERRQ(ierr);
+        ierr = PetscFPrintf(comm, fd, "\nSummary of Stages:   ----- Time ------  ----- Flop ------  --- Messages ---  -- Message Lengths --  -- Reductions --");CHKERRQ(ierr);
+        if (PetscLogMemory) {ierr = PetscFPrintf(comm, fd, " --- PetscMalloc() ----");CHKERRQ(ierr);}
+        ierr = PetscFPrintf(comm, fd, "\n                        Avg     %%Total     Avg     %%Total    Count   %%Total     Avg         %%Total    Count   %%Total ");CHKERRQ(ierr);
+        if (PetscLogMemory) {ierr = PetscFPrintf(comm, fd, "  Count    Kept    Peak");CHKERRQ(ierr);}
+        ierr = PetscFPrintf(comm, fd, "\n");CHKERRQ(ierr);
         break;
       }
     }
@@ -1417,6 +1677,11 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
         ierr = MPI_Allreduce(&stageInfo[stage].perfInfo.numMessages,   &mess,      1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
         ierr = MPI_Allreduce(&stageInfo[stage].perfInfo.messageLength, &messLen,   1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
         ierr = MPI_Allreduce(&stageInfo[stage].perfInfo.numReductions, &red,       1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
+        if (PetscLogMemory) {
+          ierr = MPI_Allreduce(&stageInfo[stage].perfInfo.numMallocs,  &mallocs,     1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
+          ierr = MPI_Allreduce(&stageInfo[stage].perfInfo.mallocSpace, &mallocSpace, 1, MPIU_PETSCLOGDOUBLE, MPI_MAX, comm);CHKERRQ(ierr);
+          ierr = MPI_Allreduce(&stageInfo[stage].perfInfo.mallocMax,   &mallocMax,   1, MPIU_PETSCLOGDOUBLE, MPI_MAX, comm);CHKERRQ(ierr);
+        }
         name = stageInfo[stage].name;
       } else {
         ierr = MPI_Allreduce(&zero,                           &stageTime, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
@@ -1424,6 +1689,11 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
         ierr = MPI_Allreduce(&zero,                           &mess,      1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
         ierr = MPI_Allreduce(&zero,                           &messLen,   1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
         ierr = MPI_Allreduce(&zero,                           &red,       1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
+        if (PetscLogMemory) {
+          ierr = MPI_Allreduce(&zero,                          &mallocs,     1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
+          ierr = MPI_Allreduce(&zero,                          &mallocSpace, 1, MPIU_PETSCLOGDOUBLE, MPI_MAX, comm);CHKERRQ(ierr);
+          ierr = MPI_Allreduce(&zero,                          &mallocMax,   1, MPIU_PETSCLOGDOUBLE, MPI_MAX, comm);CHKERRQ(ierr);
+        }
         name = "";
       }
       mess *= 0.5; messLen *= 0.5; red /= size;
@@ -1434,9 +1704,11 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
       if (mess          != 0.0) avgMessLen     = messLen/mess;           else avgMessLen     = 0.0;
       if (messageLength != 0.0) fracLength     = messLen/messageLength;  else fracLength     = 0.0;
       if (numReductions != 0.0) fracReductions = red/numReductions;      else fracReductions = 0.0;
-      ierr = PetscFPrintf(comm, fd, "%2d: %15s: %6.4e %5.1f%%  %6.4e %5.1f%%  %5.3e %5.1f%%  %5.3e      %5.1f%%  %5.3e %5.1f%% \n",
+      ierr = PetscFPrintf(comm, fd, "%2d: %15s: %6.4e %5.1f%%  %6.4e %5.1f%%  %5.3e %5.1f%%  %5.3e      %5.1f%%  %5.3e %5.1f%% ",
                           stage, name, stageTime/size, 100.0*fracTime, flops, 100.0*fracFlops,
                           mess, 100.0*fracMessages, avgMessLen, 100.0*fracLength, red, 100.0*fracReductions);CHKERRQ(ierr);
+      if (PetscLogMemory) {ierr = PetscFPrintf(comm, fd, "%2.1e %2.1e %2.1e",mallocs,mallocSpace,mallocMax);CHKERRQ(ierr);}
+      ierr = PetscFPrintf(comm, fd, "\n");CHKERRQ(ierr);
     }
   }
 
@@ -1455,13 +1727,21 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
   ierr = PetscFPrintf(comm, fd, "      %%M - percent messages in this phase     %%L - percent message lengths in this phase\n");CHKERRQ(ierr);
   ierr = PetscFPrintf(comm, fd, "      %%R - percent reductions in this phase\n");CHKERRQ(ierr);
   ierr = PetscFPrintf(comm, fd, "   Total Mflop/s: 10e-6 * (sum of flop over all processors)/(max time over all processors)\n");CHKERRQ(ierr);
+  if (PetscLogMemory) {
+    ierr = PetscFPrintf(comm, fd, "   PetscMalloc(): Count - number of calls summed over all processors\n");CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm, fd, "                  Kept - memory (bytes) allocated and not freed in this phase, max over all processors\n");CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm, fd, "                  Peak - largest increase of the allocated memory (bytes) during one call, max over all processors\n");CHKERRQ(ierr);
+  }
   ierr = PetscFPrintf(comm, fd, "------------------------------------------------------------------------------------------------------------------------\n");CHKERRQ(ierr);
 
   ierr = PetscLogViewWarnDebugging(comm,fd);CHKERRQ(ierr);
 
   /* Report events */
-  ierr = PetscFPrintf(comm, fd,"Event                Count      Time (sec)     Flop                              --- Global ---  --- Stage ----  Total\n");CHKERRQ(ierr);
-  ierr = PetscFPrintf(comm, fd,"                   Max Ratio  Max     Ratio   Max  Ratio  Mess   AvgLen  Reduct  %%T %%F %%M %%L %%R  %%T %%F %%M %%L %%R Mflop/s\n");CHKERRQ(ierr);
+  ierr = PetscFPrintf(comm, fd,"Event                Count      Time (sec)     Flop                              --- Global ---  --- Stage ----  Total");CHKERRQ(ierr);
+  if (PetscLogMemory) {ierr = PetscFPrintf(comm, fd,"  --- PetscMalloc() ----");CHKERRQ(ierr);}
+  ierr = PetscFPrintf(comm, fd,"\n                   Max Ratio  Max     Ratio   Max  Ratio  Mess   AvgLen  Reduct  %%T %%F %%M %%L %%R  %%T %%F %%M %%L %%R Mflop/s");CHKERRQ(ierr);
+  if (PetscLogMemory) {ierr = PetscFPrintf(comm, fd,"   Count    Kept    Peak");CHKERRQ(ierr);}
+  ierr = PetscFPrintf(comm, fd,"\n");CHKERRQ(ierr);
   ierr = PetscFPrintf(comm,fd,"------------------------------------------------------------------------------------------------------------------------\n");CHKERRQ(ierr);
 
   /* Problem: The stage name will not show up unless the stage executed on proc 1 */
@@ -1513,6 +1793,11 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
         ierr = MPI_Allreduce(&eventInfo[event].numReductions, &totr,  1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
         ierr = MPI_Allreduce(&eventInfo[event].count,         &minC,  1, MPI_INT,             MPI_MIN, comm);CHKERRQ(ierr);
         ierr = MPI_Allreduce(&eventInfo[event].count,         &maxC,  1, MPI_INT,             MPI_MAX, comm);CHKERRQ(ierr);
+        if (PetscLogMemory) {
+          ierr = MPI_Allreduce(&eventInfo[event].numMallocs,  &mallocs,     1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
+          ierr = MPI_Allreduce(&eventInfo[event].mallocSpace, &mallocSpace, 1, MPIU_PETSCLOGDOUBLE, MPI_MAX, comm);CHKERRQ(ierr);
+          ierr = MPI_Allreduce(&eventInfo[event].mallocMax,   &mallocMax,   1, MPIU_PETSCLOGDOUBLE, MPI_MAX, comm);CHKERRQ(ierr);
+        }
         name = stageLog->eventLog->eventInfo[event].name;
       } else {
         flopr = 0.0;
@@ -1527,6 +1812,11 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
         ierr  = MPI_Allreduce(&zero,                          &totr,  1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
         ierr  = MPI_Allreduce(&ierr,                          &minC,  1, MPI_INT,             MPI_MIN, comm);CHKERRQ(ierr);
         ierr  = MPI_Allreduce(&ierr,                          &maxC,  1, MPI_INT,             MPI_MAX, comm);CHKERRQ(ierr);
+        if (PetscLogMemory) {
+          ierr = MPI_Allreduce(&zero,                         &mallocs,     1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm);CHKERRQ(ierr);
+          ierr = MPI_Allreduce(&zero,                         &mallocSpace, 1, MPIU_PETSCLOGDOUBLE, MPI_MAX, comm);CHKERRQ(ierr);
+          ierr = MPI_Allreduce(&zero,                         &mallocMax,   1, MPIU_PETSCLOGDOUBLE, MPI_MAX, comm);CHKERRQ(ierr);
+        }
         name  = "";
       }
       if (mint < 0.0) {
@@ -1554,15 +1844,21 @@ PetscErrorCode  PetscLogView_Default(PetscViewer viewer)
         if (maxt          != 0.0) flopr            = totf/maxt;                  else flopr            = 0.0;
         if (fracStageTime > 1.00)  ierr = PetscFPrintf(comm, fd,"Warning -- total time of event greater than time of entire stage -- something is wrong with the timer\n");CHKERRQ(ierr);
         ierr = PetscFPrintf(comm, fd,
-                            "%-16s %7d%4.1f %5.4e%4.1f %3.2e%4.1f %2.1e %2.1e %2.1e%3.0f%3.0f%3.0f%3.0f%3.0f %3.0f%3.0f%3.0f%3.0f%3.0f %5.0f\n",
+                            "%-16s %7d%4.1f %5.4e%4.1f %3.2e%4.1f %2.1e %2.1e %2.1e%3.0f%3.0f%3.0f%3.0f%3.0f %3.0f%3.0f%3.0f%3.0f%3.0f %5.0f",
                             name, maxC, ratC, maxt, ratt, maxf, ratf, totm, totml, totr,
                             100.0*fracTime, 100.0*fracFlops, 100.0*fracMess, 100.0*fracMessLen, 100.0*fracRed,
                             100.0*fracStageTime, 100.0*fracStageFlops, 100.0*fracStageMess, 100.0*fracStageMessLen, 100.0*fracStageRed,
                             PetscAbs(flopr)/1.0e6);CHKERRQ(ierr);
+        if (PetscLogMemory) {
+          ierr = PetscFPrintf(comm, fd," %2.1e %2.1e %2.1e",mallocs,mallocSpace,mallocMax);CHKERRQ(ierr);
+        }
+        ierr = PetscFPrintf(comm, fd,"\n");CHKERRQ(ierr);
       }
     }
   }
 
+  ierr = PetscLogViewHWCounters_Private(comm,fd,stageLog,numStages,localStageUsed,stageVisible);CHKERRQ(ierr);
+
   /* Memory usage and object creation */
   ierr = PetscFPrintf(comm, fd, "------------------------------------------------------------------------------------------------------------------------\n");CHKERRQ(ierr);
   ierr = PetscFPrintf(comm, fd, "\n");CHKERRQ(ierr);
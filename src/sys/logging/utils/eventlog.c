@@ -8,6 +8,7 @@
 #include <petsc/private/logimpl.h>  /*I    "petscsys.h"   I*/
 
 PetscBool PetscLogSyncOn = PETSC_FALSE;
+PetscBool PetscLogMemory = PETSC_FALSE;
 
 /*----------------------------------------------- Creation Functions -------------------------------------------------*/
 /* Note: these functions do not have prototypes in a public directory, so they are considered "internal" and not exported. */
@@ -132,6 +133,8 @@ PetscErrorCode PetscEventPerfLogDestroy(PetscEventPerfLog eventLog)
 @*/
 PetscErrorCode PetscEventPerfInfoClear(PetscEventPerfInfo *eventInfo)
 {
+  PetscErrorCode ierr;
+
   PetscFunctionBegin;
   eventInfo->id            = -1;
   eventInfo->active        = PETSC_TRUE;
@@ -148,6 +151,10 @@ PetscErrorCode PetscEventPerfInfoClear(PetscEventPerfInfo *eventInfo)
   eventInfo->numMessages   = 0.0;
   eventInfo->messageLength = 0.0;
   eventInfo->numReductions = 0.0;
+  eventInfo->numMallocs    = 0.0;
+  eventInfo->mallocSpace   = 0.0;
+  eventInfo->mallocMax     = 0.0;
+  ierr = PetscMemzero(eventInfo->hwCounters,sizeof(eventInfo->hwCounters));CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -176,6 +183,54 @@ PetscErrorCode PetscEventPerfInfoCopy(PetscEventPerfInfo *eventInfo,PetscEventPe
   PetscFunctionReturn(0);
 }
 
+/*
+   PetscLogMallocSubtract - Starts an interval for the PetscMalloc() counts in a PetscEventPerfInfo, in the same way
+   that the time and flops are started by subtracting their current values
+*/
+PetscErrorCode PetscLogMallocSubtract(PetscEventPerfInfo *eventInfo)
+{
+  PetscLogDouble count,usage;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMallocGetCount(&count);CHKERRQ(ierr);
+  ierr = PetscMallocGetCurrentUsage(&usage);CHKERRQ(ierr);
+  eventInfo->numMallocs  -= count;
+  eventInfo->mallocSpace -= usage;
+  PetscFunctionReturn(0);
+}
+
+/*
+   PetscLogMallocAdd - Ends an interval started with PetscLogMallocSubtract()
+*/
+PetscErrorCode PetscLogMallocAdd(PetscEventPerfInfo *eventInfo)
+{
+  PetscLogDouble count,usage;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMallocGetCount(&count);CHKERRQ(ierr);
+  ierr = PetscMallocGetCurrentUsage(&usage);CHKERRQ(ierr);
+  eventInfo->numMallocs  += count;
+  eventInfo->mallocSpace += usage;
+  PetscFunctionReturn(0);
+}
+
+/*
+   PetscLogMallocPopMaximumUsage - Ends the interval started with PetscMallocPushMaximumUsage() and keeps its
+   high water mark if it is the largest one of the event
+*/
+PetscErrorCode PetscLogMallocPopMaximumUsage(int key,PetscEventPerfInfo *eventInfo)
+{
+  PetscLogDouble increase;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMallocPopMaximumUsage(key,&increase);CHKERRQ(ierr);
+  eventInfo->mallocMax = PetscMax(eventInfo->mallocMax,increase);
+  PetscFunctionReturn(0);
+}
+
 /*@C
   PetscEventPerfLogEnsureSize - This ensures that a PetscEventPerfLog is at least of a certain size.
 
@@ -640,6 +695,11 @@ PetscErrorCode PetscLogEventBeginDefault(PetscLogEvent event,int t,PetscObject o
   eventLog->eventInfo[event].numMessages   -= petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
   eventLog->eventInfo[event].messageLength -= petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
   eventLog->eventInfo[event].numReductions -= petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+  if (petsc_logHWCounters) {ierr = PetscLogHWCountersSubtract(&eventLog->eventInfo[event]);CHKERRQ(ierr);}
+  if (PetscLogMemory) {
+    ierr = PetscLogMallocSubtract(&eventLog->eventInfo[event]);CHKERRQ(ierr);
+    ierr = PetscMallocPushMaximumUsage(event);CHKERRQ(ierr);
+  }
   PetscFunctionReturn(0);
 }
 
@@ -659,6 +719,11 @@ PetscErrorCode PetscLogEventEndDefault(PetscLogEvent event,int t,PetscObject o1,
   if (eventLog->eventInfo[event].depth > 0) PetscFunctionReturn(0);
   else if (eventLog->eventInfo[event].depth < 0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Logging event had unbalanced begin/end pairs");
   /* Log performance info */
+  if (petsc_logHWCounters) {ierr = PetscLogHWCountersAdd(&eventLog->eventInfo[event]);CHKERRQ(ierr);}
+  if (PetscLogMemory) {
+    ierr = PetscLogMallocPopMaximumUsage(event,&eventLog->eventInfo[event]);CHKERRQ(ierr);
+    ierr = PetscLogMallocAdd(&eventLog->eventInfo[event]);CHKERRQ(ierr);
+  }
   PetscTimeAdd(&eventLog->eventInfo[event].timeTmp);
   eventLog->eventInfo[event].time          += eventLog->eventInfo[event].timeTmp;
   eventLog->eventInfo[event].time2         += eventLog->eventInfo[event].timeTmp*eventLog->eventInfo[event].timeTmp;
@@ -728,6 +793,11 @@ PetscErrorCode PetscLogEventBeginComplete(PetscLogEvent event,int t,PetscObject
   eventPerfLog->eventInfo[event].numMessages   -= petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
   eventPerfLog->eventInfo[event].messageLength -= petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
   eventPerfLog->eventInfo[event].numReductions -= petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+  if (petsc_logHWCounters) {ierr = PetscLogHWCountersSubtract(&eventPerfLog->eventInfo[event]);CHKERRQ(ierr);}
+  if (PetscLogMemory) {
+    ierr = PetscLogMallocSubtract(&eventPerfLog->eventInfo[event]);CHKERRQ(ierr);
+    ierr = PetscMallocPushMaximumUsage(event);CHKERRQ(ierr);
+  }
   PetscFunctionReturn(0);
 }
 
@@ -789,6 +859,11 @@ PetscErrorCode PetscLogEventEndComplete(PetscLogEvent event,int t,PetscObject o1
   eventPerfLog->eventInfo[event].numMessages   += petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
   eventPerfLog->eventInfo[event].messageLength += petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
   eventPerfLog->eventInfo[event].numReductions += petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+  if (petsc_logHWCounters) {ierr = PetscLogHWCountersAdd(&eventPerfLog->eventInfo[event]);CHKERRQ(ierr);}
+  if (PetscLogMemory) {
+    ierr = PetscLogMallocPopMaximumUsage(event,&eventPerfLog->eventInfo[event]);CHKERRQ(ierr);
+    ierr = PetscLogMallocAdd(&eventPerfLog->eventInfo[event]);CHKERRQ(ierr);
+  }
   PetscFunctionReturn(0);
 }
 
@@ -858,3 +933,45 @@ PetscErrorCode PetscLogEventEndTrace(PetscLogEvent event,int t,PetscObject o1,Pe
   if (err) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SYS,"fflush() failed on file");
   PetscFunctionReturn(0);
 }
+
+/* Appends a record to the ring buffer, overwriting the oldest record once it is full */
+PETSC_STATIC_INLINE PetscErrorCode PetscLogTraceJSONRecord_Private(PetscLogEvent event,int action)
+{
+  PetscStageLog  stageLog;
+  TraceRecord    *record;
+  PetscLogDouble curTime;
+  int            stage;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
+  ierr = PetscStageLogGetCurrent(stageLog,&stage);CHKERRQ(ierr);
+  PetscTime(&curTime);
+  record         = &petsc_traceRecords[petsc_numTraceRecords % petsc_maxTraceRecords];
+  record->time   = curTime - petsc_BaseTime;
+  record->event  = event;
+  record->stage  = stage;
+  record->action = action;
+  petsc_numTraceRecords++;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscLogEventBeginTraceJSON(PetscLogEvent event,int t,PetscObject o1,PetscObject o2,PetscObject o3,PetscObject o4)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLogEventBeginDefault(event,t,o1,o2,o3,o4);CHKERRQ(ierr);
+  ierr = PetscLogTraceJSONRecord_Private(event,ACTIONBEGIN);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscLogEventEndTraceJSON(PetscLogEvent event,int t,PetscObject o1,PetscObject o2,PetscObject o3,PetscObject o4)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLogTraceJSONRecord_Private(event,ACTIONEND);CHKERRQ(ierr);
+  ierr = PetscLogEventEndDefault(event,t,o1,o2,o3,o4);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,193 @@
+/*
+     Hardware performance counters for the event and stage logging, read with the Linux perf_event_open() interface.
+   Like the rest of this directory this is a private API used only by the PetscLog...() interface.
+*/
+#include <petsc/private/logimpl.h>  /*I    "petscsys.h"   I*/
+#if defined(PETSC_HAVE_LINUX_PERF_EVENT_H) && defined(PETSC_HAVE_SYS_SYSCALL_H) && defined(PETSC_HAVE_UNISTD_H)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+#define PETSC_USE_PERF_EVENT
+#endif
+
+PetscBool petsc_logHWCounters       = PETSC_FALSE;
+PetscBool petsc_logHWCountersFailed = PETSC_FALSE; /* requested but could not be opened, reported by PetscLogView() */
+
+#if defined(PETSC_USE_PERF_EVENT)
+/* The counters are read as one group so that they are scheduled (and multiplexed) together */
+static int PetscLogHWCountersFd[PETSC_LOG_HW_COUNTERS] = {-1,-1,-1};
+
+static PetscErrorCode PetscLogHWCountersOpen_Private(__u64 config,int group,int *fd)
+{
+  struct perf_event_attr attr;
+
+  PetscFunctionBegin;
+  memset(&attr,0,sizeof(attr));
+  attr.type           = PERF_TYPE_HARDWARE;
+  attr.size           = sizeof(attr);
+  attr.config         = config;
+  attr.disabled       = (group == -1);
+  attr.exclude_kernel = 1;
+  attr.exclude_hv     = 1;
+  attr.read_format    = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  *fd = (int)syscall(__NR_perf_event_open,&attr,0,-1,group,0);
+  PetscFunctionReturn(0);
+}
+#endif
+
+/*
+   PetscLogHWCountersRead - Reads the current values of the counters, scaled up if the kernel had to multiplex them
+*/
+PETSC_STATIC_INLINE PetscErrorCode PetscLogHWCountersRead(PetscLogDouble values[])
+{
+#if defined(PETSC_USE_PERF_EVENT)
+  /* nr, time enabled, time running, then one value per counter */
+  __u64          buf[3+PETSC_LOG_HW_COUNTERS];
+  PetscLogDouble scale = 1.0;
+  int            i;
+
+  PetscFunctionBegin;
+  if (read(PetscLogHWCountersFd[0],buf,sizeof(buf)) != (ssize_t)sizeof(buf)) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SYS,"Unable to read hardware counters, errno %d",errno);
+  if (buf[2] && buf[2] < buf[1]) scale = (PetscLogDouble)buf[1]/(PetscLogDouble)buf[2];
+  for (i=0; i<PETSC_LOG_HW_COUNTERS; i++) values[i] = scale*(PetscLogDouble)buf[3+i];
+  PetscFunctionReturn(0);
+#else
+  SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP_SYS,"Hardware counters require Linux perf_event_open()");
+#endif
+}
+
+/*
+   PetscLogHWCountersSubtract - Starts an interval for the counters in a PetscEventPerfInfo, in the same way
+   that the time and flops are started by subtracting their current values
+*/
+PetscErrorCode PetscLogHWCountersSubtract(PetscEventPerfInfo *info)
+{
+  PetscLogDouble values[PETSC_LOG_HW_COUNTERS];
+  PetscErrorCode ierr;
+  int            i;
+
+  PetscFunctionBegin;
+  ierr = PetscLogHWCountersRead(values);CHKERRQ(ierr);
+  for (i=0; i<PETSC_LOG_HW_COUNTERS; i++) info->hwCounters[i] -= values[i];
+  PetscFunctionReturn(0);
+}
+
+/*
+   PetscLogHWCountersAdd - Ends an interval started with PetscLogHWCountersSubtract()
+*/
+PetscErrorCode PetscLogHWCountersAdd(PetscEventPerfInfo *info)
+{
+  PetscLogDouble values[PETSC_LOG_HW_COUNTERS];
+  PetscErrorCode ierr;
+  int            i;
+
+  PetscFunctionBegin;
+  ierr = PetscLogHWCountersRead(values);CHKERRQ(ierr);
+  for (i=0; i<PETSC_LOG_HW_COUNTERS; i++) info->hwCounters[i] += values[i];
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscLogHWCountersBegin - Counts CPU cycles, instructions and last level cache misses in every logged event and
+  stage, using the Linux perf_event_open() interface. PetscLogView() then reports them, together with the memory
+  traffic estimated from the cache misses, the achieved bandwidth and the arithmetic intensity of each event.
+
+  Not Collective
+
+  Options Database Key:
+. -log_hw_counters - Activates PetscLogHWCountersBegin()
+
+  Notes:
+  Only the calling thread is counted, in user space. If the counters cannot be opened, for example because
+  /proc/sys/kernel/perf_event_paranoid does not allow it, a message is printed with -info, logging continues
+  without them and PetscLogView() says that they are not available.
+
+  The memory traffic is estimated as 64 bytes per last level cache miss; it does not include write-backs or
+  hardware prefetches, so the bandwidth it gives is a lower bound for streaming kernels.
+
+  Reading the counters costs a system call at the beginning and end of each event, so very short events are slowed down.
+
+  This must be used with the default logging (-log_view), not with the nested (-log_view :file.xml:ascii_xml) logging.
+
+  Level: advanced
+
+.seealso: PetscLogView(), PetscLogDefaultBegin()
+@*/
+PetscErrorCode PetscLogHWCountersBegin(void)
+{
+#if defined(PETSC_USE_PERF_EVENT)
+  static const __u64 config[PETSC_LOG_HW_COUNTERS] = {PERF_COUNT_HW_CPU_CYCLES,PERF_COUNT_HW_INSTRUCTIONS,PERF_COUNT_HW_CACHE_MISSES};
+  PetscStageLog      stageLog;
+  int                i,stage;
+#endif
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  if (petsc_logHWCounters) PetscFunctionReturn(0);
+#if defined(PETSC_USE_PERF_EVENT)
+  for (i=0; i<PETSC_LOG_HW_COUNTERS; i++) {
+    ierr = PetscLogHWCountersOpen_Private(config[i],i ? PetscLogHWCountersFd[0] : -1,&PetscLogHWCountersFd[i]);CHKERRQ(ierr);
+    if (PetscLogHWCountersFd[i] < 0) {
+      ierr = PetscInfo1(NULL,"perf_event_open() failed with errno %d, hardware counters are not logged\n",errno);CHKERRQ(ierr);
+      ierr = PetscLogHWCountersEnd();CHKERRQ(ierr);
+      petsc_logHWCountersFailed = PETSC_TRUE;
+      PetscFunctionReturn(0);
+    }
+  }
+  if (ioctl(PetscLogHWCountersFd[0],PERF_EVENT_IOC_ENABLE,PERF_IOC_FLAG_GROUP)) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SYS,"Unable to enable hardware counters, errno %d",errno);
+  petsc_logHWCounters = PETSC_TRUE;
+  /* if logging has already started, the current stage is inside an interval */
+  if (petsc_stageLog) {
+    ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
+    ierr = PetscStageLogGetCurrent(stageLog,&stage);CHKERRQ(ierr);
+    if (stage >= 0 && stageLog->stageInfo[stage].perfInfo.active) {
+      ierr = PetscLogHWCountersSubtract(&stageLog->stageInfo[stage].perfInfo);CHKERRQ(ierr);
+    }
+  }
+#else
+  ierr = PetscInfo(NULL,"PETSc was not configured with Linux perf_event_open(), hardware counters are not logged\n");CHKERRQ(ierr);
+  petsc_logHWCountersFailed = PETSC_TRUE;
+#endif
+  PetscFunctionReturn(0);
+}
+
+/*@C
+  PetscLogHWCountersEnd - Stops counting with hardware counters, the values already collected are kept
+
+  Not Collective
+
+  Notes:
+  Events that are active when this is called do not get the counts of their last interval.
+
+  Level: advanced
+
+.seealso: PetscLogHWCountersBegin()
+@*/
+PetscErrorCode PetscLogHWCountersEnd(void)
+{
+#if defined(PETSC_USE_PERF_EVENT)
+  PetscStageLog  stageLog;
+  int            i,stage;
+  PetscErrorCode ierr;
+#endif
+
+  PetscFunctionBegin;
+#if defined(PETSC_USE_PERF_EVENT)
+  if (petsc_logHWCounters && petsc_stageLog) {
+    ierr = PetscLogGetStageLog(&stageLog);CHKERRQ(ierr);
+    ierr = PetscStageLogGetCurrent(stageLog,&stage);CHKERRQ(ierr);
+    if (stage >= 0 && stageLog->stageInfo[stage].perfInfo.active) {
+      ierr = PetscLogHWCountersAdd(&stageLog->stageInfo[stage].perfInfo);CHKERRQ(ierr);
+    }
+  }
+  petsc_logHWCounters = PETSC_FALSE;
+  for (i=PETSC_LOG_HW_COUNTERS-1; i>=0; i--) {
+    if (PetscLogHWCountersFd[i] >= 0) close(PetscLogHWCountersFd[i]);
+    PetscLogHWCountersFd[i] = -1;
+  }
+#endif
+  PetscFunctionReturn(0);
+}
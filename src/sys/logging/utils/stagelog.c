@@ -271,6 +271,8 @@ PetscErrorCode  PetscStageLogPush(PetscStageLog stageLog, int stage)
       stageLog->stageInfo[curStage].perfInfo.numMessages   += petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
       stageLog->stageInfo[curStage].perfInfo.messageLength += petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
       stageLog->stageInfo[curStage].perfInfo.numReductions += petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+      if (petsc_logHWCounters) {ierr = PetscLogHWCountersAdd(&stageLog->stageInfo[curStage].perfInfo);CHKERRQ(ierr);}
+      if (PetscLogMemory) {ierr = PetscLogMallocAdd(&stageLog->stageInfo[curStage].perfInfo);CHKERRQ(ierr);}
     }
   }
   /* Activate the stage */
@@ -286,6 +288,11 @@ PetscErrorCode  PetscStageLogPush(PetscStageLog stageLog, int stage)
     stageLog->stageInfo[stage].perfInfo.numMessages   -= petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
     stageLog->stageInfo[stage].perfInfo.messageLength -= petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
     stageLog->stageInfo[stage].perfInfo.numReductions -= petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+    if (petsc_logHWCounters) {ierr = PetscLogHWCountersSubtract(&stageLog->stageInfo[stage].perfInfo);CHKERRQ(ierr);}
+    if (PetscLogMemory) {
+      ierr = PetscLogMallocSubtract(&stageLog->stageInfo[stage].perfInfo);CHKERRQ(ierr);
+      ierr = PetscMallocPushMaximumUsage(-1-stage);CHKERRQ(ierr);
+    }
   }
   PetscFunctionReturn(0);
 }
@@ -336,6 +343,11 @@ PetscErrorCode  PetscStageLogPop(PetscStageLog stageLog)
     stageLog->stageInfo[curStage].perfInfo.numMessages   += petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
     stageLog->stageInfo[curStage].perfInfo.messageLength += petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
     stageLog->stageInfo[curStage].perfInfo.numReductions += petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+    if (petsc_logHWCounters) {ierr = PetscLogHWCountersAdd(&stageLog->stageInfo[curStage].perfInfo);CHKERRQ(ierr);}
+    if (PetscLogMemory) {
+      ierr = PetscLogMallocPopMaximumUsage(-1-curStage,&stageLog->stageInfo[curStage].perfInfo);CHKERRQ(ierr);
+      ierr = PetscLogMallocAdd(&stageLog->stageInfo[curStage].perfInfo);CHKERRQ(ierr);
+    }
   }
   ierr = PetscIntStackEmpty(stageLog->stack, &empty);CHKERRQ(ierr);
   if (!empty) {
@@ -347,6 +359,8 @@ PetscErrorCode  PetscStageLogPop(PetscStageLog stageLog)
       stageLog->stageInfo[curStage].perfInfo.numMessages   -= petsc_irecv_ct  + petsc_isend_ct  + petsc_recv_ct  + petsc_send_ct;
       stageLog->stageInfo[curStage].perfInfo.messageLength -= petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
       stageLog->stageInfo[curStage].perfInfo.numReductions -= petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+      if (petsc_logHWCounters) {ierr = PetscLogHWCountersSubtract(&stageLog->stageInfo[curStage].perfInfo);CHKERRQ(ierr);}
+      if (PetscLogMemory) {ierr = PetscLogMallocSubtract(&stageLog->stageInfo[curStage].perfInfo);CHKERRQ(ierr);}
     }
     stageLog->curStage = curStage;
   } else stageLog->curStage = -1;
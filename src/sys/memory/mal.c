@@ -1,7 +1,7 @@
 /*
     Code that allows a user to dictate what malloc() PETSc uses.
 */
-#include <petscsys.h>             /*I   "petscsys.h"   I*/
+#include <petsc/private/petscimpl.h>  /*I   "petscsys.h"   I*/
 #include <stdarg.h>
 #if defined(PETSC_HAVE_MALLOC_H)
 #include <malloc.h>
@@ -458,3 +458,242 @@ PetscErrorCode PetscFreeA(int n,int lineno,const char *function,const char *file
   }
   PetscFunctionReturn(0);
 }
+
+/*
+    The arena is a list of chunks, the most recent first, from which memory is taken by bumping an offset.
+    PetscMallocArenaPush() records the position in the most recent chunk and PetscMallocArenaPop() returns to it,
+    freeing the chunks that were added in between. The largest chunk is kept between outermost scopes, if it is
+    not larger than PETSC_MALLOC_ARENA_MAXKEEP, so that repeated setup calls reuse the same (already mapped) memory.
+
+    Each scope records the function that pushed it; PetscError() calls PetscMallocArenaUnwind() with the function
+    an error is returned from, which pops the scopes that function left open.
+*/
+typedef struct _n_PetscMallocArenaChunk *PetscMallocArenaChunk;
+struct _n_PetscMallocArenaChunk {
+  PetscMallocArenaChunk prev;   /* the chunk allocated before this one */
+  size_t                size;   /* usable bytes after the header */
+  size_t                used;   /* bytes handed out */
+};
+
+#define PETSC_MALLOC_ARENA_HEADER  ((sizeof(struct _n_PetscMallocArenaChunk) + PETSC_MEMALIGN-1) & ~(PETSC_MEMALIGN-1))
+#define PETSC_MALLOC_ARENA_DEFAULT 65536
+#define PETSC_MALLOC_ARENA_MAXKEEP 4194304
+#define PETSC_MALLOC_ARENA_MAXDEPTH 32
+
+static PetscMallocArenaChunk arenaChunk = NULL;
+static int                   arenaDepth = 0;
+static PetscMallocArenaChunk arenaMarkChunk[PETSC_MALLOC_ARENA_MAXDEPTH];
+static size_t                arenaMarkUsed[PETSC_MALLOC_ARENA_MAXDEPTH];
+static const char            *arenaMarkFunction[PETSC_MALLOC_ARENA_MAXDEPTH];
+static PetscBool             arenaRegistered = PETSC_FALSE;
+
+static PetscErrorCode PetscMallocArenaFreeChunks_Private(PetscMallocArenaChunk mark)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  while (arenaChunk != mark) {
+    PetscMallocArenaChunk prev = arenaChunk->prev;
+
+    ierr       = (*PetscTrFree)(arenaChunk,__LINE__,PETSC_FUNCTION_NAME,__FILE__);CHKERRQ(ierr);
+    arenaChunk = prev;
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscMallocArenaFinalize_Private(void)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr            = PetscMallocArenaFreeChunks_Private(NULL);CHKERRQ(ierr);
+  arenaDepth      = 0;
+  arenaRegistered = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscMallocArenaAddChunk_Private(size_t size)
+{
+  PetscMallocArenaChunk chunk;
+  PetscErrorCode        ierr;
+
+  PetscFunctionBegin;
+  if (!arenaRegistered) {
+    ierr = PetscRegisterFinalize(PetscMallocArenaFinalize_Private);CHKERRQ(ierr);
+    arenaRegistered = PETSC_TRUE;
+  }
+  if (arenaChunk) size = PetscMax(size,2*arenaChunk->size);
+  size  = PetscMax(size,PETSC_MALLOC_ARENA_DEFAULT);
+  size  = (size + PETSC_MEMALIGN-1) & ~(PETSC_MEMALIGN-1);
+  ierr  = (*PetscTrMalloc)(PETSC_MALLOC_ARENA_HEADER+size,__LINE__,PETSC_FUNCTION_NAME,__FILE__,(void**)&chunk);CHKERRQ(ierr);
+  chunk->prev = arenaChunk;
+  chunk->size = size;
+  chunk->used = 0;
+  arenaChunk  = chunk;
+  PetscFunctionReturn(0);
+}
+
+/* Ends the innermost scope */
+static PetscErrorCode PetscMallocArenaPop_Private(void)
+{
+  PetscMallocArenaChunk mark;
+  PetscErrorCode        ierr;
+
+  PetscFunctionBegin;
+  arenaDepth--;
+  if (arenaDepth) {
+    ierr = PetscMallocArenaFreeChunks_Private(arenaMarkChunk[arenaDepth]);CHKERRQ(ierr);
+    arenaChunk->used = arenaMarkUsed[arenaDepth];
+    PetscFunctionReturn(0);
+  }
+  /* keep only the largest chunk, the most recent one, for the next scope, unless it is too large to hold on to */
+  mark = arenaChunk->size <= PETSC_MALLOC_ARENA_MAXKEEP ? arenaChunk : NULL;
+  if (mark) {
+    while (mark->prev) {
+      PetscMallocArenaChunk prev = mark->prev->prev;
+
+      ierr       = (*PetscTrFree)(mark->prev,__LINE__,PETSC_FUNCTION_NAME,__FILE__);CHKERRQ(ierr);
+      mark->prev = prev;
+    }
+    mark->used = 0;
+  } else {
+    ierr = PetscMallocArenaFreeChunks_Private(NULL);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscMallocArenaPushA - Starts a scope in which PetscMallocArena1() and friends take memory from an arena,
+   all of which is released at once by the matching PetscMallocArenaPop()
+
+   Not Collective
+
+   Input Parameters:
++  size - an estimate of the number of bytes that will be allocated in the scope, or 0
+-  function - the function that starts the scope (typically PETSC_FUNCTION_NAME)
+
+   Notes:
+   This function is not normally called directly, but rather via the macro PetscMallocArenaPush().
+
+   Level: developer
+
+.seealso: PetscMallocArenaPush(), PetscMallocArenaPop()
+@*/
+PetscErrorCode PetscMallocArenaPushA(size_t size,const char function[])
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (arenaDepth >= PETSC_MALLOC_ARENA_MAXDEPTH) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Arena scopes nested more than %d deep",PETSC_MALLOC_ARENA_MAXDEPTH);
+  if (!arenaChunk || arenaChunk->size - arenaChunk->used < size) {
+    ierr = PetscMallocArenaAddChunk_Private(size);CHKERRQ(ierr);
+  }
+  arenaMarkChunk[arenaDepth]    = arenaChunk;
+  arenaMarkUsed[arenaDepth]     = arenaChunk->used;
+  arenaMarkFunction[arenaDepth] = function;
+  arenaDepth++;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscMallocArenaPop - Ends the scope started with PetscMallocArenaPush(), releasing all the memory obtained in it
+
+   Not Collective
+
+   Notes:
+   If the function that called PetscMallocArenaPush() returns an error before PetscMallocArenaPop(), through
+   CHKERRQ() or SETERRQ(), its scope is ended by PetscError(), so the scope must be pushed and popped in the same function.
+
+   Level: developer
+
+.seealso: PetscMallocArenaPush(), PetscMallocArenaA()
+@*/
+PetscErrorCode PetscMallocArenaPop(void)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!arenaDepth) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"PetscMallocArenaPop() without PetscMallocArenaPush()");
+  ierr = PetscMallocArenaPop_Private();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   PetscMallocArenaUnwind - Called by PetscError() when function returns an error, ends the scopes that function
+   pushed and those of the functions it called that were not ended
+*/
+PetscErrorCode PetscMallocArenaUnwind(const char function[])
+{
+  PetscBool      flg = PETSC_FALSE;
+  PetscErrorCode ierr;
+  int            d;
+
+  PetscFunctionBegin;
+  if (!function) PetscFunctionReturn(0);
+  for (d=arenaDepth-1; d>=0; d--) {
+    ierr = PetscStrcmp(arenaMarkFunction[d],function,&flg);CHKERRQ(ierr);
+    if (flg) break;
+  }
+  if (!flg) PetscFunctionReturn(0);
+  while (arenaDepth > d) {ierr = PetscMallocArenaPop_Private();CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscMallocArenaA - Allocate and optionally clear one or more objects from the arena of the current PetscMallocArenaPush() scope
+
+   Not Collective
+
+   Input Parameters:
++  n - number of objects to allocate (at least 1)
+.  clear - initialize the space to zero
+.  lineno - line number to attribute allocation (typically __LINE__)
+.  function - function to attribute allocation (typically PETSC_FUNCTION_NAME)
+.  filename - file name to attribute allocation (typically __FILE__)
+-  bytes0 - first of n object sizes
+
+   Output Parameters:
+.  ptr0 - first of n pointers to allocate
+
+   Notes:
+   This function is not normally called directly, but rather via the macros PetscMallocArena1(), PetscMallocArena2(), or PetscCallocArena1().
+   The space is released by PetscMallocArenaPop(), it must not be freed with PetscFree().
+
+   Level: developer
+
+.seealso: PetscMallocArenaPush(), PetscMallocArenaPop(), PetscMallocA()
+@*/
+PetscErrorCode PetscMallocArenaA(int n,PetscBool clear,int lineno,const char *function,const char *filename,size_t bytes0,void *ptr0,...)
+{
+  PetscErrorCode ierr;
+  va_list        Argp;
+  size_t         bytes[8],sumbytes;
+  void           **ptr[8];
+  char           *p;
+  int            i;
+
+  PetscFunctionBegin;
+  if (!arenaDepth) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Arena allocation in %s() line %d outside of PetscMallocArenaPush()/PetscMallocArenaPop()",function,lineno);
+  if (n > 8) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Attempt to allocate %d objects but only 8 supported",n);
+  bytes[0] = bytes0;
+  ptr[0]   = (void**)ptr0;
+  sumbytes = (bytes0 + PETSC_MEMALIGN-1) & ~(PETSC_MEMALIGN-1);
+  va_start(Argp,ptr0);
+  for (i=1; i<n; i++) {
+    bytes[i] = va_arg(Argp,size_t);
+    ptr[i]   = va_arg(Argp,void**);
+    sumbytes += (bytes[i] + PETSC_MEMALIGN-1) & ~(PETSC_MEMALIGN-1);
+  }
+  va_end(Argp);
+  if (arenaChunk->size - arenaChunk->used < sumbytes) {
+    ierr = PetscMallocArenaAddChunk_Private(sumbytes);CHKERRQ(ierr);
+  }
+  p = (char*)arenaChunk + PETSC_MALLOC_ARENA_HEADER + arenaChunk->used;
+  arenaChunk->used += sumbytes;
+  for (i=0; i<n; i++) {
+    *ptr[i] = bytes[i] ? p : NULL;
+    if (clear && bytes[i]) {ierr = PetscMemzero(p,bytes[i]);CHKERRQ(ierr);}
+    p += (bytes[i] + PETSC_MEMALIGN-1) & ~(PETSC_MEMALIGN-1);
+  }
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,235 @@
+#include <petscsys.h>             /*I   "petscsys.h"   I*/
+
+#if defined(PETSC_HAVE_LINUX_MEMPOLICY_H) && defined(PETSC_HAVE_SYS_SYSCALL_H) && defined(PETSC_HAVE_UNISTD_H)
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <errno.h>
+#if defined(__NR_mbind) && defined(__NR_get_mempolicy) && defined(__NR_move_pages) && defined(__NR_getcpu)
+#define PETSC_USE_NUMA_SYSCALLS
+#endif
+#endif
+
+const char *const PetscMallocNUMAPolicies[] = {"DEFAULT","INTERLEAVE","FIRST_TOUCH","LOCAL","PetscMallocNUMAPolicy","PETSC_MALLOC_NUMA_",0};
+
+static PetscMallocNUMAPolicy petscmallocnumapolicy    = PETSC_MALLOC_NUMA_DEFAULT;
+static size_t                petscmallocnumathreshold = 1048576;
+static PetscBool             petscmallocnumaview      = PETSC_FALSE;
+
+#if defined(PETSC_USE_NUMA_SYSCALLS)
+/* the node masks are passed to the kernel as bit arrays, large enough for any machine */
+#define PETSC_MALLOC_NUMA_MAXNODES 1024
+#define PETSC_MALLOC_NUMA_MASKLEN  (PETSC_MALLOC_NUMA_MAXNODES/(8*sizeof(unsigned long)))
+
+/*
+   PetscMallocNUMAPages_Private - Gives the whole pages inside [ptr,ptr+bytes), only those can be given a policy
+   without changing the placement of the memory around the array
+*/
+static void PetscMallocNUMAPages_Private(const void *ptr,size_t bytes,char **start,size_t *len)
+{
+  size_t pagesize = (size_t)sysconf(_SC_PAGESIZE);
+  size_t first    = ((size_t)ptr + pagesize-1) & ~(pagesize-1);
+  size_t last     = ((size_t)ptr + bytes) & ~(pagesize-1);
+
+  *start = (char*)first;
+  *len   = last > first ? last - first : 0;
+}
+#endif
+
+/*@C
+   PetscMallocSetNUMAPolicy - Sets on which NUMA nodes the pages of large Vec and Mat arrays are placed
+
+   Not Collective
+
+   Input Parameters:
++  policy - the placement, see PetscMallocNUMAPolicy
+-  threshold - arrays smaller than this many bytes are not placed, they usually share pages with other allocations
+
+   Options Database Keys:
++  -malloc_numa <default,interleave,first_touch,local> - the placement policy
+.  -malloc_numa_threshold <bytes> - the threshold, 1 MB by default
+-  -malloc_numa_view - prints on which nodes the pages of each large Vec and Mat array were when it is destroyed
+
+   Notes:
+   The policy is applied with PetscMallocNUMAPlace() to the arrays of VECSEQ, VECMPI and MATSEQAIJ (and so the diagonal
+   and off-diagonal parts of MATMPIAIJ) right after they are allocated, before their values are first written.
+
+   With one MPI process per socket and a multi-threaded BLAS or OpenMP, FIRST_TOUCH keeps each page next to the
+   thread that initializes it, LOCAL keeps all of them on the socket of the process, and INTERLEAVE spreads the
+   bandwidth over all the sockets for processes that are not bound.
+
+   This requires Linux; on other systems the arrays are left where malloc() put them.
+
+   Level: intermediate
+
+.seealso: PetscMallocGetNUMAPolicy(), PetscMallocNUMAPlace(), PetscMallocNUMAViewFromOptions(), PetscMallocNUMAPolicy
+@*/
+PetscErrorCode PetscMallocSetNUMAPolicy(PetscMallocNUMAPolicy policy,size_t threshold)
+{
+  PetscFunctionBegin;
+  petscmallocnumapolicy    = policy;
+  petscmallocnumathreshold = threshold;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscMallocGetNUMAPolicy - Gets the NUMA placement of large Vec and Mat arrays set with PetscMallocSetNUMAPolicy()
+
+   Not Collective
+
+   Output Parameters:
++  policy - the placement, see PetscMallocNUMAPolicy
+-  threshold - arrays smaller than this many bytes are not placed
+
+   Level: intermediate
+
+.seealso: PetscMallocSetNUMAPolicy()
+@*/
+PetscErrorCode PetscMallocGetNUMAPolicy(PetscMallocNUMAPolicy *policy,size_t *threshold)
+{
+  PetscFunctionBegin;
+  if (policy)    *policy    = petscmallocnumapolicy;
+  if (threshold) *threshold = petscmallocnumathreshold;
+  PetscFunctionReturn(0);
+}
+
+PETSC_INTERN PetscErrorCode PetscMallocSetNUMAView_Private(PetscBool flg)
+{
+  PetscFunctionBegin;
+  petscmallocnumaview = flg;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscMallocNUMAPlace - Applies the policy set with PetscMallocSetNUMAPolicy() to an array obtained with PetscMalloc()
+
+   Not Collective
+
+   Input Parameters:
++  ptr - the array
+-  bytes - its length in bytes
+
+   Notes:
+   This should be called before the array is first written, only LOCAL and INTERLEAVE move pages that were already written.
+
+   Only the pages that lie entirely in the array are placed. Nothing is done for arrays smaller than the threshold,
+   or if the kernel does not allow the placement, in which case a message is printed with -info.
+
+   Level: developer
+
+.seealso: PetscMallocSetNUMAPolicy(), PetscMallocNUMAViewFromOptions()
+@*/
+PetscErrorCode PetscMallocNUMAPlace(void *ptr,size_t bytes)
+{
+#if defined(PETSC_USE_NUMA_SYSCALLS)
+  unsigned long  mask[PETSC_MALLOC_NUMA_MASKLEN];
+  unsigned int   cpu,node;
+  char           *start;
+  size_t         len;
+  long           err = 0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (petscmallocnumapolicy == PETSC_MALLOC_NUMA_DEFAULT || !ptr || bytes < petscmallocnumathreshold) PetscFunctionReturn(0);
+  PetscMallocNUMAPages_Private(ptr,bytes,&start,&len);
+  if (!len) PetscFunctionReturn(0);
+  ierr = PetscMemzero(mask,sizeof(mask));CHKERRQ(ierr);
+  switch (petscmallocnumapolicy) {
+  case PETSC_MALLOC_NUMA_INTERLEAVE:
+    err = syscall(__NR_get_mempolicy,NULL,mask,PETSC_MALLOC_NUMA_MAXNODES,NULL,MPOL_F_MEMS_ALLOWED);
+    if (!err) err = syscall(__NR_mbind,start,len,MPOL_INTERLEAVE,mask,PETSC_MALLOC_NUMA_MAXNODES+1,MPOL_MF_MOVE);
+    break;
+  case PETSC_MALLOC_NUMA_FIRST_TOUCH:
+    /* the default policy of the kernel places each page on the node of the thread that first writes it */
+    err = syscall(__NR_mbind,start,len,MPOL_DEFAULT,NULL,0,0);
+    break;
+  case PETSC_MALLOC_NUMA_LOCAL:
+    err = syscall(__NR_getcpu,&cpu,&node,NULL);
+    if (!err) {
+      if (node >= PETSC_MALLOC_NUMA_MAXNODES) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP_SYS,"NUMA node %u is too large",node);
+      mask[node/(8*sizeof(unsigned long))] |= 1UL << (node%(8*sizeof(unsigned long)));
+      err = syscall(__NR_mbind,start,len,MPOL_BIND,mask,PETSC_MALLOC_NUMA_MAXNODES+1,MPOL_MF_MOVE);
+    }
+    break;
+  default: SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Unknown NUMA policy %d",(int)petscmallocnumapolicy);
+  }
+  if (err) {ierr = PetscInfo2(NULL,"NUMA placement %s of %.0f bytes failed, the array is left where it is\n",PetscMallocNUMAPolicies[petscmallocnumapolicy],(PetscLogDouble)bytes);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+#else
+  PetscFunctionBegin;
+  PetscFunctionReturn(0);
+#endif
+}
+
+/*@C
+   PetscMallocNUMAViewFromOptions - Prints on which NUMA nodes the pages of a large array are, if -malloc_numa_view was given
+
+   Not Collective
+
+   Input Parameters:
++  ptr - the array
+.  bytes - its length in bytes
+-  label - a name for the array printed with the counts
+
+   Notes:
+   Pages that have not yet been written have no node and are counted as untouched. The kernel policy of the pages,
+   queried with get_mempolicy(), is printed after the counts. The arrays of Vec and Mat are reported when they are
+   destroyed, when they are all written.
+
+   Level: developer
+
+.seealso: PetscMallocSetNUMAPolicy(), PetscMallocNUMAPlace()
+@*/
+PetscErrorCode PetscMallocNUMAViewFromOptions(const void *ptr,size_t bytes,const char label[])
+{
+#if defined(PETSC_USE_NUMA_SYSCALLS)
+  void           *pages[512];
+  int            status[512],i,nodes[PETSC_MALLOC_NUMA_MAXNODES],maxnode = -1;
+  size_t         pagesize = (size_t)sysconf(_SC_PAGESIZE),len,off,slen,untouched = 0;
+  char           *start,line[1024];
+  const char     *policy = "unknown";
+  int            mode;
+  PetscMPIInt    rank;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!petscmallocnumaview || !ptr || bytes < petscmallocnumathreshold) PetscFunctionReturn(0);
+  PetscMallocNUMAPages_Private(ptr,bytes,&start,&len);
+  if (!len) PetscFunctionReturn(0);
+  ierr = PetscMemzero(nodes,sizeof(nodes));CHKERRQ(ierr);
+  for (off=0; off<len; ) {
+    int n = 0;
+
+    for (; off<len && n<512; off+=pagesize) pages[n++] = start + off;
+    /* with no target nodes move_pages() only returns the node of each page */
+    if (syscall(__NR_move_pages,0,(unsigned long)n,pages,NULL,status,0)) {
+      ierr = PetscInfo1(NULL,"Unable to query the NUMA nodes of the pages of %s\n",label);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+    for (i=0; i<n; i++) {
+      if (status[i] >= 0 && status[i] < PETSC_MALLOC_NUMA_MAXNODES) {nodes[status[i]]++; maxnode = PetscMax(maxnode,status[i]);}
+      else untouched++;
+    }
+  }
+  /* print one line at once so that the lines of different processes are not mixed */
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = PetscSNPrintf(line,sizeof(line),"[%d] %s %.1f MB pages on node",rank,label,bytes*1e-6);CHKERRQ(ierr);
+  for (i=0; i<=maxnode; i++) {
+    ierr = PetscStrlen(line,&slen);CHKERRQ(ierr);
+    ierr = PetscSNPrintf(line+slen,sizeof(line)-slen," %d: %d",i,nodes[i]);CHKERRQ(ierr);
+  }
+  if (!syscall(__NR_get_mempolicy,&mode,NULL,0,start,MPOL_F_ADDR)) {
+    switch (mode) {
+    case MPOL_DEFAULT:    policy = "default";    break;
+    case MPOL_PREFERRED:  policy = "preferred";  break;
+    case MPOL_BIND:       policy = "bind";       break;
+    case MPOL_INTERLEAVE: policy = "interleave"; break;
+    }
+  }
+  ierr = PetscPrintf(PETSC_COMM_SELF,"%s, untouched: %d, policy %s\n",line,(int)untouched,policy);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+#else
+  PetscFunctionBegin;
+  PetscFunctionReturn(0);
+#endif
+}
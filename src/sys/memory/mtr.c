@@ -19,6 +19,9 @@ PETSC_EXTERN PetscErrorCode PetscReallocAlign(size_t,int,const char[],const char
 PETSC_EXTERN PetscErrorCode PetscTrMallocDefault(size_t,int,const char[],const char[],void**);
 PETSC_EXTERN PetscErrorCode PetscTrFreeDefault(void*,int,const char[],const char[]);
 PETSC_EXTERN PetscErrorCode PetscTrReallocDefault(size_t,int,const char[],const char[],void**);
+PETSC_EXTERN PetscErrorCode PetscTrMallocCount(size_t,int,const char[],const char[],void**);
+PETSC_EXTERN PetscErrorCode PetscTrFreeCount(void*,int,const char[],const char[]);
+PETSC_EXTERN PetscErrorCode PetscTrReallocCount(size_t,int,const char[],const char[],void**);
 
 
 #define CLASSID_VALUE  ((PetscClassId) 0xf0e0d0c9)
@@ -59,6 +62,15 @@ static TRSPACE   *TRhead      = NULL;
 static int       TRid         = 0;
 static PetscBool TRdebugLevel = PETSC_FALSE;
 static size_t    TRMaxMem     = 0;
+static size_t    TRmallocs    = 0;
+/*
+      Stack of the high water marks of the intervals started with PetscMallocPushMaximumUsage()
+*/
+#define MAXTRMAXMEMS 64
+static int        TRMaxMemsDepth = 0;
+static int        TRMaxMemsKey[MAXTRMAXMEMS];
+static size_t     TRMaxMemsStart[MAXTRMAXMEMS];
+static size_t     TRMaxMems[MAXTRMAXMEMS];
 /*
       Arrays to log information on all Mallocs
 */
@@ -82,11 +94,25 @@ PETSC_INTERN PetscErrorCode PetscSetUseTrMalloc_Private(void)
   TRid              = 0;
   TRdebugLevel      = PETSC_FALSE;
   TRMaxMem          = 0;
+  TRmallocs         = 0;
+  TRMaxMemsDepth    = 0;
   PetscLogMallocMax = 10000;
   PetscLogMalloc    = -1;
   PetscFunctionReturn(0);
 }
 
+/*
+   PetscTrMallocAdd_Private - Accounts for nsize more bytes being allocated. Only the most recent interval of the
+   PetscMallocPushMaximumUsage() stack is updated, the others receive its high water mark when it is popped
+*/
+PETSC_STATIC_INLINE void PetscTrMallocAdd_Private(size_t nsize)
+{
+  TRallocated += nsize;
+  if (TRallocated > TRMaxMem) TRMaxMem = TRallocated;
+  if (TRMaxMemsDepth && TRallocated > TRMaxMems[TRMaxMemsDepth-1]) TRMaxMems[TRMaxMemsDepth-1] = TRallocated;
+  TRmallocs++;
+}
+
 /*@C
    PetscMallocValidate - Test the memory for corruption.  This can be used to
    check for memory overwrites.
@@ -198,8 +224,7 @@ PetscErrorCode  PetscTrMallocDefault(size_t a,int lineno,const char function[],c
   head->classid                  = CLASSID_VALUE;
   *(PetscClassId*)(inew + nsize) = CLASSID_VALUE;
 
-  TRallocated += nsize;
-  if (TRallocated > TRMaxMem) TRMaxMem = TRallocated;
+  PetscTrMallocAdd_Private(nsize);
   TRfrags++;
 
 #if defined(PETSC_USE_DEBUG)
@@ -402,8 +427,7 @@ PetscErrorCode PetscTrReallocDefault(size_t len, int lineno, const char function
   head->classid                  = CLASSID_VALUE;
   *(PetscClassId*)(inew + nsize) = CLASSID_VALUE;
 
-  TRallocated += nsize;
-  if (TRallocated > TRMaxMem) TRMaxMem = TRallocated;
+  PetscTrMallocAdd_Private(nsize);
   TRfrags++;
 
 #if defined(PETSC_USE_DEBUG)
@@ -439,6 +463,96 @@ PetscErrorCode PetscTrReallocDefault(size_t len, int lineno, const char function
 }
 
 
+/*
+   The counting malloc keeps only the size of each block, in front of it, so that the memory usage is known
+   (for -log_view_memory) at the cost of one addition per call instead of the checks of PetscTrMallocDefault()
+*/
+#define COUNT_BYTES ((sizeof(size_t)+(PETSC_MEMALIGN-1)) & ~(PETSC_MEMALIGN-1))
+
+PETSC_INTERN PetscErrorCode PetscSetUseTrMallocCount_Private(void)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMallocSet(PetscTrMallocCount,PetscTrFreeCount);CHKERRQ(ierr);
+  PetscTrRealloc = PetscTrReallocCount;
+
+  TRallocated    = 0;
+  TRMaxMem       = 0;
+  TRmallocs      = 0;
+  TRMaxMemsDepth = 0;
+  PetscFunctionReturn(0);
+}
+
+/*
+   PetscTrMallocCount - Malloc that only keeps track of the amount of memory allocated
+
+   Input Parameters:
++   a   - number of bytes to allocate
+.   lineno - line number where used.  Use __LINE__ for this
+-   filename  - file name where used.  Use __FILE__ for this
+*/
+PetscErrorCode PetscTrMallocCount(size_t a,int lineno,const char function[],const char filename[],void **result)
+{
+  char           *inew;
+  size_t         nsize;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!a) { *result = NULL; PetscFunctionReturn(0); }
+  nsize = (a + (PETSC_MEMALIGN-1)) & ~(PETSC_MEMALIGN-1);
+  ierr  = PetscMallocAlign(nsize+COUNT_BYTES,lineno,function,filename,(void**)&inew);CHKERRQ(ierr);
+  *(size_t*)inew = nsize;
+  PetscTrMallocAdd_Private(nsize);
+  *result = (void*)(inew + COUNT_BYTES);
+  PetscFunctionReturn(0);
+}
+
+/*
+   PetscTrFreeCount - Frees memory obtained with PetscTrMallocCount()
+*/
+PetscErrorCode PetscTrFreeCount(void *aa,int line,const char function[],const char file[])
+{
+  char           *a = (char*)aa;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!a) PetscFunctionReturn(0);
+  a           -= COUNT_BYTES;
+  TRallocated -= *(size_t*)a;
+  ierr = PetscFreeAlign(a,line,function,file);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   PetscTrReallocCount - Reallocates memory obtained with PetscTrMallocCount()
+*/
+PetscErrorCode PetscTrReallocCount(size_t len,int lineno,const char function[],const char filename[],void **result)
+{
+  char           *a = (char*)*result;
+  size_t         nsize;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!len) {
+    ierr = PetscTrFreeCount(*result,lineno,function,filename);CHKERRQ(ierr);
+    *result = NULL;
+    PetscFunctionReturn(0);
+  }
+  if (!a) {
+    ierr = PetscTrMallocCount(len,lineno,function,filename,result);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  a           -= COUNT_BYTES;
+  TRallocated -= *(size_t*)a;
+  nsize        = (len + (PETSC_MEMALIGN-1)) & ~(PETSC_MEMALIGN-1);
+  ierr = PetscReallocAlign(nsize+COUNT_BYTES,lineno,function,filename,(void**)&a);CHKERRQ(ierr);
+  *(size_t*)a = nsize;
+  PetscTrMallocAdd_Private(nsize);
+  *result = (void*)(a + COUNT_BYTES);
+  PetscFunctionReturn(0);
+}
+
 /*@C
     PetscMemoryView - Shows the amount of memory currently being used
         in a communicator.
@@ -570,6 +684,100 @@ PetscErrorCode  PetscMallocGetMaximumUsage(PetscLogDouble *space)
   PetscFunctionReturn(0);
 }
 
+/*@
+    PetscMallocGetCount - gets the number of PetscMalloc() and PetscRealloc() calls made during this run
+
+    Not Collective
+
+    Output Parameters:
+.   count - the number of calls
+
+    Level: intermediate
+
+    Notes:
+    This is only counted when PETSc keeps track of the memory, that is with -malloc (the default in debug builds) or -log_view_memory
+
+.seealso: PetscMallocGetCurrentUsage(), PetscMallocGetMaximumUsage(), PetscMallocPushMaximumUsage()
+ @*/
+PetscErrorCode PetscMallocGetCount(PetscLogDouble *count)
+{
+  PetscFunctionBegin;
+  *count = (PetscLogDouble) TRmallocs;
+  PetscFunctionReturn(0);
+}
+
+/*@
+    PetscMallocPushMaximumUsage - starts tracking the largest amount of memory PetscMalloc()ed during an interval of the run,
+        the interval ends with PetscMallocPopMaximumUsage()
+
+    Not Collective
+
+    Input Parameter:
+.   key - identifies the interval, it is passed again to PetscMallocPopMaximumUsage()
+
+    Level: developer
+
+    Notes:
+    The intervals are normally nested, but they may also overlap. Intervals nested more than 64 deep are not tracked.
+
+    This is used by the event and stage logging for -log_view_memory.
+
+.seealso: PetscMallocPopMaximumUsage(), PetscMallocGetMaximumUsage()
+ @*/
+PetscErrorCode PetscMallocPushMaximumUsage(int key)
+{
+  PetscFunctionBegin;
+  if (TRMaxMemsDepth < MAXTRMAXMEMS) {
+    TRMaxMemsKey[TRMaxMemsDepth]   = key;
+    TRMaxMemsStart[TRMaxMemsDepth] = TRallocated;
+    TRMaxMems[TRMaxMemsDepth]      = TRallocated;
+    TRMaxMemsDepth++;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@
+    PetscMallocPopMaximumUsage - ends an interval started with PetscMallocPushMaximumUsage()
+
+    Not Collective
+
+    Input Parameter:
+.   key - the key passed to PetscMallocPushMaximumUsage()
+
+    Output Parameter:
+.   increase - the largest amount of memory PetscMalloc()ed during the interval minus the amount at its beginning
+
+    Level: developer
+
+    Notes:
+    If no interval with this key is active (because it was not tracked) increase is zero.
+
+.seealso: PetscMallocPushMaximumUsage(), PetscMallocGetMaximumUsage()
+ @*/
+PetscErrorCode PetscMallocPopMaximumUsage(int key,PetscLogDouble *increase)
+{
+  size_t maxmem;
+  int    i,j;
+
+  PetscFunctionBegin;
+  *increase = 0.0;
+  for (i=TRMaxMemsDepth-1; i>=0; i--) if (TRMaxMemsKey[i] == key) break;
+  if (i < 0) PetscFunctionReturn(0);
+  /* the intervals started later are contained in this one; only the last one is up to date */
+  maxmem = TRMaxMems[i];
+  for (j=i+1; j<TRMaxMemsDepth; j++) maxmem = PetscMax(maxmem,TRMaxMems[j]);
+  *increase = (PetscLogDouble)(maxmem - TRMaxMemsStart[i]);
+  /* the interval started before this one also contains the part of this one that is not in the later ones */
+  if (i && TRMaxMems[i] > TRMaxMems[i-1]) TRMaxMems[i-1] = TRMaxMems[i];
+  for (j=i; j<TRMaxMemsDepth-1; j++) {
+    TRMaxMemsKey[j]   = TRMaxMemsKey[j+1];
+    TRMaxMemsStart[j] = TRMaxMemsStart[j+1];
+    TRMaxMems[j]      = TRMaxMems[j+1];
+  }
+  TRMaxMemsDepth--;
+  PetscFunctionReturn(0);
+}
+
 #if defined(PETSC_USE_DEBUG)
 /*@C
    PetscMallocGetStack - returns a pointer to the stack for the location in the program a call to PetscMalloc() was used to obtain that memory
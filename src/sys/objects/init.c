@@ -213,6 +213,8 @@ PetscErrorCode  PetscEnd(void)
 PetscBool PetscOptionsPublish = PETSC_FALSE;
 PETSC_INTERN PetscErrorCode PetscSetUseTrMalloc_Private(void);
 PETSC_INTERN PetscErrorCode PetscSetUseHBWMalloc_Private(void);
+PETSC_INTERN PetscErrorCode PetscSetUseTrMallocCount_Private(void);
+PETSC_INTERN PetscErrorCode PetscMallocSetNUMAView_Private(PetscBool);
 PETSC_INTERN PetscBool      petscsetmallocvisited;
 static       char           emacsmachinename[256];
 
@@ -312,6 +314,12 @@ PETSC_INTERN PetscErrorCode  PetscOptionsCheckInitial_Private(void)
   ierr = PetscOptionsGetBool(NULL,NULL,"-malloc_hbw",&flg1,NULL);CHKERRQ(ierr);
   /* ignore this option if malloc is already set */
   if (flg1 && !petscsetmallocvisited) {ierr = PetscSetUseHBWMalloc_Private();CHKERRQ(ierr);}
+#if defined(PETSC_USE_LOG)
+  /* -log_view_memory needs the memory to be counted, do it with the least overhead if no tracing malloc was selected */
+  flg1 = PETSC_FALSE;
+  ierr = PetscOptionsGetBool(NULL,NULL,"-log_view_memory",&flg1,NULL);CHKERRQ(ierr);
+  if (flg1 && !petscsetmallocvisited) {ierr = PetscSetUseTrMallocCount_Private();CHKERRQ(ierr);}
+#endif
 
   flg1 = PETSC_FALSE;
   ierr = PetscOptionsGetBool(NULL,NULL,"-malloc_info",&flg1,NULL);CHKERRQ(ierr);
@@ -324,6 +332,29 @@ PETSC_INTERN PetscErrorCode  PetscOptionsCheckInitial_Private(void)
   }
 #endif
 
+  {
+    PetscMallocNUMAPolicy policy;
+    size_t                threshold;
+    PetscInt              ithreshold;
+
+    ierr = PetscMallocGetNUMAPolicy(&policy,&threshold);CHKERRQ(ierr);
+    ithreshold = (PetscInt)threshold;
+    ierr = PetscOptionsGetEnum(NULL,NULL,"-malloc_numa",PetscMallocNUMAPolicies,(PetscEnum*)&policy,NULL);CHKERRQ(ierr);
+    ierr = PetscOptionsGetInt(NULL,NULL,"-malloc_numa_threshold",&ithreshold,NULL);CHKERRQ(ierr);
+    ierr = PetscMallocSetNUMAPolicy(policy,(size_t)ithreshold);CHKERRQ(ierr);
+    flg1 = PETSC_FALSE;
+    ierr = PetscOptionsGetBool(NULL,NULL,"-malloc_numa_view",&flg1,NULL);CHKERRQ(ierr);
+    ierr = PetscMallocSetNUMAView_Private(flg1);CHKERRQ(ierr);
+  }
+
+  {
+    PetscInt nthreads;
+
+    ierr = PetscThreadPoolGetSize(&nthreads);CHKERRQ(ierr);
+    ierr = PetscOptionsGetInt(NULL,NULL,"-thread_pool_size",&nthreads,NULL);CHKERRQ(ierr);
+    ierr = PetscThreadPoolSetSize(nthreads);CHKERRQ(ierr);
+  }
+
 #if defined(PETSC_USE_LOG)
   ierr = PetscOptionsHasName(NULL,NULL,"-objects_dump",&PetscObjectsLog);CHKERRQ(ierr);
 #endif
@@ -538,6 +569,18 @@ PETSC_INTERN PetscErrorCode  PetscOptionsCheckInitial_Private(void)
     ierr = PetscOptionsGetReal(NULL,NULL,"-log_threshold",&threshold,&flg1);CHKERRQ(ierr);
     if (flg1) {ierr = PetscLogSetThreshold((PetscLogDouble)threshold,NULL);CHKERRQ(ierr);}
   }
+
+  ierr = PetscOptionsHasName(NULL,NULL,"-log_trace_json",&flg1);CHKERRQ(ierr);
+  if (flg1) {
+    PetscInt size = PETSC_DEFAULT;
+    ierr = PetscOptionsGetInt(NULL,NULL,"-log_trace_json_size",&size,NULL);CHKERRQ(ierr);
+    ierr = PetscLogTraceJSONBegin(size);CHKERRQ(ierr);
+  }
+
+  flg1 = PETSC_FALSE;
+  ierr = PetscOptionsGetBool(NULL,NULL,"-log_hw_counters",&flg1,NULL);CHKERRQ(ierr);
+  if (flg1) {ierr = PetscLogHWCountersBegin();CHKERRQ(ierr);}
+  ierr = PetscOptionsGetBool(NULL,NULL,"-log_view_memory",&PetscLogMemory,NULL);CHKERRQ(ierr);
 #endif
 
   ierr = PetscOptionsGetBool(NULL,NULL,"-saws_options",&PetscOptionsPublish,NULL);CHKERRQ(ierr);
@@ -643,6 +686,10 @@ PETSC_INTERN PetscErrorCode  PetscOptionsCheckInitial_Private(void)
     ierr = (*PetscHelpPrintf)(comm," -malloc_info: prints total memory usage\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -malloc_log: keeps log of all memory allocations\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -malloc_debug: enables extended checking for memory corruption\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -malloc_numa <default,interleave,first_touch,local>: NUMA placement of large Vec and Mat arrays\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -malloc_numa_threshold <bytes>: smallest array placed with -malloc_numa\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -malloc_numa_view: print the NUMA nodes of the pages of large Vec and Mat arrays when they are destroyed\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -thread_pool_size <n>: number of threads of the multi-threaded kernels\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -options_view: dump list of options inputted\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -options_left: dump list of unused options\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -options_left no: don't dump list of unused options\n");CHKERRQ(ierr);
@@ -654,6 +701,10 @@ PETSC_INTERN PetscErrorCode  PetscOptionsCheckInitial_Private(void)
     ierr = (*PetscHelpPrintf)(comm," -get_total_flops: total flops over all processors\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -log_view [:filename:[format]]: logging objects and events\n");CHKERRQ(ierr);
     ierr = (*PetscHelpPrintf)(comm," -log_trace [filename]: prints trace of all PETSc calls\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -log_trace_json [filename]: saves a timeline of PETSc events for chrome://tracing\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -log_trace_json_size <n>: number of timeline records kept on each process\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -log_hw_counters: count cycles, instructions and cache misses of each event for -log_view\n");CHKERRQ(ierr);
+    ierr = (*PetscHelpPrintf)(comm," -log_view_memory: add the PetscMalloc() calls and memory of each event and stage to -log_view\n");CHKERRQ(ierr);
 #if defined(PETSC_HAVE_MPE)
     ierr = (*PetscHelpPrintf)(comm," -log_mpe: Also create logfile viewable through Jumpshot\n");CHKERRQ(ierr);
 #endif
@@ -695,6 +695,8 @@ int64_t Petsc_adios_group;
 .  -malloc_debug - check for memory corruption at EVERY malloc or free
 .  -malloc_dump - prints a list of all unfreed memory at the end of the run
 .  -malloc_test - like -malloc_dump -malloc_debug, but only active for debugging builds
+.  -malloc_numa <default,interleave,first_touch,local> - NUMA placement of large Vec and Mat arrays, see PetscMallocSetNUMAPolicy()
+.  -malloc_numa_view - print the NUMA nodes of the pages of large Vec and Mat arrays when they are destroyed
 .  -fp_trap - Stops on floating point exceptions (Note that on the
               IBM RS6000 this slows code by at least a factor of 10.)
 .  -no_signal_handler - Indicates not to trap error signals
@@ -712,7 +714,10 @@ int64_t Petsc_adios_group;
         however it slows things down and gives a distorted view of the overall runtime.
 .  -log_trace [filename] - Print traces of all PETSc calls to the screen (useful to determine where a program
         hangs without running in the debugger).  See PetscLogTraceBegin().
+.  -log_trace_json [filename] - Saves a timeline of all PETSc events on all processes for chrome://tracing.  See PetscLogTraceJSONBegin().
+.  -log_hw_counters - Adds the cycles, instructions and cache misses of each event, read from the hardware counters, to -log_view.  See PetscLogHWCountersBegin().
 .  -log_view [:filename:format] - Prints summary of flop and timing information to screen or file, see PetscLogView().
+.  -log_view_memory - Adds the number of PetscMalloc() calls, the memory kept and the largest increase of the memory in each event and stage to -log_view.
 .  -log_summary [filename] - (Deprecated, use -log_view) Prints summary of flop and timing information to screen. If the filename is specified the
         summary is written to the file.  See PetscLogView().
 .  -log_exclude: <vec,mat,pc,ksp,snes> - excludes subset of object classes from logging
@@ -1322,6 +1327,10 @@ PetscErrorCode  PetscFinalize(void)
   ierr = PetscOptionsGetString(NULL,NULL,"-log_all",mname,PETSC_MAX_PATH_LEN,&flg1);CHKERRQ(ierr);
   ierr = PetscOptionsGetString(NULL,NULL,"-log",mname,PETSC_MAX_PATH_LEN,&flg2);CHKERRQ(ierr);
   if (flg1 || flg2) {ierr = PetscLogDump(mname);CHKERRQ(ierr);}
+
+  mname[0] = 0;
+  ierr = PetscOptionsGetString(NULL,NULL,"-log_trace_json",mname,PETSC_MAX_PATH_LEN,&flg1);CHKERRQ(ierr);
+  if (flg1) {ierr = PetscLogTraceJSONDump(mname);CHKERRQ(ierr);}
 #endif
 
   ierr = PetscStackDestroy();CHKERRQ(ierr);
@@ -19,6 +19,135 @@
 
 /* -----------------------------------------------------------------------*/
 
+/*
+   LSD radix sort, used instead of quicksort for arrays of at least PETSC_SORT_RADIX_THRESHOLD entries.
+
+   The keys are sorted one byte at a time, least significant first, each pass being a stable counting sort into a
+   work array; the sign bit is flipped so that negative keys come first. The histograms of all the bytes are
+   computed in one sweep and the bytes in which all the keys agree, usually the high bytes of index arrays, are
+   skipped. Up to two PetscInt arrays are moved with the keys. The sort is stable.
+
+   With OpenMP, arrays of at least PETSC_SORT_RADIX_THREADS_THRESHOLD entries are split into one block per thread;
+   each thread counts its block and then scatters it to offsets ordered by thread within each bucket, so the
+   result is the same as with one thread.
+*/
+#if !defined(PETSC_SORT_RADIX_THREADS_THRESHOLD)
+#define PETSC_SORT_RADIX_THREADS_THRESHOLD 1048576
+#endif
+#define PETSC_SORT_RADIX_PASSES ((int)sizeof(PetscInt))
+
+#if defined(PETSC_USE_64BIT_INDICES)
+typedef unsigned long long PetscSortRadixUInt;
+#else
+typedef unsigned int PetscSortRadixUInt;
+#endif
+#define PetscSortRadixDigit(k,p) ((int)((((PetscSortRadixUInt)(k)) >> (8*(p))) & 0xff) ^ ((p) == PETSC_SORT_RADIX_PASSES-1 ? 0x80 : 0))
+
+static void PetscSortIntRadixPass_Private(PetscInt lo,PetscInt hi,int p,const PetscInt *key,const PetscInt *a,const PetscInt *b,PetscInt *key1,PetscInt *a1,PetscInt *b1,PetscInt offset[])
+{
+  PetscInt i,o;
+
+  if (b) {
+    for (i=lo; i<hi; i++) {o = offset[PetscSortRadixDigit(key[i],p)]++; key1[o] = key[i]; a1[o] = a[i]; b1[o] = b[i];}
+  } else if (a) {
+    for (i=lo; i<hi; i++) {o = offset[PetscSortRadixDigit(key[i],p)]++; key1[o] = key[i]; a1[o] = a[i];}
+  } else {
+    for (i=lo; i<hi; i++) {o = offset[PetscSortRadixDigit(key[i],p)]++; key1[o] = key[i];}
+  }
+}
+
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+static void PetscSortIntRadixPassThreads_Private(PetscInt n,int p,const PetscInt *key,const PetscInt *a,const PetscInt *b,PetscInt *key1,PetscInt *a1,PetscInt *b1,PetscInt *offsets)
+{
+#pragma omp parallel
+  {
+    int      t = omp_get_thread_num(),nt = omp_get_num_threads(),d;
+    PetscInt lo = (PetscInt)(((PetscInt64)n*t)/nt),hi = (PetscInt)(((PetscInt64)n*(t+1))/nt),i,*offset = offsets+256*t;
+
+    for (d=0; d<256; d++) offset[d] = 0;
+    for (i=lo; i<hi; i++) offset[PetscSortRadixDigit(key[i],p)]++;
+#pragma omp barrier
+#pragma omp single
+    {
+      PetscInt sum = 0,c;
+      int      tt;
+
+      for (d=0; d<256; d++) {
+        for (tt=0; tt<nt; tt++) {c = offsets[256*tt+d]; offsets[256*tt+d] = sum; sum += c;}
+      }
+    }
+    PetscSortIntRadixPass_Private(lo,hi,p,key,a,b,key1,a1,b1,offset);
+  }
+}
+#endif
+
+/*
+   PetscSortIntRadix_Private - Sorts key[] in increasing order, moving the optional arrays a[] and b[] with it
+*/
+PetscErrorCode PetscSortIntRadix_Private(PetscInt n,PetscInt key[],PetscInt a[],PetscInt b[])
+{
+  PetscInt       count[PETSC_SORT_RADIX_PASSES][256],*key0 = key,*a0 = a,*b0 = b,*key1,*a1,*b1,*wkey,*wa,*wb,*t,i,sum,c;
+  int            p,d;
+#if defined(PETSC_HAVE_OPENMP)
+  PetscInt       *offsets = NULL;
+#endif
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (n < 2) PetscFunctionReturn(0);
+  ierr = PetscMemzero(count,sizeof(count));CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    for (p=0; p<PETSC_SORT_RADIX_PASSES; p++) count[p][PetscSortRadixDigit(key[i],p)]++;
+  }
+  ierr = PetscMalloc3(n,&wkey,a ? n : 0,&wa,b ? n : 0,&wb);CHKERRQ(ierr);
+  key1 = wkey; a1 = wa; b1 = wb;
+#if defined(PETSC_HAVE_OPENMP)
+  if (n >= PETSC_SORT_RADIX_THREADS_THRESHOLD && omp_get_max_threads() > 1) {ierr = PetscMalloc1(256*omp_get_max_threads(),&offsets);CHKERRQ(ierr);}
+#endif
+  for (p=0; p<PETSC_SORT_RADIX_PASSES; p++) {
+    if (count[p][PetscSortRadixDigit(key0[0],p)] == n) continue; /* all the keys have the same byte */
+#if defined(PETSC_HAVE_OPENMP)
+    if (offsets) PetscSortIntRadixPassThreads_Private(n,p,key0,a0,b0,key1,a1,b1,offsets);
+    else
+#endif
+    {
+      for (sum=0,d=0; d<256; d++) {c = count[p][d]; count[p][d] = sum; sum += c;}
+      PetscSortIntRadixPass_Private(0,n,p,key0,a0,b0,key1,a1,b1,count[p]);
+    }
+    t = key0; key0 = key1; key1 = t;
+    t = a0;   a0   = a1;   a1   = t;
+    t = b0;   b0   = b1;   b1   = t;
+  }
+  if (key0 != key) {
+    ierr = PetscMemcpy(key,key0,n*sizeof(PetscInt));CHKERRQ(ierr);
+    if (a) {ierr = PetscMemcpy(a,a0,n*sizeof(PetscInt));CHKERRQ(ierr);}
+    if (b) {ierr = PetscMemcpy(b,b0,n*sizeof(PetscInt));CHKERRQ(ierr);}
+  }
+#if defined(PETSC_HAVE_OPENMP)
+  ierr = PetscFree(offsets);CHKERRQ(ierr);
+#endif
+  ierr = PetscFree3(wkey,wa,wb);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   PetscSortIntRadixPermutation_Private - Sorts key[] in increasing order and gives in perm[] the original position of each entry
+*/
+static PetscErrorCode PetscSortIntRadixPermutation_Private(PetscInt n,PetscInt key[],PetscInt **perm)
+{
+  PetscErrorCode ierr;
+  PetscInt       i;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc1(n,perm);CHKERRQ(ierr);
+  for (i=0; i<n; i++) (*perm)[i] = i;
+  ierr = PetscSortIntRadix_Private(n,key,*perm,NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* -----------------------------------------------------------------------*/
+
 /*
    A simple version of quicksort; taken from Kernighan and Ritchie, page 87.
    Assumes 0 origin for v, number of elements = right+1 (right is index of
@@ -57,6 +186,9 @@ static void PetscSortInt_Private(PetscInt *v,PetscInt right)
 +  n  - number of values
 -  i  - array of integers
 
+   Notes:
+   Arrays of 1024 or more entries are sorted with a radix sort, which is linear in the number of entries.
+
    Level: intermediate
 
    Concepts: sorting^ints
@@ -65,7 +197,8 @@ static void PetscSortInt_Private(PetscInt *v,PetscInt right)
 @*/
 PetscErrorCode  PetscSortInt(PetscInt n,PetscInt i[])
 {
-  PetscInt j,k,tmp,ik;
+  PetscErrorCode ierr;
+  PetscInt       j,k,tmp,ik;
 
   PetscFunctionBegin;
   if (n<8) {
@@ -78,7 +211,10 @@ PetscErrorCode  PetscSortInt(PetscInt n,PetscInt i[])
         }
       }
     }
-  } else PetscSortInt_Private(i,n-1);
+  } else if (n < PETSC_SORT_RADIX_THRESHOLD) PetscSortInt_Private(i,n-1);
+  else {
+    ierr = PetscSortIntRadix_Private(n,i,NULL,NULL);CHKERRQ(ierr);
+  }
   PetscFunctionReturn(0);
 }
 
@@ -258,6 +394,10 @@ static PetscErrorCode PetscSortIntWithArray_Private(PetscInt *v,PetscInt *V,Pets
 .  i  - array of integers
 -  I - second array of integers
 
+   Notes:
+   Arrays of 1024 or more entries are sorted with a stable radix sort, so entries with equal keys keep their order.
+   For shorter arrays the order of such entries is not defined.
+
    Level: intermediate
 
    Concepts: sorting^ints with array
@@ -280,8 +420,10 @@ PetscErrorCode  PetscSortIntWithArray(PetscInt n,PetscInt i[],PetscInt Ii[])
         }
       }
     }
-  } else {
+  } else if (n < PETSC_SORT_RADIX_THRESHOLD) {
     ierr = PetscSortIntWithArray_Private(i,Ii,n-1);CHKERRQ(ierr);
+  } else {
+    ierr = PetscSortIntRadix_Private(n,i,Ii,NULL);CHKERRQ(ierr);
   }
   PetscFunctionReturn(0);
 }
@@ -352,8 +494,10 @@ PetscErrorCode  PetscSortIntWithArrayPair(PetscInt n,PetscInt L[],PetscInt J[],
         }
       }
     }
-  } else {
+  } else if (n < PETSC_SORT_RADIX_THRESHOLD) {
     ierr = PetscSortIntWithArrayPair_Private(L,J,K,n-1);CHKERRQ(ierr);
+  } else {
+    ierr = PetscSortIntRadix_Private(n,L,J,K);CHKERRQ(ierr);
   }
   PetscFunctionReturn(0);
 }
@@ -590,8 +734,18 @@ PetscErrorCode  PetscSortIntWithScalarArray(PetscInt n,PetscInt i[],PetscScalar
         }
       }
     }
-  } else {
+  } else if (n < PETSC_SORT_RADIX_THRESHOLD) {
     ierr = PetscSortIntWithScalarArray_Private(i,Ii,n-1);CHKERRQ(ierr);
+  } else {
+    PetscInt    *perm;
+    PetscScalar *work;
+
+    ierr = PetscSortIntRadixPermutation_Private(n,i,&perm);CHKERRQ(ierr);
+    ierr = PetscMalloc1(n,&work);CHKERRQ(ierr);
+    for (k=0; k<n; k++) work[k] = Ii[perm[k]];
+    ierr = PetscMemcpy(Ii,work,n*sizeof(PetscScalar));CHKERRQ(ierr);
+    ierr = PetscFree(work);CHKERRQ(ierr);
+    ierr = PetscFree(perm);CHKERRQ(ierr);
   }
   PetscFunctionReturn(0);
 }
@@ -669,8 +823,18 @@ PetscErrorCode  PetscSortIntWithDataArray(PetscInt n,PetscInt i[],void *Ii,size_
         }
       }
     }
-  } else {
+  } else if (n < PETSC_SORT_RADIX_THRESHOLD) {
     ierr = PetscSortIntWithDataArray_Private(i,V,n-1,size,work);CHKERRQ(ierr);
+  } else {
+    PetscInt *perm;
+    char     *data;
+
+    ierr = PetscSortIntRadixPermutation_Private(n,i,&perm);CHKERRQ(ierr);
+    ierr = PetscMalloc1(n*size,&data);CHKERRQ(ierr);
+    for (k=0; k<n; k++) {ierr = PetscMemcpy(data+size*k,V+size*perm[k],size);CHKERRQ(ierr);}
+    ierr = PetscMemcpy(V,data,n*size);CHKERRQ(ierr);
+    ierr = PetscFree(data);CHKERRQ(ierr);
+    ierr = PetscFree(perm);CHKERRQ(ierr);
   }
   PetscFunctionReturn(0);
 }
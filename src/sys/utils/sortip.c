@@ -6,7 +6,7 @@
    aliased.  For some compilers, this can cause the compiler to fail to
    place inner-loop variables into registers.
  */
-#include <petscsys.h>                /*I  "petscsys.h"  I*/
+#include <petsc/private/petscimpl.h>                /*I  "petscsys.h"  I*/
 
 #define SWAP(a,b,t) {t=a;a=b;b=t;}
 
@@ -70,8 +70,16 @@ PetscErrorCode  PetscSortIntWithPermutation(PetscInt n,const PetscInt i[],PetscI
         }
       }
     }
-  } else {
+  } else if (n < PETSC_SORT_RADIX_THRESHOLD) {
     ierr = PetscSortIntWithPermutation_Private(i,idx,n-1);CHKERRQ(ierr);
+  } else {
+    PetscInt *key;
+
+    /* radix sort copies of the values, it reads them in order instead of through idx */
+    ierr = PetscMalloc1(n,&key);CHKERRQ(ierr);
+    for (k=0; k<n; k++) key[k] = i[idx[k]];
+    ierr = PetscSortIntRadix_Private(n,key,idx,NULL);CHKERRQ(ierr);
+    ierr = PetscFree(key);CHKERRQ(ierr);
   }
   PetscFunctionReturn(0);
 }
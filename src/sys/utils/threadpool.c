@@ -0,0 +1,256 @@
+/*
+     A pool of threads started once and reused by the computational kernels that are split among threads,
+   such as the BLAS 1 operations of large VECSEQ and VECMPI vectors.
+*/
+#include <petsc/private/petscimpl.h>     /*I   "petscsys.h"   I*/
+#if defined(PETSC_HAVE_PTHREAD) && defined(PETSC_HAVE_PTHREAD_H)
+#include <pthread.h>
+#define PETSC_USE_THREAD_POOL
+#endif
+#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__SSE2__)
+#include <immintrin.h>
+#define PetscThreadPoolPause() _mm_pause()
+#else
+#define PetscThreadPoolPause()
+#endif
+
+/* the idle threads and the calling thread poll this many times before they sleep on a condition variable */
+#define PETSC_THREAD_POOL_SPIN 20000
+
+#if defined(__GNUC__)
+#define PetscThreadPoolLoad(a)    __atomic_load_n(&(a),__ATOMIC_ACQUIRE)
+#define PetscThreadPoolStore(a,v) __atomic_store_n(&(a),(v),__ATOMIC_RELEASE)
+#else
+#define PetscThreadPoolLoad(a)    (a)
+#define PetscThreadPoolStore(a,v) ((a) = (v))
+#define PETSC_THREAD_POOL_NO_SPIN
+#endif
+
+#if defined(PETSC_USE_THREAD_POOL)
+typedef struct {
+  pthread_mutex_t       lock;
+  pthread_cond_t        start,done;
+  pthread_t             *threads;
+  PetscInt              nthreads;
+  unsigned long         generation; /* incremented for each kernel run, the threads wait for it to change */
+  unsigned long         base;       /* the generation when the threads were started */
+  PetscInt              pending;    /* number of threads that have not finished the current kernel */
+  PetscThreadPoolKernel kernel;     /* NULL tells the threads to exit */
+  void                  *ctx;
+  PetscBool             running;    /* set during PetscThreadPoolRun() to catch nested calls */
+} PetscThreadPool;
+
+static PetscThreadPool petscthreadpool = {PTHREAD_MUTEX_INITIALIZER,PTHREAD_COND_INITIALIZER,PTHREAD_COND_INITIALIZER,NULL,1,0,0,0,NULL,NULL,PETSC_FALSE};
+static PetscBool       petscthreadpoolregistered = PETSC_FALSE;
+
+static void *PetscThreadPoolWorker_Private(void *arg)
+{
+  PetscThreadPool       *pool = &petscthreadpool;
+  PetscInt              tid   = (PetscInt)(size_t)arg,nthreads;
+  unsigned long         gen   = pool->base;
+  PetscThreadPoolKernel kernel;
+  void                  *ctx;
+  int                   i;
+
+  for (;;) {
+#if !defined(PETSC_THREAD_POOL_NO_SPIN)
+    for (i=0; i<PETSC_THREAD_POOL_SPIN && PetscThreadPoolLoad(pool->generation) == gen; i++) PetscThreadPoolPause();
+#else
+    (void)i;
+#endif
+    pthread_mutex_lock(&pool->lock);
+    while (pool->generation == gen) pthread_cond_wait(&pool->start,&pool->lock);
+    gen      = pool->generation;
+    kernel   = pool->kernel;
+    ctx      = pool->ctx;
+    nthreads = pool->nthreads;
+    pthread_mutex_unlock(&pool->lock);
+    if (!kernel) break;
+    (*kernel)(tid,nthreads,ctx);
+    pthread_mutex_lock(&pool->lock);
+    PetscThreadPoolStore(pool->pending,pool->pending-1);
+    if (!pool->pending) pthread_cond_signal(&pool->done);
+    pthread_mutex_unlock(&pool->lock);
+  }
+  return NULL;
+}
+
+/* stops and joins the threads, the calling thread is then the only one */
+static PetscErrorCode PetscThreadPoolStop_Private(void)
+{
+  PetscThreadPool *pool = &petscthreadpool;
+  PetscInt        i;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  if (pool->nthreads == 1) PetscFunctionReturn(0);
+  pthread_mutex_lock(&pool->lock);
+  pool->kernel = NULL;
+  PetscThreadPoolStore(pool->generation,pool->generation+1);
+  pthread_cond_broadcast(&pool->start);
+  pthread_mutex_unlock(&pool->lock);
+  for (i=1; i<pool->nthreads; i++) {
+    if (pthread_join(pool->threads[i],NULL)) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SYS,"Unable to join thread %D of the thread pool",i);
+  }
+  ierr = PetscFree(pool->threads);CHKERRQ(ierr);
+  pool->nthreads = 1;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscThreadPoolFinalize_Private(void)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscThreadPoolStop_Private();CHKERRQ(ierr);
+  petscthreadpoolregistered = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+#endif
+
+/*@C
+   PetscThreadPoolSetSize - Sets the number of threads of the thread pool used by the multi-threaded kernels
+
+   Not Collective
+
+   Input Parameter:
+.  nthreads - the number of threads, including the calling thread; 1 runs all the kernels on the calling thread
+
+   Options Database Key:
+.  -thread_pool_size <n> - the number of threads
+
+   Notes:
+   The threads are started by this routine and sleep until PetscThreadPoolRun() gives them work; they are stopped in
+   PetscFinalize(). With MPI, each process has its own pool, so usually the number of processes per node times the
+   number of threads is the number of cores of the node. The threads are not bound to cores; since the idle threads
+   spin for a while before they sleep, using more threads than available cores makes the kernels much slower.
+
+   Multi-threaded kernels include the operations on VECSEQ and VECMPI vectors with at least -vec_threads_min_size local entries
+   and MatMult(), MatMultAdd() and MatMultTranspose() for MATSEQAIJ matrices, and the diagonal and off-diagonal blocks of
+   MATMPIAIJ matrices, with at least -mat_threads_min_nz nonzeros.
+
+   This requires pthreads; otherwise only 1 thread is supported.
+
+   Level: intermediate
+
+.seealso: PetscThreadPoolGetSize(), PetscThreadPoolRun()
+@*/
+PetscErrorCode PetscThreadPoolSetSize(PetscInt nthreads)
+{
+#if defined(PETSC_USE_THREAD_POOL)
+  PetscThreadPool *pool = &petscthreadpool;
+  PetscInt        i;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  if (nthreads < 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Number of threads %D must be positive",nthreads);
+  if (pool->running) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Cannot resize the thread pool from one of its kernels");
+  if (nthreads == pool->nthreads) PetscFunctionReturn(0);
+  ierr = PetscThreadPoolStop_Private();CHKERRQ(ierr);
+  if (nthreads == 1) PetscFunctionReturn(0);
+  ierr = PetscMalloc1(nthreads,&pool->threads);CHKERRQ(ierr);
+  pool->threads[0] = pthread_self();
+  pool->nthreads   = nthreads;
+  pool->base       = pool->generation;
+  for (i=1; i<nthreads; i++) {
+    if (pthread_create(&pool->threads[i],NULL,PetscThreadPoolWorker_Private,(void*)(size_t)i)) {
+      pool->nthreads = i;
+      ierr = PetscThreadPoolStop_Private();CHKERRQ(ierr);
+      SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_SYS,"Unable to start thread %D of %D of the thread pool",i,nthreads);
+    }
+  }
+  if (!petscthreadpoolregistered) {
+    ierr = PetscRegisterFinalize(PetscThreadPoolFinalize_Private);CHKERRQ(ierr);
+    petscthreadpoolregistered = PETSC_TRUE;
+  }
+  ierr = PetscInfo1(NULL,"Started a pool of %D threads\n",nthreads);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+#else
+  PetscFunctionBegin;
+  if (nthreads != 1) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP_SYS,"The thread pool requires pthreads");
+  PetscFunctionReturn(0);
+#endif
+}
+
+/*@C
+   PetscThreadPoolGetSize - Gets the number of threads of the thread pool
+
+   Not Collective
+
+   Output Parameter:
+.  nthreads - the number of threads, including the calling thread
+
+   Level: intermediate
+
+.seealso: PetscThreadPoolSetSize()
+@*/
+PetscErrorCode PetscThreadPoolGetSize(PetscInt *nthreads)
+{
+  PetscFunctionBegin;
+  PetscValidIntPointer(nthreads,1);
+#if defined(PETSC_USE_THREAD_POOL)
+  *nthreads = petscthreadpool.nthreads;
+#else
+  *nthreads = 1;
+#endif
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscThreadPoolRun - Runs a kernel on all the threads of the thread pool and waits for them to finish
+
+   Not Collective
+
+   Input Parameters:
++  kernel - the kernel, called as kernel(tid,nthreads,ctx) on thread tid = 0,...,nthreads-1
+-  ctx - the context passed to the kernel
+
+   Notes:
+   The calling thread runs the kernel with tid 0. PetscThreadPoolGetRange() gives each thread its part of an array,
+   the same part for arrays of the same length in every call, so that the pages first written by a thread stay
+   close to it on NUMA machines.
+
+   The kernel runs outside of the PETSc error handling and logging: it must not call PETSc routines that use
+   PetscFunctionBegin, error checking, logging or PetscMalloc(), nor PetscThreadPoolRun().
+
+   Level: developer
+
+.seealso: PetscThreadPoolSetSize(), PetscThreadPoolGetRange()
+@*/
+PetscErrorCode PetscThreadPoolRun(PetscThreadPoolKernel kernel,void *ctx)
+{
+#if defined(PETSC_USE_THREAD_POOL)
+  PetscThreadPool *pool = &petscthreadpool;
+  int             i;
+
+  PetscFunctionBegin;
+  if (pool->nthreads == 1) {
+    (*kernel)(0,1,ctx);
+    PetscFunctionReturn(0);
+  }
+  if (pool->running) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Cannot nest PetscThreadPoolRun()");
+  pool->running = PETSC_TRUE;
+  pthread_mutex_lock(&pool->lock);
+  pool->kernel  = kernel;
+  pool->ctx     = ctx;
+  pool->pending = pool->nthreads-1;
+  PetscThreadPoolStore(pool->generation,pool->generation+1);
+  pthread_cond_broadcast(&pool->start);
+  pthread_mutex_unlock(&pool->lock);
+  (*kernel)(0,pool->nthreads,ctx);
+#if !defined(PETSC_THREAD_POOL_NO_SPIN)
+  for (i=0; i<PETSC_THREAD_POOL_SPIN && PetscThreadPoolLoad(pool->pending); i++) PetscThreadPoolPause();
+#else
+  (void)i;
+#endif
+  pthread_mutex_lock(&pool->lock);
+  while (pool->pending) pthread_cond_wait(&pool->done,&pool->lock);
+  pthread_mutex_unlock(&pool->lock);
+  pool->running = PETSC_FALSE;
+  PetscFunctionReturn(0);
+#else
+  PetscFunctionBegin;
+  (*kernel)(0,1,ctx);
+  PetscFunctionReturn(0);
+#endif
+}
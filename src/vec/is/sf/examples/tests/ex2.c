@@ -0,0 +1,147 @@
+static const char help[] = "Test the communication of several fields at once with PetscSF\n\n";
+
+/*T
+    Description: This example compares PetscSFBcastMultiBegin() and PetscSFReduceMultiBegin() to the communication of one field at a time.
+T*/
+
+#include <petscsf.h>
+
+int main(int argc,char **argv)
+{
+  PetscSF        sf;
+  PetscInt       i,j,nroots,nleaves,*ilocal;
+  PetscSFNode    *iremote;
+  PetscMPIInt    rank,size;
+  MPI_Datatype   triple,unit[3];
+  PetscInt       *rint,*lint,*rint1,*lint1;
+  PetscScalar    *rsca,*lsca,*rsca1,*lsca1;
+  PetscReal      *rrea,*lrea,*rrea1,*lrea1;
+  const void     *rootdata[3],*leafdata[3];
+  void           *rootupdate[3],*leafupdate[3];
+  PetscBool      same,flg;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
+
+  /* the sizes differ from rank to rank so that the fields of a message do not all share the alignment of the first one */
+  nroots  = 3 + rank;
+  nleaves = 2*nroots + 1;
+  ierr = PetscMalloc2(nleaves,&ilocal,nleaves,&iremote);CHKERRQ(ierr);
+  for (i=0; i<nleaves; i++) {
+    ilocal[i]        = nleaves - 1 - i;   /* leaves in reverse order */
+    iremote[i].rank  = (i % 2) ? rank : (rank+1) % size;
+    iremote[i].index = (i % 2) ? (i/2) % nroots : i % (3 + (rank+1) % size);
+  }
+  ierr = PetscSFCreate(PETSC_COMM_WORLD,&sf);CHKERRQ(ierr);
+  ierr = PetscSFSetFromOptions(sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sf,nroots,nleaves,ilocal,PETSC_COPY_VALUES,iremote,PETSC_COPY_VALUES);CHKERRQ(ierr);
+  ierr = PetscFree2(ilocal,iremote);CHKERRQ(ierr);
+
+  ierr = MPI_Type_contiguous(3,MPIU_SCALAR,&triple);CHKERRQ(ierr);
+  ierr = MPI_Type_commit(&triple);CHKERRQ(ierr);
+  unit[0] = MPIU_INT; unit[1] = triple; unit[2] = MPIU_REAL;
+  ierr = PetscMalloc4(nroots,&rint,nleaves,&lint,nroots,&rint1,nleaves,&lint1);CHKERRQ(ierr);
+  ierr = PetscMalloc4(3*nroots,&rsca,3*nleaves,&lsca,3*nroots,&rsca1,3*nleaves,&lsca1);CHKERRQ(ierr);
+  ierr = PetscMalloc4(nroots,&rrea,nleaves,&lrea,nroots,&rrea1,nleaves,&lrea1);CHKERRQ(ierr);
+  for (i=0; i<nroots; i++) {
+    rint[i] = rint1[i] = 100*rank + i;
+    rrea[i] = rrea1[i] = 0.5*rank - i;
+    for (j=0; j<3; j++) rsca[3*i+j] = rsca1[3*i+j] = 10.0*rank + i + 0.25*j;
+  }
+  for (i=0; i<nleaves; i++) {
+    lint[i] = lint1[i] = -1;
+    lrea[i] = lrea1[i] = -1.0;
+    for (j=0; j<3; j++) lsca[3*i+j] = lsca1[3*i+j] = -1.0;
+  }
+
+  /* broadcast */
+  rootdata[0] = rint; rootdata[1] = rsca; rootdata[2] = rrea;
+  leafupdate[0] = lint; leafupdate[1] = lsca; leafupdate[2] = lrea;
+  ierr = PetscSFBcastMultiBegin(sf,3,unit,rootdata,leafupdate);CHKERRQ(ierr);
+  ierr = PetscSFBcastMultiEnd(sf,3,unit,rootdata,leafupdate);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(sf,MPIU_INT,rint1,lint1);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(sf,MPIU_INT,rint1,lint1);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(sf,triple,rsca1,lsca1);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(sf,triple,rsca1,lsca1);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(sf,MPIU_REAL,rrea1,lrea1);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(sf,MPIU_REAL,rrea1,lrea1);CHKERRQ(ierr);
+  ierr = PetscMemcmp(lint,lint1,nleaves*sizeof(PetscInt),&flg);CHKERRQ(ierr);
+  same = flg;
+  ierr = PetscMemcmp(lsca,lsca1,3*nleaves*sizeof(PetscScalar),&flg);CHKERRQ(ierr);
+  same = (PetscBool)(same && flg);
+  ierr = PetscMemcmp(lrea,lrea1,nleaves*sizeof(PetscReal),&flg);CHKERRQ(ierr);
+  same = (PetscBool)(same && flg);
+  ierr = MPIU_Allreduce(MPI_IN_PLACE,&same,1,MPIU_BOOL,MPI_LAND,PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Batched broadcast %s\n",same ? "matches" : "differs");CHKERRQ(ierr);
+
+  /* reduction with a sum, each field reduced into the root values above */
+  leafdata[0] = lint; leafdata[1] = lsca; leafdata[2] = lrea;
+  rootupdate[0] = rint; rootupdate[1] = rsca; rootupdate[2] = rrea;
+  ierr = PetscSFReduceMultiBegin(sf,3,unit,leafdata,rootupdate,MPIU_SUM);CHKERRQ(ierr);
+  ierr = PetscSFReduceMultiEnd(sf,3,unit,leafdata,rootupdate,MPIU_SUM);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(sf,MPIU_INT,lint1,rint1,MPIU_SUM);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(sf,MPIU_INT,lint1,rint1,MPIU_SUM);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(sf,triple,lsca1,rsca1,MPIU_SUM);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(sf,triple,lsca1,rsca1,MPIU_SUM);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(sf,MPIU_REAL,lrea1,rrea1,MPIU_SUM);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(sf,MPIU_REAL,lrea1,rrea1,MPIU_SUM);CHKERRQ(ierr);
+  ierr = PetscMemcmp(rint,rint1,nroots*sizeof(PetscInt),&flg);CHKERRQ(ierr);
+  same = flg;
+  ierr = PetscMemcmp(rsca,rsca1,3*nroots*sizeof(PetscScalar),&flg);CHKERRQ(ierr);
+  same = (PetscBool)(same && flg);
+  ierr = PetscMemcmp(rrea,rrea1,nroots*sizeof(PetscReal),&flg);CHKERRQ(ierr);
+  same = (PetscBool)(same && flg);
+  ierr = MPIU_Allreduce(MPI_IN_PLACE,&same,1,MPIU_BOOL,MPI_LAND,PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Batched reduction %s\n",same ? "matches" : "differs");CHKERRQ(ierr);
+
+  /* a bitwise and of real values is rejected by the beginning of the reduction, which leaves nothing outstanding */
+  ierr = PetscOptionsHasName(NULL,NULL,"-test_unsupported_op",&flg);CHKERRQ(ierr);
+  if (flg) {
+    ierr = PetscPushErrorHandler(PetscReturnErrorHandler,NULL);CHKERRQ(ierr);
+    ierr = PetscSFReduceMultiBegin(sf,3,unit,leafdata,rootupdate,MPI_BAND);
+    same = (ierr == PETSC_ERR_SUP) ? PETSC_TRUE : PETSC_FALSE;
+    ierr = PetscPopErrorHandler();CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"Unsupported operation %s\n",same ? "rejected" : "accepted");CHKERRQ(ierr);
+    ierr = PetscSFReduceMultiBegin(sf,3,unit,leafdata,rootupdate,MPIU_SUM);CHKERRQ(ierr);
+    ierr = PetscSFReduceMultiEnd(sf,3,unit,leafdata,rootupdate,MPIU_SUM);CHKERRQ(ierr);
+  }
+
+  ierr = PetscFree4(rint,lint,rint1,lint1);CHKERRQ(ierr);
+  ierr = PetscFree4(rsca,lsca,rsca1,lsca1);CHKERRQ(ierr);
+  ierr = PetscFree4(rrea,lrea,rrea1,lrea1);CHKERRQ(ierr);
+  ierr = MPI_Type_free(&triple);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      suffix: basic
+      nsize: {{1 3}}
+      output_file: output/ex2_1.out
+
+   test:
+      suffix: unsupported_op
+      nsize: 3
+      args: -test_unsupported_op -sf_type {{basic node}}
+      requires: define(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+
+   test:
+      suffix: node
+      nsize: 3
+      args: -sf_type node -sf_node_split_size {{0 1 2}}
+      requires: define(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+      output_file: output/ex2_1.out
+
+   test:
+      suffix: window
+      nsize: 3
+      args: -sf_type window
+      requires: define(PETSC_HAVE_MPI_WIN_CREATE) define(PETSC_HAVE_MPICH_NUMVERSION)
+      output_file: output/ex2_1.out
+
+TEST*/
@@ -375,6 +375,24 @@ int main(int argc,char **argv)
       args: -test_bcast -sf_type basic
       output_file: output/ex1_1_basic.out
 
+   test:
+      suffix: 1_node
+      nsize: 4
+      args: -test_bcast -sf_type node -sf_node_split_size 2
+      requires: define(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+
+   test:
+      suffix: 2_node
+      nsize: 4
+      args: -test_reduce -sf_type node -sf_node_split_size 2
+      requires: define(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+
+   test:
+      suffix: 4_node
+      nsize: 4
+      args: -test_gather -sf_type node -sf_node_split_size 1
+      requires: define(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+
    test:
       suffix: 8
       nsize: 3
@@ -1,57 +1,33 @@
 
-#include <petsc/private/sfimpl.h> /*I "petscsf.h" I*/
-
-typedef struct _n_PetscSFBasicPack *PetscSFBasicPack;
-struct _n_PetscSFBasicPack {
-  void (*Pack)(PetscInt,PetscInt,const PetscInt*,const void*,void*);
-  void (*UnpackInsert)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
-  void (*UnpackAdd)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
-  void (*UnpackMin)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
-  void (*UnpackMax)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
-  void (*UnpackMinloc)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
-  void (*UnpackMaxloc)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
-  void (*UnpackMult)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
-  void (*UnpackLAND)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
-  void (*UnpackBAND)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
-  void (*UnpackLOR)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
-  void (*UnpackBOR)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
-  void (*UnpackLXOR)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
-  void (*UnpackBXOR)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
-  void (*FetchAndInsert)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndAdd)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndMin)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndMax)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndMinloc)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndMaxloc)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndMult)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndLAND)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndBAND)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndLOR)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndBOR)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndLXOR)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-  void (*FetchAndBXOR)(PetscInt,PetscInt,const PetscInt*,void*,void*);
-
-  MPI_Datatype     unit;
-  size_t           unitbytes;   /* Number of bytes in a unit */
-  PetscInt         bs;          /* Number of basic units in a unit */
-  const void       *key;        /* Array used as key for operation */
-  char             **root;      /* Packed root data, indexed by leaf rank */
-  char             **leaf;      /* Packed leaf data, indexed by root rank */
-  MPI_Request      *requests;   /* Array of root requests followed by leaf requests */
-  PetscSFBasicPack next;
+#include <../src/vec/is/sf/impls/basic/sfbasic.h> /*I "petscsf.h" I*/
+
+/*
+ * A batched operation on several fields packs, for each rank, the data of all the fields one after the other in a
+ * single message of MPI_BYTE, each field starting on a PETSC_MEMALIGN boundary; the link of each field only provides
+ * its packing routines
+ */
+struct _n_PetscSFBasicMulti {
+  const void        *key;        /* Root data of the first field */
+  PetscInt          nfields;
+  PetscSFBasicPack  *links;      /* [nfields] Link of each field */
+  size_t            *rootdispl;  /* [nrootranks+1] Offset in bytes of the message of each root rank in root */
+  size_t            *leafdispl;  /* [nleafranks+1] Offset in bytes of the message of each leaf rank in leaf */
+  char              *root;       /* Packed root data */
+  char              *leaf;       /* Packed leaf data */
+  MPI_Request       *requests;   /* Array of root requests followed by leaf requests */
+  PetscSFBasicMulti next;
 };
 
-typedef struct {
-  PetscMPIInt      tag;
-  PetscMPIInt      niranks;     /* Number of incoming ranks (ranks accessing my roots) */
-  PetscMPIInt      ndiranks;    /* Number of incoming ranks (ranks accessing my roots) in distinguished set */
-  PetscMPIInt      *iranks;     /* Array of ranks that reference my roots */
-  PetscInt         itotal;      /* Total number of graph edges referencing my roots */
-  PetscInt         *ioffset;    /* Array of length niranks+1 holding offset in irootloc[] for each rank */
-  PetscInt         *irootloc;   /* Incoming roots referenced by ranks starting at ioffset[rank] */
-  PetscSFBasicPack avail;       /* One or more entries per MPI Datatype, lazily constructed */
-  PetscSFBasicPack inuse;       /* Buffers being used for transactions that have not yet completed */
-} PetscSF_Basic;
+/* Offset in bytes of field f in the message of n nodes of a batched operation */
+PETSC_STATIC_INLINE size_t PetscSFBasicMultiOffset(PetscSFBasicMulti multi,PetscInt n,PetscInt f)
+{
+  size_t   bytes = 0;
+  PetscInt g;
+
+  for (g=0; g<f; g++) bytes += (n*multi->links[g]->unitbytes + PETSC_MEMALIGN-1)/PETSC_MEMALIGN*PETSC_MEMALIGN;
+  return bytes;
+}
+
 
 #if !defined(PETSC_HAVE_MPI_TYPE_DUP)
 PETSC_STATIC_INLINE int MPI_Type_dup(MPI_Datatype datatype,MPI_Datatype *newtype)
@@ -63,6 +39,25 @@ PETSC_STATIC_INLINE int MPI_Type_dup(MPI_Datatype datatype,MPI_Datatype *newtype
 }
 #endif
 
+/*
+ * Indices forming one contiguous run are packed with a memcpy(), and the messages sent to or received from
+ * non-distinguished ranks use the user array directly. This is not done when the root and leaf arrays are the same,
+ * since the messages could then overlap the entries being packed or unpacked.
+ */
+static PetscErrorCode PetscSFBasicFindContiguous_Private(PetscInt n,const PetscInt *offset,const PetscInt *loc,PetscInt *start)
+{
+  PetscInt i,j;
+
+  PetscFunctionBegin;
+  for (i=0; i<n; i++) {
+    start[i] = offset[i+1] > offset[i] ? loc[offset[i]] : -1;
+    for (j=offset[i]+1; j<offset[i+1]; j++) {
+      if (loc[j] != loc[j-1]+1) {start[i] = -1; break;}
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
 /*
  * MPI_Reduce_local is not really useful because it can't handle sparse data and it vectorizes "in the wrong direction",
  * therefore we pack data types manually. This section defines packing routines for the standard data types.
@@ -531,7 +526,7 @@ DEF_Block(int,6)
 DEF_Block(int,7)
 DEF_Block(int,8)
 
-static PetscErrorCode PetscSFSetUp_Basic(PetscSF sf)
+PetscErrorCode PetscSFSetUp_Basic(PetscSF sf)
 {
   PetscSF_Basic *bas = (PetscSF_Basic*)sf->data;
   PetscErrorCode ierr;
@@ -598,6 +593,11 @@ static PetscErrorCode PetscSFSetUp_Basic(PetscSF sf)
   ierr = MPI_Waitall(bas->niranks-bas->ndiranks,rootreqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
   ierr = MPI_Waitall(sf->nranks-sf->ndranks,leafreqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
   ierr = PetscFree2(rootreqs,leafreqs);CHKERRQ(ierr);
+
+  /* Find the ranks whose roots or leaves are contiguous */
+  ierr = PetscMalloc2(bas->niranks,&bas->irootstart,sf->nranks,&bas->leafstart);CHKERRQ(ierr);
+  ierr = PetscSFBasicFindContiguous_Private(bas->niranks,bas->ioffset,bas->irootloc,bas->irootstart);CHKERRQ(ierr);
+  ierr = PetscSFBasicFindContiguous_Private(sf->nranks,sf->roffset,sf->rmine,bas->leafstart);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -682,7 +682,7 @@ static PetscErrorCode PetscSFBasicPackTypeSetup(PetscSFBasicPack link,MPI_Dataty
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFBasicPackGetUnpackOp(PetscSF sf,PetscSFBasicPack link,MPI_Op op,void (**UnpackOp)(PetscInt,PetscInt,const PetscInt*,void*,const void*))
+PetscErrorCode PetscSFBasicPackGetUnpackOp(PetscSF sf,PetscSFBasicPack link,MPI_Op op,void (**UnpackOp)(PetscInt,PetscInt,const PetscInt*,void*,const void*))
 {
   PetscFunctionBegin;
   *UnpackOp = NULL;
@@ -743,7 +743,7 @@ static PetscErrorCode PetscSFBasicPackWaitall(PetscSF sf,PetscSFBasicPack link)
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFBasicGetRootInfo(PetscSF sf,PetscInt *nrootranks,PetscInt *ndrootranks,const PetscMPIInt **rootranks,const PetscInt **rootoffset,const PetscInt **rootloc)
+PetscErrorCode PetscSFBasicGetRootInfo(PetscSF sf,PetscInt *nrootranks,PetscInt *ndrootranks,const PetscMPIInt **rootranks,const PetscInt **rootoffset,const PetscInt **rootloc)
 {
   PetscSF_Basic *bas = (PetscSF_Basic*)sf->data;
 
@@ -756,7 +756,7 @@ static PetscErrorCode PetscSFBasicGetRootInfo(PetscSF sf,PetscInt *nrootranks,Pe
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFBasicGetLeafInfo(PetscSF sf,PetscInt *nleafranks,PetscInt *ndleafranks,const PetscMPIInt **leafranks,const PetscInt **leafoffset,const PetscInt **leafloc)
+PetscErrorCode PetscSFBasicGetLeafInfo(PetscSF sf,PetscInt *nleafranks,PetscInt *ndleafranks,const PetscMPIInt **leafranks,const PetscInt **leafoffset,const PetscInt **leafloc)
 {
   PetscFunctionBegin;
   if (nleafranks)  *nleafranks  = sf->nranks;
@@ -767,7 +767,7 @@ static PetscErrorCode PetscSFBasicGetLeafInfo(PetscSF sf,PetscInt *nleafranks,Pe
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFBasicGetPack(PetscSF sf,MPI_Datatype unit,const void *key,PetscSFBasicPack *mylink)
+PetscErrorCode PetscSFBasicGetPack(PetscSF sf,MPI_Datatype unit,const void *key,PetscSFBasicPack *mylink)
 {
   PetscSF_Basic    *bas = (PetscSF_Basic*)sf->data;
   PetscErrorCode   ierr;
@@ -814,7 +814,7 @@ found:
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFBasicGetPackInUse(PetscSF sf,MPI_Datatype unit,const void *key,PetscCopyMode cmode,PetscSFBasicPack *mylink)
+PetscErrorCode PetscSFBasicGetPackInUse(PetscSF sf,MPI_Datatype unit,const void *key,PetscCopyMode cmode,PetscSFBasicPack *mylink)
 {
   PetscSF_Basic    *bas = (PetscSF_Basic*)sf->data;
   PetscErrorCode   ierr;
@@ -839,7 +839,7 @@ static PetscErrorCode PetscSFBasicGetPackInUse(PetscSF sf,MPI_Datatype unit,cons
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFBasicReclaimPack(PetscSF sf,PetscSFBasicPack *link)
+PetscErrorCode PetscSFBasicReclaimPack(PetscSF sf,PetscSFBasicPack *link)
 {
   PetscSF_Basic *bas = (PetscSF_Basic*)sf->data;
 
@@ -851,6 +851,71 @@ static PetscErrorCode PetscSFBasicReclaimPack(PetscSF sf,PetscSFBasicPack *link)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode PetscSFBasicGetMulti(PetscSF sf,PetscInt nfields,const MPI_Datatype *unit,const void **keys,PetscSFBasicMulti *mymulti)
+{
+  PetscSF_Basic     *bas = (PetscSF_Basic*)sf->data;
+  PetscErrorCode    ierr;
+  PetscSFBasicMulti multi;
+  PetscInt          i,f,nrootranks,ndrootranks,nleafranks,ndleafranks;
+  const PetscInt    *rootoffset,*leafoffset;
+
+  PetscFunctionBegin;
+  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,NULL,&rootoffset,NULL);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,NULL,&leafoffset,NULL);CHKERRQ(ierr);
+  ierr = PetscNew(&multi);CHKERRQ(ierr);
+  ierr = PetscMalloc3(nfields,&multi->links,nrootranks+1,&multi->rootdispl,nleafranks+1,&multi->leafdispl);CHKERRQ(ierr);
+  for (f=0; f<nfields; f++) {
+    ierr = PetscSFBasicGetPack(sf,unit[f],keys[f],&multi->links[f]);CHKERRQ(ierr);
+  }
+  multi->rootdispl[0] = 0;
+  for (i=0; i<nrootranks; i++) multi->rootdispl[i+1] = multi->rootdispl[i] + PetscSFBasicMultiOffset(multi,rootoffset[i+1]-rootoffset[i],nfields);
+  multi->leafdispl[0] = 0;
+  for (i=0; i<nleafranks; i++) multi->leafdispl[i+1] = multi->leafdispl[i] + PetscSFBasicMultiOffset(multi,leafoffset[i+1]-leafoffset[i],nfields);
+  ierr = PetscMalloc3(multi->rootdispl[nrootranks],&multi->root,multi->leafdispl[nleafranks],&multi->leaf,nrootranks+nleafranks-(ndrootranks+ndleafranks),&multi->requests);CHKERRQ(ierr);
+  multi->key     = nfields ? keys[0] : NULL;
+  multi->nfields = nfields;
+  multi->next    = bas->multi;
+  bas->multi     = multi;
+  *mymulti       = multi;
+  PetscFunctionReturn(0);
+}
+
+/* Finds the batched transaction started with these arguments, removes it from the list and returns its links to the cache */
+static PetscErrorCode PetscSFBasicGetMultiInUse(PetscSF sf,PetscInt nfields,const MPI_Datatype *unit,const void **keys,PetscSFBasicMulti *mymulti)
+{
+  PetscSF_Basic     *bas = (PetscSF_Basic*)sf->data;
+  PetscErrorCode    ierr;
+  PetscSFBasicMulti multi,*p;
+  PetscSFBasicPack  link;
+  PetscInt          f;
+
+  PetscFunctionBegin;
+  for (p=&bas->multi; (multi=*p); p=&multi->next) {
+    if (multi->nfields == nfields && multi->key == (nfields ? keys[0] : NULL)) {
+      *p = multi->next;
+      for (f=0; f<nfields; f++) {
+        ierr = PetscSFBasicGetPackInUse(sf,unit[f],keys[f],PETSC_OWN_POINTER,&link);CHKERRQ(ierr);
+        ierr = PetscSFBasicReclaimPack(sf,&link);CHKERRQ(ierr);
+      }
+      *mymulti = multi;
+      PetscFunctionReturn(0);
+    }
+  }
+  SETERRQ(PetscObjectComm((PetscObject)sf),PETSC_ERR_ARG_WRONGSTATE,"Could not find batched operation");
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFBasicMultiDestroy(PetscSFBasicMulti *multi)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree3((*multi)->links,(*multi)->rootdispl,(*multi)->leafdispl);CHKERRQ(ierr);
+  ierr = PetscFree3((*multi)->root,(*multi)->leaf,(*multi)->requests);CHKERRQ(ierr);
+  ierr = PetscFree(*multi);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode PetscSFSetFromOptions_Basic(PetscOptionItems *PetscOptionsObject,PetscSF sf)
 {
   PetscErrorCode ierr;
@@ -861,16 +926,17 @@ static PetscErrorCode PetscSFSetFromOptions_Basic(PetscOptionItems *PetscOptions
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFReset_Basic(PetscSF sf)
+PetscErrorCode PetscSFReset_Basic(PetscSF sf)
 {
   PetscSF_Basic    *bas = (PetscSF_Basic*)sf->data;
   PetscErrorCode   ierr;
   PetscSFBasicPack link,next;
 
   PetscFunctionBegin;
-  if (bas->inuse) SETERRQ(PetscObjectComm((PetscObject)sf),PETSC_ERR_ARG_WRONGSTATE,"Outstanding operation has not been completed");
+  if (bas->inuse || bas->multi) SETERRQ(PetscObjectComm((PetscObject)sf),PETSC_ERR_ARG_WRONGSTATE,"Outstanding operation has not been completed");
   ierr = PetscFree2(bas->iranks,bas->ioffset);CHKERRQ(ierr);
   ierr = PetscFree(bas->irootloc);CHKERRQ(ierr);
+  ierr = PetscFree2(bas->irootstart,bas->leafstart);CHKERRQ(ierr);
   for (link=bas->avail; link; link=next) {
     PetscInt i;
     next = link->next;
@@ -895,7 +961,7 @@ static PetscErrorCode PetscSFDestroy_Basic(PetscSF sf)
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFView_Basic(PetscSF sf,PetscViewer viewer)
+PetscErrorCode PetscSFView_Basic(PetscSF sf,PetscViewer viewer)
 {
   /* PetscSF_Basic *bas = (PetscSF_Basic*)sf->data; */
   PetscErrorCode ierr;
@@ -919,6 +985,7 @@ static PetscErrorCode PetscSFBcastBegin_Basic(PetscSF sf,MPI_Datatype unit,const
   const PetscInt    *rootoffset,*leafoffset,*rootloc,*leafloc;
   const PetscMPIInt *rootranks,*leafranks;
   MPI_Request       *rootreqs,*leafreqs;
+  PetscBool         zerocopy;
 
   PetscFunctionBegin;
   ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,&rootranks,&rootoffset,&rootloc);CHKERRQ(ierr);
@@ -926,16 +993,27 @@ static PetscErrorCode PetscSFBcastBegin_Basic(PetscSF sf,MPI_Datatype unit,const
   ierr = PetscSFBasicGetPack(sf,unit,rootdata,&link);CHKERRQ(ierr);
 
   ierr = PetscSFBasicPackGetReqs(sf,link,&rootreqs,&leafreqs);CHKERRQ(ierr);
+  zerocopy = (rootdata != leafdata) ? PETSC_TRUE : PETSC_FALSE;
   /* Eagerly post leaf receives, but only from non-distinguished ranks -- distinguished ranks will receive via shared memory */
   for (i=ndleafranks; i<nleafranks; i++) {
-    PetscMPIInt n = leafoffset[i+1] - leafoffset[i];
-    ierr = MPI_Irecv(link->leaf[i],n,unit,leafranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&leafreqs[i-ndleafranks]);CHKERRQ(ierr);
+    PetscMPIInt n    = leafoffset[i+1] - leafoffset[i];
+    void        *buf = (zerocopy && bas->leafstart[i] >= 0) ? (char*)leafdata+bas->leafstart[i]*link->unitbytes : link->leaf[i];
+    ierr = MPI_Irecv(buf,n,unit,leafranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&leafreqs[i-ndleafranks]);CHKERRQ(ierr);
   }
   /* Pack and send root data */
   for (i=0; i<nrootranks; i++) {
     PetscMPIInt n          = rootoffset[i+1] - rootoffset[i];
     void        *packstart = link->root[i];
-    (*link->Pack)(n,link->bs,rootloc+rootoffset[i],rootdata,packstart);
+    if (bas->irootstart[i] >= 0) {
+      const char *run = (const char*)rootdata+bas->irootstart[i]*link->unitbytes;
+      if (i >= ndrootranks && zerocopy) {
+        ierr = MPI_Isend((void*)run,n,unit,rootranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&rootreqs[i-ndrootranks]);CHKERRQ(ierr);
+        continue;
+      }
+      ierr = PetscMemcpy(packstart,run,n*link->unitbytes);CHKERRQ(ierr);
+    } else {
+      (*link->Pack)(n,link->bs,rootloc+rootoffset[i],rootdata,packstart);
+    }
     if (i < ndrootranks) continue; /* shared memory */
     ierr = MPI_Isend(packstart,n,unit,rootranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&rootreqs[i-ndrootranks]);CHKERRQ(ierr);
   }
@@ -944,10 +1022,12 @@ static PetscErrorCode PetscSFBcastBegin_Basic(PetscSF sf,MPI_Datatype unit,const
 
 PetscErrorCode PetscSFBcastEnd_Basic(PetscSF sf,MPI_Datatype unit,const void *rootdata,void *leafdata)
 {
+  PetscSF_Basic    *bas = (PetscSF_Basic*)sf->data;
   PetscErrorCode   ierr;
   PetscSFBasicPack link;
   PetscInt         i,nleafranks,ndleafranks;
   const PetscInt   *leafoffset,*leafloc;
+  PetscBool        zerocopy = (rootdata != leafdata) ? PETSC_TRUE : PETSC_FALSE;
 
   PetscFunctionBegin;
   ierr = PetscSFBasicGetPackInUse(sf,unit,rootdata,PETSC_OWN_POINTER,&link);CHKERRQ(ierr);
@@ -956,7 +1036,12 @@ PetscErrorCode PetscSFBcastEnd_Basic(PetscSF sf,MPI_Datatype unit,const void *ro
   for (i=0; i<nleafranks; i++) {
     PetscMPIInt n          = leafoffset[i+1] - leafoffset[i];
     const void  *packstart = link->leaf[i];
-    (*link->UnpackInsert)(n,link->bs,leafloc+leafoffset[i],leafdata,packstart);
+    if (bas->leafstart[i] >= 0) {
+      if (i >= ndleafranks && zerocopy) continue; /* received in place */
+      ierr = PetscMemcpy((char*)leafdata+bas->leafstart[i]*link->unitbytes,packstart,n*link->unitbytes);CHKERRQ(ierr);
+    } else {
+      (*link->UnpackInsert)(n,link->bs,leafloc+leafoffset[i],leafdata,packstart);
+    }
   }
   ierr = PetscSFBasicReclaimPack(sf,&link);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -972,6 +1057,7 @@ PetscErrorCode PetscSFReduceBegin_Basic(PetscSF sf,MPI_Datatype unit,const void
   const PetscInt    *rootoffset,*leafoffset,*rootloc,*leafloc;
   const PetscMPIInt *rootranks,*leafranks;
   MPI_Request       *rootreqs,*leafreqs;
+  PetscBool         zerocopy;
 
   PetscFunctionBegin;
   ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,&rootranks,&rootoffset,&rootloc);CHKERRQ(ierr);
@@ -985,10 +1071,20 @@ PetscErrorCode PetscSFReduceBegin_Basic(PetscSF sf,MPI_Datatype unit,const void
     ierr = MPI_Irecv(link->root[i],n,unit,rootranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&rootreqs[i-ndrootranks]);CHKERRQ(ierr);
   }
   /* Pack and send leaf data */
+  zerocopy = (rootdata != leafdata) ? PETSC_TRUE : PETSC_FALSE;
   for (i=0; i<nleafranks; i++) {
     PetscMPIInt n          = leafoffset[i+1] - leafoffset[i];
     void        *packstart = link->leaf[i];
-    (*link->Pack)(n,link->bs,leafloc+leafoffset[i],leafdata,packstart);
+    if (bas->leafstart[i] >= 0) {
+      const char *run = (const char*)leafdata+bas->leafstart[i]*link->unitbytes;
+      if (i >= ndleafranks && zerocopy) {
+        ierr = MPI_Isend((void*)run,n,unit,leafranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&leafreqs[i-ndleafranks]);CHKERRQ(ierr);
+        continue;
+      }
+      ierr = PetscMemcpy(packstart,run,n*link->unitbytes);CHKERRQ(ierr);
+    } else {
+      (*link->Pack)(n,link->bs,leafloc+leafoffset[i],leafdata,packstart);
+    }
     if (i < ndleafranks) continue; /* shared memory */
     ierr = MPI_Isend(packstart,n,unit,leafranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&leafreqs[i-ndleafranks]);CHKERRQ(ierr);
   }
@@ -997,6 +1093,7 @@ PetscErrorCode PetscSFReduceBegin_Basic(PetscSF sf,MPI_Datatype unit,const void
 
 static PetscErrorCode PetscSFReduceEnd_Basic(PetscSF sf,MPI_Datatype unit,const void *leafdata,void *rootdata,MPI_Op op)
 {
+  PetscSF_Basic    *bas = (PetscSF_Basic*)sf->data;
   void             (*UnpackOp)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
   PetscErrorCode   ierr;
   PetscSFBasicPack link;
@@ -1020,7 +1117,9 @@ static PetscErrorCode PetscSFReduceEnd_Basic(PetscSF sf,MPI_Datatype unit,const
     PetscMPIInt n   = rootoffset[i+1] - rootoffset[i];
     char *packstart = (char *) link->root[i];
 
-    if (UnpackOp) {
+    if (op == MPIU_REPLACE && bas->irootstart[i] >= 0) {
+      ierr = PetscMemcpy((char*)rootdata+bas->irootstart[i]*link->unitbytes,packstart,n*link->unitbytes);CHKERRQ(ierr);
+    } else if (UnpackOp) {
       (*UnpackOp)(n,link->bs,rootloc+rootoffset[i],rootdata,(const void *)packstart);
     }
 #if PETSC_HAVE_MPI_REDUCE_LOCAL
@@ -1041,7 +1140,7 @@ static PetscErrorCode PetscSFReduceEnd_Basic(PetscSF sf,MPI_Datatype unit,const
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFFetchAndOpBegin_Basic(PetscSF sf,MPI_Datatype unit,void *rootdata,const void *leafdata,void *leafupdate,MPI_Op op)
+PetscErrorCode PetscSFFetchAndOpBegin_Basic(PetscSF sf,MPI_Datatype unit,void *rootdata,const void *leafdata,void *leafupdate,MPI_Op op)
 {
   PetscErrorCode ierr;
 
@@ -1050,7 +1149,7 @@ static PetscErrorCode PetscSFFetchAndOpBegin_Basic(PetscSF sf,MPI_Datatype unit,
   PetscFunctionReturn(0);
 }
 
-static PetscErrorCode PetscSFFetchAndOpEnd_Basic(PetscSF sf,MPI_Datatype unit,void *rootdata,const void *leafdata,void *leafupdate,MPI_Op op)
+PetscErrorCode PetscSFFetchAndOpEnd_Basic(PetscSF sf,MPI_Datatype unit,void *rootdata,const void *leafdata,void *leafupdate,MPI_Op op)
 {
   PetscSF_Basic     *bas = (PetscSF_Basic*)sf->data;
   void              (*FetchAndOp)(PetscInt,PetscInt,const PetscInt*,void*,void*);
@@ -1093,6 +1192,125 @@ static PetscErrorCode PetscSFFetchAndOpEnd_Basic(PetscSF sf,MPI_Datatype unit,vo
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode PetscSFBcastMultiBegin_Basic(PetscSF sf,PetscInt nfields,const MPI_Datatype *unit,const void **rootdata,void **leafdata)
+{
+  PetscSF_Basic     *bas = (PetscSF_Basic*)sf->data;
+  PetscErrorCode    ierr;
+  PetscSFBasicMulti multi;
+  PetscInt          i,f,nrootranks,ndrootranks,nleafranks,ndleafranks;
+  const PetscInt    *rootoffset,*leafoffset,*rootloc;
+  const PetscMPIInt *rootranks,*leafranks;
+  MPI_Request       *rootreqs,*leafreqs;
+  PetscMPIInt       count;
+
+  PetscFunctionBegin;
+  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,&rootranks,&rootoffset,&rootloc);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,&leafranks,&leafoffset,NULL);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetMulti(sf,nfields,unit,rootdata,&multi);CHKERRQ(ierr);
+  rootreqs = multi->requests;
+  leafreqs = multi->requests + (nrootranks - ndrootranks);
+  for (i=ndleafranks; i<nleafranks; i++) {
+    ierr = PetscMPIIntCast(multi->leafdispl[i+1]-multi->leafdispl[i],&count);CHKERRQ(ierr);
+    ierr = MPI_Irecv(multi->leaf+multi->leafdispl[i],count,MPI_BYTE,leafranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&leafreqs[i-ndleafranks]);CHKERRQ(ierr);
+  }
+  for (i=0; i<nrootranks; i++) {
+    PetscInt n          = rootoffset[i+1] - rootoffset[i];
+    char     *packstart = multi->root + multi->rootdispl[i];
+    for (f=0; f<nfields; f++) (*multi->links[f]->Pack)(n,multi->links[f]->bs,rootloc+rootoffset[i],rootdata[f],packstart+PetscSFBasicMultiOffset(multi,n,f));
+    if (i < ndrootranks) continue; /* shared memory */
+    ierr = PetscMPIIntCast(multi->rootdispl[i+1]-multi->rootdispl[i],&count);CHKERRQ(ierr);
+    ierr = MPI_Isend(packstart,count,MPI_BYTE,rootranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&rootreqs[i-ndrootranks]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscSFBcastMultiEnd_Basic(PetscSF sf,PetscInt nfields,const MPI_Datatype *unit,const void **rootdata,void **leafdata)
+{
+  PetscErrorCode    ierr;
+  PetscSFBasicMulti multi;
+  PetscInt          i,f,nrootranks,ndrootranks,nleafranks,ndleafranks;
+  const PetscInt    *leafoffset,*leafloc;
+
+  PetscFunctionBegin;
+  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,NULL,NULL,NULL);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,NULL,&leafoffset,&leafloc);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetMultiInUse(sf,nfields,unit,rootdata,&multi);CHKERRQ(ierr);
+  ierr = MPI_Waitall(nrootranks+nleafranks-(ndrootranks+ndleafranks),multi->requests,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+  for (i=0; i<nleafranks; i++) {
+    PetscInt   n          = leafoffset[i+1] - leafoffset[i];
+    const char *packstart = (i < ndleafranks) ? multi->root : multi->leaf + multi->leafdispl[i]; /* distinguished ranks read the root buffer */
+    for (f=0; f<nfields; f++) (*multi->links[f]->UnpackInsert)(n,multi->links[f]->bs,leafloc+leafoffset[i],leafdata[f],packstart+PetscSFBasicMultiOffset(multi,n,f));
+  }
+  ierr = PetscSFBasicMultiDestroy(&multi);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscSFReduceMultiBegin_Basic(PetscSF sf,PetscInt nfields,const MPI_Datatype *unit,const void **leafdata,void **rootdata,MPI_Op op)
+{
+  PetscSF_Basic     *bas = (PetscSF_Basic*)sf->data;
+  PetscErrorCode    ierr;
+  PetscSFBasicMulti multi;
+  PetscInt          i,f,nrootranks,ndrootranks,nleafranks,ndleafranks;
+  const PetscInt    *rootoffset,*leafoffset,*leafloc;
+  const PetscMPIInt *rootranks,*leafranks;
+  MPI_Request       *rootreqs,*leafreqs;
+  PetscMPIInt       count;
+  void              (*UnpackOp)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
+
+  PetscFunctionBegin;
+  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,&rootranks,&rootoffset,NULL);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,&leafranks,&leafoffset,&leafloc);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetMulti(sf,nfields,unit,(const void**)rootdata,&multi);CHKERRQ(ierr);
+  /* check the operation before anything is sent, an unsupported one ends the transaction here */
+  for (f=0; f<nfields; f++) {
+    ierr = PetscSFBasicPackGetUnpackOp(sf,multi->links[f],op,&UnpackOp);CHKERRQ(ierr);
+    if (!UnpackOp) {
+      ierr = PetscSFBasicGetMultiInUse(sf,nfields,unit,(const void**)rootdata,&multi);CHKERRQ(ierr);
+      ierr = PetscSFBasicMultiDestroy(&multi);CHKERRQ(ierr);
+      SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_SUP,"No unpacking reduction operation for this MPI_Op in a batched reduction, for field %D",f);
+    }
+  }
+  rootreqs = multi->requests;
+  leafreqs = multi->requests + (nrootranks - ndrootranks);
+  for (i=ndrootranks; i<nrootranks; i++) {
+    ierr = PetscMPIIntCast(multi->rootdispl[i+1]-multi->rootdispl[i],&count);CHKERRQ(ierr);
+    ierr = MPI_Irecv(multi->root+multi->rootdispl[i],count,MPI_BYTE,rootranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&rootreqs[i-ndrootranks]);CHKERRQ(ierr);
+  }
+  for (i=0; i<nleafranks; i++) {
+    PetscInt n          = leafoffset[i+1] - leafoffset[i];
+    char     *packstart = (i < ndleafranks) ? multi->root : multi->leaf + multi->leafdispl[i]; /* distinguished ranks write the root buffer */
+    for (f=0; f<nfields; f++) (*multi->links[f]->Pack)(n,multi->links[f]->bs,leafloc+leafoffset[i],leafdata[f],packstart+PetscSFBasicMultiOffset(multi,n,f));
+    if (i < ndleafranks) continue; /* shared memory */
+    ierr = PetscMPIIntCast(multi->leafdispl[i+1]-multi->leafdispl[i],&count);CHKERRQ(ierr);
+    ierr = MPI_Isend(packstart,count,MPI_BYTE,leafranks[i],bas->tag,PetscObjectComm((PetscObject)sf),&leafreqs[i-ndleafranks]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PetscSFReduceMultiEnd_Basic(PetscSF sf,PetscInt nfields,const MPI_Datatype *unit,const void **leafdata,void **rootdata,MPI_Op op)
+{
+  void              (*UnpackOp)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
+  PetscErrorCode    ierr;
+  PetscSFBasicMulti multi;
+  PetscInt          i,f,nrootranks,ndrootranks,nleafranks,ndleafranks;
+  const PetscInt    *rootoffset,*rootloc;
+
+  PetscFunctionBegin;
+  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,NULL,&rootoffset,&rootloc);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,NULL,NULL,NULL);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetMultiInUse(sf,nfields,unit,(const void**)rootdata,&multi);CHKERRQ(ierr);
+  ierr = MPI_Waitall(nrootranks+nleafranks-(ndrootranks+ndleafranks),multi->requests,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+  for (f=0; f<nfields; f++) {
+    ierr = PetscSFBasicPackGetUnpackOp(sf,multi->links[f],op,&UnpackOp);CHKERRQ(ierr); /* checked in PetscSFReduceMultiBegin_Basic() */
+    for (i=0; i<nrootranks; i++) {
+      PetscInt n = rootoffset[i+1] - rootoffset[i];
+      (*UnpackOp)(n,multi->links[f]->bs,rootloc+rootoffset[i],rootdata[f],multi->root+multi->rootdispl[i]+PetscSFBasicMultiOffset(multi,n,f));
+    }
+  }
+  ierr = PetscSFBasicMultiDestroy(&multi);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PETSC_EXTERN PetscErrorCode PetscSFCreate_Basic(PetscSF sf)
 {
   PetscSF_Basic  *bas = (PetscSF_Basic*)sf->data;
@@ -1110,6 +1328,10 @@ PETSC_EXTERN PetscErrorCode PetscSFCreate_Basic(PetscSF sf)
   sf->ops->ReduceEnd       = PetscSFReduceEnd_Basic;
   sf->ops->FetchAndOpBegin = PetscSFFetchAndOpBegin_Basic;
   sf->ops->FetchAndOpEnd   = PetscSFFetchAndOpEnd_Basic;
+  sf->ops->BcastMultiBegin  = PetscSFBcastMultiBegin_Basic;
+  sf->ops->BcastMultiEnd    = PetscSFBcastMultiEnd_Basic;
+  sf->ops->ReduceMultiBegin = PetscSFReduceMultiBegin_Basic;
+  sf->ops->ReduceMultiEnd   = PetscSFReduceMultiEnd_Basic;
 
   ierr = PetscNewLog(sf,&bas);CHKERRQ(ierr);
   sf->data = (void*)bas;
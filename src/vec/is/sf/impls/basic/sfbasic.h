@@ -0,0 +1,81 @@
+/*
+   Private data structures of the PETSCSFBASIC star forest, shared with the implementations built on top of it
+*/
+#if !defined(__SFBASIC_H)
+#define __SFBASIC_H
+
+#include <petsc/private/sfimpl.h>
+
+typedef struct _n_PetscSFBasicPack *PetscSFBasicPack;
+typedef struct _n_PetscSFBasicMulti *PetscSFBasicMulti;
+struct _n_PetscSFBasicPack {
+  void (*Pack)(PetscInt,PetscInt,const PetscInt*,const void*,void*);
+  void (*UnpackInsert)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
+  void (*UnpackAdd)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
+  void (*UnpackMin)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
+  void (*UnpackMax)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
+  void (*UnpackMinloc)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
+  void (*UnpackMaxloc)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
+  void (*UnpackMult)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
+  void (*UnpackLAND)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
+  void (*UnpackBAND)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
+  void (*UnpackLOR)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
+  void (*UnpackBOR)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
+  void (*UnpackLXOR)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
+  void (*UnpackBXOR)(PetscInt,PetscInt,const PetscInt*,void*,const void *);
+  void (*FetchAndInsert)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndAdd)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndMin)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndMax)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndMinloc)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndMaxloc)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndMult)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndLAND)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndBAND)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndLOR)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndBOR)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndLXOR)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+  void (*FetchAndBXOR)(PetscInt,PetscInt,const PetscInt*,void*,void*);
+
+  MPI_Datatype     unit;
+  size_t           unitbytes;   /* Number of bytes in a unit */
+  PetscInt         bs;          /* Number of basic units in a unit */
+  const void       *key;        /* Array used as key for operation */
+  char             **root;      /* Packed root data, indexed by leaf rank */
+  char             **leaf;      /* Packed leaf data, indexed by root rank */
+  MPI_Request      *requests;   /* Array of root requests followed by leaf requests */
+  PetscSFBasicPack next;
+};
+
+typedef struct {
+  PetscMPIInt      tag;
+  PetscMPIInt      niranks;     /* Number of incoming ranks (ranks accessing my roots) */
+  PetscMPIInt      ndiranks;    /* Number of incoming ranks (ranks accessing my roots) in distinguished set */
+  PetscMPIInt      *iranks;     /* Array of ranks that reference my roots */
+  PetscInt         itotal;      /* Total number of graph edges referencing my roots */
+  PetscInt         *ioffset;    /* Array of length niranks+1 holding offset in irootloc[] for each rank */
+  PetscInt         *irootloc;   /* Incoming roots referenced by ranks starting at ioffset[rank] */
+  PetscInt         *irootstart; /* [niranks] first root referenced by iranks[i] if these roots are contiguous, otherwise -1 */
+  PetscInt         *leafstart;  /* [nranks] first leaf connected to ranks[i] if these leaves are contiguous, otherwise -1 */
+  PetscSFBasicPack avail;       /* One or more entries per MPI Datatype, lazily constructed */
+  PetscSFBasicPack inuse;       /* Buffers being used for transactions that have not yet completed */
+  PetscSFBasicMulti multi;      /* Batched transactions on several fields that have not yet completed */
+} PetscSF_Basic;
+
+PETSC_INTERN PetscErrorCode PetscSFSetUp_Basic(PetscSF);
+PETSC_INTERN PetscErrorCode PetscSFReset_Basic(PetscSF);
+PETSC_INTERN PetscErrorCode PetscSFView_Basic(PetscSF,PetscViewer);
+PETSC_INTERN PetscErrorCode PetscSFFetchAndOpBegin_Basic(PetscSF,MPI_Datatype,void*,const void*,void*,MPI_Op);
+PETSC_INTERN PetscErrorCode PetscSFFetchAndOpEnd_Basic(PetscSF,MPI_Datatype,void*,const void*,void*,MPI_Op);
+PETSC_INTERN PetscErrorCode PetscSFBcastMultiBegin_Basic(PetscSF,PetscInt,const MPI_Datatype*,const void**,void**);
+PETSC_INTERN PetscErrorCode PetscSFBcastMultiEnd_Basic(PetscSF,PetscInt,const MPI_Datatype*,const void**,void**);
+PETSC_INTERN PetscErrorCode PetscSFReduceMultiBegin_Basic(PetscSF,PetscInt,const MPI_Datatype*,const void**,void**,MPI_Op);
+PETSC_INTERN PetscErrorCode PetscSFReduceMultiEnd_Basic(PetscSF,PetscInt,const MPI_Datatype*,const void**,void**,MPI_Op);
+PETSC_INTERN PetscErrorCode PetscSFBasicGetRootInfo(PetscSF,PetscInt*,PetscInt*,const PetscMPIInt**,const PetscInt**,const PetscInt**);
+PETSC_INTERN PetscErrorCode PetscSFBasicGetLeafInfo(PetscSF,PetscInt*,PetscInt*,const PetscMPIInt**,const PetscInt**,const PetscInt**);
+PETSC_INTERN PetscErrorCode PetscSFBasicGetPack(PetscSF,MPI_Datatype,const void*,PetscSFBasicPack*);
+PETSC_INTERN PetscErrorCode PetscSFBasicGetPackInUse(PetscSF,MPI_Datatype,const void*,PetscCopyMode,PetscSFBasicPack*);
+PETSC_INTERN PetscErrorCode PetscSFBasicReclaimPack(PetscSF,PetscSFBasicPack*);
+PETSC_INTERN PetscErrorCode PetscSFBasicPackGetUnpackOp(PetscSF,PetscSFBasicPack,MPI_Op,void (**)(PetscInt,PetscInt,const PetscInt*,void*,const void*));
+
+#endif
@@ -0,0 +1,556 @@
+#include <../src/vec/is/sf/impls/basic/sfbasic.h> /*I "petscsf.h" I*/
+
+/*
+ * PETSCSFNODE uses the setup of PETSCSFBASIC but replaces its broadcasts and reductions. The processes of a node
+ * exchange their packed data through a shared memory window, and the data between two nodes travels in a single
+ * message between the first processes of the nodes, the leaders, which gather and scatter it in the window.
+ *
+ * Each process owns a segment of the window, counted in units of the data type of the operation:
+ *   [0,itotal)                     root data packed for each leaf rank iranks[i], at ioffset[i]
+ *   [itotal,itotal+roffset[nranks]) leaf data packed for each root rank ranks[j], at itotal+roffset[j]
+ * followed, on the leaders, by the messages exchanged with the other leaders (see PetscSFNodeMsgs).
+ */
+
+typedef struct _n_PetscSFNodeWin *PetscSFNodeWin;
+struct _n_PetscSFNodeWin {
+  MPI_Win          win;
+  size_t           bytes;       /* Size of my segment */
+  char             **base;      /* [nodesize] Segment of each process of the node */
+  MPI_Request      *requests;   /* Messages of the leader */
+  PetscSFBasicPack link;        /* Operation using the window, NULL if the window is available */
+  PetscSFNodeWin   next;
+};
+
+/*
+ * The messages exchanged by a leader with the other leaders in one direction. The message to or from a remote leader
+ * is made of pieces, the data between a pair of processes, ordered by process in the sending node then by process
+ * in the receiving node, so that both leaders agree on the layout without communicating it.
+ */
+typedef struct {
+  PetscInt    n;                /* Number of remote leaders */
+  PetscMPIInt *leaders;         /* [n] Remote leaders */
+  PetscInt    *offset;          /* [n+1] Offset of the message of each remote leader, relative to start */
+  PetscInt    start;            /* Offset of the messages in the segment of the leader */
+  PetscInt    npieces;          /* Number of pieces, one after the other in the messages */
+  PetscMPIInt *local;           /* [npieces] Process of the node whose segment holds each piece */
+  PetscInt    *poffset;         /* [npieces] Offset of each piece in the segment of that process */
+  PetscInt    *count;           /* [npieces] Size of each piece */
+} PetscSFNodeMsgs;
+
+typedef struct {
+  PetscSF_Basic   bas;          /* Must come first, since the PETSCSFBASIC routines are used on this type */
+  PetscInt        splitsize;    /* Split each shared memory node in groups of this many processes, 0 to keep it whole */
+  PetscMPIInt     tag;
+  MPI_Comm        comm;         /* Processes of the node */
+  PetscMPIInt     nrank,nsize;  /* Rank and size in comm, the leader has rank 0 */
+  PetscInt        units;        /* Size of my segment */
+  PetscMPIInt     *rootlocal;   /* [niranks] Rank in the node of iranks[i], -1 if it is on another node */
+  PetscInt        *rootremote;  /* [niranks] Offset of the leaf data of iranks[i] for my roots, in its segment or in the one of the leader */
+  PetscMPIInt     *leaflocal;   /* [nranks] Rank in the node of ranks[j], -1 if it is on another node */
+  PetscInt        *leafremote;  /* [nranks] Offset of the root data of ranks[j] for my leaves, in its segment or in the one of the leader */
+  PetscSFNodeMsgs rootmsgs;     /* Leader: root data of the node, sent by broadcasts and received by reductions */
+  PetscSFNodeMsgs leafmsgs;     /* Leader: leaf data of the node, received by broadcasts and sent by reductions */
+  PetscSFNodeWin  wins;         /* Windows, one per operation in progress */
+} PetscSF_Node;
+
+/* A piece of data between two processes on different nodes, as gathered by the leader */
+typedef struct {
+  PetscInt leader,src,dst,count,offset,local,index;
+} PetscSFNodePiece;
+
+static int PetscSFNodePieceCompare(const void *a,const void *b)
+{
+  const PetscSFNodePiece *p = (const PetscSFNodePiece*)a,*q = (const PetscSFNodePiece*)b;
+
+  if (p->leader != q->leader) return p->leader < q->leader ? -1 : 1;
+  if (p->src != q->src) return p->src < q->src ? -1 : 1;
+  if (p->dst != q->dst) return p->dst < q->dst ? -1 : 1;
+  return 0;
+}
+
+/*
+ * Gathers on the leader the pieces of the node, given by each process as (remote leader,src,dst,count,offset,local),
+ * lays out the messages from start and returns to each process the offset of its pieces in the segment of the leader
+ */
+static PetscErrorCode PetscSFNodeSetUpMsgs(PetscSF sf,PetscInt npieces,const PetscInt *pieces,PetscInt start,PetscSFNodeMsgs *msgs,PetscInt *remote)
+{
+  PetscSF_Node     *node = (PetscSF_Node*)sf->data;
+  PetscErrorCode   ierr;
+  PetscMPIInt      np,*counts = NULL,*displs = NULL,*rcounts = NULL,*rdispls = NULL;
+  PetscInt         i,k,total = 0,*all = NULL,*allremote = NULL;
+  PetscSFNodePiece *sorted = NULL;
+
+  PetscFunctionBegin;
+  ierr = PetscMemzero(msgs,sizeof(*msgs));CHKERRQ(ierr);
+  ierr = PetscMPIIntCast(npieces,&np);CHKERRQ(ierr);
+  if (!node->nrank) {ierr = PetscMalloc4(node->nsize,&counts,node->nsize+1,&displs,node->nsize,&rcounts,node->nsize+1,&rdispls);CHKERRQ(ierr);}
+  ierr = MPI_Gather(&np,1,MPI_INT,rcounts,1,MPI_INT,0,node->comm);CHKERRQ(ierr);
+  if (!node->nrank) {
+    rdispls[0] = displs[0] = 0;
+    for (i=0; i<node->nsize; i++) {
+      counts[i]    = 6*rcounts[i];
+      displs[i+1]  = displs[i] + counts[i];
+      rdispls[i+1] = rdispls[i] + rcounts[i];
+    }
+    total = rdispls[node->nsize];
+    ierr  = PetscMalloc3(6*total,&all,total,&allremote,total,&sorted);CHKERRQ(ierr);
+  }
+  ierr = PetscMPIIntCast(6*npieces,&np);CHKERRQ(ierr);
+  ierr = MPI_Gatherv((void*)pieces,np,MPIU_INT,all,counts,displs,MPIU_INT,0,node->comm);CHKERRQ(ierr);
+  if (!node->nrank) {
+    PetscInt pos = 0;
+
+    for (k=0; k<total; k++) {
+      sorted[k].leader = all[6*k];
+      sorted[k].src    = all[6*k+1];
+      sorted[k].dst    = all[6*k+2];
+      sorted[k].count  = all[6*k+3];
+      sorted[k].offset = all[6*k+4];
+      sorted[k].local  = all[6*k+5];
+      sorted[k].index  = k;
+    }
+    qsort(sorted,total,sizeof(PetscSFNodePiece),PetscSFNodePieceCompare);
+    for (k=0; k<total; k++) if (!k || sorted[k].leader != sorted[k-1].leader) msgs->n++;
+    msgs->start   = start;
+    msgs->npieces = total;
+    ierr = PetscMalloc5(msgs->n,&msgs->leaders,msgs->n+1,&msgs->offset,total,&msgs->local,total,&msgs->poffset,total,&msgs->count);CHKERRQ(ierr);
+    for (i=-1,k=0; k<total; k++) {
+      if (!k || sorted[k].leader != sorted[k-1].leader) {
+        i++;
+        ierr = PetscMPIIntCast(sorted[k].leader,&msgs->leaders[i]);CHKERRQ(ierr);
+        msgs->offset[i] = pos;
+      }
+      ierr = PetscMPIIntCast(sorted[k].local,&msgs->local[k]);CHKERRQ(ierr);
+      msgs->poffset[k]           = sorted[k].offset;
+      msgs->count[k]             = sorted[k].count;
+      allremote[sorted[k].index] = start + pos;
+      pos                       += sorted[k].count;
+    }
+    msgs->offset[msgs->n] = pos;
+  }
+  ierr = MPI_Scatterv(allremote,rcounts,rdispls,MPIU_INT,remote,npieces,MPIU_INT,0,node->comm);CHKERRQ(ierr);
+  if (!node->nrank) {
+    ierr = PetscFree4(counts,displs,rcounts,rdispls);CHKERRQ(ierr);
+    ierr = PetscFree3(all,allremote,sorted);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFNodeMsgsDestroy(PetscSFNodeMsgs *msgs)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree5(msgs->leaders,msgs->offset,msgs->local,msgs->poffset,msgs->count);CHKERRQ(ierr);
+  ierr = PetscMemzero(msgs,sizeof(*msgs));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFSetUp_Node(PetscSF sf)
+{
+  PetscSF_Node      *node = (PetscSF_Node*)sf->data;
+  PetscErrorCode    ierr;
+  MPI_Comm          comm,shmcomm;
+  PetscShmComm      pshmcomm;
+  MPI_Group         group,nodegroup;
+  PetscMPIInt       rank,leader,tag,*nodeglob,*nodelocal,nreqs = 0;
+  PetscInt          i,loc,nrootranks,ndrootranks,nleafranks,ndleafranks,itotal,npieces,*pieces,*remote;
+  PetscInt          *sendroot,*sendleaf,*recvroot,*recvleaf;
+  const PetscInt    *rootoffset,*leafoffset;
+  const PetscMPIInt *rootranks,*leafranks;
+  MPI_Request       *reqs;
+
+  PetscFunctionBegin;
+  ierr = PetscSFSetUp_Basic(sf);CHKERRQ(ierr);
+  ierr = PetscObjectGetComm((PetscObject)sf,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  ierr = PetscObjectGetNewTag((PetscObject)sf,&node->tag);CHKERRQ(ierr);
+  ierr = PetscObjectGetNewTag((PetscObject)sf,&tag);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,&ndrootranks,&rootranks,&rootoffset,NULL);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,&ndleafranks,&leafranks,&leafoffset,NULL);CHKERRQ(ierr);
+  itotal = rootoffset[nrootranks];
+
+  /* The processes sharing memory, possibly split in smaller groups */
+  ierr = PetscShmCommGet(comm,&pshmcomm);CHKERRQ(ierr);
+  ierr = PetscShmCommGetMpiShmComm(pshmcomm,&shmcomm);CHKERRQ(ierr);
+  if (node->splitsize > 0) {
+    PetscMPIInt shmrank,color;
+
+    ierr = MPI_Comm_rank(shmcomm,&shmrank);CHKERRQ(ierr);
+    ierr = PetscMPIIntCast(shmrank/node->splitsize,&color);CHKERRQ(ierr);
+    ierr = MPI_Comm_split(shmcomm,color,shmrank,&node->comm);CHKERRQ(ierr);
+  } else {
+    ierr = MPI_Comm_dup(shmcomm,&node->comm);CHKERRQ(ierr);
+  }
+  ierr = MPI_Comm_rank(node->comm,&node->nrank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(node->comm,&node->nsize);CHKERRQ(ierr);
+  ierr = PetscMalloc2(node->nsize,&nodeglob,node->nsize,&nodelocal);CHKERRQ(ierr);
+  for (i=0; i<node->nsize; i++) nodelocal[i] = (PetscMPIInt)i;
+  ierr = MPI_Comm_group(comm,&group);CHKERRQ(ierr);
+  ierr = MPI_Comm_group(node->comm,&nodegroup);CHKERRQ(ierr);
+  ierr = MPI_Group_translate_ranks(nodegroup,node->nsize,nodelocal,group,nodeglob);CHKERRQ(ierr);
+  ierr = MPI_Group_free(&group);CHKERRQ(ierr);
+  ierr = MPI_Group_free(&nodegroup);CHKERRQ(ierr);
+  leader = nodeglob[0];
+  ierr = PetscSortMPIIntWithArray(node->nsize,nodeglob,nodelocal);CHKERRQ(ierr);
+
+  /* Tell each neighbor our leader and the offset of its data in our segment */
+  ierr = PetscMalloc2(4*(nrootranks+nleafranks),&sendroot,2*(nrootranks+nleafranks),&reqs);CHKERRQ(ierr);
+  sendleaf = sendroot + 2*nrootranks;
+  recvroot = sendleaf + 2*nleafranks;
+  recvleaf = recvroot + 2*nrootranks;
+  for (i=0; i<nrootranks; i++) {
+    sendroot[2*i]   = leader;
+    sendroot[2*i+1] = rootoffset[i];
+  }
+  for (i=0; i<nleafranks; i++) {
+    sendleaf[2*i]   = leader;
+    sendleaf[2*i+1] = itotal + leafoffset[i];
+  }
+  for (i=ndrootranks; i<nrootranks; i++) {
+    ierr = MPI_Irecv(recvroot+2*i,2,MPIU_INT,rootranks[i],tag,comm,&reqs[nreqs++]);CHKERRQ(ierr);
+    ierr = MPI_Isend(sendroot+2*i,2,MPIU_INT,rootranks[i],node->tag,comm,&reqs[nreqs++]);CHKERRQ(ierr);
+  }
+  for (i=ndleafranks; i<nleafranks; i++) {
+    ierr = MPI_Irecv(recvleaf+2*i,2,MPIU_INT,leafranks[i],node->tag,comm,&reqs[nreqs++]);CHKERRQ(ierr);
+    ierr = MPI_Isend(sendleaf+2*i,2,MPIU_INT,leafranks[i],tag,comm,&reqs[nreqs++]);CHKERRQ(ierr);
+  }
+  ierr = MPI_Waitall(nreqs,reqs,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+  if (ndrootranks) {            /* The distinguished rank is this process, whose leaf data for itself is in its own segment */
+    recvroot[0] = sendleaf[0];
+    recvroot[1] = sendleaf[1];
+  }
+  if (ndleafranks) {
+    recvleaf[0] = sendroot[0];
+    recvleaf[1] = sendroot[1];
+  }
+
+  /* Neighbors on the node are read directly, the data of the other ones goes through the messages of the leader */
+  ierr = PetscMalloc4(nrootranks,&node->rootlocal,nrootranks,&node->rootremote,nleafranks,&node->leaflocal,nleafranks,&node->leafremote);CHKERRQ(ierr);
+  ierr = PetscMalloc2(6*PetscMax(nrootranks,nleafranks),&pieces,PetscMax(nrootranks,nleafranks),&remote);CHKERRQ(ierr);
+  node->units = itotal + leafoffset[nleafranks];
+  for (i=0,npieces=0; i<nrootranks; i++) {
+    ierr = PetscFindMPIInt(rootranks[i],node->nsize,nodeglob,&loc);CHKERRQ(ierr);
+    node->rootlocal[i]  = loc >= 0 ? nodelocal[loc] : -1;
+    node->rootremote[i] = recvroot[2*i+1];
+    if (loc >= 0) continue;
+    pieces[6*npieces]   = recvroot[2*i];
+    pieces[6*npieces+1] = rank;
+    pieces[6*npieces+2] = rootranks[i];
+    pieces[6*npieces+3] = rootoffset[i+1] - rootoffset[i];
+    pieces[6*npieces+4] = rootoffset[i];
+    pieces[6*npieces+5] = node->nrank;
+    npieces++;
+  }
+  ierr = PetscSFNodeSetUpMsgs(sf,npieces,pieces,node->units,&node->rootmsgs,remote);CHKERRQ(ierr);
+  for (i=0,npieces=0; i<nrootranks; i++) if (node->rootlocal[i] < 0) node->rootremote[i] = remote[npieces++];
+  if (!node->nrank) node->units += node->rootmsgs.offset[node->rootmsgs.n];
+  for (i=0,npieces=0; i<nleafranks; i++) {
+    ierr = PetscFindMPIInt(leafranks[i],node->nsize,nodeglob,&loc);CHKERRQ(ierr);
+    node->leaflocal[i]  = loc >= 0 ? nodelocal[loc] : -1;
+    node->leafremote[i] = recvleaf[2*i+1];
+    if (loc >= 0) continue;
+    pieces[6*npieces]   = recvleaf[2*i];
+    pieces[6*npieces+1] = leafranks[i];
+    pieces[6*npieces+2] = rank;
+    pieces[6*npieces+3] = leafoffset[i+1] - leafoffset[i];
+    pieces[6*npieces+4] = itotal + leafoffset[i];
+    pieces[6*npieces+5] = node->nrank;
+    npieces++;
+  }
+  ierr = PetscSFNodeSetUpMsgs(sf,npieces,pieces,node->units,&node->leafmsgs,remote);CHKERRQ(ierr);
+  for (i=0,npieces=0; i<nleafranks; i++) if (node->leaflocal[i] < 0) node->leafremote[i] = remote[npieces++];
+  if (!node->nrank) node->units += node->leafmsgs.offset[node->leafmsgs.n];
+
+  ierr = PetscFree2(pieces,remote);CHKERRQ(ierr);
+  ierr = PetscFree2(sendroot,reqs);CHKERRQ(ierr);
+  ierr = PetscFree2(nodeglob,nodelocal);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFReset_Node(PetscSF sf)
+{
+  PetscSF_Node   *node = (PetscSF_Node*)sf->data;
+  PetscErrorCode ierr;
+  PetscSFNodeWin win,next;
+
+  PetscFunctionBegin;
+  for (win=node->wins; win; win=next) {
+    next = win->next;
+    if (win->link) SETERRQ(PetscObjectComm((PetscObject)sf),PETSC_ERR_ARG_WRONGSTATE,"Outstanding operation has not been completed");
+    if (win->win != MPI_WIN_NULL) {ierr = MPI_Win_free(&win->win);CHKERRQ(ierr);}
+    ierr = PetscFree2(win->base,win->requests);CHKERRQ(ierr);
+    ierr = PetscFree(win);CHKERRQ(ierr);
+  }
+  node->wins = NULL;
+  ierr = PetscFree4(node->rootlocal,node->rootremote,node->leaflocal,node->leafremote);CHKERRQ(ierr);
+  ierr = PetscSFNodeMsgsDestroy(&node->rootmsgs);CHKERRQ(ierr);
+  ierr = PetscSFNodeMsgsDestroy(&node->leafmsgs);CHKERRQ(ierr);
+  if (node->comm != MPI_COMM_NULL) {ierr = MPI_Comm_free(&node->comm);CHKERRQ(ierr);}
+  ierr = PetscSFReset_Basic(sf);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFDestroy_Node(PetscSF sf)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSFReset_Node(sf);CHKERRQ(ierr);
+  ierr = PetscFree(sf->data);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFSetFromOptions_Node(PetscOptionItems *PetscOptionsObject,PetscSF sf)
+{
+  PetscSF_Node   *node = (PetscSF_Node*)sf->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"PetscSF Node options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-sf_node_split_size","Split each shared memory node in groups of this many processes","PetscSFSetType",node->splitsize,&node->splitsize,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFView_Node(PetscSF sf,PetscViewer viewer)
+{
+  PetscSF_Node   *node = (PetscSF_Node*)sf->data;
+  PetscErrorCode ierr;
+  PetscBool      iascii;
+
+  PetscFunctionBegin;
+  ierr = PetscSFView_Basic(sf,viewer);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii && node->comm != MPI_COMM_NULL) {
+    ierr = PetscViewerASCIIPrintf(viewer,"  processes per node %d\n",node->nsize);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Gets an available window whose segments can hold the data of the operation */
+static PetscErrorCode PetscSFNodeGetWin(PetscSF sf,PetscSFBasicPack link,PetscSFNodeWin *mywin)
+{
+  PetscSF_Node   *node = (PetscSF_Node*)sf->data;
+  PetscErrorCode ierr;
+  PetscSFNodeWin win,*p;
+  PetscBool      grow,anygrow;
+  size_t         bytes = node->units*link->unitbytes;
+
+  PetscFunctionBegin;
+  for (p=&node->wins; (win=*p); p=&win->next) if (!win->link) break;
+  if (!win) {
+    ierr = PetscNew(&win);CHKERRQ(ierr);
+    ierr = PetscMalloc2(node->nsize,&win->base,node->rootmsgs.n+node->leafmsgs.n,&win->requests);CHKERRQ(ierr);
+    win->win = MPI_WIN_NULL;
+    *p       = win;
+  }
+  /* Since all the processes of the node take part, this also ensures that they are done reading the previous data of the window */
+  grow = (PetscBool)(win->win == MPI_WIN_NULL || win->bytes < bytes);
+  ierr = MPIU_Allreduce(&grow,&anygrow,1,MPIU_BOOL,MPI_LOR,node->comm);CHKERRQ(ierr);
+  if (anygrow) {
+    MPI_Info    info;
+    MPI_Aint    sz;
+    PetscMPIInt i,dsp_unit;
+
+    if (win->win != MPI_WIN_NULL) {ierr = MPI_Win_free(&win->win);CHKERRQ(ierr);}
+    ierr = MPI_Info_create(&info);CHKERRQ(ierr);
+    ierr = MPI_Info_set(info,"alloc_shared_noncontig","true");CHKERRQ(ierr);
+    ierr = MPIU_Win_allocate_shared(bytes,sizeof(PetscScalar),info,node->comm,&win->base[node->nrank],&win->win);CHKERRQ(ierr);
+    ierr = MPI_Info_free(&info);CHKERRQ(ierr);
+    for (i=0; i<node->nsize; i++) {
+      if (i == node->nrank) continue;
+      ierr = MPIU_Win_shared_query(win->win,i,&sz,&dsp_unit,&win->base[i]);CHKERRQ(ierr);
+    }
+    win->bytes = bytes;
+  }
+  win->link = link;
+  *mywin    = win;
+  PetscFunctionReturn(0);
+}
+
+/* Gets the operation in progress started with these arguments and its window, and makes them available again */
+static PetscErrorCode PetscSFNodeGetWinInUse(PetscSF sf,MPI_Datatype unit,const void *key,PetscSFBasicPack *mylink,PetscSFNodeWin *mywin)
+{
+  PetscSF_Node   *node = (PetscSF_Node*)sf->data;
+  PetscErrorCode ierr;
+  PetscSFNodeWin win;
+
+  PetscFunctionBegin;
+  ierr = PetscSFBasicGetPackInUse(sf,unit,key,PETSC_OWN_POINTER,mylink);CHKERRQ(ierr);
+  for (win=node->wins; win; win=win->next) if (win->link == *mylink) break;
+  if (!win) SETERRQ(PetscObjectComm((PetscObject)sf),PETSC_ERR_PLIB,"Could not find window");
+  win->link = NULL;
+  *mywin    = win;
+  PetscFunctionReturn(0);
+}
+
+/* The leader gathers the pieces of the node in the messages to send, then starts the exchange with the other leaders */
+static PetscErrorCode PetscSFNodeStartMsgs(PetscSF sf,PetscSFNodeWin win,size_t unitbytes,const PetscSFNodeMsgs *send,const PetscSFNodeMsgs *recv)
+{
+  PetscSF_Node   *node = (PetscSF_Node*)sf->data;
+  PetscErrorCode ierr;
+  PetscInt       i,pos;
+  PetscMPIInt    count;
+  char           *mine = win->base[0];
+
+  PetscFunctionBegin;
+  for (i=0; i<recv->n; i++) {
+    ierr = PetscMPIIntCast((recv->offset[i+1]-recv->offset[i])*unitbytes,&count);CHKERRQ(ierr);
+    ierr = MPI_Irecv(mine+(recv->start+recv->offset[i])*unitbytes,count,MPI_BYTE,recv->leaders[i],node->tag,PetscObjectComm((PetscObject)sf),&win->requests[i]);CHKERRQ(ierr);
+  }
+  for (i=0,pos=send->start; i<send->npieces; pos+=send->count[i],i++) {
+    ierr = PetscMemcpy(mine+pos*unitbytes,win->base[send->local[i]]+send->poffset[i]*unitbytes,send->count[i]*unitbytes);CHKERRQ(ierr);
+  }
+  for (i=0; i<send->n; i++) {
+    ierr = PetscMPIIntCast((send->offset[i+1]-send->offset[i])*unitbytes,&count);CHKERRQ(ierr);
+    ierr = MPI_Isend(mine+(send->start+send->offset[i])*unitbytes,count,MPI_BYTE,send->leaders[i],node->tag,PetscObjectComm((PetscObject)sf),&win->requests[recv->n+i]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* Waits for the messages of the leader, then for the whole node so that the data in the window is complete */
+static PetscErrorCode PetscSFNodeFinishMsgs(PetscSF sf,PetscSFNodeWin win)
+{
+  PetscSF_Node   *node = (PetscSF_Node*)sf->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!node->nrank) {ierr = MPI_Waitall(node->rootmsgs.n+node->leafmsgs.n,win->requests,MPI_STATUSES_IGNORE);CHKERRQ(ierr);}
+  ierr = MPI_Barrier(node->comm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFBcastBegin_Node(PetscSF sf,MPI_Datatype unit,const void *rootdata,void *leafdata)
+{
+  PetscSF_Node     *node = (PetscSF_Node*)sf->data;
+  PetscErrorCode   ierr;
+  PetscSFBasicPack link;
+  PetscSFNodeWin   win;
+  PetscInt         i,nrootranks;
+  const PetscInt   *rootoffset,*rootloc;
+  char             *mine;
+
+  PetscFunctionBegin;
+  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,NULL,NULL,&rootoffset,&rootloc);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetPack(sf,unit,rootdata,&link);CHKERRQ(ierr);
+  ierr = PetscSFNodeGetWin(sf,link,&win);CHKERRQ(ierr);
+  mine = win->base[node->nrank];
+  for (i=0; i<nrootranks; i++) {
+    (*link->Pack)(rootoffset[i+1]-rootoffset[i],link->bs,rootloc+rootoffset[i],rootdata,mine+rootoffset[i]*link->unitbytes);
+  }
+  ierr = MPI_Barrier(node->comm);CHKERRQ(ierr);
+  if (!node->nrank) {ierr = PetscSFNodeStartMsgs(sf,win,link->unitbytes,&node->rootmsgs,&node->leafmsgs);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFBcastEnd_Node(PetscSF sf,MPI_Datatype unit,const void *rootdata,void *leafdata)
+{
+  PetscSF_Node     *node = (PetscSF_Node*)sf->data;
+  PetscErrorCode   ierr;
+  PetscSFBasicPack link;
+  PetscSFNodeWin   win;
+  PetscInt         i,nleafranks;
+  const PetscInt   *leafoffset,*leafloc;
+
+  PetscFunctionBegin;
+  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,NULL,NULL,&leafoffset,&leafloc);CHKERRQ(ierr);
+  ierr = PetscSFNodeGetWinInUse(sf,unit,rootdata,&link,&win);CHKERRQ(ierr);
+  ierr = PetscSFNodeFinishMsgs(sf,win);CHKERRQ(ierr);
+  for (i=0; i<nleafranks; i++) {
+    const char *packstart = win->base[node->leaflocal[i] >= 0 ? node->leaflocal[i] : 0] + node->leafremote[i]*link->unitbytes;
+    (*link->UnpackInsert)(leafoffset[i+1]-leafoffset[i],link->bs,leafloc+leafoffset[i],leafdata,packstart);
+  }
+  ierr = PetscSFBasicReclaimPack(sf,&link);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFReduceBegin_Node(PetscSF sf,MPI_Datatype unit,const void *leafdata,void *rootdata,MPI_Op op)
+{
+  PetscSF_Node     *node = (PetscSF_Node*)sf->data;
+  PetscErrorCode   ierr;
+  PetscSFBasicPack link;
+  PetscSFNodeWin   win;
+  PetscInt         i,nrootranks,nleafranks;
+  const PetscInt   *rootoffset,*leafoffset,*leafloc;
+  char             *mine;
+
+  PetscFunctionBegin;
+  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,NULL,NULL,&rootoffset,NULL);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetLeafInfo(sf,&nleafranks,NULL,NULL,&leafoffset,&leafloc);CHKERRQ(ierr);
+  ierr = PetscSFBasicGetPack(sf,unit,rootdata,&link);CHKERRQ(ierr);
+  ierr = PetscSFNodeGetWin(sf,link,&win);CHKERRQ(ierr);
+  mine = win->base[node->nrank] + rootoffset[nrootranks]*link->unitbytes;
+  for (i=0; i<nleafranks; i++) {
+    (*link->Pack)(leafoffset[i+1]-leafoffset[i],link->bs,leafloc+leafoffset[i],leafdata,mine+leafoffset[i]*link->unitbytes);
+  }
+  ierr = MPI_Barrier(node->comm);CHKERRQ(ierr);
+  if (!node->nrank) {ierr = PetscSFNodeStartMsgs(sf,win,link->unitbytes,&node->leafmsgs,&node->rootmsgs);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PetscSFReduceEnd_Node(PetscSF sf,MPI_Datatype unit,const void *leafdata,void *rootdata,MPI_Op op)
+{
+  PetscSF_Node     *node = (PetscSF_Node*)sf->data;
+  void             (*UnpackOp)(PetscInt,PetscInt,const PetscInt*,void*,const void*);
+  PetscErrorCode   ierr;
+  PetscSFBasicPack link;
+  PetscSFNodeWin   win;
+  PetscInt         i,nrootranks;
+  const PetscInt   *rootoffset,*rootloc;
+
+  PetscFunctionBegin;
+  ierr = PetscSFBasicGetRootInfo(sf,&nrootranks,NULL,NULL,&rootoffset,&rootloc);CHKERRQ(ierr);
+  ierr = PetscSFNodeGetWinInUse(sf,unit,rootdata,&link,&win);CHKERRQ(ierr);
+  ierr = PetscSFNodeFinishMsgs(sf,win);CHKERRQ(ierr);
+  ierr = PetscSFBasicPackGetUnpackOp(sf,link,op,&UnpackOp);CHKERRQ(ierr);
+  for (i=0; i<nrootranks; i++) {
+    PetscInt   n          = rootoffset[i+1] - rootoffset[i];
+    const char *packstart = win->base[node->rootlocal[i] >= 0 ? node->rootlocal[i] : 0] + node->rootremote[i]*link->unitbytes;
+
+    if (UnpackOp) {
+      (*UnpackOp)(n,link->bs,rootloc+rootoffset[i],rootdata,packstart);
+    }
+#if PETSC_HAVE_MPI_REDUCE_LOCAL
+    else if (n) { /* the op should be defined to operate on the whole datatype, so we ignore link->bs */
+      PetscInt j;
+
+      for (j=0; j<n; j++) {
+        ierr = MPI_Reduce_local((void*)(packstart+j*link->unitbytes),(char*)rootdata+rootloc[rootoffset[i]+j]*link->unitbytes,1,unit,op);CHKERRQ(ierr);
+      }
+    }
+#else
+    else SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"No unpacking reduction operation for this MPI_Op");
+#endif
+  }
+  ierr = PetscSFBasicReclaimPack(sf,&link);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PETSC_EXTERN PetscErrorCode PetscSFCreate_Node(PetscSF sf)
+{
+  PetscSF_Node   *node;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  sf->ops->SetUp            = PetscSFSetUp_Node;
+  sf->ops->SetFromOptions   = PetscSFSetFromOptions_Node;
+  sf->ops->Reset            = PetscSFReset_Node;
+  sf->ops->Destroy          = PetscSFDestroy_Node;
+  sf->ops->View             = PetscSFView_Node;
+  sf->ops->BcastBegin       = PetscSFBcastBegin_Node;
+  sf->ops->BcastEnd         = PetscSFBcastEnd_Node;
+  sf->ops->ReduceBegin      = PetscSFReduceBegin_Node;
+  sf->ops->ReduceEnd        = PetscSFReduceEnd_Node;
+  sf->ops->FetchAndOpBegin  = PetscSFFetchAndOpBegin_Basic;
+  sf->ops->FetchAndOpEnd    = PetscSFFetchAndOpEnd_Basic;
+  sf->ops->BcastMultiBegin  = PetscSFBcastMultiBegin_Basic;
+  sf->ops->BcastMultiEnd    = PetscSFBcastMultiEnd_Basic;
+  sf->ops->ReduceMultiBegin = PetscSFReduceMultiBegin_Basic;
+  sf->ops->ReduceMultiEnd   = PetscSFReduceMultiEnd_Basic;
+
+  ierr = PetscNewLog(sf,&node);CHKERRQ(ierr);
+  node->comm = MPI_COMM_NULL;
+  sf->data   = (void*)node;
+  PetscFunctionReturn(0);
+}
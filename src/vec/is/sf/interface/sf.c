@@ -1035,6 +1035,11 @@ PetscErrorCode PetscSFCreateEmbeddedLeafSF(PetscSF sf, PetscInt nleaves, const P
    Output Arguments:
 .  leafdata - buffer to update with values from each leaf's respective root
 
+   Notes:
+   When rootdata and leafdata are different arrays, messages may be sent directly from rootdata and received directly
+   into leafdata. Hence rootdata must not be changed, and leafdata must not be read or changed, until PetscSFBcastEnd()
+   has been called.
+
    Level: intermediate
 
 .seealso: PetscSFCreate(), PetscSFSetGraph(), PetscSFView(), PetscSFBcastEnd(), PetscSFReduceBegin()
@@ -1096,6 +1101,10 @@ PetscErrorCode PetscSFBcastEnd(PetscSF sf,MPI_Datatype unit,const void *rootdata
    Output Arguments:
 .  rootdata - result of reduction of values from all leaves of each root
 
+   Notes:
+   When rootdata and leafdata are different arrays, messages may be sent directly from leafdata. Hence leafdata must
+   not be changed, and rootdata must not be read or changed, until PetscSFReduceEnd() has been called.
+
    Level: intermediate
 
 .seealso: PetscSFBcastBegin()
@@ -1144,6 +1153,174 @@ PetscErrorCode PetscSFReduceEnd(PetscSF sf,MPI_Datatype unit,const void *leafdat
   PetscFunctionReturn(0);
 }
 
+/*@C
+   PetscSFBcastMultiBegin - begin the broadcast of several fields at once, to be concluded with a call to PetscSFBcastMultiEnd()
+
+   Collective on PetscSF
+
+   Input Arguments:
++  sf - star forest on which to communicate
+.  nfields - number of fields
+.  unit - data type associated with each node, for each field
+-  rootdata - buffer to broadcast, for each field
+
+   Output Arguments:
+.  leafdata - buffer to update with values from each leaf's respective root, for each field
+
+   Notes:
+   This is the same as calling PetscSFBcastBegin() for each field, but the data of all the fields going to a
+   process is sent in a single message, so a code with several fields on the same star forest pays the message
+   latency once. The arrays of data types and buffers are read again by PetscSFBcastMultiEnd(), which must be
+   given the same arguments.
+
+   Level: intermediate
+
+.seealso: PetscSFBcastMultiEnd(), PetscSFBcastBegin(), PetscSFReduceMultiBegin()
+@*/
+PetscErrorCode PetscSFBcastMultiBegin(PetscSF sf,PetscInt nfields,const MPI_Datatype unit[],const void *rootdata[],void *leafdata[])
+{
+  PetscErrorCode ierr;
+  PetscInt       f;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf,PETSCSF_CLASSID,1);
+  if (nfields < 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Number of fields %D cannot be negative",nfields);
+  if (nfields) {
+    PetscValidPointer(unit,3);
+    PetscValidPointer(rootdata,4);
+    PetscValidPointer(leafdata,5);
+  }
+  ierr = PetscSFSetUp(sf);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(PETSCSF_BcastBegin,sf,0,0,0);CHKERRQ(ierr);
+  if (sf->ops->BcastMultiBegin) {
+    ierr = (*sf->ops->BcastMultiBegin)(sf,nfields,unit,rootdata,leafdata);CHKERRQ(ierr);
+  } else {
+    for (f=0; f<nfields; f++) {ierr = (*sf->ops->BcastBegin)(sf,unit[f],rootdata[f],leafdata[f]);CHKERRQ(ierr);}
+  }
+  ierr = PetscLogEventEnd(PETSCSF_BcastBegin,sf,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscSFBcastMultiEnd - end a broadcast of several fields started with PetscSFBcastMultiBegin()
+
+   Collective on PetscSF
+
+   Input Arguments:
++  sf - star forest
+.  nfields - number of fields
+.  unit - data type of each field
+-  rootdata - buffer to broadcast, for each field
+
+   Output Arguments:
+.  leafdata - buffer to update with values from each leaf's respective root, for each field
+
+   Level: intermediate
+
+.seealso: PetscSFBcastMultiBegin(), PetscSFBcastEnd()
+@*/
+PetscErrorCode PetscSFBcastMultiEnd(PetscSF sf,PetscInt nfields,const MPI_Datatype unit[],const void *rootdata[],void *leafdata[])
+{
+  PetscErrorCode ierr;
+  PetscInt       f;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf,PETSCSF_CLASSID,1);
+  ierr = PetscSFSetUp(sf);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(PETSCSF_BcastEnd,sf,0,0,0);CHKERRQ(ierr);
+  if (sf->ops->BcastMultiEnd) {
+    ierr = (*sf->ops->BcastMultiEnd)(sf,nfields,unit,rootdata,leafdata);CHKERRQ(ierr);
+  } else {
+    for (f=0; f<nfields; f++) {ierr = (*sf->ops->BcastEnd)(sf,unit[f],rootdata[f],leafdata[f]);CHKERRQ(ierr);}
+  }
+  ierr = PetscLogEventEnd(PETSCSF_BcastEnd,sf,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscSFReduceMultiBegin - begin the reduction of several fields at once, to be completed with a call to PetscSFReduceMultiEnd()
+
+   Collective on PetscSF
+
+   Input Arguments:
++  sf - star forest
+.  nfields - number of fields
+.  unit - data type of each field
+.  leafdata - values to reduce, for each field
+-  op - reduction operation, the same for all the fields
+
+   Output Arguments:
+.  rootdata - result of reduction of values from all leaves of each root, for each field
+
+   Notes:
+   This is the same as calling PetscSFReduceBegin() for each field, but the data of all the fields going to a
+   process is sent in a single message. PetscSFReduceMultiEnd() must be given the same arguments.
+
+   Level: intermediate
+
+.seealso: PetscSFReduceMultiEnd(), PetscSFReduceBegin(), PetscSFBcastMultiBegin()
+@*/
+PetscErrorCode PetscSFReduceMultiBegin(PetscSF sf,PetscInt nfields,const MPI_Datatype unit[],const void *leafdata[],void *rootdata[],MPI_Op op)
+{
+  PetscErrorCode ierr;
+  PetscInt       f;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf,PETSCSF_CLASSID,1);
+  if (nfields < 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Number of fields %D cannot be negative",nfields);
+  if (nfields) {
+    PetscValidPointer(unit,3);
+    PetscValidPointer(leafdata,4);
+    PetscValidPointer(rootdata,5);
+  }
+  ierr = PetscSFSetUp(sf);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(PETSCSF_ReduceBegin,sf,0,0,0);CHKERRQ(ierr);
+  if (sf->ops->ReduceMultiBegin) {
+    ierr = (*sf->ops->ReduceMultiBegin)(sf,nfields,unit,leafdata,rootdata,op);CHKERRQ(ierr);
+  } else {
+    for (f=0; f<nfields; f++) {ierr = (*sf->ops->ReduceBegin)(sf,unit[f],leafdata[f],rootdata[f],op);CHKERRQ(ierr);}
+  }
+  ierr = PetscLogEventEnd(PETSCSF_ReduceBegin,sf,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   PetscSFReduceMultiEnd - end a reduction of several fields started with PetscSFReduceMultiBegin()
+
+   Collective on PetscSF
+
+   Input Arguments:
++  sf - star forest
+.  nfields - number of fields
+.  unit - data type of each field
+.  leafdata - values to reduce, for each field
+-  op - reduction operation
+
+   Output Arguments:
+.  rootdata - result of reduction of values from all leaves of each root, for each field
+
+   Level: intermediate
+
+.seealso: PetscSFReduceMultiBegin(), PetscSFReduceEnd()
+@*/
+PetscErrorCode PetscSFReduceMultiEnd(PetscSF sf,PetscInt nfields,const MPI_Datatype unit[],const void *leafdata[],void *rootdata[],MPI_Op op)
+{
+  PetscErrorCode ierr;
+  PetscInt       f;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf,PETSCSF_CLASSID,1);
+  ierr = PetscSFSetUp(sf);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(PETSCSF_ReduceEnd,sf,0,0,0);CHKERRQ(ierr);
+  if (sf->ops->ReduceMultiEnd) {
+    ierr = (*sf->ops->ReduceMultiEnd)(sf,nfields,unit,leafdata,rootdata,op);CHKERRQ(ierr);
+  } else {
+    for (f=0; f<nfields; f++) {ierr = (*sf->ops->ReduceEnd)(sf,unit[f],leafdata[f],rootdata[f],op);CHKERRQ(ierr);}
+  }
+  ierr = PetscLogEventEnd(PETSCSF_ReduceEnd,sf,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@C
    PetscSFComputeDegreeBegin - begin computation of degree for each root vertex, to be completed with PetscSFComputeDegreeEnd()
 
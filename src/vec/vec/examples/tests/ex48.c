@@ -0,0 +1,75 @@
+static char help[] = "Tests VecMDot() and VecMAXPY() against VecDot() and VecAXPY() for all numbers of vectors up to -nv.\n\n";
+
+#include <petscvec.h>
+
+int main(int argc,char **argv)
+{
+  Vec            x,w,*y;
+  PetscInt       n = 10001,nvmax = 19,nv,j;
+  PetscScalar    *dots,*alpha,dot;
+  PetscReal      norm,wnorm,err,maxerr = 0.0;
+  PetscRandom    rand;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nv",&nvmax,NULL);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = VecCreate(PETSC_COMM_WORLD,&x);CHKERRQ(ierr);
+  ierr = VecSetSizes(x,n,PETSC_DECIDE);CHKERRQ(ierr);
+  ierr = VecSetFromOptions(x);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&w);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(x,nvmax,&y);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nvmax,&dots,nvmax,&alpha);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+  for (j=0; j<nvmax; j++) {
+    ierr     = VecSetRandom(y[j],rand);CHKERRQ(ierr);
+    alpha[j] = 1.0/(j+2) - 0.3;
+  }
+
+  for (nv=1; nv<=nvmax; nv++) {
+    ierr = VecMDot(x,nv,y,dots);CHKERRQ(ierr);
+    for (j=0; j<nv; j++) {
+      ierr = VecDot(x,y[j],&dot);CHKERRQ(ierr);
+      err  = PetscAbsScalar(dots[j]-dot)/PetscAbsScalar(dot);
+      if (err > 100*PETSC_MACHINE_EPSILON) SETERRQ4(PETSC_COMM_WORLD,PETSC_ERR_PLIB,"VecMDot() with %D vectors: entry %D has relative error %g, VecDot() gives %g",nv,j,(double)err,(double)PetscRealPart(dot));
+      maxerr = PetscMax(maxerr,err);
+    }
+
+    ierr = VecCopy(x,w);CHKERRQ(ierr);
+    ierr = VecMAXPY(w,nv,alpha,y);CHKERRQ(ierr);
+    for (j=0; j<nv; j++) {ierr = VecAXPY(w,-alpha[j],y[j]);CHKERRQ(ierr);}
+    ierr = VecAXPY(w,-1.0,x);CHKERRQ(ierr);
+    ierr = VecNorm(w,NORM_INFINITY,&wnorm);CHKERRQ(ierr);
+    ierr = VecNorm(x,NORM_INFINITY,&norm);CHKERRQ(ierr);
+    if (wnorm > 100*nv*PETSC_MACHINE_EPSILON*norm) SETERRQ2(PETSC_COMM_WORLD,PETSC_ERR_PLIB,"VecMAXPY() with %D vectors differs from VecAXPY() by %g",nv,(double)wnorm);
+  }
+  ierr = PetscInfo1(NULL,"Largest relative error of VecMDot() %g\n",(double)maxerr);CHKERRQ(ierr);
+
+  ierr = PetscFree2(dots,alpha);CHKERRQ(ierr);
+  ierr = VecDestroyVecs(nvmax,&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&w);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      output_file: output/ex48_1.out
+
+   test:
+      suffix: 2
+      nsize: 2
+      args: -n 37 -nv 9
+      output_file: output/ex48_1.out
+
+   test:
+      suffix: threads
+      args: -thread_pool_size 3 -vec_threads_min_size 1000
+      output_file: output/ex48_1.out
+
+TEST*/
@@ -0,0 +1,107 @@
+static char help[] = "Tests VecProgram against the separate vector operations.\n\n";
+
+#include <petscvec.h>
+
+int main(int argc,char **argv)
+{
+  Vec            v[6],c[6],x;
+  PetscInt       n = 10001,i;
+  PetscScalar    alpha = 0.7,beta = -1.3,gamma = 0.4,dot,tdot,cdot,ctdot;
+  PetscReal      norms[2],ninf,xnorm,cnorms[2],cninf,cxnorm,err,vnorm;
+  VecProgram     prog;
+  PetscRandom    rand;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = VecCreate(PETSC_COMM_WORLD,&x);CHKERRQ(ierr);
+  ierr = VecSetSizes(x,n,PETSC_DECIDE);CHKERRQ(ierr);
+  ierr = VecSetFromOptions(x);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+  for (i=0; i<6; i++) {
+    ierr = VecDuplicate(x,&v[i]);CHKERRQ(ierr);
+    ierr = VecDuplicate(x,&c[i]);CHKERRQ(ierr);
+    ierr = VecSetRandom(v[i],rand);CHKERRQ(ierr);
+    ierr = VecCopy(v[i],c[i]);CHKERRQ(ierr);
+  }
+
+  /* the updates read vectors written by the previous ones, and a split phase reduction is started before the program */
+  ierr = VecProgramCreate(&prog);CHKERRQ(ierr);
+  ierr = VecProgramAXPY(prog,v[0],alpha,v[1]);CHKERRQ(ierr);
+  ierr = VecProgramAYPX(prog,v[1],beta,v[0]);CHKERRQ(ierr);
+  ierr = VecProgramAXPBY(prog,v[2],alpha,beta,v[1]);CHKERRQ(ierr);
+  ierr = VecProgramAXPBYPCZ(prog,v[3],alpha,beta,gamma,v[0],v[2]);CHKERRQ(ierr);
+  ierr = VecProgramWAXPY(prog,v[4],gamma,v[3],v[5]);CHKERRQ(ierr);
+  ierr = VecProgramDot(prog,v[4],v[0],&dot);CHKERRQ(ierr);
+  ierr = VecProgramTDot(prog,v[2],v[3],&tdot);CHKERRQ(ierr);
+  ierr = VecProgramNorm(prog,v[4],NORM_1_AND_2,norms);CHKERRQ(ierr);
+  ierr = VecProgramNorm(prog,v[1],NORM_INFINITY,&ninf);CHKERRQ(ierr);
+  ierr = VecNormBegin(x,NORM_2,&xnorm);CHKERRQ(ierr);
+  ierr = VecProgramBegin(prog);CHKERRQ(ierr);
+  ierr = PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)x));CHKERRQ(ierr);
+  ierr = VecNormEnd(x,NORM_2,&xnorm);CHKERRQ(ierr);
+  ierr = VecProgramEnd(prog);CHKERRQ(ierr);
+
+  ierr = VecAXPY(c[0],alpha,c[1]);CHKERRQ(ierr);
+  ierr = VecAYPX(c[1],beta,c[0]);CHKERRQ(ierr);
+  ierr = VecAXPBY(c[2],alpha,beta,c[1]);CHKERRQ(ierr);
+  ierr = VecAXPBYPCZ(c[3],alpha,beta,gamma,c[0],c[2]);CHKERRQ(ierr);
+  ierr = VecWAXPY(c[4],gamma,c[3],c[5]);CHKERRQ(ierr);
+  ierr = VecDot(c[4],c[0],&cdot);CHKERRQ(ierr);
+  ierr = VecTDot(c[2],c[3],&ctdot);CHKERRQ(ierr);
+  ierr = VecNorm(c[4],NORM_1_AND_2,cnorms);CHKERRQ(ierr);
+  ierr = VecNorm(c[1],NORM_INFINITY,&cninf);CHKERRQ(ierr);
+  ierr = VecNorm(x,NORM_2,&cxnorm);CHKERRQ(ierr);
+
+  for (i=0; i<6; i++) {
+    ierr = VecAXPY(c[i],-1.0,v[i]);CHKERRQ(ierr);
+    ierr = VecNorm(c[i],NORM_INFINITY,&err);CHKERRQ(ierr);
+    ierr = VecNorm(v[i],NORM_INFINITY,&vnorm);CHKERRQ(ierr);
+    if (err > 100*PETSC_MACHINE_EPSILON*vnorm) SETERRQ2(PETSC_COMM_WORLD,PETSC_ERR_PLIB,"Vector %D differs from the separate operations by %g",i,(double)err);
+  }
+  if (PetscAbsScalar(dot-cdot) > 1000*PETSC_MACHINE_EPSILON*PetscAbsScalar(cdot)) SETERRQ2(PETSC_COMM_WORLD,PETSC_ERR_PLIB,"Dot %g instead of %g",(double)PetscRealPart(dot),(double)PetscRealPart(cdot));
+  if (PetscAbsScalar(tdot-ctdot) > 1000*PETSC_MACHINE_EPSILON*PetscAbsScalar(ctdot)) SETERRQ2(PETSC_COMM_WORLD,PETSC_ERR_PLIB,"TDot %g instead of %g",(double)PetscRealPart(tdot),(double)PetscRealPart(ctdot));
+  for (i=0; i<2; i++) {
+    if (PetscAbsReal(norms[i]-cnorms[i]) > 1000*PETSC_MACHINE_EPSILON*cnorms[i]) SETERRQ3(PETSC_COMM_WORLD,PETSC_ERR_PLIB,"Norm %D is %g instead of %g",i,(double)norms[i],(double)cnorms[i]);
+  }
+  if (ninf != cninf) SETERRQ2(PETSC_COMM_WORLD,PETSC_ERR_PLIB,"Infinity norm %g instead of %g",(double)ninf,(double)cninf);
+  if (PetscAbsReal(xnorm-cxnorm) > 1000*PETSC_MACHINE_EPSILON*cxnorm) SETERRQ2(PETSC_COMM_WORLD,PETSC_ERR_PLIB,"Norm of x %g instead of %g",(double)xnorm,(double)cxnorm);
+
+  /* an empty program, then the program is reused */
+  ierr = VecProgramBegin(prog);CHKERRQ(ierr);
+  ierr = VecProgramEnd(prog);CHKERRQ(ierr);
+  ierr = VecProgramNorm(prog,x,NORM_2,&xnorm);CHKERRQ(ierr);
+  ierr = VecProgramBegin(prog);CHKERRQ(ierr);
+  ierr = VecProgramEnd(prog);CHKERRQ(ierr);
+  if (PetscAbsReal(xnorm-cxnorm) > 1000*PETSC_MACHINE_EPSILON*cxnorm) SETERRQ2(PETSC_COMM_WORLD,PETSC_ERR_PLIB,"Norm of x %g instead of %g",(double)xnorm,(double)cxnorm);
+
+  ierr = VecProgramDestroy(&prog);CHKERRQ(ierr);
+  for (i=0; i<6; i++) {
+    ierr = VecDestroy(&v[i]);CHKERRQ(ierr);
+    ierr = VecDestroy(&c[i]);CHKERRQ(ierr);
+  }
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      output_file: output/ex49_1.out
+
+   test:
+      suffix: 2
+      nsize: 2
+      args: -n 37
+      output_file: output/ex49_1.out
+
+   test:
+      suffix: threads
+      args: -thread_pool_size 3 -vec_threads_min_size 1000
+      output_file: output/ex49_1.out
+
+TEST*/
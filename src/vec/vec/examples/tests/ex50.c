@@ -0,0 +1,167 @@
+static char help[] = "Tests the vectors stored in single precision against the standard vectors.\n\n";
+
+#include <petscvec.h>
+
+/* relative difference between a single precision vector and a standard one */
+static PetscErrorCode CheckVec(const char *name,Vec s,Vec d)
+{
+  Vec            t;
+  PetscReal      err,nrm;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecDuplicate(d,&t);CHKERRQ(ierr);
+  ierr = VecCopy(s,t);CHKERRQ(ierr);
+  ierr = VecAXPY(t,-1.0,d);CHKERRQ(ierr);
+  ierr = VecNorm(t,NORM_INFINITY,&err);CHKERRQ(ierr);
+  ierr = VecNorm(d,NORM_INFINITY,&nrm);CHKERRQ(ierr);
+  if (err > 1.e-5*PetscMax(nrm,1.0)) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"%s differs by %g\n",name,(double)err);CHKERRQ(ierr);
+  }
+  ierr = VecDestroy(&t);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode CheckScalar(const char *name,PetscScalar s,PetscScalar d)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (PetscAbsScalar(s-d) > 1.e-5*PetscMax(PetscAbsScalar(d),1.0)) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"%s differs: %g %g\n",name,(double)PetscRealPart(s),(double)PetscRealPart(d));CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  Vec            d[6],s[6];
+  PetscInt       n = 1001,i,rstart,N;
+  PetscScalar    alpha[5] = {0.7,-1.3,0.4,2.1,-0.6},ds,dd,ms[5],md[5],*a,v;
+  PetscReal      ns[2],nd[2];
+  NormType       types[4] = {NORM_1,NORM_2,NORM_INFINITY,NORM_1_AND_2};
+  PetscRandom    rand;
+  char           name[32];
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = VecCreate(PETSC_COMM_WORLD,&d[0]);CHKERRQ(ierr);
+  ierr = VecSetSizes(d[0],n,PETSC_DECIDE);CHKERRQ(ierr);
+  ierr = VecSetFromOptions(d[0]);CHKERRQ(ierr);
+  ierr = VecCreate(PETSC_COMM_WORLD,&s[0]);CHKERRQ(ierr);
+  ierr = VecSetSizes(s[0],n,PETSC_DECIDE);CHKERRQ(ierr);
+  ierr = VecSetType(s[0],VECSINGLE);CHKERRQ(ierr);
+  for (i=1; i<6; i++) {
+    ierr = VecDuplicate(d[0],&d[i]);CHKERRQ(ierr);
+    ierr = VecDuplicate(s[0],&s[i]);CHKERRQ(ierr);
+  }
+  /* the standard vectors get the values rounded to single precision */
+  for (i=0; i<6; i++) {
+    ierr = VecSetRandom(d[i],rand);CHKERRQ(ierr);
+    ierr = VecCopy(d[i],s[i]);CHKERRQ(ierr);
+    ierr = VecCopy(s[i],d[i]);CHKERRQ(ierr);
+  }
+
+  /* reductions */
+  ierr = VecDot(s[0],s[1],&ds);CHKERRQ(ierr);
+  ierr = VecDot(d[0],d[1],&dd);CHKERRQ(ierr);
+  ierr = CheckScalar("VecDot",ds,dd);CHKERRQ(ierr);
+  ierr = VecTDot(s[0],s[2],&ds);CHKERRQ(ierr);
+  ierr = VecTDot(d[0],d[2],&dd);CHKERRQ(ierr);
+  ierr = CheckScalar("VecTDot",ds,dd);CHKERRQ(ierr);
+  ierr = VecDot(s[0],d[1],&ds);CHKERRQ(ierr);
+  ierr = VecDot(d[0],d[1],&dd);CHKERRQ(ierr);
+  ierr = CheckScalar("VecDot mixed",ds,dd);CHKERRQ(ierr);
+  ierr = VecMDot(s[0],5,s+1,ms);CHKERRQ(ierr);
+  ierr = VecMDot(d[0],5,d+1,md);CHKERRQ(ierr);
+  for (i=0; i<5; i++) {ierr = CheckScalar("VecMDot",ms[i],md[i]);CHKERRQ(ierr);}
+  for (i=0; i<4; i++) {
+    ierr = VecNorm(s[3],types[i],ns);CHKERRQ(ierr);
+    ierr = VecNorm(d[3],types[i],nd);CHKERRQ(ierr);
+    ierr = PetscSNPrintf(name,sizeof(name),"VecNorm %s",NormTypes[types[i]]);CHKERRQ(ierr);
+    ierr = CheckScalar(name,ns[0],nd[0]);CHKERRQ(ierr);
+    if (types[i] == NORM_1_AND_2) {ierr = CheckScalar(name,ns[1],nd[1]);CHKERRQ(ierr);}
+  }
+
+  /* updates */
+  ierr = VecAXPY(s[0],alpha[0],s[1]);CHKERRQ(ierr);
+  ierr = VecAXPY(d[0],alpha[0],d[1]);CHKERRQ(ierr);
+  ierr = CheckVec("VecAXPY",s[0],d[0]);CHKERRQ(ierr);
+  ierr = VecAYPX(s[1],alpha[1],s[2]);CHKERRQ(ierr);
+  ierr = VecAYPX(d[1],alpha[1],d[2]);CHKERRQ(ierr);
+  ierr = CheckVec("VecAYPX",s[1],d[1]);CHKERRQ(ierr);
+  ierr = VecAXPBY(s[2],alpha[2],alpha[3],s[0]);CHKERRQ(ierr);
+  ierr = VecAXPBY(d[2],alpha[2],alpha[3],d[0]);CHKERRQ(ierr);
+  ierr = CheckVec("VecAXPBY",s[2],d[2]);CHKERRQ(ierr);
+  ierr = VecWAXPY(s[3],alpha[4],s[1],s[2]);CHKERRQ(ierr);
+  ierr = VecWAXPY(d[3],alpha[4],d[1],d[2]);CHKERRQ(ierr);
+  ierr = CheckVec("VecWAXPY",s[3],d[3]);CHKERRQ(ierr);
+  ierr = VecMAXPY(s[5],5,alpha,s);CHKERRQ(ierr);
+  ierr = VecMAXPY(d[5],5,alpha,d);CHKERRQ(ierr);
+  ierr = CheckVec("VecMAXPY",s[5],d[5]);CHKERRQ(ierr);
+  ierr = VecScale(s[4],alpha[3]);CHKERRQ(ierr);
+  ierr = VecScale(d[4],alpha[3]);CHKERRQ(ierr);
+  ierr = CheckVec("VecScale",s[4],d[4]);CHKERRQ(ierr);
+  /* operations without single precision kernels, and updates mixing both types, go through the arrays */
+  ierr = VecAXPBYPCZ(s[4],alpha[0],alpha[1],alpha[2],s[0],s[1]);CHKERRQ(ierr);
+  ierr = VecAXPBYPCZ(d[4],alpha[0],alpha[1],alpha[2],d[0],d[1]);CHKERRQ(ierr);
+  ierr = CheckVec("VecAXPBYPCZ",s[4],d[4]);CHKERRQ(ierr);
+  ierr = VecAXPY(s[3],alpha[1],d[2]);CHKERRQ(ierr);
+  ierr = VecAXPY(d[3],alpha[1],d[2]);CHKERRQ(ierr);
+  ierr = CheckVec("VecAXPY mixed",s[3],d[3]);CHKERRQ(ierr);
+  ierr = VecPointwiseMult(s[2],s[3],s[4]);CHKERRQ(ierr);
+  ierr = VecPointwiseMult(d[2],d[3],d[4]);CHKERRQ(ierr);
+  ierr = CheckVec("VecPointwiseMult",s[2],d[2]);CHKERRQ(ierr);
+
+  /* the array and the values set with VecSetValues() are converted back */
+  ierr = VecGetArray(s[1],&a);CHKERRQ(ierr);
+  a[0] = 3.0;
+  ierr = VecRestoreArray(s[1],&a);CHKERRQ(ierr);
+  ierr = VecGetArray(d[1],&a);CHKERRQ(ierr);
+  a[0] = 3.0;
+  ierr = VecRestoreArray(d[1],&a);CHKERRQ(ierr);
+  ierr = VecGetOwnershipRange(s[1],&rstart,NULL);CHKERRQ(ierr);
+  ierr = VecGetSize(s[1],&N);CHKERRQ(ierr);
+  v    = -2.5;
+  i    = (rstart+n) % N;
+  ierr = VecSetValues(s[1],1,&i,&v,INSERT_VALUES);CHKERRQ(ierr);
+  ierr = VecSetValues(d[1],1,&i,&v,INSERT_VALUES);CHKERRQ(ierr);
+  ierr = VecAssemblyBegin(s[1]);CHKERRQ(ierr);
+  ierr = VecAssemblyEnd(s[1]);CHKERRQ(ierr);
+  ierr = VecAssemblyBegin(d[1]);CHKERRQ(ierr);
+  ierr = VecAssemblyEnd(d[1]);CHKERRQ(ierr);
+  ierr = CheckVec("VecSetValues",s[1],d[1]);CHKERRQ(ierr);
+  ierr = VecNorm(s[1],NORM_INFINITY,ns);CHKERRQ(ierr);
+  ierr = VecNorm(d[1],NORM_INFINITY,nd);CHKERRQ(ierr);
+  ierr = CheckScalar("VecNorm after VecGetArray",ns[0],nd[0]);CHKERRQ(ierr);
+  ierr = VecSet(s[1],alpha[2]);CHKERRQ(ierr);
+  ierr = VecSet(d[1],alpha[2]);CHKERRQ(ierr);
+  ierr = CheckVec("VecSet",s[1],d[1]);CHKERRQ(ierr);
+
+  for (i=0; i<6; i++) {
+    ierr = VecDestroy(&d[i]);CHKERRQ(ierr);
+    ierr = VecDestroy(&s[i]);CHKERRQ(ierr);
+  }
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   build:
+      requires: !complex
+
+   test:
+      output_file: output/ex50_1.out
+
+   test:
+      suffix: 2
+      nsize: 3
+      args: -n 37
+      output_file: output/ex50_1.out
+
+TEST*/
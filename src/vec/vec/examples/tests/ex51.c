@@ -0,0 +1,125 @@
+static char help[] = "Tests deferring the blocking vector reductions with PetscCommDeferReductionsBegin().\n\n";
+
+#include <petscvec.h>
+
+static PetscErrorCode CheckScalar(const char *name,PetscScalar s,PetscScalar d)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (PetscAbsScalar(s-d) > 1.e-12*PetscMax(PetscAbsScalar(d),1.0)) {
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"%s differs: %g %g\n",name,(double)PetscRealPart(s),(double)PetscRealPart(d));CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  Vec            x,y[3];
+  PetscInt       n = 20,i;
+  PetscScalar    dot,tdot,mdot[3],ddot,dtdot,dmdot[3],sdot,dsdot,pdot;
+  PetscReal      nrm[4],nrm12[2],dnrm[4],dnrm12[2],nrmz;
+  NormType       types[3] = {NORM_1,NORM_2,NORM_INFINITY};
+  PetscRandom    rand;
+  VecProgram     prog;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&argv,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rand);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rand);CHKERRQ(ierr);
+  ierr = VecCreate(PETSC_COMM_WORLD,&x);CHKERRQ(ierr);
+  ierr = VecSetSizes(x,n,PETSC_DECIDE);CHKERRQ(ierr);
+  ierr = VecSetFromOptions(x);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rand);CHKERRQ(ierr);
+  for (i=0; i<3; i++) {
+    ierr = VecDuplicate(x,&y[i]);CHKERRQ(ierr);
+    ierr = VecSetRandom(y[i],rand);CHKERRQ(ierr);
+  }
+
+  /* the reductions done one at a time */
+  ierr = VecDot(x,y[0],&dot);CHKERRQ(ierr);
+  ierr = VecTDot(x,y[1],&tdot);CHKERRQ(ierr);
+  ierr = VecMDot(x,3,y,mdot);CHKERRQ(ierr);
+  for (i=0; i<3; i++) {ierr = VecNorm(y[i],types[i],&nrm[i]);CHKERRQ(ierr);}
+  ierr = VecNorm(x,NORM_1_AND_2,nrm12);CHKERRQ(ierr);
+  ierr = VecDot(y[1],y[2],&sdot);CHKERRQ(ierr);
+
+  /* the same reductions queued and done together; y is doubled through its array, which VecScale() would not do,
+     so that the cached norms are dropped and the norms are computed again */
+  for (i=0; i<3; i++) {
+    PetscScalar *a;
+    PetscInt    j,m;
+
+    ierr = VecGetLocalSize(y[i],&m);CHKERRQ(ierr);
+    ierr = VecGetArray(y[i],&a);CHKERRQ(ierr);
+    for (j=0; j<m; j++) a[j] *= 2.0;
+    ierr = VecRestoreArray(y[i],&a);CHKERRQ(ierr);
+  }
+  ierr = PetscCommDeferReductionsBegin(PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = VecDot(x,y[0],&ddot);CHKERRQ(ierr);
+  ierr = VecTDot(x,y[1],&dtdot);CHKERRQ(ierr);
+  ierr = PetscCommDeferReductionsBegin(PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = VecMDot(x,3,y,dmdot);CHKERRQ(ierr);
+  for (i=0; i<3; i++) {ierr = VecNorm(y[i],types[i],&dnrm[i]);CHKERRQ(ierr);}
+  ierr = PetscCommDeferReductionsEnd(PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = VecNorm(x,NORM_1_AND_2,dnrm12);CHKERRQ(ierr);
+  /* a split phase reduction in the region computes the queued ones first */
+  ierr = VecDotBegin(y[1],y[2],&dsdot);CHKERRQ(ierr);
+  ierr = VecDotEnd(y[1],y[2],&dsdot);CHKERRQ(ierr);
+  ierr = CheckScalar("VecDot",ddot,2.0*dot);CHKERRQ(ierr);
+  ierr = CheckScalar("VecTDot",dtdot,2.0*tdot);CHKERRQ(ierr);
+  for (i=0; i<3; i++) {ierr = CheckScalar("VecMDot",dmdot[i],2.0*mdot[i]);CHKERRQ(ierr);}
+  for (i=0; i<3; i++) {ierr = CheckScalar(NormTypes[types[i]],dnrm[i],2.0*nrm[i]);CHKERRQ(ierr);}
+  ierr = CheckScalar("NORM_1_AND_2",dnrm12[0],nrm12[0]);CHKERRQ(ierr);
+  ierr = CheckScalar("NORM_1_AND_2",dnrm12[1],nrm12[1]);CHKERRQ(ierr);
+  ierr = CheckScalar("VecDotBegin",dsdot,4.0*sdot);CHKERRQ(ierr);
+  ierr = VecNorm(x,NORM_2,&dnrm[3]);CHKERRQ(ierr);
+  ierr = PetscCommFlushDeferredReductions(PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = CheckScalar("VecNorm after flush",dnrm[3],nrm12[1]);CHKERRQ(ierr);
+  ierr = VecNormalize(y[0],&nrmz);CHKERRQ(ierr);
+  ierr = VecDot(x,y[0],&ddot);CHKERRQ(ierr);
+  ierr = PetscCommDeferReductionsEnd(PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = CheckScalar("VecDot after VecNormalize",ddot,dot/nrmz*2.0);CHKERRQ(ierr);
+
+  /* a vector program in the region computes the queued reductions first */
+  ierr = PetscCommDeferReductionsBegin(PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = VecTDot(x,y[1],&dtdot);CHKERRQ(ierr);
+  ierr = VecProgramCreate(&prog);CHKERRQ(ierr);
+  ierr = VecProgramDot(prog,x,y[0],&pdot);CHKERRQ(ierr);
+  ierr = VecProgramBegin(prog);CHKERRQ(ierr);
+  ierr = VecProgramEnd(prog);CHKERRQ(ierr);
+  ierr = PetscCommDeferReductionsEnd(PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = VecProgramDestroy(&prog);CHKERRQ(ierr);
+  ierr = CheckScalar("VecTDot before VecProgram",dtdot,2.0*tdot);CHKERRQ(ierr);
+  ierr = CheckScalar("VecProgramDot",pdot,dot/nrmz*2.0);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Deferred reductions done\n");CHKERRQ(ierr);
+
+  for (i=0; i<3; i++) {ierr = VecDestroy(&y[i]);CHKERRQ(ierr);}
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rand);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      output_file: output/ex51_1.out
+
+   test:
+      suffix: 2
+      nsize: 3
+      args: -log_view -n 7
+      filter: grep -e "Reductions Merged" -e Deferred -e differs
+      requires: define(PETSC_USE_LOG)
+      output_file: output/ex51_2.out
+
+   test:
+      suffix: info
+      nsize: 3
+      args: -info -n 7
+      filter: grep -c "Merged 7 deferred reductions"
+      requires: define(PETSC_USE_INFO)
+
+TEST*/
@@ -0,0 +1,82 @@
+static char help[] = "Tests VecPlaceArray() and VecResetArray() on a vector loaded from a memory mapping of a binary file.\n\n";
+
+#include <petscvec.h>
+
+static PetscErrorCode CheckValues(const char *when,Vec x,PetscScalar shift)
+{
+  const PetscScalar *a;
+  PetscInt          i,n;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = VecGetLocalSize(x,&n);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(x,&a);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    if (a[i] != (PetscScalar)i + shift) {
+      ierr = PetscPrintf(PETSC_COMM_SELF,"%s: entry %D differs\n",when,i);CHKERRQ(ierr);
+      break;
+    }
+  }
+  ierr = VecRestoreArrayRead(x,&a);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Vec            x,y;
+  PetscViewer    viewer;
+  PetscScalar    *a,*b;
+  PetscInt       i,n = 10;
+  PetscObject    mapping;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,NULL,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = VecCreate(PETSC_COMM_WORLD,&x);CHKERRQ(ierr);
+  ierr = VecSetSizes(x,n,PETSC_DECIDE);CHKERRQ(ierr);
+  ierr = VecSetFromOptions(x);CHKERRQ(ierr);
+  ierr = VecGetArray(x,&a);CHKERRQ(ierr);
+  for (i=0; i<n; i++) a[i] = i;
+  ierr = VecRestoreArray(x,&a);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryOpen(PETSC_COMM_WORLD,"vector.dat",FILE_MODE_WRITE,&viewer);CHKERRQ(ierr);
+  ierr = VecView(x,viewer);CHKERRQ(ierr);
+  ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+
+  ierr = PetscViewerBinaryOpen(PETSC_COMM_WORLD,"vector.dat",FILE_MODE_READ,&viewer);CHKERRQ(ierr);
+  ierr = PetscViewerBinarySetUseMMap(viewer,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = VecCreate(PETSC_COMM_WORLD,&y);CHKERRQ(ierr);
+  ierr = VecSetFromOptions(y);CHKERRQ(ierr);
+  ierr = VecLoad(y,viewer);CHKERRQ(ierr);
+  ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+  ierr = PetscObjectQuery((PetscObject)y,"VecLoad_mapping",&mapping);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Loaded %s a mapping\n",mapping ? "from" : "without");CHKERRQ(ierr);
+  ierr = CheckValues("VecLoad()",y,0.0);CHKERRQ(ierr);
+
+  /* the mapping is the array of the vector, so another array can be placed and removed */
+  ierr = PetscMalloc1(n,&b);CHKERRQ(ierr);
+  for (i=0; i<n; i++) b[i] = i + 1.0;
+  ierr = VecPlaceArray(y,b);CHKERRQ(ierr);
+  ierr = CheckValues("VecPlaceArray()",y,1.0);CHKERRQ(ierr);
+  ierr = VecResetArray(y);CHKERRQ(ierr);
+  ierr = CheckValues("VecResetArray()",y,0.0);CHKERRQ(ierr);
+  ierr = VecShift(y,2.0);CHKERRQ(ierr);
+  ierr = CheckValues("VecShift()",y,2.0);CHKERRQ(ierr);
+  ierr = PetscFree(b);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+      requires: define(PETSC_HAVE_MMAP)
+
+   test:
+      suffix: mpi
+      requires: define(PETSC_HAVE_MMAP)
+      args: -vec_type mpi
+      output_file: output/ex52_1.out
+
+TEST*/
@@ -188,4 +188,27 @@ int main(int argc,char **argv)
       output_file: output/ex1_1.out
       requires: cuda
 
+   test:
+      suffix: malloc_numa
+      nsize: 2
+      requires: define(PETSC_HAVE_LINUX_MEMPOLICY_H)
+      args: -n 100000 -malloc_numa interleave -malloc_numa_threshold 4096 -malloc_numa_view
+      filter: grep "pages on node" | sed -e "s/.*, policy/policy/" | sort -u
+
+   test:
+      suffix: malloc_numa_first_touch
+      requires: define(PETSC_HAVE_LINUX_MEMPOLICY_H)
+      args: -n 100000 -malloc_numa first_touch -malloc_numa_threshold 4096 -malloc_numa_view
+      filter: grep "pages on node" | sed -e "s/.*, policy/policy/" | sort -u
+
+   test:
+      suffix: threads
+      nsize: 2
+      args: -thread_pool_size 3 -vec_threads_min_size 1
+      output_file: output/ex1_1.out
+
+   test:
+      suffix: threads_large
+      args: -n 100000 -thread_pool_size 4 -vec_threads_min_size 1000
+
 TEST*/
@@ -54,4 +54,32 @@ PETSC_INTERN PetscErrorCode VecPointwiseDivide_Seq(Vec,Vec,Vec);
 PETSC_EXTERN PetscErrorCode VecCreate_Seq(Vec);
 PETSC_INTERN PetscErrorCode VecCreate_Seq_Private(Vec,const PetscScalar[]);
 
+/* multi-threaded versions of the operations, in dvecthreads.c */
+PETSC_INTERN PetscInt VecSeqThreadsMinSize;
+PETSC_INTERN PetscErrorCode VecDot_SeqThreads(Vec,Vec,PetscScalar*);
+PETSC_INTERN PetscErrorCode VecMDot_SeqThreads(Vec,PetscInt,const Vec[],PetscScalar*);
+PETSC_INTERN PetscErrorCode VecNorm_SeqThreads(Vec,NormType,PetscReal*);
+PETSC_INTERN PetscErrorCode VecSet_SeqThreads(Vec,PetscScalar);
+PETSC_INTERN PetscErrorCode VecScale_SeqThreads(Vec,PetscScalar);
+PETSC_INTERN PetscErrorCode VecCopy_SeqThreads(Vec,Vec);
+PETSC_INTERN PetscErrorCode VecAXPY_SeqThreads(Vec,PetscScalar,Vec);
+PETSC_INTERN PetscErrorCode VecAYPX_SeqThreads(Vec,PetscScalar,Vec);
+PETSC_INTERN PetscErrorCode VecAXPBY_SeqThreads(Vec,PetscScalar,PetscScalar,Vec);
+PETSC_INTERN PetscErrorCode VecAXPBYPCZ_SeqThreads(Vec,PetscScalar,PetscScalar,PetscScalar,Vec,Vec);
+PETSC_INTERN PetscErrorCode VecWAXPY_SeqThreads(Vec,PetscScalar,Vec,Vec);
+PETSC_INTERN PetscErrorCode VecMAXPY_SeqThreads(Vec,PetscInt,const PetscScalar*,Vec*);
+PETSC_INTERN PetscErrorCode VecPointwiseMult_SeqThreads(Vec,Vec,Vec);
+PETSC_INTERN PetscErrorCode VecPointwiseDivide_SeqThreads(Vec,Vec,Vec);
+PETSC_INTERN PetscErrorCode VecSeqThreadsZero_Private(PetscScalar*,PetscInt);
+
+/* true if the operations on n local entries are split among the threads of the pool */
+PETSC_STATIC_INLINE PetscBool VecSeqUseThreads_Private(PetscInt n)
+{
+  PetscInt nthreads;
+
+  if (n < VecSeqThreadsMinSize) return PETSC_FALSE;
+  if (PetscThreadPoolGetSize(&nthreads)) return PETSC_FALSE;
+  return nthreads > 1 ? PETSC_TRUE : PETSC_FALSE;
+}
+
 #endif
@@ -0,0 +1,173 @@
+/*
+   Parallel vectors whose entries are stored in single precision, see vecsingle.c for the local operations
+*/
+#include <../src/vec/vec/impls/seq/seqsingle/singlevecimpl.h>   /*I "petscvec.h" I*/
+#include <../src/vec/vec/impls/mpi/pvecimpl.h>
+
+static PetscErrorCode VecDot_MPISingle(Vec xin,Vec yin,PetscScalar *z)
+{
+  PetscScalar    work;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecDot_SeqSingle(xin,yin,&work);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&work,z,1,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecTDot_MPISingle(Vec xin,Vec yin,PetscScalar *z)
+{
+  PetscScalar    work;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecTDot_SeqSingle(xin,yin,&work);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(&work,z,1,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecMDot_MPISingle(Vec xin,PetscInt nv,const Vec y[],PetscScalar *z)
+{
+  PetscScalar    awork[128],*work = awork;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (nv > 128) {
+    ierr = PetscMalloc1(nv,&work);CHKERRQ(ierr);
+  }
+  ierr = VecMDot_SeqSingle(xin,nv,y,work);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(work,z,nv,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+  if (nv > 128) {
+    ierr = PetscFree(work);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecMTDot_MPISingle(Vec xin,PetscInt nv,const Vec y[],PetscScalar *z)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecMDot_MPISingle(xin,nv,y,z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecNorm_MPISingle(Vec xin,NormType type,PetscReal *z)
+{
+  PetscReal      work[2];
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (type == NORM_2 || type == NORM_FROBENIUS) {
+    ierr    = VecNorm_SeqSingle(xin,NORM_2,work);CHKERRQ(ierr);
+    work[0] = work[0]*work[0];
+    ierr    = MPIU_Allreduce(work,z,1,MPIU_REAL,MPIU_SUM,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+    *z      = PetscSqrtReal(*z);
+  } else if (type == NORM_1) {
+    ierr = VecNorm_SeqSingle(xin,NORM_1,work);CHKERRQ(ierr);
+    ierr = MPIU_Allreduce(work,z,1,MPIU_REAL,MPIU_SUM,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+  } else if (type == NORM_INFINITY) {
+    ierr = VecNorm_SeqSingle(xin,NORM_INFINITY,work);CHKERRQ(ierr);
+    ierr = MPIU_Allreduce(work,z,1,MPIU_REAL,MPIU_MAX,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+  } else if (type == NORM_1_AND_2) {
+    ierr    = VecNorm_SeqSingle(xin,NORM_1_AND_2,work);CHKERRQ(ierr);
+    work[1] = work[1]*work[1];
+    ierr    = MPIU_Allreduce(work,z,2,MPIU_REAL,MPIU_SUM,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
+    z[1]    = PetscSqrtReal(z[1]);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecDuplicate_MPISingle(Vec win,Vec *v)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecCreate(PetscObjectComm((PetscObject)win),v);CHKERRQ(ierr);
+  ierr = PetscLayoutReference(win->map,&(*v)->map);CHKERRQ(ierr);
+  ierr = VecSetType(*v,((PetscObject)win)->type_name);CHKERRQ(ierr);
+  ierr = PetscObjectListDuplicate(((PetscObject)win)->olist,&((PetscObject)(*v))->olist);CHKERRQ(ierr);
+  ierr = PetscFunctionListDuplicate(((PetscObject)win)->qlist,&((PetscObject)(*v))->qlist);CHKERRQ(ierr);
+
+  /* New vector should inherit stashing property of parent */
+  (*v)->stash.donotstash   = win->stash.donotstash;
+  (*v)->stash.ignorenegidx = win->stash.ignorenegidx;
+  (*v)->map->bs            = PetscAbs(win->map->bs);
+  (*v)->bstash.bs          = win->bstash.bs;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecDestroy_MPISingle(Vec v)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecSingleDestroy_Private(v);CHKERRQ(ierr);
+  ierr = VecDestroy_MPI(v);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   VECMPISINGLE - VECMPISINGLE = "mpisingle" - The parallel vector whose entries are stored in single precision
+
+   Options Database Keys:
+. -vec_type mpisingle - sets the vector type to VECMPISINGLE during a call to VecSetFromOptions()
+
+   Notes:
+   See VECSEQSINGLE for the operations done directly on the single precision entries. Ghosted vectors are not supported.
+
+   Only available with real scalars.
+
+   Level: intermediate
+
+.seealso: VecCreate(), VecSetType(), VECSINGLE, VECSEQSINGLE, VECMPI, KSPGMRESSetSinglePrecisionBasis()
+M*/
+
+PETSC_EXTERN PetscErrorCode VecCreate_MPISingle(Vec v)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecCreate_MPI_Private(v,PETSC_FALSE,0,NULL);CHKERRQ(ierr);
+  ierr = VecSingleSetUp_Private(v);CHKERRQ(ierr);
+  v->ops->duplicate   = VecDuplicate_MPISingle;
+  v->ops->destroy     = VecDestroy_MPISingle;
+  v->ops->dot         = VecDot_MPISingle;
+  v->ops->tdot        = VecTDot_MPISingle;
+  v->ops->mdot        = VecMDot_MPISingle;
+  v->ops->mtdot       = VecMTDot_MPISingle;
+  v->ops->norm        = VecNorm_MPISingle;
+  v->ops->dot_local   = VecDot_SeqSingle;
+  v->ops->tdot_local  = VecTDot_SeqSingle;
+  v->ops->norm_local  = VecNorm_SeqSingle;
+  v->ops->mdot_local  = VecMDot_SeqSingle;
+  v->ops->mtdot_local = VecMTDot_SeqSingle;
+  ierr = PetscObjectChangeTypeName((PetscObject)v,VECMPISINGLE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   VECSINGLE - VECSINGLE = "single" - A VECSEQSINGLE on a single process communicator, and VECMPISINGLE otherwise.
+
+   Options Database Keys:
+. -vec_type single - sets the vector type to VECSINGLE during a call to VecSetFromOptions()
+
+   Level: intermediate
+
+.seealso: VecCreate(), VecSetType(), VECSEQSINGLE, VECMPISINGLE, VECSTANDARD, KSPGMRESSetSinglePrecisionBasis()
+M*/
+
+PETSC_EXTERN PetscErrorCode VecCreate_Single(Vec v)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    size;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)v),&size);CHKERRQ(ierr);
+  if (size == 1) {
+    ierr = VecSetType(v,VECSEQSINGLE);CHKERRQ(ierr);
+  } else {
+    ierr = VecSetType(v,VECMPISINGLE);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
@@ -498,8 +498,9 @@ PetscErrorCode VecCreate_MPI_Private(Vec v,PetscBool alloc,PetscInt nghost,const
   if (alloc && !array) {
     PetscInt n = v->map->n+nghost;
     ierr               = PetscMalloc1(n,&s->array);CHKERRQ(ierr);
+    ierr               = PetscMallocNUMAPlace(s->array,n*sizeof(PetscScalar));CHKERRQ(ierr);
     ierr               = PetscLogObjectMemory((PetscObject)v,n*sizeof(PetscScalar));CHKERRQ(ierr);
-    ierr               = PetscMemzero(s->array,n*sizeof(PetscScalar));CHKERRQ(ierr);
+    ierr               = VecSeqThreadsZero_Private(s->array,n);CHKERRQ(ierr);
     s->array_allocated = s->array;
   }
 
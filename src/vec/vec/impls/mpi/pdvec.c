@@ -17,6 +17,7 @@ PetscErrorCode VecDestroy_MPI(Vec v)
   PetscLogObjectState((PetscObject)v,"Length=%D",v->map->N);
 #endif
   if (!x) PetscFunctionReturn(0);
+  ierr = PetscMallocNUMAViewFromOptions(x->array_allocated,(v->map->n+x->nghost)*sizeof(PetscScalar),"VecMPI array");CHKERRQ(ierr);
   ierr = PetscFree(x->array_allocated);CHKERRQ(ierr);
 
   /* Destroy local representation of vector if it exists */
@@ -384,28 +385,17 @@ PetscErrorCode VecView_MPI_ASCII(Vec xin,PetscViewer viewer)
 PetscErrorCode VecView_MPI_Binary(Vec xin,PetscViewer viewer)
 {
   PetscErrorCode    ierr;
-  PetscMPIInt       rank,size,mesgsize,tag = ((PetscObject)viewer)->tag, mesglen;
-  PetscInt          len,n,j,tr[2];
-  int               fdes;
-  MPI_Status        status;
-  PetscScalar       *values;
+  PetscMPIInt       rank;
+  PetscInt          tr[2];
   const PetscScalar *xarray;
   FILE              *file;
-#if defined(PETSC_HAVE_MPIIO)
-  PetscBool         isMPIIO;
-#endif
   PetscBool         skipHeader;
-  PetscInt          message_count,flowcontrolcount;
   PetscViewerFormat format;
 
   PetscFunctionBegin;
   ierr = VecGetArrayRead(xin,&xarray);CHKERRQ(ierr);
-  ierr = PetscViewerBinaryGetDescriptor(viewer,&fdes);CHKERRQ(ierr);
   ierr = PetscViewerBinaryGetSkipHeader(viewer,&skipHeader);CHKERRQ(ierr);
-
-  /* determine maximum message to arrive */
   ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)xin),&rank);CHKERRQ(ierr);
-  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)xin),&size);CHKERRQ(ierr);
 
   if (!skipHeader) {
     tr[0] = VEC_FILE_CLASSID;
@@ -413,62 +403,22 @@ PetscErrorCode VecView_MPI_Binary(Vec xin,PetscViewer viewer)
     ierr  = PetscViewerBinaryWrite(viewer,tr,2,PETSC_INT,PETSC_FALSE);CHKERRQ(ierr);
   }
 
-#if defined(PETSC_HAVE_MPIIO)
-  ierr = PetscViewerBinaryGetUseMPIIO(viewer,&isMPIIO);CHKERRQ(ierr);
-  if (!isMPIIO) {
-#endif
-    ierr = PetscViewerFlowControlStart(viewer,&message_count,&flowcontrolcount);CHKERRQ(ierr);
-    if (!rank) {
-      ierr = PetscBinaryWrite(fdes,(void*)xarray,xin->map->n,PETSC_SCALAR,PETSC_FALSE);CHKERRQ(ierr);
-
-      len = 0;
-      for (j=1; j<size; j++) len = PetscMax(len,xin->map->range[j+1]-xin->map->range[j]);
-      ierr = PetscMalloc1(len,&values);CHKERRQ(ierr);
-      ierr = PetscMPIIntCast(len,&mesgsize);CHKERRQ(ierr);
-      /* receive and save messages */
-      for (j=1; j<size; j++) {
-        ierr = PetscViewerFlowControlStepMaster(viewer,j,&message_count,flowcontrolcount);CHKERRQ(ierr);
-        ierr = MPI_Recv(values,mesgsize,MPIU_SCALAR,j,tag,PetscObjectComm((PetscObject)xin),&status);CHKERRQ(ierr);
-        ierr = MPI_Get_count(&status,MPIU_SCALAR,&mesglen);CHKERRQ(ierr);
-        n    = (PetscInt)mesglen;
-        ierr = PetscBinaryWrite(fdes,values,n,PETSC_SCALAR,PETSC_TRUE);CHKERRQ(ierr);
-      }
-      ierr = PetscViewerFlowControlEndMaster(viewer,&message_count);CHKERRQ(ierr);
-      ierr = PetscFree(values);CHKERRQ(ierr);
-    } else {
-      ierr = PetscViewerFlowControlStepWorker(viewer,rank,&message_count);CHKERRQ(ierr);
-      ierr = PetscMPIIntCast(xin->map->n,&mesgsize);CHKERRQ(ierr);
-      ierr = MPI_Send((void*)xarray,mesgsize,MPIU_SCALAR,0,tag,PetscObjectComm((PetscObject)xin));CHKERRQ(ierr);
-      ierr = PetscViewerFlowControlEndWorker(viewer,&message_count);CHKERRQ(ierr);
-    }
-    ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
-    if (format == PETSC_VIEWER_BINARY_MATLAB) {
-      MPI_Comm   comm;
-      FILE       *info;
-      const char *name;
+  /* each process stores its own part of the vector, in parallel when the viewer uses MPI-IO */
+  ierr = PetscViewerBinaryWriteAll(viewer,(void*)xarray,xin->map->n,xin->map->rstart,xin->map->N,PETSC_SCALAR);CHKERRQ(ierr);
 
-      ierr = PetscObjectGetName((PetscObject)xin,&name);CHKERRQ(ierr);
-      ierr = PetscObjectGetComm((PetscObject)viewer,&comm);CHKERRQ(ierr);
-      ierr = PetscViewerBinaryGetInfoPointer(viewer,&info);CHKERRQ(ierr);
-      ierr = PetscFPrintf(comm,info,"#--- begin code written by PetscViewerBinary for MATLAB format ---#\n");CHKERRQ(ierr);
-      ierr = PetscFPrintf(comm,info,"#$$ Set.%s = PetscBinaryRead(fd);\n",name);CHKERRQ(ierr);
-      ierr = PetscFPrintf(comm,info,"#--- end code written by PetscViewerBinary for MATLAB format ---#\n\n");CHKERRQ(ierr);
-    }
-#if defined(PETSC_HAVE_MPIIO)
-  } else {
-    MPI_Offset   off;
-    MPI_File     mfdes;
-    PetscMPIInt  lsize;
-
-    ierr = PetscMPIIntCast(xin->map->n,&lsize);CHKERRQ(ierr);
-    ierr = PetscViewerBinaryGetMPIIODescriptor(viewer,&mfdes);CHKERRQ(ierr);
-    ierr = PetscViewerBinaryGetMPIIOOffset(viewer,&off);CHKERRQ(ierr);
-    off += xin->map->rstart*sizeof(PetscScalar); /* off is MPI_Offset, not PetscMPIInt */
-    ierr = MPI_File_set_view(mfdes,off,MPIU_SCALAR,MPIU_SCALAR,(char*)"native",MPI_INFO_NULL);CHKERRQ(ierr);
-    ierr = MPIU_File_write_all(mfdes,(void*)xarray,lsize,MPIU_SCALAR,MPI_STATUS_IGNORE);CHKERRQ(ierr);
-    ierr = PetscViewerBinaryAddMPIIOOffset(viewer,xin->map->N*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
+  if (format == PETSC_VIEWER_BINARY_MATLAB) {
+    MPI_Comm   comm;
+    FILE       *info;
+    const char *name;
+
+    ierr = PetscObjectGetName((PetscObject)xin,&name);CHKERRQ(ierr);
+    ierr = PetscObjectGetComm((PetscObject)viewer,&comm);CHKERRQ(ierr);
+    ierr = PetscViewerBinaryGetInfoPointer(viewer,&info);CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm,info,"#--- begin code written by PetscViewerBinary for MATLAB format ---#\n");CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm,info,"#$$ Set.%s = PetscBinaryRead(fd);\n",name);CHKERRQ(ierr);
+    ierr = PetscFPrintf(comm,info,"#--- end code written by PetscViewerBinary for MATLAB format ---#\n\n");CHKERRQ(ierr);
   }
-#endif
 
   ierr = VecRestoreArrayRead(xin,&xarray);CHKERRQ(ierr);
   if (!rank) {
@@ -14,6 +14,10 @@ PetscErrorCode VecDot_Seq(Vec xin,Vec yin,PetscScalar *z)
   PetscErrorCode    ierr;
 
   PetscFunctionBegin;
+  if (VecSeqUseThreads_Private(xin->map->n)) {
+    ierr = VecDot_SeqThreads(xin,yin,z);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = PetscBLASIntCast(xin->map->n,&bn);CHKERRQ(ierr);
   ierr = VecGetArrayRead(xin,&xa);CHKERRQ(ierr);
   ierr = VecGetArrayRead(yin,&ya);CHKERRQ(ierr);
@@ -55,6 +59,8 @@ PetscErrorCode VecScale_Seq(Vec xin, PetscScalar alpha)
   ierr = PetscBLASIntCast(xin->map->n,&bn);CHKERRQ(ierr);
   if (alpha == (PetscScalar)0.0) {
     ierr = VecSet_Seq(xin,alpha);CHKERRQ(ierr);
+  } else if (VecSeqUseThreads_Private(xin->map->n) && alpha != (PetscScalar)1.0) {
+    ierr = VecScale_SeqThreads(xin,alpha);CHKERRQ(ierr);
   } else if (alpha != (PetscScalar)1.0) {
     PetscScalar a = alpha,*xarray;
     ierr = VecGetArray(xin,&xarray);CHKERRQ(ierr);
@@ -75,7 +81,10 @@ PetscErrorCode VecAXPY_Seq(Vec yin,PetscScalar alpha,Vec xin)
   PetscFunctionBegin;
   ierr = PetscBLASIntCast(yin->map->n,&bn);CHKERRQ(ierr);
   /* assume that the BLAS handles alpha == 1.0 efficiently since we have no fast code for it */
-  if (alpha != (PetscScalar)0.0) {
+  if (alpha != (PetscScalar)0.0 && VecSeqUseThreads_Private(yin->map->n)) {
+    ierr = VecAXPY_SeqThreads(yin,alpha,xin);CHKERRQ(ierr);
+    ierr = PetscLogFlops(2.0*yin->map->n);CHKERRQ(ierr);
+  } else if (alpha != (PetscScalar)0.0) {
     ierr = VecGetArrayRead(xin,&xarray);CHKERRQ(ierr);
     ierr = VecGetArray(yin,&yarray);CHKERRQ(ierr);
     PetscStackCallBLAS("BLASaxpy",BLASaxpy_(&bn,&alpha,xarray,&one,yarray,&one));
@@ -100,6 +109,9 @@ PetscErrorCode VecAXPBY_Seq(Vec yin,PetscScalar alpha,PetscScalar beta,Vec xin)
     ierr = VecAXPY_Seq(yin,alpha,xin);CHKERRQ(ierr);
   } else if (a == (PetscScalar)1.0) {
     ierr = VecAYPX_Seq(yin,beta,xin);CHKERRQ(ierr);
+  } else if (VecSeqUseThreads_Private(n)) {
+    ierr = VecAXPBY_SeqThreads(yin,alpha,beta,xin);CHKERRQ(ierr);
+    ierr = PetscLogFlops((b == (PetscScalar)0.0 ? 1.0 : 3.0)*n);CHKERRQ(ierr);
   } else if (b == (PetscScalar)0.0) {
     ierr = VecGetArrayRead(xin,&xx);CHKERRQ(ierr);
     ierr = VecGetArray(yin,(PetscScalar**)&yy);CHKERRQ(ierr);
@@ -130,6 +142,13 @@ PetscErrorCode VecAXPBYPCZ_Seq(Vec zin,PetscScalar alpha,PetscScalar beta,PetscS
   PetscScalar       *zz;
 
   PetscFunctionBegin;
+  if (VecSeqUseThreads_Private(n)) {
+    ierr = VecAXPBYPCZ_SeqThreads(zin,alpha,beta,gamma,xin,yin);CHKERRQ(ierr);
+    if (gamma == (PetscScalar)0.0) {ierr = PetscLogFlops(3.0*n);CHKERRQ(ierr);}
+    else if (alpha == (PetscScalar)1.0 || gamma == (PetscScalar)1.0) {ierr = PetscLogFlops(4.0*n);CHKERRQ(ierr);}
+    else {ierr = PetscLogFlops(5.0*n);CHKERRQ(ierr);}
+    PetscFunctionReturn(0);
+  }
   ierr = VecGetArrayRead(xin,&xx);CHKERRQ(ierr);
   ierr = VecGetArrayRead(yin,&yy);CHKERRQ(ierr);
   ierr = VecGetArray(zin,&zz);CHKERRQ(ierr);
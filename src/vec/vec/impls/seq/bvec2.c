@@ -82,6 +82,11 @@ PetscErrorCode VecPointwiseMult_Seq(Vec win,Vec xin,Vec yin)
   PetscScalar    *ww,*xx,*yy; /* cannot make xx or yy const since might be ww */
 
   PetscFunctionBegin;
+  if (VecSeqUseThreads_Private(n)) {
+    ierr = VecPointwiseMult_SeqThreads(win,xin,yin);CHKERRQ(ierr);
+    ierr = PetscLogFlops(n);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = VecGetArrayRead(xin,(const PetscScalar**)&xx);CHKERRQ(ierr);
   ierr = VecGetArrayRead(yin,(const PetscScalar**)&yy);CHKERRQ(ierr);
   ierr = VecGetArray(win,&ww);CHKERRQ(ierr);
@@ -110,6 +115,11 @@ PetscErrorCode VecPointwiseDivide_Seq(Vec win,Vec xin,Vec yin)
   PetscScalar    *ww,*xx,*yy; /* cannot make xx or yy const since might be ww */
 
   PetscFunctionBegin;
+  if (VecSeqUseThreads_Private(n)) {
+    ierr = VecPointwiseDivide_SeqThreads(win,xin,yin);CHKERRQ(ierr);
+    ierr = PetscLogFlops(n);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = VecGetArrayRead(xin,(const PetscScalar**)&xx);CHKERRQ(ierr);
   ierr = VecGetArrayRead(yin,(const PetscScalar**)&yy);CHKERRQ(ierr);
   ierr = VecGetArray(win,&ww);CHKERRQ(ierr);
@@ -181,7 +191,9 @@ PetscErrorCode VecCopy_Seq(Vec xin,Vec yin)
   PetscErrorCode    ierr;
 
   PetscFunctionBegin;
-  if (xin != yin) {
+  if (xin != yin && VecSeqUseThreads_Private(xin->map->n)) {
+    ierr = VecCopy_SeqThreads(xin,yin);CHKERRQ(ierr);
+  } else if (xin != yin) {
     ierr = VecGetArrayRead(xin,&xa);CHKERRQ(ierr);
     ierr = VecGetArray(yin,&ya);CHKERRQ(ierr);
     ierr = PetscMemcpy(ya,xa,xin->map->n*sizeof(PetscScalar));CHKERRQ(ierr);
@@ -219,6 +231,10 @@ PetscErrorCode VecNorm_Seq(Vec xin,NormType type,PetscReal *z)
   PetscBLASInt      one = 1, bn;
 
   PetscFunctionBegin;
+  if (VecSeqUseThreads_Private(n)) {
+    ierr = VecNorm_SeqThreads(xin,type,z);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = PetscBLASIntCast(n,&bn);CHKERRQ(ierr);
   if (type == NORM_2 || type == NORM_FROBENIUS) {
     ierr = VecGetArrayRead(xin,&xx);CHKERRQ(ierr);
@@ -785,6 +801,7 @@ PetscErrorCode VecDestroy_Seq(Vec v)
 #if defined(PETSC_USE_LOG)
   PetscLogObjectState((PetscObject)v,"Length=%D",v->map->n);
 #endif
+  ierr = PetscMallocNUMAViewFromOptions(vs->array_allocated,v->map->n*sizeof(PetscScalar),"VecSeq array");CHKERRQ(ierr);
   ierr = PetscFree(vs->array_allocated);CHKERRQ(ierr);
   ierr = PetscFree(v->data);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -6,6 +6,165 @@
 #include <../src/vec/vec/impls/dvecimpl.h>
 #include <petsc/private/kernels/petscaxpy.h>
 
+/*
+   With AVX-512, or AVX2 and FMA, VecMDot_Seq() and VecMAXPY_Seq() use the vector kernels below, selected at compile
+   time as in MatMult_SeqSELL(). The y vectors are traversed eight at a time, so each block of x is read once per eight
+   vectors, and x is processed in blocks of PETSC_VEC_AVX_BLOCK entries that stay in cache for all the y vectors.
+*/
+#if defined(PETSC_HAVE_IMMINTRIN_H) && (defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__))) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX)
+  #include <immintrin.h>
+  #define PETSC_VEC_USE_AVX
+
+  #define PETSC_VEC_AVX_BLOCK 4096
+
+  #if defined(__AVX512F__)
+    #define PETSC_VEC_AVX_WIDTH 8
+    typedef __m512d PetscVecAVX;
+    #define PetscVecAVXZero()          _mm512_setzero_pd()
+    #define PetscVecAVXSet(a)          _mm512_set1_pd(a)
+    #define PetscVecAVXLoad(p)         _mm512_loadu_pd(p)
+    #define PetscVecAVXStore(p,v)      _mm512_storeu_pd(p,v)
+    #define PetscVecAVXFMA(a,b,c)      _mm512_fmadd_pd(a,b,c)
+    #define PetscVecAVXAdd(a,b)        _mm512_add_pd(a,b)
+    #define PetscVecAVXMul(a,b)        _mm512_mul_pd(a,b)
+    #define PetscVecAVXReduce(v)       _mm512_reduce_add_pd(v)
+  #else
+    #define PETSC_VEC_AVX_WIDTH 4
+    typedef __m256d PetscVecAVX;
+    #define PetscVecAVXZero()          _mm256_setzero_pd()
+    #define PetscVecAVXSet(a)          _mm256_set1_pd(a)
+    #define PetscVecAVXLoad(p)         _mm256_loadu_pd(p)
+    #define PetscVecAVXStore(p,v)      _mm256_storeu_pd(p,v)
+    #define PetscVecAVXFMA(a,b,c)      _mm256_fmadd_pd(a,b,c)
+    #define PetscVecAVXAdd(a,b)        _mm256_add_pd(a,b)
+    #define PetscVecAVXMul(a,b)        _mm256_mul_pd(a,b)
+PETSC_STATIC_INLINE double PetscVecAVXReduce(__m256d v)
+{
+  __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v),_mm256_extractf128_pd(v,1));
+  return _mm_cvtsd_f64(_mm_add_sd(s,_mm_unpackhi_pd(s,s)));
+}
+  #endif
+
+/* z[j] += x[0:n] . y[j][off:off+n] for j = 0,...,7 */
+PETSC_STATIC_INLINE void VecMDot_AVX8_Private(PetscInt n,const PetscScalar *x,const PetscScalar *const *y,PetscInt off,PetscScalar *z)
+{
+  const PetscScalar *y0 = y[0]+off,*y1 = y[1]+off,*y2 = y[2]+off,*y3 = y[3]+off;
+  const PetscScalar *y4 = y[4]+off,*y5 = y[5]+off,*y6 = y[6]+off,*y7 = y[7]+off;
+  PetscVecAVX       xv,s0,s1,s2,s3,s4,s5,s6,s7;
+  PetscInt          i;
+
+  s0 = s1 = s2 = s3 = s4 = s5 = s6 = s7 = PetscVecAVXZero();
+  for (i=0; i+PETSC_VEC_AVX_WIDTH<=n; i+=PETSC_VEC_AVX_WIDTH) {
+    xv = PetscVecAVXLoad(x+i);
+    s0 = PetscVecAVXFMA(xv,PetscVecAVXLoad(y0+i),s0);
+    s1 = PetscVecAVXFMA(xv,PetscVecAVXLoad(y1+i),s1);
+    s2 = PetscVecAVXFMA(xv,PetscVecAVXLoad(y2+i),s2);
+    s3 = PetscVecAVXFMA(xv,PetscVecAVXLoad(y3+i),s3);
+    s4 = PetscVecAVXFMA(xv,PetscVecAVXLoad(y4+i),s4);
+    s5 = PetscVecAVXFMA(xv,PetscVecAVXLoad(y5+i),s5);
+    s6 = PetscVecAVXFMA(xv,PetscVecAVXLoad(y6+i),s6);
+    s7 = PetscVecAVXFMA(xv,PetscVecAVXLoad(y7+i),s7);
+  }
+  z[0] += PetscVecAVXReduce(s0); z[1] += PetscVecAVXReduce(s1); z[2] += PetscVecAVXReduce(s2); z[3] += PetscVecAVXReduce(s3);
+  z[4] += PetscVecAVXReduce(s4); z[5] += PetscVecAVXReduce(s5); z[6] += PetscVecAVXReduce(s6); z[7] += PetscVecAVXReduce(s7);
+  for (; i<n; i++) {
+    z[0] += x[i]*y0[i]; z[1] += x[i]*y1[i]; z[2] += x[i]*y2[i]; z[3] += x[i]*y3[i];
+    z[4] += x[i]*y4[i]; z[5] += x[i]*y5[i]; z[6] += x[i]*y6[i]; z[7] += x[i]*y7[i];
+  }
+}
+
+/* z[j] += x[0:n] . y[j][off:off+n] for j = 0,...,3 */
+PETSC_STATIC_INLINE void VecMDot_AVX4_Private(PetscInt n,const PetscScalar *x,const PetscScalar *const *y,PetscInt off,PetscScalar *z)
+{
+  const PetscScalar *y0 = y[0]+off,*y1 = y[1]+off,*y2 = y[2]+off,*y3 = y[3]+off;
+  PetscVecAVX       xv,s0,s1,s2,s3;
+  PetscInt          i;
+
+  s0 = s1 = s2 = s3 = PetscVecAVXZero();
+  for (i=0; i+PETSC_VEC_AVX_WIDTH<=n; i+=PETSC_VEC_AVX_WIDTH) {
+    xv = PetscVecAVXLoad(x+i);
+    s0 = PetscVecAVXFMA(xv,PetscVecAVXLoad(y0+i),s0);
+    s1 = PetscVecAVXFMA(xv,PetscVecAVXLoad(y1+i),s1);
+    s2 = PetscVecAVXFMA(xv,PetscVecAVXLoad(y2+i),s2);
+    s3 = PetscVecAVXFMA(xv,PetscVecAVXLoad(y3+i),s3);
+  }
+  z[0] += PetscVecAVXReduce(s0); z[1] += PetscVecAVXReduce(s1); z[2] += PetscVecAVXReduce(s2); z[3] += PetscVecAVXReduce(s3);
+  for (; i<n; i++) {z[0] += x[i]*y0[i]; z[1] += x[i]*y1[i]; z[2] += x[i]*y2[i]; z[3] += x[i]*y3[i];}
+}
+
+/* z[0] += x[0:n] . y[0][off:off+n], with four partial sums to hide the latency of the FMA */
+PETSC_STATIC_INLINE void VecMDot_AVX1_Private(PetscInt n,const PetscScalar *x,const PetscScalar *const *y,PetscInt off,PetscScalar *z)
+{
+  const PetscScalar *y0 = y[0]+off;
+  PetscVecAVX       s0,s1,s2,s3;
+  PetscInt          i;
+
+  s0 = s1 = s2 = s3 = PetscVecAVXZero();
+  for (i=0; i+4*PETSC_VEC_AVX_WIDTH<=n; i+=4*PETSC_VEC_AVX_WIDTH) {
+    s0 = PetscVecAVXFMA(PetscVecAVXLoad(x+i),PetscVecAVXLoad(y0+i),s0);
+    s1 = PetscVecAVXFMA(PetscVecAVXLoad(x+i+PETSC_VEC_AVX_WIDTH),PetscVecAVXLoad(y0+i+PETSC_VEC_AVX_WIDTH),s1);
+    s2 = PetscVecAVXFMA(PetscVecAVXLoad(x+i+2*PETSC_VEC_AVX_WIDTH),PetscVecAVXLoad(y0+i+2*PETSC_VEC_AVX_WIDTH),s2);
+    s3 = PetscVecAVXFMA(PetscVecAVXLoad(x+i+3*PETSC_VEC_AVX_WIDTH),PetscVecAVXLoad(y0+i+3*PETSC_VEC_AVX_WIDTH),s3);
+  }
+  for (; i+PETSC_VEC_AVX_WIDTH<=n; i+=PETSC_VEC_AVX_WIDTH) s0 = PetscVecAVXFMA(PetscVecAVXLoad(x+i),PetscVecAVXLoad(y0+i),s0);
+  z[0] += PetscVecAVXReduce(PetscVecAVXAdd(PetscVecAVXAdd(s0,s1),PetscVecAVXAdd(s2,s3)));
+  for (; i<n; i++) z[0] += x[i]*y0[i];
+}
+
+/* x[0:n] += sum_j alpha[j] y[j][off:off+n] for j = 0,...,7 */
+PETSC_STATIC_INLINE void VecMAXPY_AVX8_Private(PetscInt n,PetscScalar *x,const PetscScalar *alpha,const PetscScalar *const *y,PetscInt off)
+{
+  const PetscScalar *y0 = y[0]+off,*y1 = y[1]+off,*y2 = y[2]+off,*y3 = y[3]+off;
+  const PetscScalar *y4 = y[4]+off,*y5 = y[5]+off,*y6 = y[6]+off,*y7 = y[7]+off;
+  const PetscVecAVX a0 = PetscVecAVXSet(alpha[0]),a1 = PetscVecAVXSet(alpha[1]),a2 = PetscVecAVXSet(alpha[2]),a3 = PetscVecAVXSet(alpha[3]);
+  const PetscVecAVX a4 = PetscVecAVXSet(alpha[4]),a5 = PetscVecAVXSet(alpha[5]),a6 = PetscVecAVXSet(alpha[6]),a7 = PetscVecAVXSet(alpha[7]);
+  PetscVecAVX       xv,tv;
+  PetscInt          i;
+
+  for (i=0; i+PETSC_VEC_AVX_WIDTH<=n; i+=PETSC_VEC_AVX_WIDTH) {
+    /* two independent chains of FMA */
+    xv = PetscVecAVXFMA(a0,PetscVecAVXLoad(y0+i),PetscVecAVXLoad(x+i));
+    tv = PetscVecAVXMul(a1,PetscVecAVXLoad(y1+i));
+    xv = PetscVecAVXFMA(a2,PetscVecAVXLoad(y2+i),xv);
+    tv = PetscVecAVXFMA(a3,PetscVecAVXLoad(y3+i),tv);
+    xv = PetscVecAVXFMA(a4,PetscVecAVXLoad(y4+i),xv);
+    tv = PetscVecAVXFMA(a5,PetscVecAVXLoad(y5+i),tv);
+    xv = PetscVecAVXFMA(a6,PetscVecAVXLoad(y6+i),xv);
+    tv = PetscVecAVXFMA(a7,PetscVecAVXLoad(y7+i),tv);
+    PetscVecAVXStore(x+i,PetscVecAVXAdd(xv,tv));
+  }
+  for (; i<n; i++) x[i] += alpha[0]*y0[i] + alpha[1]*y1[i] + alpha[2]*y2[i] + alpha[3]*y3[i] + alpha[4]*y4[i] + alpha[5]*y5[i] + alpha[6]*y6[i] + alpha[7]*y7[i];
+}
+
+/* x[0:n] += sum_j alpha[j] y[j][off:off+n] for j = 0,...,3 */
+PETSC_STATIC_INLINE void VecMAXPY_AVX4_Private(PetscInt n,PetscScalar *x,const PetscScalar *alpha,const PetscScalar *const *y,PetscInt off)
+{
+  const PetscScalar *y0 = y[0]+off,*y1 = y[1]+off,*y2 = y[2]+off,*y3 = y[3]+off;
+  const PetscVecAVX a0 = PetscVecAVXSet(alpha[0]),a1 = PetscVecAVXSet(alpha[1]),a2 = PetscVecAVXSet(alpha[2]),a3 = PetscVecAVXSet(alpha[3]);
+  PetscVecAVX       xv;
+  PetscInt          i;
+
+  for (i=0; i+PETSC_VEC_AVX_WIDTH<=n; i+=PETSC_VEC_AVX_WIDTH) {
+    xv = PetscVecAVXFMA(a0,PetscVecAVXLoad(y0+i),PetscVecAVXLoad(x+i));
+    xv = PetscVecAVXFMA(a1,PetscVecAVXLoad(y1+i),xv);
+    xv = PetscVecAVXFMA(a2,PetscVecAVXLoad(y2+i),xv);
+    xv = PetscVecAVXFMA(a3,PetscVecAVXLoad(y3+i),xv);
+    PetscVecAVXStore(x+i,xv);
+  }
+  for (; i<n; i++) x[i] += alpha[0]*y0[i] + alpha[1]*y1[i] + alpha[2]*y2[i] + alpha[3]*y3[i];
+}
+
+/* x[0:n] += alpha[0] y[0][off:off+n] */
+PETSC_STATIC_INLINE void VecMAXPY_AVX1_Private(PetscInt n,PetscScalar *x,const PetscScalar *alpha,const PetscScalar *const *y,PetscInt off)
+{
+  const PetscScalar *y0 = y[0]+off;
+  const PetscVecAVX a0  = PetscVecAVXSet(alpha[0]);
+  PetscInt          i;
+
+  for (i=0; i+PETSC_VEC_AVX_WIDTH<=n; i+=PETSC_VEC_AVX_WIDTH) PetscVecAVXStore(x+i,PetscVecAVXFMA(a0,PetscVecAVXLoad(y0+i),PetscVecAVXLoad(x+i)));
+  for (; i<n; i++) x[i] += alpha[0]*y0[i];
+}
+#endif
 
 
 #if defined(PETSC_USE_FORTRAN_KERNEL_MDOT)
@@ -19,6 +178,10 @@ PetscErrorCode VecMDot_Seq(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
   Vec               *yy;
 
   PetscFunctionBegin;
+  if (VecSeqUseThreads_Private(n)) {
+    ierr = VecMDot_SeqThreads(xin,nv,yin,z);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   sum0 = 0.0;
   sum1 = 0.0;
   sum2 = 0.0;
@@ -90,6 +253,37 @@ PetscErrorCode VecMDot_Seq(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
   PetscFunctionReturn(0);
 }
 
+#elif defined(PETSC_VEC_USE_AVX)
+PetscErrorCode VecMDot_Seq(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
+{
+  PetscErrorCode    ierr;
+  PetscInt          n = xin->map->n,i,j,m;
+  const PetscScalar *x,**y;
+
+  PetscFunctionBegin;
+  if (VecSeqUseThreads_Private(n)) {
+    ierr = VecMDot_SeqThreads(xin,nv,yin,z);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscMalloc1(nv,&y);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(xin,&x);CHKERRQ(ierr);
+  for (j=0; j<nv; j++) {
+    ierr = VecGetArrayRead(yin[j],&y[j]);CHKERRQ(ierr);
+    z[j] = 0.0;
+  }
+  for (i=0; i<n; i+=PETSC_VEC_AVX_BLOCK) {
+    m = PetscMin(PETSC_VEC_AVX_BLOCK,n-i);
+    for (j=0; j+8<=nv; j+=8) VecMDot_AVX8_Private(m,x+i,y+j,i,z+j);
+    if (j+4<=nv) {VecMDot_AVX4_Private(m,x+i,y+j,i,z+j); j += 4;}
+    for (; j<nv; j++) VecMDot_AVX1_Private(m,x+i,y+j,i,z+j);
+  }
+  for (j=0; j<nv; j++) {ierr = VecRestoreArrayRead(yin[j],&y[j]);CHKERRQ(ierr);}
+  ierr = VecRestoreArrayRead(xin,&x);CHKERRQ(ierr);
+  ierr = PetscFree(y);CHKERRQ(ierr);
+  ierr = PetscLogFlops(PetscMax(nv*(2.0*n-1),0.0));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #else
 PetscErrorCode VecMDot_Seq(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
 {
@@ -100,6 +294,10 @@ PetscErrorCode VecMDot_Seq(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
   Vec               *yy;
 
   PetscFunctionBegin;
+  if (VecSeqUseThreads_Private(n)) {
+    ierr = VecMDot_SeqThreads(xin,nv,yin,z);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   sum0 = 0.;
   sum1 = 0.;
   sum2 = 0.;
@@ -543,6 +741,10 @@ PetscErrorCode VecSet_Seq(Vec xin,PetscScalar alpha)
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
+  if (VecSeqUseThreads_Private(n)) {
+    ierr = VecSet_SeqThreads(xin,alpha);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = VecGetArray(xin,&xx);CHKERRQ(ierr);
   if (alpha == (PetscScalar)0.0) {
     ierr = PetscMemzero(xx,n*sizeof(PetscScalar));CHKERRQ(ierr);
@@ -553,6 +755,35 @@ PetscErrorCode VecSet_Seq(Vec xin,PetscScalar alpha)
   PetscFunctionReturn(0);
 }
 
+#if defined(PETSC_VEC_USE_AVX)
+PetscErrorCode VecMAXPY_Seq(Vec xin,PetscInt nv,const PetscScalar *alpha,Vec *yin)
+{
+  PetscErrorCode    ierr;
+  PetscInt          n = xin->map->n,i,j,m;
+  PetscScalar       *x;
+  const PetscScalar **y;
+
+  PetscFunctionBegin;
+  if (VecSeqUseThreads_Private(n)) {
+    ierr = VecMAXPY_SeqThreads(xin,nv,alpha,yin);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscLogFlops(nv*2.0*n);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nv,&y);CHKERRQ(ierr);
+  ierr = VecGetArray(xin,&x);CHKERRQ(ierr);
+  for (j=0; j<nv; j++) {ierr = VecGetArrayRead(yin[j],&y[j]);CHKERRQ(ierr);}
+  for (i=0; i<n; i+=PETSC_VEC_AVX_BLOCK) {
+    m = PetscMin(PETSC_VEC_AVX_BLOCK,n-i);
+    for (j=0; j+8<=nv; j+=8) VecMAXPY_AVX8_Private(m,x+i,alpha+j,y+j,i);
+    if (j+4<=nv) {VecMAXPY_AVX4_Private(m,x+i,alpha+j,y+j,i); j += 4;}
+    for (; j<nv; j++) VecMAXPY_AVX1_Private(m,x+i,alpha+j,y+j,i);
+  }
+  for (j=0; j<nv; j++) {ierr = VecRestoreArrayRead(yin[j],&y[j]);CHKERRQ(ierr);}
+  ierr = VecRestoreArray(xin,&x);CHKERRQ(ierr);
+  ierr = PetscFree(y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#else
 PetscErrorCode VecMAXPY_Seq(Vec xin, PetscInt nv,const PetscScalar *alpha,Vec *y)
 {
   PetscErrorCode    ierr;
@@ -565,6 +796,10 @@ PetscErrorCode VecMAXPY_Seq(Vec xin, PetscInt nv,const PetscScalar *alpha,Vec *y
 #endif
 
   PetscFunctionBegin;
+  if (VecSeqUseThreads_Private(n)) {
+    ierr = VecMAXPY_SeqThreads(xin,nv,alpha,y);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = PetscLogFlops(nv*2.0*n);CHKERRQ(ierr);
   ierr = VecGetArray(xin,&xx);CHKERRQ(ierr);
   switch (j_rem=nv&0x3) {
@@ -622,6 +857,7 @@ PetscErrorCode VecMAXPY_Seq(Vec xin, PetscInt nv,const PetscScalar *alpha,Vec *y
   ierr = VecRestoreArray(xin,&xx);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
+#endif
 
 #include <../src/vec/vec/impls/seq/ftn-kernels/faypx.h>
 
@@ -637,6 +873,9 @@ PetscErrorCode VecAYPX_Seq(Vec yin,PetscScalar alpha,Vec xin)
     ierr = VecCopy(xin,yin);CHKERRQ(ierr);
   } else if (alpha == (PetscScalar)1.0) {
     ierr = VecAXPY_Seq(yin,alpha,xin);CHKERRQ(ierr);
+  } else if (VecSeqUseThreads_Private(n)) {
+    ierr = VecAYPX_SeqThreads(yin,alpha,xin);CHKERRQ(ierr);
+    ierr = PetscLogFlops((alpha == (PetscScalar)-1.0 ? 1.0 : 2.0)*n);CHKERRQ(ierr);
   } else if (alpha == (PetscScalar)-1.0) {
     PetscInt i;
     ierr = VecGetArrayRead(xin,&xx);CHKERRQ(ierr);
@@ -684,6 +923,11 @@ PetscErrorCode VecWAXPY_Seq(Vec win, PetscScalar alpha,Vec xin,Vec yin)
   const PetscScalar  *yy,*xx;
 
   PetscFunctionBegin;
+  if (alpha != (PetscScalar)0.0 && VecSeqUseThreads_Private(n)) {
+    ierr = VecWAXPY_SeqThreads(win,alpha,xin,yin);CHKERRQ(ierr);
+    ierr = PetscLogFlops((alpha == (PetscScalar)1.0 || alpha == (PetscScalar)-1.0 ? 1.0 : 2.0)*n);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = VecGetArrayRead(xin,&xx);CHKERRQ(ierr);
   ierr = VecGetArrayRead(yin,&yy);CHKERRQ(ierr);
   ierr = VecGetArray(win,&ww);CHKERRQ(ierr);
@@ -0,0 +1,384 @@
+/*
+   Multi-threaded versions of the vector operations shared by sequential and parallel vectors, used by the _Seq
+  operations for vectors with at least VecSeqThreadsMinSize local entries when the thread pool has more than one thread.
+
+   Each thread works on the part of the arrays given by PetscThreadPoolGetRange(), the same in every operation, so
+  the pages of the arrays are placed by their first write in VecCreate_Seq() and VecCreate_MPI_Private() next to the
+  thread that uses them. Reductions are summed in a fixed order, so results do not vary from run to run.
+*/
+#include <../src/vec/vec/impls/dvecimpl.h>          /*I "petscvec.h" I*/
+
+/* set with -vec_threads_min_size in VecInitializePackage() */
+PetscInt VecSeqThreadsMinSize = 50000;
+
+typedef enum {VEC_THREADS_DOT,VEC_THREADS_MDOT,VEC_THREADS_NORM,VEC_THREADS_SET,VEC_THREADS_SCALE,VEC_THREADS_COPY,
+              VEC_THREADS_AXPY,VEC_THREADS_AYPX,VEC_THREADS_AXPBY,VEC_THREADS_AXPBYPCZ,VEC_THREADS_WAXPY,VEC_THREADS_MAXPY,
+              VEC_THREADS_PMULT,VEC_THREADS_PDIVIDE} VecThreadsOp;
+
+typedef struct {
+  VecThreadsOp       op;
+  PetscInt           n,nv;
+  PetscScalar        *w;                 /* the array written */
+  const PetscScalar  *x,*y;
+  const PetscScalar  **yv;               /* the nv arrays of VecMDot() and VecMAXPY() */
+  PetscScalar        alpha,beta,gamma;
+  const PetscScalar  *alphas;
+  NormType           type;
+  PetscInt           stride;             /* distance between the partial results of two threads, a multiple of a cache line */
+  PetscScalar        *sum;               /* partial results of the reductions, stride entries per thread */
+} VecThreadsCtx;
+
+static void VecThreadsKernel_Private(PetscInt tid,PetscInt nthreads,void *vctx)
+{
+  VecThreadsCtx     *ctx = (VecThreadsCtx*)vctx;
+  PetscScalar       *w   = ctx->w,alpha = ctx->alpha,beta = ctx->beta,gamma = ctx->gamma;
+  const PetscScalar *x   = ctx->x,*y = ctx->y;
+  PetscScalar       *sum = ctx->sum ? ctx->sum + tid*ctx->stride : NULL;
+  PetscInt          start,end,i,j;
+
+  PetscThreadPoolGetRange(ctx->n,tid,nthreads,&start,&end);
+  switch (ctx->op) {
+  case VEC_THREADS_DOT: {
+    PetscScalar s = 0.0;
+    for (i=start; i<end; i++) s += x[i]*PetscConj(y[i]);
+    sum[0] = s;
+  } break;
+  case VEC_THREADS_MDOT:
+    /* four vectors at a time, so that x is read once for each four */
+    for (j=0; j+4<=ctx->nv; j+=4) {
+      const PetscScalar *y0 = ctx->yv[j],*y1 = ctx->yv[j+1],*y2 = ctx->yv[j+2],*y3 = ctx->yv[j+3];
+      PetscScalar       s0 = 0.0,s1 = 0.0,s2 = 0.0,s3 = 0.0;
+      for (i=start; i<end; i++) {
+        const PetscScalar xi = x[i];
+        s0 += xi*PetscConj(y0[i]); s1 += xi*PetscConj(y1[i]); s2 += xi*PetscConj(y2[i]); s3 += xi*PetscConj(y3[i]);
+      }
+      sum[j] = s0; sum[j+1] = s1; sum[j+2] = s2; sum[j+3] = s3;
+    }
+    for (; j<ctx->nv; j++) {
+      const PetscScalar *y0 = ctx->yv[j];
+      PetscScalar       s0  = 0.0;
+      for (i=start; i<end; i++) s0 += x[i]*PetscConj(y0[i]);
+      sum[j] = s0;
+    }
+    break;
+  case VEC_THREADS_NORM: {
+    PetscReal s1 = 0.0,s2 = 0.0,mx = 0.0,tmp;
+    if (ctx->type == NORM_INFINITY) {
+      for (i=start; i<end; i++) {
+        if ((tmp = PetscAbsScalar(x[i])) > mx) mx = tmp;
+        /* check special case of tmp == NaN */
+        if (tmp != tmp) {mx = tmp; break;}
+      }
+      sum[0] = mx;
+    } else {
+      if (ctx->type != NORM_1) for (i=start; i<end; i++) s2 += PetscRealPart(x[i]*PetscConj(x[i]));
+      if (ctx->type == NORM_1 || ctx->type == NORM_1_AND_2) for (i=start; i<end; i++) s1 += PetscAbsScalar(x[i]);
+      sum[0] = s1; sum[1] = s2;
+    }
+  } break;
+  case VEC_THREADS_SET:
+    if (alpha == (PetscScalar)0.0) {
+      if (end > start) memset(w+start,0,(end-start)*sizeof(PetscScalar));
+    } else {
+      for (i=start; i<end; i++) w[i] = alpha;
+    }
+    break;
+  case VEC_THREADS_SCALE:
+    for (i=start; i<end; i++) w[i] *= alpha;
+    break;
+  case VEC_THREADS_COPY:
+    if (end > start) memcpy(w+start,x+start,(end-start)*sizeof(PetscScalar));
+    break;
+  case VEC_THREADS_AXPY:
+    for (i=start; i<end; i++) w[i] += alpha*x[i];
+    break;
+  case VEC_THREADS_AYPX:
+    for (i=start; i<end; i++) w[i] = x[i] + alpha*w[i];
+    break;
+  case VEC_THREADS_AXPBY:
+    if (beta == (PetscScalar)0.0) for (i=start; i<end; i++) w[i] = alpha*x[i];
+    else                          for (i=start; i<end; i++) w[i] = alpha*x[i] + beta*w[i];
+    break;
+  case VEC_THREADS_AXPBYPCZ:
+    if (gamma == (PetscScalar)0.0) for (i=start; i<end; i++) w[i] = alpha*x[i] + beta*y[i];
+    else                           for (i=start; i<end; i++) w[i] = alpha*x[i] + beta*y[i] + gamma*w[i];
+    break;
+  case VEC_THREADS_WAXPY:
+    for (i=start; i<end; i++) w[i] = y[i] + alpha*x[i];
+    break;
+  case VEC_THREADS_MAXPY:
+    for (j=0; j+4<=ctx->nv; j+=4) {
+      const PetscScalar *y0 = ctx->yv[j],*y1 = ctx->yv[j+1],*y2 = ctx->yv[j+2],*y3 = ctx->yv[j+3];
+      const PetscScalar a0  = ctx->alphas[j],a1 = ctx->alphas[j+1],a2 = ctx->alphas[j+2],a3 = ctx->alphas[j+3];
+      for (i=start; i<end; i++) w[i] += a0*y0[i] + a1*y1[i] + a2*y2[i] + a3*y3[i];
+    }
+    for (; j<ctx->nv; j++) {
+      const PetscScalar *y0 = ctx->yv[j],a0 = ctx->alphas[j];
+      for (i=start; i<end; i++) w[i] += a0*y0[i];
+    }
+    break;
+  case VEC_THREADS_PMULT:
+    for (i=start; i<end; i++) w[i] = x[i]*y[i];
+    break;
+  case VEC_THREADS_PDIVIDE:
+    for (i=start; i<end; i++) w[i] = y[i] != (PetscScalar)0.0 ? x[i]/y[i] : (PetscScalar)0.0;
+    break;
+  }
+}
+
+/* runs the operation on the pool; for reductions, sum[] receives the nresults results summed over the threads */
+static PetscErrorCode VecThreadsRun_Private(VecThreadsCtx *ctx,PetscInt nresults,PetscScalar result[])
+{
+  PetscInt       nthreads,t,j;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ctx->sum = NULL;
+  if (nresults) {
+    ierr        = PetscThreadPoolGetSize(&nthreads);CHKERRQ(ierr);
+    ctx->stride = ((nresults + 7)/8)*8;
+    ierr        = PetscMalloc1(nthreads*ctx->stride,&ctx->sum);CHKERRQ(ierr);
+  }
+  ierr = PetscThreadPoolRun(VecThreadsKernel_Private,ctx);CHKERRQ(ierr);
+  if (nresults) {
+    for (j=0; j<nresults; j++) {
+      result[j] = ctx->sum[j];
+      for (t=1; t<nthreads; t++) result[j] += ctx->sum[t*ctx->stride+j];
+    }
+    ierr = PetscFree(ctx->sum);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecDot_SeqThreads(Vec xin,Vec yin,PetscScalar *z)
+{
+  VecThreadsCtx  ctx;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ctx.op = VEC_THREADS_DOT;
+  ctx.n  = xin->map->n;
+  ierr   = VecGetArrayRead(xin,&ctx.x);CHKERRQ(ierr);
+  ierr   = VecGetArrayRead(yin,&ctx.y);CHKERRQ(ierr);
+  ierr   = VecThreadsRun_Private(&ctx,1,z);CHKERRQ(ierr);
+  ierr   = VecRestoreArrayRead(xin,&ctx.x);CHKERRQ(ierr);
+  ierr   = VecRestoreArrayRead(yin,&ctx.y);CHKERRQ(ierr);
+  ierr   = PetscLogFlops(2.0*ctx.n-1);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecMDot_SeqThreads(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
+{
+  VecThreadsCtx  ctx;
+  PetscInt       j;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ctx.op = VEC_THREADS_MDOT;
+  ctx.n  = xin->map->n;
+  ctx.nv = nv;
+  ierr   = PetscMalloc1(nv,&ctx.yv);CHKERRQ(ierr);
+  ierr   = VecGetArrayRead(xin,&ctx.x);CHKERRQ(ierr);
+  for (j=0; j<nv; j++) {ierr = VecGetArrayRead(yin[j],&ctx.yv[j]);CHKERRQ(ierr);}
+  ierr = VecThreadsRun_Private(&ctx,nv,z);CHKERRQ(ierr);
+  for (j=0; j<nv; j++) {ierr = VecRestoreArrayRead(yin[j],&ctx.yv[j]);CHKERRQ(ierr);}
+  ierr = VecRestoreArrayRead(xin,&ctx.x);CHKERRQ(ierr);
+  ierr = PetscFree(ctx.yv);CHKERRQ(ierr);
+  ierr = PetscLogFlops(PetscMax(nv*(2.0*ctx.n-1),0.0));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecNorm_SeqThreads(Vec xin,NormType type,PetscReal *z)
+{
+  VecThreadsCtx  ctx;
+  PetscScalar    sums[2];
+  PetscInt       nthreads,t;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ctx.op   = VEC_THREADS_NORM;
+  ctx.n    = xin->map->n;
+  ctx.type = type;
+  ierr     = VecGetArrayRead(xin,&ctx.x);CHKERRQ(ierr);
+  if (type == NORM_INFINITY) {
+    /* the maximum is not a sum, so it is taken from the partial results here */
+    ierr       = PetscThreadPoolGetSize(&nthreads);CHKERRQ(ierr);
+    ctx.stride = 8;
+    ierr       = PetscMalloc1(nthreads*ctx.stride,&ctx.sum);CHKERRQ(ierr);
+    ierr       = PetscThreadPoolRun(VecThreadsKernel_Private,&ctx);CHKERRQ(ierr);
+    *z         = PetscRealPart(ctx.sum[0]);
+    for (t=1; t<nthreads; t++) {
+      PetscReal tmp = PetscRealPart(ctx.sum[t*ctx.stride]);
+      if (*z != *z) break;
+      if (tmp > *z || tmp != tmp) *z = tmp;
+    }
+    ierr = PetscFree(ctx.sum);CHKERRQ(ierr);
+  } else {
+    ierr = VecThreadsRun_Private(&ctx,2,sums);CHKERRQ(ierr);
+    if (type == NORM_1) *z = PetscRealPart(sums[0]);
+    else if (type == NORM_1_AND_2) {z[0] = PetscRealPart(sums[0]); z[1] = PetscSqrtReal(PetscRealPart(sums[1]));}
+    else *z = PetscSqrtReal(PetscRealPart(sums[1]));
+    if (type == NORM_1_AND_2) {ierr = PetscLogFlops(PetscMax(3.0*ctx.n-2,0.0));CHKERRQ(ierr);}
+    else if (type == NORM_1)  {ierr = PetscLogFlops(PetscMax(ctx.n-1.0,0.0));CHKERRQ(ierr);}
+    else                      {ierr = PetscLogFlops(PetscMax(2.0*ctx.n-1,0.0));CHKERRQ(ierr);}
+  }
+  ierr = VecRestoreArrayRead(xin,&ctx.x);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* the operations w = f(alpha,beta,gamma,w,x,y), the flops are logged by the callers */
+static PetscErrorCode VecPointwise_SeqThreads(VecThreadsOp op,Vec win,PetscScalar alpha,PetscScalar beta,PetscScalar gamma,Vec xin,Vec yin)
+{
+  VecThreadsCtx  ctx;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ctx.op    = op;
+  ctx.n     = win->map->n;
+  ctx.alpha = alpha;
+  ctx.beta  = beta;
+  ctx.gamma = gamma;
+  ctx.x     = ctx.y = NULL;
+  if (xin) {ierr = VecGetArrayRead(xin,&ctx.x);CHKERRQ(ierr);}
+  if (yin) {ierr = VecGetArrayRead(yin,&ctx.y);CHKERRQ(ierr);}
+  ierr = VecGetArray(win,&ctx.w);CHKERRQ(ierr);
+  ierr = VecThreadsRun_Private(&ctx,0,NULL);CHKERRQ(ierr);
+  ierr = VecRestoreArray(win,&ctx.w);CHKERRQ(ierr);
+  if (xin) {ierr = VecRestoreArrayRead(xin,&ctx.x);CHKERRQ(ierr);}
+  if (yin) {ierr = VecRestoreArrayRead(yin,&ctx.y);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecSet_SeqThreads(Vec xin,PetscScalar alpha)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecPointwise_SeqThreads(VEC_THREADS_SET,xin,alpha,0.0,0.0,NULL,NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecScale_SeqThreads(Vec xin,PetscScalar alpha)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecPointwise_SeqThreads(VEC_THREADS_SCALE,xin,alpha,0.0,0.0,NULL,NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecCopy_SeqThreads(Vec xin,Vec yin)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecPointwise_SeqThreads(VEC_THREADS_COPY,yin,0.0,0.0,0.0,xin,NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecAXPY_SeqThreads(Vec yin,PetscScalar alpha,Vec xin)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecPointwise_SeqThreads(VEC_THREADS_AXPY,yin,alpha,0.0,0.0,xin,NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecAYPX_SeqThreads(Vec yin,PetscScalar alpha,Vec xin)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecPointwise_SeqThreads(VEC_THREADS_AYPX,yin,alpha,0.0,0.0,xin,NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecAXPBY_SeqThreads(Vec yin,PetscScalar alpha,PetscScalar beta,Vec xin)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecPointwise_SeqThreads(VEC_THREADS_AXPBY,yin,alpha,beta,0.0,xin,NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecAXPBYPCZ_SeqThreads(Vec zin,PetscScalar alpha,PetscScalar beta,PetscScalar gamma,Vec xin,Vec yin)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecPointwise_SeqThreads(VEC_THREADS_AXPBYPCZ,zin,alpha,beta,gamma,xin,yin);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecWAXPY_SeqThreads(Vec win,PetscScalar alpha,Vec xin,Vec yin)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecPointwise_SeqThreads(VEC_THREADS_WAXPY,win,alpha,0.0,0.0,xin,yin);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecPointwiseMult_SeqThreads(Vec win,Vec xin,Vec yin)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecPointwise_SeqThreads(VEC_THREADS_PMULT,win,0.0,0.0,0.0,xin,yin);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecPointwiseDivide_SeqThreads(Vec win,Vec xin,Vec yin)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecPointwise_SeqThreads(VEC_THREADS_PDIVIDE,win,0.0,0.0,0.0,xin,yin);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecMAXPY_SeqThreads(Vec xin,PetscInt nv,const PetscScalar *alpha,Vec *y)
+{
+  VecThreadsCtx  ctx;
+  PetscInt       j;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ctx.op     = VEC_THREADS_MAXPY;
+  ctx.n      = xin->map->n;
+  ctx.nv     = nv;
+  ctx.alphas = alpha;
+  ierr       = PetscMalloc1(nv,&ctx.yv);CHKERRQ(ierr);
+  for (j=0; j<nv; j++) {ierr = VecGetArrayRead(y[j],&ctx.yv[j]);CHKERRQ(ierr);}
+  ierr = VecGetArray(xin,&ctx.w);CHKERRQ(ierr);
+  ierr = VecThreadsRun_Private(&ctx,0,NULL);CHKERRQ(ierr);
+  ierr = VecRestoreArray(xin,&ctx.w);CHKERRQ(ierr);
+  for (j=0; j<nv; j++) {ierr = VecRestoreArrayRead(y[j],&ctx.yv[j]);CHKERRQ(ierr);}
+  ierr = PetscFree(ctx.yv);CHKERRQ(ierr);
+  ierr = PetscLogFlops(nv*2.0*ctx.n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   VecSeqThreadsZero_Private - Zeros a newly allocated array of a vector, with the threads of the pool if it is large
+   so that each page is first written by the thread that will work on it
+*/
+PetscErrorCode VecSeqThreadsZero_Private(PetscScalar *array,PetscInt n)
+{
+  VecThreadsCtx  ctx;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!VecSeqUseThreads_Private(n)) {
+    ierr = PetscMemzero(array,n*sizeof(PetscScalar));CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ctx.op    = VEC_THREADS_SET;
+  ctx.n     = n;
+  ctx.alpha = 0.0;
+  ctx.w     = array;
+  ierr      = VecThreadsRun_Private(&ctx,0,NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
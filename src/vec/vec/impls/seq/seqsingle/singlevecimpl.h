@@ -0,0 +1,27 @@
+/*
+   Private data structure of the VECSEQSINGLE and VECMPISINGLE vectors, whose entries are stored in single precision;
+   it is kept in the spptr of a Vec_Seq or Vec_MPI that has no array of its own.
+*/
+#if !defined(__SINGLEVECIMPL)
+#define __SINGLEVECIMPL
+
+#include <../src/vec/vec/impls/dvecimpl.h>
+
+typedef struct {
+  float       *values;   /* the local entries */
+  PetscScalar *array;    /* the local entries converted to PetscScalar while an array obtained with VecGetArray() is in use */
+  PetscInt    narray;    /* number of VecGetArray() and VecGetArrayRead() not yet restored */
+  PetscBool   modified;  /* the array was obtained with VecGetArray(), so it is copied back to the values when restored */
+} Vec_Single;
+
+PETSC_INTERN PetscErrorCode VecSingleSetUp_Private(Vec);
+PETSC_INTERN PetscErrorCode VecSingleDestroy_Private(Vec);
+PETSC_INTERN PetscErrorCode VecDot_SeqSingle(Vec,Vec,PetscScalar*);
+PETSC_INTERN PetscErrorCode VecTDot_SeqSingle(Vec,Vec,PetscScalar*);
+PETSC_INTERN PetscErrorCode VecMDot_SeqSingle(Vec,PetscInt,const Vec[],PetscScalar*);
+PETSC_INTERN PetscErrorCode VecMTDot_SeqSingle(Vec,PetscInt,const Vec[],PetscScalar*);
+PETSC_INTERN PetscErrorCode VecNorm_SeqSingle(Vec,NormType,PetscReal*);
+PETSC_EXTERN PetscErrorCode VecCreate_SeqSingle(Vec);
+PETSC_EXTERN PetscErrorCode VecCreate_MPISingle(Vec);
+
+#endif
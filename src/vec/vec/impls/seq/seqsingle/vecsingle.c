@@ -0,0 +1,464 @@
+/*
+   Sequential vectors whose entries are stored in single precision while the operations are done in PetscScalar.
+   They halve the memory and the memory traffic of vectors, such as Krylov bases, that need less accuracy than the
+   arithmetic done with them.
+*/
+#include <../src/vec/vec/impls/seq/seqsingle/singlevecimpl.h>   /*I "petscvec.h" I*/
+
+/*
+   Gets the values of a vector stored in single precision, or NULL if the vector is of another type or its array is
+   in use, in which case the operations fall back to the VECSEQ ones that work on the array
+*/
+static PetscErrorCode VecSingleGetValues_Private(Vec v,float **values)
+{
+  PetscBool      single;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr    = PetscObjectTypeCompareAny((PetscObject)v,&single,VECSEQSINGLE,VECMPISINGLE,"");CHKERRQ(ierr);
+  *values = (single && !((Vec_Single*)v->spptr)->narray) ? ((Vec_Single*)v->spptr)->values : NULL;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecGetArray_SeqSingle(Vec v,PetscScalar **a)
+{
+  Vec_Single     *s = (Vec_Single*)v->spptr;
+  PetscInt       i,n = v->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!s->narray) {
+    ierr = PetscMalloc1(n,&s->array);CHKERRQ(ierr);
+    for (i=0; i<n; i++) s->array[i] = s->values[i];
+  }
+  s->narray++;
+  s->modified = PETSC_TRUE;
+  *a          = s->array;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecGetArrayRead_SeqSingle(Vec v,const PetscScalar **a)
+{
+  Vec_Single     *s = (Vec_Single*)v->spptr;
+  PetscInt       i,n = v->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!s->narray) {
+    ierr = PetscMalloc1(n,&s->array);CHKERRQ(ierr);
+    for (i=0; i<n; i++) s->array[i] = s->values[i];
+  }
+  s->narray++;
+  *a = s->array;
+  PetscFunctionReturn(0);
+}
+
+/* the last restore copies a modified array back to the values and frees it */
+static PetscErrorCode VecRestoreArray_SeqSingle(Vec v,PetscScalar **a)
+{
+  Vec_Single     *s = (Vec_Single*)v->spptr;
+  PetscInt       i,n = v->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!s->narray) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Vector array restored more times than it was obtained");
+  if (--s->narray) PetscFunctionReturn(0);
+  if (s->modified) {
+    for (i=0; i<n; i++) s->values[i] = (float)PetscRealPart(s->array[i]);
+    s->modified = PETSC_FALSE;
+  }
+  ierr = PetscFree(s->array);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecRestoreArrayRead_SeqSingle(Vec v,const PetscScalar **a)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecRestoreArray_SeqSingle(v,(PetscScalar**)a);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecDot_SeqSingle(Vec xin,Vec yin,PetscScalar *z)
+{
+  float          *x,*y;
+  PetscScalar    sum = 0.0;
+  PetscInt       i,n = xin->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecSingleGetValues_Private(xin,&x);CHKERRQ(ierr);
+  ierr = VecSingleGetValues_Private(yin,&y);CHKERRQ(ierr);
+  if (!x || !y) {
+    ierr = VecDot_Seq(xin,yin,z);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  for (i=0; i<n; i++) sum += (PetscScalar)x[i]*y[i];
+  *z   = sum;
+  ierr = PetscLogFlops(PetscMax(2.0*n-1,0.0));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecTDot_SeqSingle(Vec xin,Vec yin,PetscScalar *z)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  /* the entries are real */
+  ierr = VecDot_SeqSingle(xin,yin,z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecMDot_SeqSingle(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
+{
+  float          *x,*y0,*y1,*y2,*y3;
+  PetscScalar    sum0,sum1,sum2,sum3,xi;
+  PetscInt       i,j,k,n = xin->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecSingleGetValues_Private(xin,&x);CHKERRQ(ierr);
+  for (j=0; j<nv && x; j++) {
+    ierr = VecSingleGetValues_Private(yin[j],&y0);CHKERRQ(ierr);
+    if (!y0) x = NULL;
+  }
+  if (!x) {
+    ierr = VecMDot_Seq(xin,nv,yin,z);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  /* x is read once for four vectors */
+  for (j=0; j+4<=nv; j+=4) {
+    y0   = ((Vec_Single*)yin[j]->spptr)->values;
+    y1   = ((Vec_Single*)yin[j+1]->spptr)->values;
+    y2   = ((Vec_Single*)yin[j+2]->spptr)->values;
+    y3   = ((Vec_Single*)yin[j+3]->spptr)->values;
+    sum0 = sum1 = sum2 = sum3 = 0.0;
+    for (i=0; i<n; i++) {
+      xi    = x[i];
+      sum0 += xi*y0[i];
+      sum1 += xi*y1[i];
+      sum2 += xi*y2[i];
+      sum3 += xi*y3[i];
+    }
+    z[j] = sum0; z[j+1] = sum1; z[j+2] = sum2; z[j+3] = sum3;
+  }
+  for (k=j; k<nv; k++) {
+    y0   = ((Vec_Single*)yin[k]->spptr)->values;
+    sum0 = 0.0;
+    for (i=0; i<n; i++) sum0 += (PetscScalar)x[i]*y0[i];
+    z[k] = sum0;
+  }
+  ierr = PetscLogFlops(PetscMax(nv*(2.0*n-1),0.0));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecMTDot_SeqSingle(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecMDot_SeqSingle(xin,nv,yin,z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecNorm_SeqSingle(Vec xin,NormType type,PetscReal *z)
+{
+  float          *x;
+  PetscReal      sum = 0.0,max = 0.0,tmp;
+  PetscInt       i,n = xin->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecSingleGetValues_Private(xin,&x);CHKERRQ(ierr);
+  if (!x) {
+    ierr = VecNorm_Seq(xin,type,z);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (type == NORM_2 || type == NORM_FROBENIUS) {
+    for (i=0; i<n; i++) sum += (PetscReal)x[i]*x[i];
+    *z   = PetscSqrtReal(sum);
+    ierr = PetscLogFlops(PetscMax(2.0*n-1,0.0));CHKERRQ(ierr);
+  } else if (type == NORM_INFINITY) {
+    for (i=0; i<n; i++) {
+      if ((tmp = PetscAbsReal(x[i])) > max) max = tmp;
+      /* check special case of tmp == NaN */
+      if (tmp != tmp) {max = tmp; break;}
+    }
+    *z = max;
+  } else if (type == NORM_1) {
+    for (i=0; i<n; i++) sum += PetscAbsReal(x[i]);
+    *z   = sum;
+    ierr = PetscLogFlops(PetscMax(n-1.0,0.0));CHKERRQ(ierr);
+  } else if (type == NORM_1_AND_2) {
+    ierr = VecNorm_SeqSingle(xin,NORM_1,z);CHKERRQ(ierr);
+    ierr = VecNorm_SeqSingle(xin,NORM_2,z+1);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecSet_SeqSingle(Vec xin,PetscScalar alpha)
+{
+  float          *x,a = (float)PetscRealPart(alpha);
+  PetscInt       i,n = xin->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecSingleGetValues_Private(xin,&x);CHKERRQ(ierr);
+  if (!x) {
+    ierr = VecSet_Seq(xin,alpha);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  for (i=0; i<n; i++) x[i] = a;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecScale_SeqSingle(Vec xin,PetscScalar alpha)
+{
+  float          *x;
+  PetscInt       i,n = xin->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (alpha == (PetscScalar)0.0) {
+    ierr = VecSet_SeqSingle(xin,alpha);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (alpha == (PetscScalar)1.0) PetscFunctionReturn(0);
+  ierr = VecSingleGetValues_Private(xin,&x);CHKERRQ(ierr);
+  if (!x) {
+    ierr = VecScale_Seq(xin,alpha);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  for (i=0; i<n; i++) x[i] = (float)PetscRealPart(alpha*x[i]);
+  ierr = PetscLogFlops(n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* also copies between single precision and other vectors without converting the whole array twice */
+static PetscErrorCode VecCopy_SeqSingle(Vec xin,Vec yin)
+{
+  float          *x,*y;
+  PetscScalar    *ya;
+  PetscInt       i,n = xin->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecSingleGetValues_Private(xin,&x);CHKERRQ(ierr);
+  ierr = VecSingleGetValues_Private(yin,&y);CHKERRQ(ierr);
+  if (x && y) {
+    ierr = PetscMemcpy(y,x,n*sizeof(float));CHKERRQ(ierr);
+  } else if (x) {
+    ierr = VecGetArray(yin,&ya);CHKERRQ(ierr);
+    for (i=0; i<n; i++) ya[i] = x[i];
+    ierr = VecRestoreArray(yin,&ya);CHKERRQ(ierr);
+  } else {
+    ierr = VecCopy_Seq(xin,yin);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecAXPY_SeqSingle(Vec yin,PetscScalar alpha,Vec xin)
+{
+  float          *x,*y;
+  PetscInt       i,n = yin->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (alpha == (PetscScalar)0.0) PetscFunctionReturn(0);
+  ierr = VecSingleGetValues_Private(xin,&x);CHKERRQ(ierr);
+  ierr = VecSingleGetValues_Private(yin,&y);CHKERRQ(ierr);
+  if (!x || !y) {
+    ierr = VecAXPY_Seq(yin,alpha,xin);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  for (i=0; i<n; i++) y[i] = (float)PetscRealPart(y[i] + alpha*x[i]);
+  ierr = PetscLogFlops(2.0*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecAYPX_SeqSingle(Vec yin,PetscScalar alpha,Vec xin)
+{
+  float          *x,*y;
+  PetscInt       i,n = yin->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecSingleGetValues_Private(xin,&x);CHKERRQ(ierr);
+  ierr = VecSingleGetValues_Private(yin,&y);CHKERRQ(ierr);
+  if (!x || !y) {
+    ierr = VecAYPX_Seq(yin,alpha,xin);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  for (i=0; i<n; i++) y[i] = (float)PetscRealPart(x[i] + alpha*y[i]);
+  ierr = PetscLogFlops(2.0*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecAXPBY_SeqSingle(Vec yin,PetscScalar alpha,PetscScalar beta,Vec xin)
+{
+  float          *x,*y;
+  PetscInt       i,n = yin->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecSingleGetValues_Private(xin,&x);CHKERRQ(ierr);
+  ierr = VecSingleGetValues_Private(yin,&y);CHKERRQ(ierr);
+  if (!x || !y) {
+    ierr = VecAXPBY_Seq(yin,alpha,beta,xin);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  for (i=0; i<n; i++) y[i] = (float)PetscRealPart(alpha*x[i] + beta*y[i]);
+  ierr = PetscLogFlops(3.0*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecWAXPY_SeqSingle(Vec win,PetscScalar alpha,Vec xin,Vec yin)
+{
+  float          *w,*x,*y;
+  PetscInt       i,n = win->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecSingleGetValues_Private(win,&w);CHKERRQ(ierr);
+  ierr = VecSingleGetValues_Private(xin,&x);CHKERRQ(ierr);
+  ierr = VecSingleGetValues_Private(yin,&y);CHKERRQ(ierr);
+  if (!w || !x || !y) {
+    ierr = VecWAXPY_Seq(win,alpha,xin,yin);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  for (i=0; i<n; i++) w[i] = (float)PetscRealPart(alpha*x[i] + y[i]);
+  ierr = PetscLogFlops(2.0*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecMAXPY_SeqSingle(Vec yin,PetscInt nv,const PetscScalar *alpha,Vec *xin)
+{
+  float          *y,*x0,*x1,*x2,*x3;
+  PetscScalar    a0,a1,a2,a3;
+  PetscInt       i,j,n = yin->map->n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecSingleGetValues_Private(yin,&y);CHKERRQ(ierr);
+  for (j=0; j<nv && y; j++) {
+    ierr = VecSingleGetValues_Private(xin[j],&x0);CHKERRQ(ierr);
+    if (!x0) y = NULL;
+  }
+  if (!y) {
+    ierr = VecMAXPY_Seq(yin,nv,alpha,xin);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  /* y is read and written once for four vectors */
+  for (j=0; j+4<=nv; j+=4) {
+    x0 = ((Vec_Single*)xin[j]->spptr)->values;   a0 = alpha[j];
+    x1 = ((Vec_Single*)xin[j+1]->spptr)->values; a1 = alpha[j+1];
+    x2 = ((Vec_Single*)xin[j+2]->spptr)->values; a2 = alpha[j+2];
+    x3 = ((Vec_Single*)xin[j+3]->spptr)->values; a3 = alpha[j+3];
+    for (i=0; i<n; i++) y[i] = (float)PetscRealPart(y[i] + a0*x0[i] + a1*x1[i] + a2*x2[i] + a3*x3[i]);
+  }
+  for (; j<nv; j++) {
+    x0 = ((Vec_Single*)xin[j]->spptr)->values; a0 = alpha[j];
+    for (i=0; i<n; i++) y[i] = (float)PetscRealPart(y[i] + a0*x0[i]);
+  }
+  ierr = PetscLogFlops(nv*2.0*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecDestroy_SeqSingle(Vec v)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecSingleDestroy_Private(v);CHKERRQ(ierr);
+  ierr = VecDestroy_Seq(v);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecSingleDestroy_Private(Vec v)
+{
+  Vec_Single     *s = (Vec_Single*)v->spptr;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!s) PetscFunctionReturn(0);
+  ierr     = PetscFree(s->array);CHKERRQ(ierr);
+  ierr     = PetscFree(s->values);CHKERRQ(ierr);
+  ierr     = PetscFree(v->spptr);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   VecSingleSetUp_Private - Allocates the single precision values of a VECSEQ or VECMPI vector created without an
+   array and sets the operations shared by VECSEQSINGLE and VECMPISINGLE
+*/
+PetscErrorCode VecSingleSetUp_Private(Vec v)
+{
+  Vec_Single     *s;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscNewLog(v,&s);CHKERRQ(ierr);
+  ierr = PetscCalloc1(v->map->n,&s->values);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)v,v->map->n*sizeof(float));CHKERRQ(ierr);
+  v->spptr       = (void*)s;
+  v->petscnative = PETSC_FALSE;
+
+  v->ops->getarray         = VecGetArray_SeqSingle;
+  v->ops->restorearray     = VecRestoreArray_SeqSingle;
+  v->ops->getarrayread     = VecGetArrayRead_SeqSingle;
+  v->ops->restorearrayread = VecRestoreArrayRead_SeqSingle;
+  v->ops->placearray       = NULL;
+  v->ops->replacearray     = NULL;
+  v->ops->resetarray       = NULL;
+  v->ops->dot              = VecDot_SeqSingle;
+  v->ops->tdot             = VecTDot_SeqSingle;
+  v->ops->mdot             = VecMDot_SeqSingle;
+  v->ops->mtdot            = VecMTDot_SeqSingle;
+  v->ops->norm             = VecNorm_SeqSingle;
+  v->ops->set              = VecSet_SeqSingle;
+  v->ops->scale            = VecScale_SeqSingle;
+  v->ops->copy             = VecCopy_SeqSingle;
+  v->ops->axpy             = VecAXPY_SeqSingle;
+  v->ops->aypx             = VecAYPX_SeqSingle;
+  v->ops->axpby            = VecAXPBY_SeqSingle;
+  v->ops->waxpy            = VecWAXPY_SeqSingle;
+  v->ops->maxpy            = VecMAXPY_SeqSingle;
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   VECSEQSINGLE - VECSEQSINGLE = "seqsingle" - The sequential vector whose entries are stored in single precision
+
+   Options Database Keys:
+. -vec_type seqsingle - sets the vector type to VECSEQSINGLE during a call to VecSetFromOptions()
+
+   Notes:
+   The reductions are accumulated and the updates computed in PetscScalar, only the storage is in single precision, so
+   these vectors need half the memory and half the memory traffic of VECSEQ vectors, with a relative accuracy of about
+   1e-7 for each entry. VecDot(), VecMDot(), VecNorm(), VecScale(), VecSet(), VecCopy(), VecAXPY(), VecAYPX(),
+   VecAXPBY(), VecWAXPY() and VecMAXPY() work directly on the single precision entries when all the vectors are of this
+   type; the other operations, and VecGetArray(), convert the entries to a temporary PetscScalar array, which is
+   copied back when the array is restored. VecPlaceArray() and VecReplaceArray() are not supported.
+
+   Only available with real scalars.
+
+   Level: intermediate
+
+.seealso: VecCreate(), VecSetType(), VECSINGLE, VECMPISINGLE, VECSEQ, KSPGMRESSetSinglePrecisionBasis()
+M*/
+
+PETSC_EXTERN PetscErrorCode VecCreate_SeqSingle(Vec V)
+{
+  PetscMPIInt    size;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)V),&size);CHKERRQ(ierr);
+  if (size > 1) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Cannot create VECSEQSINGLE on more than one process");
+  ierr = VecCreate_Seq_Private(V,NULL);CHKERRQ(ierr);
+  ierr = VecSingleSetUp_Private(V);CHKERRQ(ierr);
+  V->ops->destroy = VecDestroy_SeqSingle;
+  ierr = PetscObjectChangeTypeName((PetscObject)V,VECSEQSINGLE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -1,5 +1,6 @@
 
 #include <petsc/private/vecimpl.h>
+#include <../src/vec/vec/impls/dvecimpl.h>
 #include <petsc/private/isimpl.h>
 #include <petscpf.h>
 #include <petscsf.h>
@@ -234,6 +235,9 @@ PetscErrorCode  VecInitializePackage(void)
     if (pkg) {ierr = PetscLogEventExcludeClass(VEC_SCATTER_CLASSID);CHKERRQ(ierr);}
   }
 
+  /* Process the smallest local size of the vectors whose operations are multi-threaded */
+  ierr = PetscOptionsGetInt(NULL,NULL,"-vec_threads_min_size",&VecSeqThreadsMinSize,NULL);CHKERRQ(ierr);
+
   /*
     Create the special MPI reduction operation that may be used by VecNorm/DotBegin()
   */
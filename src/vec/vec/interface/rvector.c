@@ -118,6 +118,12 @@ PetscErrorCode  VecDot(Vec x,Vec y,PetscScalar *val)
   PetscCheckSameTypeAndComm(x,1,y,2);
   VecCheckSameSize(x,1,y,2);
 
+  if (VecReductionsDeferred) {
+    PetscBool deferred;
+
+    ierr = VecDotDeferred_Private(x,y,val,&deferred);CHKERRQ(ierr);
+    if (deferred) PetscFunctionReturn(0);
+  }
   ierr = PetscLogEventBegin(VEC_Dot,x,y,0,0);CHKERRQ(ierr);
   ierr = (*x->ops->dot)(x,y,val);CHKERRQ(ierr);
   ierr = PetscLogEventEnd(VEC_Dot,x,y,0,0);CHKERRQ(ierr);
@@ -164,6 +170,7 @@ PetscErrorCode  VecDotRealPart(Vec x,Vec y,PetscReal *val)
 
   PetscFunctionBegin;
   ierr = VecDot(x,y,&fdot);CHKERRQ(ierr);
+  if (VecReductionsDeferred) {ierr = PetscCommFlushDeferredReductions(PetscObjectComm((PetscObject)x));CHKERRQ(ierr);}
   *val = PetscRealPart(fdot);
   PetscFunctionReturn(0);
 }
@@ -223,6 +230,12 @@ PetscErrorCode  VecNorm(Vec x,NormType type,PetscReal *val)
     ierr = PetscObjectComposedDataGetReal((PetscObject)x,NormIds[type],*val,flg);CHKERRQ(ierr);
     if (flg) PetscFunctionReturn(0);
   }
+  if (VecReductionsDeferred) {
+    PetscBool deferred;
+
+    ierr = VecNormDeferred_Private(x,type,val,&deferred);CHKERRQ(ierr);
+    if (deferred) PetscFunctionReturn(0);
+  }
   ierr = PetscLogEventBegin(VEC_Norm,x,0,0,0);CHKERRQ(ierr);
   ierr = (*x->ops->norm)(x,type,val);CHKERRQ(ierr);
   ierr = PetscLogEventEnd(VEC_Norm,x,0,0,0);CHKERRQ(ierr);
@@ -316,6 +329,7 @@ PetscErrorCode  VecNormalize(Vec x,PetscReal *val)
   PetscValidType(x,1);
   ierr = PetscLogEventBegin(VEC_Normalize,x,0,0,0);CHKERRQ(ierr);
   ierr = VecNorm(x,NORM_2,&norm);CHKERRQ(ierr);
+  if (VecReductionsDeferred) {ierr = PetscCommFlushDeferredReductions(PetscObjectComm((PetscObject)x));CHKERRQ(ierr);}
   if (norm == 0.0) {
     ierr = PetscInfo(x,"Vector of zero norm can not be normalized; Returning only the zero norm\n");CHKERRQ(ierr);
   } else if (norm != 1.0) {
@@ -444,6 +458,12 @@ PetscErrorCode  VecTDot(Vec x,Vec y,PetscScalar *val)
   PetscCheckSameTypeAndComm(x,1,y,2);
   VecCheckSameSize(x,1,y,2);
 
+  if (VecReductionsDeferred) {
+    PetscBool deferred;
+
+    ierr = VecTDotDeferred_Private(x,y,val,&deferred);CHKERRQ(ierr);
+    if (deferred) PetscFunctionReturn(0);
+  }
   ierr = PetscLogEventBegin(VEC_TDot,x,y,0,0);CHKERRQ(ierr);
   ierr = (*x->ops->tdot)(x,y,val);CHKERRQ(ierr);
   ierr = PetscLogEventEnd(VEC_TDot,x,y,0,0);CHKERRQ(ierr);
@@ -1132,6 +1152,12 @@ PetscErrorCode  VecMTDot(Vec x,PetscInt nv,const Vec y[],PetscScalar val[])
   PetscCheckSameTypeAndComm(x,2,*y,3);
   VecCheckSameSize(x,1,*y,3);
 
+  if (VecReductionsDeferred) {
+    PetscBool deferred;
+
+    ierr = VecMTDotDeferred_Private(x,nv,y,val,&deferred);CHKERRQ(ierr);
+    if (deferred) PetscFunctionReturn(0);
+  }
   ierr = PetscLogEventBegin(VEC_MTDot,x,*y,0,0);CHKERRQ(ierr);
   ierr = (*x->ops->mtdot)(x,nv,y,val);CHKERRQ(ierr);
   ierr = PetscLogEventEnd(VEC_MTDot,x,*y,0,0);CHKERRQ(ierr);
@@ -1183,6 +1209,12 @@ PetscErrorCode  VecMDot(Vec x,PetscInt nv,const Vec y[],PetscScalar val[])
   PetscCheckSameTypeAndComm(x,2,*y,3);
   VecCheckSameSize(x,1,*y,3);
 
+  if (VecReductionsDeferred) {
+    PetscBool deferred;
+
+    ierr = VecMDotDeferred_Private(x,nv,y,val,&deferred);CHKERRQ(ierr);
+    if (deferred) PetscFunctionReturn(0);
+  }
   ierr = PetscLogEventBegin(VEC_MDot,x,*y,0,0);CHKERRQ(ierr);
   ierr = (*x->ops->mdot)(x,nv,y,val);CHKERRQ(ierr);
   ierr = PetscLogEventEnd(VEC_MDot,x,*y,0,0);CHKERRQ(ierr);
@@ -18,6 +18,11 @@ PETSC_EXTERN PetscErrorCode VecCreate_SeqCUDA(Vec);
 PETSC_EXTERN PetscErrorCode VecCreate_MPICUDA(Vec);
 PETSC_EXTERN PetscErrorCode VecCreate_CUDA(Vec);
 #endif
+#if !defined(PETSC_USE_COMPLEX)
+PETSC_EXTERN PetscErrorCode VecCreate_SeqSingle(Vec);
+PETSC_EXTERN PetscErrorCode VecCreate_MPISingle(Vec);
+PETSC_EXTERN PetscErrorCode VecCreate_Single(Vec);
+#endif
 
 /*@C
   VecRegisterAll - Registers all of the vector components in the Vec package.
@@ -53,6 +58,11 @@ PetscErrorCode VecRegisterAll(void)
   ierr = VecRegister(VECSEQCUDA,    VecCreate_SeqCUDA);CHKERRQ(ierr);
   ierr = VecRegister(VECMPICUDA,    VecCreate_MPICUDA);CHKERRQ(ierr);
   ierr = VecRegister(VECCUDA,       VecCreate_CUDA);CHKERRQ(ierr);
+#endif
+#if !defined(PETSC_USE_COMPLEX)
+  ierr = VecRegister(VECSEQSINGLE,  VecCreate_SeqSingle);CHKERRQ(ierr);
+  ierr = VecRegister(VECMPISINGLE,  VecCreate_MPISingle);CHKERRQ(ierr);
+  ierr = VecRegister(VECSINGLE,     VecCreate_Single);CHKERRQ(ierr);
 #endif
   PetscFunctionReturn(0);
 }
@@ -65,6 +65,9 @@ static PetscErrorCode  PetscSplitReductionCreate(MPI_Comm comm,PetscSplitReducti
   (*sr)->comm        = comm;
   (*sr)->request     = MPI_REQUEST_NULL;
   ierr               = PetscMalloc1(32,&(*sr)->reducetype);CHKERRQ(ierr);
+  ierr               = PetscMalloc2(32,&(*sr)->results,32,&(*sr)->resulttype);CHKERRQ(ierr);
+  (*sr)->defer       = 0;
+  (*sr)->numdeferred = 0;
   (*sr)->async       = PETSC_FALSE;
 #if defined(PETSC_HAVE_MPI_IALLREDUCE) || defined(PETSC_HAVE_MPIX_IALLREDUCE)
   (*sr)->async = PETSC_TRUE;    /* Enable by default */
@@ -129,6 +132,9 @@ PetscErrorCode PetscCommSplitReductionBegin(MPI_Comm comm)
 
   PetscFunctionBegin;
   ierr = PetscSplitReductionGet(comm,&sr);CHKERRQ(ierr);
+  if (sr->numdeferred) {
+    ierr = PetscSplitReductionFlush(sr);CHKERRQ(ierr);
+  }
   if (sr->numopsend > 0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Cannot call this after VecxxxEnd() has been called");
   if (sr->async) {              /* Bad reuse, setup code copied from PetscSplitReductionApply(). */
     PetscInt       i,numops = sr->numopsbegin,*reducetype = sr->reducetype;
@@ -178,6 +184,9 @@ PetscErrorCode PetscSplitReductionEnd(PetscSplitReduction *sr)
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
+  if (sr->numdeferred) {
+    ierr = PetscSplitReductionFlush(sr);CHKERRQ(ierr);
+  }
   switch (sr->state) {
   case STATE_BEGIN: /* We are doing synchronous communication and this is the first call to VecXxxEnd() so do the communication */
     ierr = PetscSplitReductionApply(sr);CHKERRQ(ierr);
@@ -251,7 +260,8 @@ PetscErrorCode  PetscSplitReductionExtend(PetscSplitReduction *sr)
   PetscErrorCode ierr;
   PetscInt       maxops   = sr->maxops,*reducetype = sr->reducetype;
   PetscScalar    *lvalues = sr->lvalues,*gvalues = sr->gvalues;
-  void           *invecs  = sr->invecs;
+  void           *invecs  = sr->invecs,**results = sr->results;
+  PetscInt       *resulttype = sr->resulttype;
 
   PetscFunctionBegin;
   sr->maxops     = 2*maxops;
@@ -259,14 +269,18 @@ PetscErrorCode  PetscSplitReductionExtend(PetscSplitReduction *sr)
   ierr = PetscMalloc1(2*2*maxops,&sr->gvalues);CHKERRQ(ierr);
   ierr = PetscMalloc1(2*maxops,&sr->reducetype);CHKERRQ(ierr);
   ierr = PetscMalloc1(2*maxops,&sr->invecs);CHKERRQ(ierr);
+  ierr = PetscMalloc2(2*maxops,&sr->results,2*maxops,&sr->resulttype);CHKERRQ(ierr);
   ierr = PetscMemcpy(sr->lvalues,lvalues,maxops*sizeof(PetscScalar));CHKERRQ(ierr);
   ierr = PetscMemcpy(sr->gvalues,gvalues,maxops*sizeof(PetscScalar));CHKERRQ(ierr);
   ierr = PetscMemcpy(sr->reducetype,reducetype,maxops*sizeof(PetscInt));CHKERRQ(ierr);
   ierr = PetscMemcpy(sr->invecs,invecs,maxops*sizeof(void*));CHKERRQ(ierr);
+  ierr = PetscMemcpy(sr->results,results,maxops*sizeof(void*));CHKERRQ(ierr);
+  ierr = PetscMemcpy(sr->resulttype,resulttype,maxops*sizeof(PetscInt));CHKERRQ(ierr);
   ierr = PetscFree(lvalues);CHKERRQ(ierr);
   ierr = PetscFree(gvalues);CHKERRQ(ierr);
   ierr = PetscFree(reducetype);CHKERRQ(ierr);
   ierr = PetscFree(invecs);CHKERRQ(ierr);
+  ierr = PetscFree2(results,resulttype);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -279,6 +293,7 @@ PetscErrorCode  PetscSplitReductionDestroy(PetscSplitReduction *sr)
   ierr = PetscFree(sr->gvalues);CHKERRQ(ierr);
   ierr = PetscFree(sr->reducetype);CHKERRQ(ierr);
   ierr = PetscFree(sr->invecs);CHKERRQ(ierr);
+  ierr = PetscFree2(sr->results,sr->resulttype);CHKERRQ(ierr);
   ierr = PetscFree(sr);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -361,6 +376,9 @@ PetscErrorCode  VecDotBegin(Vec x,Vec y,PetscScalar *result)
   PetscValidHeaderSpecific(y,VEC_CLASSID,1);
   ierr = PetscObjectGetComm((PetscObject)x,&comm);CHKERRQ(ierr);
   ierr = PetscSplitReductionGet(comm,&sr);CHKERRQ(ierr);
+  if (sr->numdeferred) {
+    ierr = PetscSplitReductionFlush(sr);CHKERRQ(ierr);
+  }
   if (sr->state != STATE_BEGIN) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Called before all VecxxxEnd() called");
   if (sr->numopsbegin >= sr->maxops) {
     ierr = PetscSplitReductionExtend(sr);CHKERRQ(ierr);
@@ -444,6 +462,9 @@ PetscErrorCode  VecTDotBegin(Vec x,Vec y,PetscScalar *result)
   PetscFunctionBegin;
   ierr = PetscObjectGetComm((PetscObject)x,&comm);CHKERRQ(ierr);
   ierr = PetscSplitReductionGet(comm,&sr);CHKERRQ(ierr);
+  if (sr->numdeferred) {
+    ierr = PetscSplitReductionFlush(sr);CHKERRQ(ierr);
+  }
   if (sr->state != STATE_BEGIN) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Called before all VecxxxEnd() called");
   if (sr->numopsbegin >= sr->maxops) {
     ierr = PetscSplitReductionExtend(sr);CHKERRQ(ierr);
@@ -514,6 +535,9 @@ PetscErrorCode  VecNormBegin(Vec x,NormType ntype,PetscReal *result)
   PetscValidHeaderSpecific(x,VEC_CLASSID,1);
   ierr = PetscObjectGetComm((PetscObject)x,&comm);CHKERRQ(ierr);
   ierr = PetscSplitReductionGet(comm,&sr);CHKERRQ(ierr);
+  if (sr->numdeferred) {
+    ierr = PetscSplitReductionFlush(sr);CHKERRQ(ierr);
+  }
   if (sr->state != STATE_BEGIN) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Called before all VecxxxEnd() called");
   if (sr->numopsbegin >= sr->maxops || (sr->numopsbegin == sr->maxops-1 && ntype == NORM_1_AND_2)) {
     ierr = PetscSplitReductionExtend(sr);CHKERRQ(ierr);
@@ -624,6 +648,9 @@ PetscErrorCode  VecMDotBegin(Vec x,PetscInt nv,const Vec y[],PetscScalar result[
   PetscFunctionBegin;
   ierr = PetscObjectGetComm((PetscObject)x,&comm);CHKERRQ(ierr);
   ierr = PetscSplitReductionGet(comm,&sr);CHKERRQ(ierr);
+  if (sr->numdeferred) {
+    ierr = PetscSplitReductionFlush(sr);CHKERRQ(ierr);
+  }
   if (sr->state != STATE_BEGIN) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Called before all VecxxxEnd() called");
   for (i=0; i<nv; i++) {
     if (sr->numopsbegin+i >= sr->maxops) {
@@ -716,6 +743,9 @@ PetscErrorCode  VecMTDotBegin(Vec x,PetscInt nv,const Vec y[],PetscScalar result
   PetscFunctionBegin;
   ierr = PetscObjectGetComm((PetscObject)x,&comm);CHKERRQ(ierr);
   ierr = PetscSplitReductionGet(comm,&sr);CHKERRQ(ierr);
+  if (sr->numdeferred) {
+    ierr = PetscSplitReductionFlush(sr);CHKERRQ(ierr);
+  }
   if (sr->state != STATE_BEGIN) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Called before all VecxxxEnd() called");
   for (i=0; i<nv; i++) {
     if (sr->numopsbegin+i >= sr->maxops) {
@@ -762,3 +792,301 @@ PetscErrorCode  VecMTDotEnd(Vec x,PetscInt nv,const Vec y[],PetscScalar result[]
   ierr = VecMDotEnd(x,nv,y,result);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
+
+/* ----------------------------------------------------------------------------------------------------*/
+/*
+     Deferred reductions: while PetscCommDeferReductionsBegin() is active on a communicator the blocking VecDot(),
+   VecTDot(), VecMDot(), VecMTDot() and VecNorm() only compute their local part and queue it in the split reduction
+   of the communicator, along with where the result goes. The queue is flushed with a single reduction.
+*/
+
+typedef enum {PETSC_SR_RESULT_SCALAR,PETSC_SR_RESULT_REAL,PETSC_SR_RESULT_SQRT} PetscSRResultType;
+
+PetscInt VecReductionsDeferred = 0;
+
+/*
+   PetscSplitReductionFlush - Does the reduction of the deferred entries and writes their results
+*/
+PetscErrorCode PetscSplitReductionFlush(PetscSplitReduction *sr)
+{
+  PetscErrorCode ierr;
+  PetscInt       i;
+  PetscMPIInt    size;
+
+  PetscFunctionBegin;
+  if (!sr->numdeferred) PetscFunctionReturn(0);
+  ierr = PetscSplitReductionApply(sr);CHKERRQ(ierr);
+  for (i=0; i<sr->numopsbegin; i++) {
+    switch (sr->resulttype[i]) {
+    case PETSC_SR_RESULT_SCALAR: *(PetscScalar*)sr->results[i] = sr->gvalues[i]; break;
+    case PETSC_SR_RESULT_REAL:   *(PetscReal*)sr->results[i]   = PetscRealPart(sr->gvalues[i]); break;
+    case PETSC_SR_RESULT_SQRT:   *(PetscReal*)sr->results[i]   = PetscSqrtReal(PetscRealPart(sr->gvalues[i])); break;
+    default: SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Error in PetscSplitReduction() data structure, probably memory corruption");
+    }
+  }
+  ierr = MPI_Comm_size(sr->comm,&size);CHKERRQ(ierr);
+  if (size > 1) {
+#if defined(PETSC_USE_LOG)
+    petsc_allreduce_merged_ct += sr->numdeferred - 1;
+#endif
+    ierr = PetscInfo2(0,"Merged %D deferred reductions into one in an MPI_Comm %ld\n",sr->numdeferred,(long)sr->comm);CHKERRQ(ierr);
+  }
+  sr->state       = STATE_BEGIN;
+  sr->numopsbegin = 0;
+  sr->numopsend   = 0;
+  sr->numdeferred = 0;
+  PetscFunctionReturn(0);
+}
+
+/*
+   VecDeferredReserve - Returns the split reduction with room for n more entries if the reductions of x are deferred, else NULL
+
+   Reductions are not deferred while split phase VecxxxBegin()/VecxxxEnd() are outstanding on the communicator.
+*/
+static PetscErrorCode VecDeferredReserve(Vec x,PetscInt n,PetscSplitReduction **sr)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSplitReductionGet(PetscObjectComm((PetscObject)x),sr);CHKERRQ(ierr);
+  if (!(*sr)->defer || (*sr)->state != STATE_BEGIN || (!(*sr)->numdeferred && (*sr)->numopsbegin)) {
+    *sr = NULL;
+    PetscFunctionReturn(0);
+  }
+  while ((*sr)->numopsbegin + n > (*sr)->maxops) {
+    ierr = PetscSplitReductionExtend(*sr);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   VecDeferredQueue - Records the n entries just computed from x at the end of the split reduction
+*/
+static PetscErrorCode VecDeferredQueue(PetscSplitReduction *sr,Vec x,PetscInt n,PetscSRReductionType reducetype,void *result,size_t size,PetscSRResultType resulttype)
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+  for (i=0; i<n; i++) {
+    sr->reducetype[sr->numopsbegin] = reducetype;
+    sr->invecs[sr->numopsbegin]     = (void*)x;
+    sr->results[sr->numopsbegin]    = (char*)result + i*size;
+    sr->resulttype[sr->numopsbegin] = resulttype;
+    sr->numopsbegin++;
+  }
+  sr->numdeferred++;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecDotDeferred_Private(Vec x,Vec y,PetscScalar *result,PetscBool *deferred)
+{
+  PetscErrorCode      ierr;
+  PetscSplitReduction *sr;
+
+  PetscFunctionBegin;
+  *deferred = PETSC_FALSE;
+  if (!x->ops->dot_local) PetscFunctionReturn(0);
+  ierr = VecDeferredReserve(x,1,&sr);CHKERRQ(ierr);
+  if (!sr) PetscFunctionReturn(0);
+  ierr = PetscLogEventBegin(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+  ierr = (*x->ops->dot_local)(x,y,sr->lvalues+sr->numopsbegin);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+  ierr = VecDeferredQueue(sr,x,1,PETSC_SR_REDUCE_SUM,result,sizeof(PetscScalar),PETSC_SR_RESULT_SCALAR);CHKERRQ(ierr);
+  *deferred = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecTDotDeferred_Private(Vec x,Vec y,PetscScalar *result,PetscBool *deferred)
+{
+  PetscErrorCode      ierr;
+  PetscSplitReduction *sr;
+
+  PetscFunctionBegin;
+  *deferred = PETSC_FALSE;
+  if (!x->ops->tdot_local) PetscFunctionReturn(0);
+  ierr = VecDeferredReserve(x,1,&sr);CHKERRQ(ierr);
+  if (!sr) PetscFunctionReturn(0);
+  ierr = PetscLogEventBegin(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+  ierr = (*x->ops->tdot_local)(x,y,sr->lvalues+sr->numopsbegin);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+  ierr = VecDeferredQueue(sr,x,1,PETSC_SR_REDUCE_SUM,result,sizeof(PetscScalar),PETSC_SR_RESULT_SCALAR);CHKERRQ(ierr);
+  *deferred = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecMDotDeferred_Private(Vec x,PetscInt nv,const Vec y[],PetscScalar result[],PetscBool *deferred)
+{
+  PetscErrorCode      ierr;
+  PetscSplitReduction *sr;
+
+  PetscFunctionBegin;
+  *deferred = PETSC_FALSE;
+  if (!x->ops->mdot_local) PetscFunctionReturn(0);
+  ierr = VecDeferredReserve(x,nv,&sr);CHKERRQ(ierr);
+  if (!sr) PetscFunctionReturn(0);
+  ierr = PetscLogEventBegin(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+  ierr = (*x->ops->mdot_local)(x,nv,y,sr->lvalues+sr->numopsbegin);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+  ierr = VecDeferredQueue(sr,x,nv,PETSC_SR_REDUCE_SUM,result,sizeof(PetscScalar),PETSC_SR_RESULT_SCALAR);CHKERRQ(ierr);
+  *deferred = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecMTDotDeferred_Private(Vec x,PetscInt nv,const Vec y[],PetscScalar result[],PetscBool *deferred)
+{
+  PetscErrorCode      ierr;
+  PetscSplitReduction *sr;
+
+  PetscFunctionBegin;
+  *deferred = PETSC_FALSE;
+  if (!x->ops->mtdot_local) PetscFunctionReturn(0);
+  ierr = VecDeferredReserve(x,nv,&sr);CHKERRQ(ierr);
+  if (!sr) PetscFunctionReturn(0);
+  ierr = PetscLogEventBegin(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+  ierr = (*x->ops->mtdot_local)(x,nv,y,sr->lvalues+sr->numopsbegin);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+  ierr = VecDeferredQueue(sr,x,nv,PETSC_SR_REDUCE_SUM,result,sizeof(PetscScalar),PETSC_SR_RESULT_SCALAR);CHKERRQ(ierr);
+  *deferred = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/*
+   The deferred norms are not cached in the vector since the vector may change before the queue is flushed
+*/
+PetscErrorCode VecNormDeferred_Private(Vec x,NormType ntype,PetscReal *result,PetscBool *deferred)
+{
+  PetscErrorCode      ierr;
+  PetscSplitReduction *sr;
+  PetscReal           lresult[2];
+
+  PetscFunctionBegin;
+  *deferred = PETSC_FALSE;
+  if (!x->ops->norm_local) PetscFunctionReturn(0);
+  ierr = VecDeferredReserve(x,ntype == NORM_1_AND_2 ? 2 : 1,&sr);CHKERRQ(ierr);
+  if (!sr) PetscFunctionReturn(0);
+  if (ntype == NORM_FROBENIUS) ntype = NORM_2;
+  ierr = PetscLogEventBegin(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+  ierr = (*x->ops->norm_local)(x,ntype,lresult);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(VEC_ReduceArithmetic,0,0,0,0);CHKERRQ(ierr);
+  if (ntype == NORM_2) {
+    sr->lvalues[sr->numopsbegin] = lresult[0]*lresult[0];
+    ierr = VecDeferredQueue(sr,x,1,PETSC_SR_REDUCE_SUM,result,sizeof(PetscReal),PETSC_SR_RESULT_SQRT);CHKERRQ(ierr);
+  } else if (ntype == NORM_1_AND_2) {
+    sr->lvalues[sr->numopsbegin]   = lresult[0];
+    sr->lvalues[sr->numopsbegin+1] = lresult[1]*lresult[1];
+    ierr = VecDeferredQueue(sr,x,2,PETSC_SR_REDUCE_SUM,result,sizeof(PetscReal),PETSC_SR_RESULT_REAL);CHKERRQ(ierr);
+    sr->resulttype[sr->numopsbegin-1] = PETSC_SR_RESULT_SQRT;
+  } else {
+    sr->lvalues[sr->numopsbegin] = lresult[0];
+    ierr = VecDeferredQueue(sr,x,1,ntype == NORM_MAX ? PETSC_SR_REDUCE_MAX : PETSC_SR_REDUCE_SUM,result,sizeof(PetscReal),PETSC_SR_RESULT_REAL);CHKERRQ(ierr);
+  }
+  *deferred = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   PetscCommDeferReductionsBegin - Starts a region in which the blocking vector reductions on a communicator are queued
+   and later done together in a single reduction
+
+   Collective on MPI_Comm
+
+   Input Parameter:
+.  comm - the communicator of the vectors
+
+   Level: advanced
+
+   Notes:
+   Until the matching PetscCommDeferReductionsEnd() or a call to PetscCommFlushDeferredReductions(), VecDot(), VecTDot(),
+   VecMDot(), VecMTDot() and VecNorm() on vectors of this communicator only compute their local contribution and return;
+   the results are written when the queue is flushed. The values must therefore not be used, and the locations given for
+   them must remain valid, until then. This allows code that calls several independent blocking reductions in a row to
+   pay for the latency of one reduction without being rewritten with VecDotBegin()/VecDotEnd().
+
+   A split phase VecxxxBegin() on the communicator flushes the queue first, so the two forms can be mixed. VecNormalize()
+   and VecDotRealPart() flush the queue since they need their result. Other routines that use the value of a reduction
+   internally should not be called inside the region. Norms computed while deferring are not cached in the vectors.
+   Vector types that do not provide the local reductions are not deferred.
+
+   The number of reductions saved this way is reported as "MPI Reductions Merged" by -log_view, and each flush is
+   reported with -info.
+
+   The regions may be nested; only the outermost PetscCommDeferReductionsEnd() flushes.
+
+.seealso: PetscCommDeferReductionsEnd(), PetscCommFlushDeferredReductions(), VecDotBegin(), VecNormBegin(), PetscCommSplitReductionBegin()
+@*/
+PetscErrorCode PetscCommDeferReductionsBegin(MPI_Comm comm)
+{
+  PetscErrorCode      ierr;
+  PetscSplitReduction *sr;
+  MPI_Comm            icomm;
+
+  PetscFunctionBegin;
+  /* the reference to the inner communicator is kept until PetscCommDeferReductionsEnd() so the queue outlives the vectors */
+  ierr = PetscCommDuplicate(comm,&icomm,NULL);CHKERRQ(ierr);
+  ierr = PetscSplitReductionGet(icomm,&sr);CHKERRQ(ierr);
+  if (!sr->defer++) VecReductionsDeferred++;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   PetscCommDeferReductionsEnd - Ends a region started with PetscCommDeferReductionsBegin(), computing the queued reductions
+
+   Collective on MPI_Comm
+
+   Input Parameter:
+.  comm - the communicator of the vectors
+
+   Level: advanced
+
+.seealso: PetscCommDeferReductionsBegin(), PetscCommFlushDeferredReductions()
+@*/
+PetscErrorCode PetscCommDeferReductionsEnd(MPI_Comm comm)
+{
+  PetscErrorCode      ierr;
+  PetscSplitReduction *sr;
+  MPI_Comm            icomm,bcomm;
+
+  PetscFunctionBegin;
+  ierr = PetscCommDuplicate(comm,&icomm,NULL);CHKERRQ(ierr);
+  ierr = PetscSplitReductionGet(icomm,&sr);CHKERRQ(ierr);
+  if (!sr->defer) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Must call PetscCommDeferReductionsBegin() first");
+  if (!--sr->defer) {
+    ierr = PetscSplitReductionFlush(sr);CHKERRQ(ierr);
+    VecReductionsDeferred--;
+  }
+  /* release the reference taken here and the one taken by PetscCommDeferReductionsBegin() */
+  bcomm = icomm;
+  ierr  = PetscCommDestroy(&icomm);CHKERRQ(ierr);
+  ierr  = PetscCommDestroy(&bcomm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   PetscCommFlushDeferredReductions - Computes the reductions queued since PetscCommDeferReductionsBegin() so that
+   their results can be used
+
+   Collective on MPI_Comm
+
+   Input Parameter:
+.  comm - the communicator of the vectors
+
+   Level: advanced
+
+   Notes:
+   Reductions called after this are queued again until the region ends.
+
+.seealso: PetscCommDeferReductionsBegin(), PetscCommDeferReductionsEnd()
+@*/
+PetscErrorCode PetscCommFlushDeferredReductions(MPI_Comm comm)
+{
+  PetscErrorCode      ierr;
+  PetscSplitReduction *sr;
+  MPI_Comm            icomm;
+
+  PetscFunctionBegin;
+  ierr = PetscCommDuplicate(comm,&icomm,NULL);CHKERRQ(ierr);
+  ierr = PetscSplitReductionGet(icomm,&sr);CHKERRQ(ierr);
+  ierr = PetscSplitReductionFlush(sr);CHKERRQ(ierr);
+  ierr = PetscCommDestroy(&icomm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
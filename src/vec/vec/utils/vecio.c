@@ -8,6 +8,7 @@
 #include <petscsys.h>
 #include <petscvec.h>         /*I  "petscvec.h"  I*/
 #include <petsc/private/vecimpl.h>
+#include <../src/vec/vec/impls/mpi/pvecimpl.h>
 #include <petscviewerhdf5.h>
 
 static PetscErrorCode PetscViewerBinaryReadVecHeader_Private(PetscViewer viewer,PetscInt *rows)
@@ -29,56 +30,46 @@ static PetscErrorCode PetscViewerBinaryReadVecHeader_Private(PetscViewer viewer,
   PetscFunctionReturn(0);
 }
 
-#if defined(PETSC_HAVE_MPIIO)
-static PetscErrorCode VecLoad_Binary_MPIIO(Vec vec, PetscViewer viewer)
+/*
+   VecLoadMapped_Private - Reads the values of a VECSEQ or VECMPI vector in place in a memory mapping of the file, if the viewer provides one
+
+   The mapping replaces the array of the vector, as if the vector had been created with it, so that VecPlaceArray() and
+   VecResetArray() work as usual; it is released with the vector.
+*/
+static PetscErrorCode VecLoadMapped_Private(Vec vec,PetscViewer viewer,PetscBool *mapped)
 {
+  Vec_MPI        *v = (Vec_MPI*)vec->data;
+  PetscScalar    *avec = NULL;
+  PetscContainer mapping;
+  PetscBool      isseq,ismpi;
   PetscErrorCode ierr;
-  PetscMPIInt    lsize;
-  PetscScalar    *avec;
-  MPI_File       mfdes;
-  MPI_Offset     off;
 
   PetscFunctionBegin;
-  ierr = VecGetArray(vec,&avec);CHKERRQ(ierr);
-  ierr = PetscMPIIntCast(vec->map->n,&lsize);CHKERRQ(ierr);
-
-  ierr = PetscViewerBinaryGetMPIIODescriptor(viewer,&mfdes);CHKERRQ(ierr);
-  ierr = PetscViewerBinaryGetMPIIOOffset(viewer,&off);CHKERRQ(ierr);
-  off += vec->map->rstart*sizeof(PetscScalar);
-  ierr = MPI_File_set_view(mfdes,off,MPIU_SCALAR,MPIU_SCALAR,(char*)"native",MPI_INFO_NULL);CHKERRQ(ierr);
-  ierr = MPIU_File_read_all(mfdes,avec,lsize,MPIU_SCALAR,MPI_STATUS_IGNORE);CHKERRQ(ierr);
-  ierr = PetscViewerBinaryAddMPIIOOffset(viewer,vec->map->N*sizeof(PetscScalar));CHKERRQ(ierr);
-
-  ierr = VecRestoreArray(vec,&avec);CHKERRQ(ierr);
-  ierr = VecAssemblyBegin(vec);CHKERRQ(ierr);
-  ierr = VecAssemblyEnd(vec);CHKERRQ(ierr);
+  *mapped = PETSC_FALSE;
+  ierr = PetscObjectTypeCompare((PetscObject)vec,VECSEQ,&isseq);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)vec,VECMPI,&ismpi);CHKERRQ(ierr);
+  if (!isseq && !(ismpi && !v->localrep)) PetscFunctionReturn(0);
+  if (v->unplacedarray) PetscFunctionReturn(0);
+  ierr = PetscViewerBinaryReadMapped(viewer,vec->map->n,PETSC_SCALAR,(void**)&avec,&mapping);CHKERRQ(ierr);
+  if (!avec) PetscFunctionReturn(0);
+  /* Vec_Seq and Vec_MPI share the array fields of VECHEADER */
+  ierr = PetscFree(v->array_allocated);CHKERRQ(ierr);
+  v->array = avec;
+  ierr = PetscObjectCompose((PetscObject)vec,"VecLoad_mapping",(PetscObject)mapping);CHKERRQ(ierr);
+  *mapped = PETSC_TRUE;
   PetscFunctionReturn(0);
 }
-#endif
 
 PetscErrorCode VecLoad_Binary(Vec vec, PetscViewer viewer)
 {
-  PetscMPIInt    size,rank,tag;
-  int            fd;
-  PetscInt       i,rows = 0,n,*range,N,bs;
+  PetscInt       rows = 0,N,bs;
   PetscErrorCode ierr;
-  PetscBool      flag,skipheader;
-  PetscScalar    *avec,*avecwork;
-  MPI_Comm       comm;
-  MPI_Request    request;
-  MPI_Status     status;
-#if defined(PETSC_HAVE_MPIIO)
-  PetscBool      useMPIIO;
-#endif
+  PetscBool      flag,skipheader,mapped;
+  PetscScalar    *avec;
 
   PetscFunctionBegin;
   /* force binary viewer to load .info file if it has not yet done so */
   ierr = PetscViewerSetUp(viewer);CHKERRQ(ierr);
-  ierr = PetscObjectGetComm((PetscObject)viewer,&comm);CHKERRQ(ierr);
-  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
-  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
-
-  ierr = PetscViewerBinaryGetDescriptor(viewer,&fd);CHKERRQ(ierr);
   ierr = PetscViewerBinaryGetSkipHeader(viewer,&skipheader);CHKERRQ(ierr);
   if (!skipheader) {
     ierr = PetscViewerBinaryReadVecHeader_Private(viewer,&rows);CHKERRQ(ierr);
@@ -103,41 +94,14 @@ PetscErrorCode VecLoad_Binary(Vec vec, PetscViewer viewer)
   ierr = VecGetSize(vec, &N);CHKERRQ(ierr);
   if (N != rows) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED, "Vector in file different length (%D) then input vector (%D)", rows, N);
 
-#if defined(PETSC_HAVE_MPIIO)
-  ierr = PetscViewerBinaryGetUseMPIIO(viewer,&useMPIIO);CHKERRQ(ierr);
-  if (useMPIIO) {
-    ierr = VecLoad_Binary_MPIIO(vec, viewer);CHKERRQ(ierr);
-    PetscFunctionReturn(0);
-  }
-#endif
-
-  ierr = VecGetLocalSize(vec,&n);CHKERRQ(ierr);
-  ierr = PetscObjectGetNewTag((PetscObject)viewer,&tag);CHKERRQ(ierr);
-  ierr = VecGetArray(vec,&avec);CHKERRQ(ierr);
-  if (!rank) {
-    ierr = PetscBinaryRead(fd,avec,n,PETSC_SCALAR);CHKERRQ(ierr);
-
-    if (size > 1) {
-      /* read in other chuncks and send to other processors */
-      /* determine maximum chunck owned by other */
-      range = vec->map->range;
-      n = 1;
-      for (i=1; i<size; i++) n = PetscMax(n,range[i+1] - range[i]);
-
-      ierr = PetscMalloc1(n,&avecwork);CHKERRQ(ierr);
-      for (i=1; i<size; i++) {
-        n    = range[i+1] - range[i];
-        ierr = PetscBinaryRead(fd,avecwork,n,PETSC_SCALAR);CHKERRQ(ierr);
-        ierr = MPI_Isend(avecwork,n,MPIU_SCALAR,i,tag,comm,&request);CHKERRQ(ierr);
-        ierr = MPI_Wait(&request,&status);CHKERRQ(ierr);
-      }
-      ierr = PetscFree(avecwork);CHKERRQ(ierr);
-    }
-  } else {
-    ierr = MPI_Recv(avec,n,MPIU_SCALAR,0,tag,comm,&status);CHKERRQ(ierr);
+  /* on one process the values may be used in place in a memory mapping of the file */
+  ierr = VecLoadMapped_Private(vec,viewer,&mapped);CHKERRQ(ierr);
+  if (!mapped) {
+    /* each process reads its own segment, in parallel when the viewer uses MPI-IO */
+    ierr = VecGetArray(vec,&avec);CHKERRQ(ierr);
+    ierr = PetscViewerBinaryReadAll(viewer,avec,vec->map->n,vec->map->rstart,N,PETSC_SCALAR);CHKERRQ(ierr);
+    ierr = VecRestoreArray(vec,&avec);CHKERRQ(ierr);
   }
-
-  ierr = VecRestoreArray(vec,&avec);CHKERRQ(ierr);
   ierr = VecAssemblyBegin(vec);CHKERRQ(ierr);
   ierr = VecAssemblyEnd(vec);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -0,0 +1,667 @@
+/*
+      Vector programs: a short sequence of vector updates and reductions, such as the ones ending an iteration of
+   a Krylov method, that is recorded and then executed in one pass over the vectors, with the reductions queued in
+   the split phase reduction of the communicator (see comb.c).
+
+       Usage:
+             VecProgramAXPY(prog,x,alpha,p);
+             VecProgramAXPY(prog,r,-alpha,w);
+             VecProgramNorm(prog,r,NORM_2,&rnorm);
+             VecProgramBegin(prog);
+             ....
+             VecProgramEnd(prog);
+*/
+#include <../src/vec/vec/impls/dvecimpl.h>    /*I   "petscvec.h"    I*/
+
+/* number of entries of each vector processed by one operation before the next operation, small enough that the
+   entries of all the vectors of a program stay in the L1 cache */
+#define VEC_PROGRAM_BLOCK 256
+
+typedef enum {VEC_PROGRAM_AXPY,VEC_PROGRAM_AYPX,VEC_PROGRAM_AXPBY,VEC_PROGRAM_AXPBYPCZ,VEC_PROGRAM_WAXPY,
+              VEC_PROGRAM_DOT,VEC_PROGRAM_TDOT,VEC_PROGRAM_NORM} VecProgramOpType;
+
+typedef struct {
+  VecProgramOpType type;
+  Vec              w,x,y;             /* w is written, x and y are read; reductions have no w */
+  PetscInt         iw,ix,iy;          /* indices of w, x and y in the list of vectors of the program */
+  PetscScalar      alpha,beta,gamma;
+  NormType         ntype;
+  PetscInt         slot;              /* index of the first local result of a reduction */
+  void             *result;
+} VecProgramOp;
+
+struct _n_VecProgram {
+  PetscInt     nops,maxops;
+  VecProgramOp *ops;
+  PetscInt     nvecs,maxvecs;
+  Vec          *vecs;                 /* the distinct vectors of the program */
+  PetscBool    *written;
+  PetscInt     nreductions;           /* number of local results of the reductions */
+  PetscBool    begun;
+};
+
+/*@C
+   VecProgramCreate - Creates an empty vector program
+
+   Not Collective
+
+   Output Parameter:
+.  prog - the vector program
+
+   Notes:
+   A vector program records vector updates such as VecProgramAXPY() and reductions such as VecProgramDot() and
+   VecProgramNorm(). VecProgramBegin() executes them in one pass over the vectors, instead of one pass for each
+   operation, and starts the reductions together with the other split phase reductions, such as VecDotBegin(), on
+   the same communicator. VecProgramEnd() gives the results of the reductions and empties the program so that it can
+   record the operations of the next iteration.
+
+   Level: advanced
+
+.seealso: VecProgramDestroy(), VecProgramBegin(), VecProgramEnd(), VecDotBegin(), PetscCommSplitReductionBegin()
+@*/
+PetscErrorCode VecProgramCreate(VecProgram *prog)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidPointer(prog,1);
+  ierr = PetscNew(prog);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   VecProgramDestroy - Destroys a vector program
+
+   Not Collective
+
+   Input Parameter:
+.  prog - the vector program
+
+   Level: advanced
+
+.seealso: VecProgramCreate()
+@*/
+PetscErrorCode VecProgramDestroy(VecProgram *prog)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!*prog) PetscFunctionReturn(0);
+  ierr = PetscFree((*prog)->ops);CHKERRQ(ierr);
+  ierr = PetscFree2((*prog)->vecs,(*prog)->written);CHKERRQ(ierr);
+  ierr = PetscFree(*prog);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* returns the index of v in the list of vectors of the program, adding it if needed */
+static PetscErrorCode VecProgramAddVec_Private(VecProgram prog,Vec v,PetscBool write,PetscInt *idx)
+{
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (prog->nvecs && v->map->n != prog->vecs[0]->map->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_INCOMP,"Vectors of a program must have the same local size, %D and %D",v->map->n,prog->vecs[0]->map->n);
+  for (i=0; i<prog->nvecs; i++) if (prog->vecs[i] == v) break;
+  if (i == prog->nvecs) {
+    if (prog->nvecs == prog->maxvecs) {
+      Vec       *vecs;
+      PetscBool *written;
+
+      ierr = PetscMalloc2(2*prog->maxvecs+8,&vecs,2*prog->maxvecs+8,&written);CHKERRQ(ierr);
+      ierr = PetscMemcpy(vecs,prog->vecs,prog->nvecs*sizeof(Vec));CHKERRQ(ierr);
+      ierr = PetscMemcpy(written,prog->written,prog->nvecs*sizeof(PetscBool));CHKERRQ(ierr);
+      ierr = PetscFree2(prog->vecs,prog->written);CHKERRQ(ierr);
+      prog->vecs    = vecs;
+      prog->written = written;
+      prog->maxvecs = 2*prog->maxvecs+8;
+    }
+    prog->vecs[i]    = v;
+    prog->written[i] = PETSC_FALSE;
+    prog->nvecs++;
+  }
+  if (write) prog->written[i] = PETSC_TRUE;
+  *idx = i;
+  PetscFunctionReturn(0);
+}
+
+/* appends an operation w = f(x,y) to the program */
+static PetscErrorCode VecProgramAddOp_Private(VecProgram prog,VecProgramOpType type,Vec w,Vec x,Vec y,PetscScalar alpha,PetscScalar beta,PetscScalar gamma,VecProgramOp **op)
+{
+  VecProgramOp   *o;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (prog->begun) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Cannot record operations between VecProgramBegin() and VecProgramEnd()");
+  if (w && prog->nreductions) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Vector updates must be recorded before the reductions of a program");
+  if (prog->nops == prog->maxops) {
+    VecProgramOp *ops;
+
+    ierr = PetscMalloc1(2*prog->maxops+8,&ops);CHKERRQ(ierr);
+    ierr = PetscMemcpy(ops,prog->ops,prog->nops*sizeof(VecProgramOp));CHKERRQ(ierr);
+    ierr = PetscFree(prog->ops);CHKERRQ(ierr);
+    prog->ops    = ops;
+    prog->maxops = 2*prog->maxops+8;
+  }
+  o        = &prog->ops[prog->nops++];
+  o->type  = type;
+  o->w     = w;
+  o->x     = x;
+  o->y     = y;
+  o->iw    = o->ix = o->iy = -1;
+  o->alpha = alpha;
+  o->beta  = beta;
+  o->gamma = gamma;
+  if (x) {ierr = VecProgramAddVec_Private(prog,x,PETSC_FALSE,&o->ix);CHKERRQ(ierr);}
+  if (y) {ierr = VecProgramAddVec_Private(prog,y,PETSC_FALSE,&o->iy);CHKERRQ(ierr);}
+  if (w) {ierr = VecProgramAddVec_Private(prog,w,PETSC_TRUE,&o->iw);CHKERRQ(ierr);}
+  if (op) *op = o;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   VecProgramAXPY - Records y = alpha x + y in a vector program
+
+   Logically Collective on Vec
+
+   Input Parameters:
++  prog - the vector program
+.  y - the vector updated
+.  alpha - the scalar
+-  x - the other vector
+
+   Level: advanced
+
+.seealso: VecAXPY(), VecProgramCreate(), VecProgramBegin()
+@*/
+PetscErrorCode VecProgramAXPY(VecProgram prog,Vec y,PetscScalar alpha,Vec x)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidPointer(prog,1);
+  PetscValidHeaderSpecific(y,VEC_CLASSID,2);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,4);
+  PetscValidLogicalCollectiveScalar(y,alpha,3);
+  if (x == y) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_IDN,"x and y cannot be the same vector");
+  ierr = VecProgramAddOp_Private(prog,VEC_PROGRAM_AXPY,y,x,NULL,alpha,0.0,0.0,NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   VecProgramAYPX - Records y = x + beta y in a vector program
+
+   Logically Collective on Vec
+
+   Input Parameters:
++  prog - the vector program
+.  y - the vector updated
+.  beta - the scalar
+-  x - the other vector
+
+   Level: advanced
+
+.seealso: VecAYPX(), VecProgramCreate(), VecProgramBegin()
+@*/
+PetscErrorCode VecProgramAYPX(VecProgram prog,Vec y,PetscScalar beta,Vec x)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidPointer(prog,1);
+  PetscValidHeaderSpecific(y,VEC_CLASSID,2);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,4);
+  PetscValidLogicalCollectiveScalar(y,beta,3);
+  if (x == y) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_IDN,"x and y cannot be the same vector");
+  ierr = VecProgramAddOp_Private(prog,VEC_PROGRAM_AYPX,y,x,NULL,beta,0.0,0.0,NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   VecProgramAXPBY - Records y = alpha x + beta y in a vector program
+
+   Logically Collective on Vec
+
+   Input Parameters:
++  prog - the vector program
+.  y - the vector updated
+.  alpha - the first scalar
+.  beta - the second scalar
+-  x - the other vector
+
+   Level: advanced
+
+.seealso: VecAXPBY(), VecProgramCreate(), VecProgramBegin()
+@*/
+PetscErrorCode VecProgramAXPBY(VecProgram prog,Vec y,PetscScalar alpha,PetscScalar beta,Vec x)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidPointer(prog,1);
+  PetscValidHeaderSpecific(y,VEC_CLASSID,2);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,5);
+  PetscValidLogicalCollectiveScalar(y,alpha,3);
+  PetscValidLogicalCollectiveScalar(y,beta,4);
+  if (x == y) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_IDN,"x and y cannot be the same vector");
+  ierr = VecProgramAddOp_Private(prog,VEC_PROGRAM_AXPBY,y,x,NULL,alpha,beta,0.0,NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   VecProgramAXPBYPCZ - Records z = alpha x + beta y + gamma z in a vector program
+
+   Logically Collective on Vec
+
+   Input Parameters:
++  prog - the vector program
+.  z - the vector updated
+.  alpha - the first scalar
+.  beta - the second scalar
+.  gamma - the third scalar
+.  x - the first vector
+-  y - the second vector
+
+   Level: advanced
+
+.seealso: VecAXPBYPCZ(), VecProgramCreate(), VecProgramBegin()
+@*/
+PetscErrorCode VecProgramAXPBYPCZ(VecProgram prog,Vec z,PetscScalar alpha,PetscScalar beta,PetscScalar gamma,Vec x,Vec y)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidPointer(prog,1);
+  PetscValidHeaderSpecific(z,VEC_CLASSID,2);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,6);
+  PetscValidHeaderSpecific(y,VEC_CLASSID,7);
+  PetscValidLogicalCollectiveScalar(z,alpha,3);
+  PetscValidLogicalCollectiveScalar(z,beta,4);
+  PetscValidLogicalCollectiveScalar(z,gamma,5);
+  if (x == y || x == z || y == z) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_IDN,"x, y and z must be different vectors");
+  ierr = VecProgramAddOp_Private(prog,VEC_PROGRAM_AXPBYPCZ,z,x,y,alpha,beta,gamma,NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   VecProgramWAXPY - Records w = alpha x + y in a vector program
+
+   Logically Collective on Vec
+
+   Input Parameters:
++  prog - the vector program
+.  w - the vector set
+.  alpha - the scalar
+.  x - the first vector
+-  y - the second vector
+
+   Level: advanced
+
+.seealso: VecWAXPY(), VecProgramCreate(), VecProgramBegin()
+@*/
+PetscErrorCode VecProgramWAXPY(VecProgram prog,Vec w,PetscScalar alpha,Vec x,Vec y)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidPointer(prog,1);
+  PetscValidHeaderSpecific(w,VEC_CLASSID,2);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,4);
+  PetscValidHeaderSpecific(y,VEC_CLASSID,5);
+  PetscValidLogicalCollectiveScalar(w,alpha,3);
+  if (w == x || w == y) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_IDN,"w cannot be the same vector as x or y");
+  ierr = VecProgramAddOp_Private(prog,VEC_PROGRAM_WAXPY,w,x,y,alpha,0.0,0.0,NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   VecProgramDot - Records the dot product (x,y) in a vector program
+
+   Collective on Vec, when the program is executed
+
+   Input Parameters:
++  prog - the vector program
+.  x - the first vector
+.  y - the second vector
+-  result - where VecProgramEnd() puts the result
+
+   Notes:
+   The dot product is computed with the values of x and y after all the updates recorded in the program, which must
+   precede the reductions.
+
+   Level: advanced
+
+.seealso: VecDot(), VecProgramTDot(), VecProgramNorm(), VecProgramCreate(), VecProgramBegin(), VecProgramEnd()
+@*/
+PetscErrorCode VecProgramDot(VecProgram prog,Vec x,Vec y,PetscScalar *result)
+{
+  VecProgramOp   *op;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidPointer(prog,1);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,2);
+  PetscValidHeaderSpecific(y,VEC_CLASSID,3);
+  PetscValidScalarPointer(result,4);
+  ierr       = VecProgramAddOp_Private(prog,VEC_PROGRAM_DOT,NULL,x,y,0.0,0.0,0.0,&op);CHKERRQ(ierr);
+  op->result = result;
+  op->slot   = prog->nreductions++;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   VecProgramTDot - Records the indefinite dot product x^T y in a vector program
+
+   Collective on Vec, when the program is executed
+
+   Input Parameters:
++  prog - the vector program
+.  x - the first vector
+.  y - the second vector
+-  result - where VecProgramEnd() puts the result
+
+   Level: advanced
+
+.seealso: VecTDot(), VecProgramDot(), VecProgramCreate(), VecProgramBegin(), VecProgramEnd()
+@*/
+PetscErrorCode VecProgramTDot(VecProgram prog,Vec x,Vec y,PetscScalar *result)
+{
+  VecProgramOp   *op;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidPointer(prog,1);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,2);
+  PetscValidHeaderSpecific(y,VEC_CLASSID,3);
+  PetscValidScalarPointer(result,4);
+  ierr       = VecProgramAddOp_Private(prog,VEC_PROGRAM_TDOT,NULL,x,y,0.0,0.0,0.0,&op);CHKERRQ(ierr);
+  op->result = result;
+  op->slot   = prog->nreductions++;
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   VecProgramNorm - Records a norm of a vector in a vector program
+
+   Collective on Vec, when the program is executed
+
+   Input Parameters:
++  prog - the vector program
+.  x - the vector
+.  ntype - one of NORM_1, NORM_2, NORM_INFINITY or NORM_1_AND_2
+-  result - where VecProgramEnd() puts the result, two values for NORM_1_AND_2
+
+   Level: advanced
+
+.seealso: VecNorm(), VecProgramDot(), VecProgramCreate(), VecProgramBegin(), VecProgramEnd()
+@*/
+PetscErrorCode VecProgramNorm(VecProgram prog,Vec x,NormType ntype,PetscReal *result)
+{
+  VecProgramOp   *op;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidPointer(prog,1);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,2);
+  PetscValidRealPointer(result,4);
+  if (ntype == NORM_FROBENIUS) ntype = NORM_2;
+  ierr              = VecProgramAddOp_Private(prog,VEC_PROGRAM_NORM,NULL,x,NULL,0.0,0.0,0.0,&op);CHKERRQ(ierr);
+  op->ntype         = ntype;
+  op->result        = result;
+  op->slot          = prog->nreductions;
+  prog->nreductions += ntype == NORM_1_AND_2 ? 2 : 1;
+  PetscFunctionReturn(0);
+}
+
+typedef struct {
+  VecProgram  prog;
+  PetscInt    n;
+  PetscScalar **arrays;                /* the arrays of the vectors of the program */
+  PetscInt    stride;                  /* distance between the local results of two threads */
+  PetscScalar *partial;                /* local results of the reductions, stride entries per thread */
+} VecProgramCtx;
+
+/* executes the program on the part of the arrays of thread tid */
+static void VecProgramKernel_Private(PetscInt tid,PetscInt nthreads,void *vctx)
+{
+  VecProgramCtx     *ctx  = (VecProgramCtx*)vctx;
+  VecProgram        prog  = ctx->prog;
+  PetscScalar       *red  = ctx->partial + tid*ctx->stride,a,b,c,*w;
+  const PetscScalar *x,*y;
+  PetscReal         tmp,mx;
+  PetscInt          start,end,bs,be,i,k;
+
+  PetscThreadPoolGetRange(ctx->n,tid,nthreads,&start,&end);
+  for (k=0; k<prog->nreductions; k++) red[k] = 0.0;
+  for (bs=start; bs<end; bs+=VEC_PROGRAM_BLOCK) {
+    be = PetscMin(bs+VEC_PROGRAM_BLOCK,end);
+    for (k=0; k<prog->nops; k++) {
+      const VecProgramOp *op = &prog->ops[k];
+
+      w = op->iw >= 0 ? ctx->arrays[op->iw] : NULL;
+      x = op->ix >= 0 ? ctx->arrays[op->ix] : NULL;
+      y = op->iy >= 0 ? ctx->arrays[op->iy] : NULL;
+      a = op->alpha; b = op->beta; c = op->gamma;
+      switch (op->type) {
+      case VEC_PROGRAM_AXPY:
+        for (i=bs; i<be; i++) w[i] += a*x[i];
+        break;
+      case VEC_PROGRAM_AYPX:
+        for (i=bs; i<be; i++) w[i] = x[i] + a*w[i];
+        break;
+      case VEC_PROGRAM_AXPBY:
+        for (i=bs; i<be; i++) w[i] = a*x[i] + b*w[i];
+        break;
+      case VEC_PROGRAM_AXPBYPCZ:
+        for (i=bs; i<be; i++) w[i] = a*x[i] + b*y[i] + c*w[i];
+        break;
+      case VEC_PROGRAM_WAXPY:
+        for (i=bs; i<be; i++) w[i] = a*x[i] + y[i];
+        break;
+      case VEC_PROGRAM_DOT:
+        a = 0.0;
+        for (i=bs; i<be; i++) a += x[i]*PetscConj(y[i]);
+        red[op->slot] += a;
+        break;
+      case VEC_PROGRAM_TDOT:
+        a = 0.0;
+        for (i=bs; i<be; i++) a += x[i]*y[i];
+        red[op->slot] += a;
+        break;
+      case VEC_PROGRAM_NORM:
+        if (op->ntype == NORM_INFINITY) {
+          mx = PetscRealPart(red[op->slot]);
+          for (i=bs; i<be; i++) {
+            tmp = PetscAbsScalar(x[i]);
+            if (tmp > mx || tmp != tmp) mx = tmp;
+          }
+          red[op->slot] = mx;
+        } else {
+          PetscInt  s  = op->slot;
+          PetscReal s1 = 0.0,s2 = 0.0;
+
+          if (op->ntype != NORM_2) {
+            for (i=bs; i<be; i++) s1 += PetscAbsScalar(x[i]);
+            red[s++] += s1;
+          }
+          if (op->ntype != NORM_1) {
+            for (i=bs; i<be; i++) s2 += PetscRealPart(x[i]*PetscConj(x[i]));
+            red[s] += s2;
+          }
+        }
+        break;
+      }
+    }
+  }
+}
+
+/*@C
+   VecProgramBegin - Executes the vector updates of a program and starts its reductions
+
+   Collective on Vec
+
+   Input Parameter:
+.  prog - the vector program
+
+   Notes:
+   For VECSEQ and VECMPI vectors all the operations are done in one pass over the vectors, split among the threads
+   of the thread pool for large vectors; for other vector types they are done one after the other. The reductions are
+   started with the split phase reductions of the communicator, so they share one MPI reduction with the
+   VecDotBegin() and VecNormBegin() called before VecProgramEnd(). PetscCommSplitReductionBegin() can be called next to
+   overlap the communication with other work.
+
+   The updates are done when VecProgramBegin() returns; the results of the reductions are available after
+   VecProgramEnd().
+
+   Level: advanced
+
+.seealso: VecProgramEnd(), VecProgramCreate(), PetscCommSplitReductionBegin(), VecDotBegin()
+@*/
+PetscErrorCode VecProgramBegin(VecProgram prog)
+{
+  VecProgramCtx       ctx;
+  PetscSplitReduction *sr = NULL;
+  PetscBool           native = PETSC_TRUE;
+  PetscInt            i,k,n,nthreads,s;
+  PetscLogDouble      flops = 0.0;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  PetscValidPointer(prog,1);
+  if (prog->begun) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"VecProgramBegin() called twice without VecProgramEnd()");
+  prog->begun = PETSC_TRUE;
+  if (!prog->nops) PetscFunctionReturn(0);
+  for (i=0; i<prog->nvecs && native; i++) {
+    ierr = PetscObjectTypeCompareAny((PetscObject)prog->vecs[i],&native,VECSEQ,VECMPI,"");CHKERRQ(ierr);
+  }
+
+  if (!native) {
+    /* other vector types keep their own implementations of the operations */
+    for (k=0; k<prog->nops; k++) {
+      VecProgramOp *op = &prog->ops[k];
+
+      switch (op->type) {
+      case VEC_PROGRAM_AXPY:     ierr = VecAXPY(op->w,op->alpha,op->x);CHKERRQ(ierr); break;
+      case VEC_PROGRAM_AYPX:     ierr = VecAYPX(op->w,op->alpha,op->x);CHKERRQ(ierr); break;
+      case VEC_PROGRAM_AXPBY:    ierr = VecAXPBY(op->w,op->alpha,op->beta,op->x);CHKERRQ(ierr); break;
+      case VEC_PROGRAM_AXPBYPCZ: ierr = VecAXPBYPCZ(op->w,op->alpha,op->beta,op->gamma,op->x,op->y);CHKERRQ(ierr); break;
+      case VEC_PROGRAM_WAXPY:    ierr = VecWAXPY(op->w,op->alpha,op->x,op->y);CHKERRQ(ierr); break;
+      case VEC_PROGRAM_DOT:      ierr = VecDotBegin(op->x,op->y,(PetscScalar*)op->result);CHKERRQ(ierr); break;
+      case VEC_PROGRAM_TDOT:     ierr = VecTDotBegin(op->x,op->y,(PetscScalar*)op->result);CHKERRQ(ierr); break;
+      case VEC_PROGRAM_NORM:     ierr = VecNormBegin(op->x,op->ntype,(PetscReal*)op->result);CHKERRQ(ierr); break;
+      }
+    }
+    PetscFunctionReturn(0);
+  }
+
+  n = prog->vecs[0]->map->n;
+  ierr = PetscLogEventBegin(VEC_Ops,0,0,0,0);CHKERRQ(ierr);
+  nthreads = 1;
+  if (VecSeqUseThreads_Private(n)) {ierr = PetscThreadPoolGetSize(&nthreads);CHKERRQ(ierr);}
+  ctx.prog   = prog;
+  ctx.n      = n;
+  ctx.stride = ((prog->nreductions + 7)/8)*8;
+  ierr = PetscMalloc2(prog->nvecs,&ctx.arrays,nthreads*ctx.stride,&ctx.partial);CHKERRQ(ierr);
+  for (i=0; i<prog->nvecs; i++) {
+    if (prog->written[i]) {ierr = VecGetArray(prog->vecs[i],&ctx.arrays[i]);CHKERRQ(ierr);}
+    else {ierr = VecGetArrayRead(prog->vecs[i],(const PetscScalar**)&ctx.arrays[i]);CHKERRQ(ierr);}
+  }
+  if (nthreads > 1) {
+    ierr = PetscThreadPoolRun(VecProgramKernel_Private,&ctx);CHKERRQ(ierr);
+  } else {
+    VecProgramKernel_Private(0,1,&ctx);
+  }
+  for (i=0; i<prog->nvecs; i++) {
+    if (prog->written[i]) {ierr = VecRestoreArray(prog->vecs[i],&ctx.arrays[i]);CHKERRQ(ierr);}
+    else {ierr = VecRestoreArrayRead(prog->vecs[i],(const PetscScalar**)&ctx.arrays[i]);CHKERRQ(ierr);}
+  }
+
+  /* queue the local results in the split reduction, as VecDotBegin() and VecNormBegin() do */
+  if (prog->nreductions) {
+    ierr = PetscSplitReductionGet(PetscObjectComm((PetscObject)prog->vecs[0]),&sr);CHKERRQ(ierr);
+    if (sr->numdeferred) {ierr = PetscSplitReductionFlush(sr);CHKERRQ(ierr);}
+    if (sr->state != STATE_BEGIN) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"Called before all VecxxxEnd() called");
+    while (sr->numopsbegin + prog->nreductions > sr->maxops) {ierr = PetscSplitReductionExtend(sr);CHKERRQ(ierr);}
+  }
+  for (k=0; k<prog->nops; k++) {
+    VecProgramOp *op = &prog->ops[k];
+    PetscInt     nvals = 0;
+
+    switch (op->type) {
+    case VEC_PROGRAM_AXPY:     flops += 2.0*n; break;
+    case VEC_PROGRAM_AYPX:     flops += 2.0*n; break;
+    case VEC_PROGRAM_AXPBY:    flops += 3.0*n; break;
+    case VEC_PROGRAM_AXPBYPCZ: flops += 5.0*n; break;
+    case VEC_PROGRAM_WAXPY:    flops += 2.0*n; break;
+    case VEC_PROGRAM_DOT:
+    case VEC_PROGRAM_TDOT:     flops += 2.0*n; nvals = 1; break;
+    case VEC_PROGRAM_NORM:
+      if (op->ntype == NORM_1_AND_2)      {flops += 3.0*n; nvals = 2;}
+      else if (op->ntype == NORM_1)       {flops += n;     nvals = 1;}
+      else if (op->ntype == NORM_INFINITY) nvals = 1;
+      else                                {flops += 2.0*n; nvals = 1;}
+      break;
+    }
+    for (s=op->slot; s<op->slot+nvals; s++) {
+      PetscScalar value = ctx.partial[s];
+
+      if (op->type == VEC_PROGRAM_NORM && op->ntype == NORM_INFINITY) {
+        for (i=1; i<nthreads; i++) {
+          PetscReal tmp = PetscRealPart(ctx.partial[i*ctx.stride+s]);
+          if (tmp > PetscRealPart(value) || tmp != tmp) value = tmp;
+        }
+        sr->reducetype[sr->numopsbegin] = PETSC_SR_REDUCE_MAX;
+      } else {
+        for (i=1; i<nthreads; i++) value += ctx.partial[i*ctx.stride+s];
+        sr->reducetype[sr->numopsbegin] = PETSC_SR_REDUCE_SUM;
+      }
+      sr->invecs[sr->numopsbegin]    = (void*)op->x;
+      sr->lvalues[sr->numopsbegin++] = value;
+    }
+  }
+  ierr = PetscFree2(ctx.arrays,ctx.partial);CHKERRQ(ierr);
+  ierr = PetscLogFlops(flops);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(VEC_Ops,0,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+   VecProgramEnd - Ends the reductions of a vector program, puts their results where requested, and empties the program
+
+   Collective on Vec
+
+   Input Parameter:
+.  prog - the vector program
+
+   Notes:
+   The reductions of the program end in the order they were recorded, so the VecDotEnd() and VecNormEnd() of split
+   phase reductions started before VecProgramBegin() must be called before VecProgramEnd(), and those started after
+   it after VecProgramEnd().
+
+   Level: advanced
+
+.seealso: VecProgramBegin(), VecProgramCreate(), VecDotEnd()
+@*/
+PetscErrorCode VecProgramEnd(VecProgram prog)
+{
+  PetscInt       k;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidPointer(prog,1);
+  if (!prog->begun) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ORDER,"VecProgramEnd() called without VecProgramBegin()");
+  for (k=0; k<prog->nops; k++) {
+    VecProgramOp *op = &prog->ops[k];
+
+    switch (op->type) {
+    case VEC_PROGRAM_DOT:  ierr = VecDotEnd(op->x,op->y,(PetscScalar*)op->result);CHKERRQ(ierr); break;
+    case VEC_PROGRAM_TDOT: ierr = VecTDotEnd(op->x,op->y,(PetscScalar*)op->result);CHKERRQ(ierr); break;
+    case VEC_PROGRAM_NORM: ierr = VecNormEnd(op->x,op->ntype,(PetscReal*)op->result);CHKERRQ(ierr); break;
+    default: break;
+    }
+  }
+  prog->nops        = 0;
+  prog->nvecs       = 0;
+  prog->nreductions = 0;
+  prog->begun       = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
@@ -124,4 +124,11 @@ int main(int argc,char **argv)
       output_file: output/ex2_5.out
       requires:  define(PETSC_HAVE_MPI_WIN_CREATE_FEATURE)
 
+   test:
+      suffix: 6
+      nsize: 3
+      args: -vecscatter_type mpineighbor
+      output_file: output/ex2_5.out
+      requires:  define(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+
 TEST*/
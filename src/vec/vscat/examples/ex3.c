@@ -127,4 +127,11 @@ int main(int argc,char **argv)
       output_file: output/ex3_5.out
       requires:  define(PETSC_HAVE_MPI_WIN_CREATE_FEATURE)
 
+   test:
+      suffix: 6
+      nsize: 2
+      args: -bs 2 -vecscatter_type mpineighbor
+      output_file: output/ex3_3.out
+      requires:  define(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+
 TEST*/
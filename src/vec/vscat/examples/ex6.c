@@ -0,0 +1,104 @@
+static char help[]= "Tests ADD_VALUES and MAX_VALUES of sequential scatters whose indices are contiguous runs, which are done with memcpy plans.\n\n";
+
+#include <petscvec.h>
+
+/* scatters x into y with addv, from y into x when reverse, and compares y with its expected values */
+static PetscErrorCode CheckScatter(VecScatter vscat,PetscBool reverse,Vec x,Vec y,InsertMode addv,const PetscInt idx[])
+{
+  PetscInt          i,n;
+  PetscScalar       *yv,expected;
+  const PetscScalar *y0;
+  Vec               w;
+  PetscBool         ok = PETSC_TRUE;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = VecGetLocalSize(y,&n);CHKERRQ(ierr);
+  ierr = VecGetArray(y,&yv);CHKERRQ(ierr);
+  for (i=0; i<n; i++) yv[i] = (i % 2) ? 1000.0 : -1.0;
+  ierr = VecRestoreArray(y,&yv);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&w);CHKERRQ(ierr);
+  ierr = VecCopy(y,w);CHKERRQ(ierr);
+
+  if (reverse) {
+    ierr = VecScatterBegin(vscat,x,y,addv,SCATTER_REVERSE);CHKERRQ(ierr);
+    ierr = VecScatterEnd(vscat,x,y,addv,SCATTER_REVERSE);CHKERRQ(ierr);
+  } else {
+    ierr = VecScatterBegin(vscat,x,y,addv,SCATTER_FORWARD);CHKERRQ(ierr);
+    ierr = VecScatterEnd(vscat,x,y,addv,SCATTER_FORWARD);CHKERRQ(ierr);
+  }
+
+  /* x[i] = i, so the value gathered in y[i] is idx[i] */
+  ierr = VecGetArray(y,&yv);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(w,&y0);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    if (addv == ADD_VALUES) expected = y0[i] + idx[i];
+    else expected = PetscMax(PetscRealPart(y0[i]),(PetscReal)idx[i]);
+    if (yv[i] != expected) ok = PETSC_FALSE;
+  }
+  ierr = VecRestoreArrayRead(w,&y0);CHKERRQ(ierr);
+  ierr = VecRestoreArray(y,&yv);CHKERRQ(ierr);
+  ierr = VecDestroy(&w);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF,"%s %s: %s\n",reverse ? "Reverse" : "Forward",addv == ADD_VALUES ? "ADD_VALUES" : "MAX_VALUES",ok ? "ok" : "wrong");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,n = 64,N,*idx;
+  PetscScalar    *xv;
+  Vec            x,y;
+  IS             isx,isy;
+  VecScatter     vscat,rscat;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+
+  /* x[i] = i, and y gathers two runs of n entries of x, far apart, so the plan has two copies */
+  N    = 8*n;
+  ierr = VecCreateSeq(PETSC_COMM_SELF,N,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(x,&xv);CHKERRQ(ierr);
+  for (i=0; i<N; i++) xv[i] = i;
+  ierr = VecRestoreArray(x,&xv);CHKERRQ(ierr);
+  ierr = VecCreateSeq(PETSC_COMM_SELF,2*n,&y);CHKERRQ(ierr);
+  ierr = PetscMalloc1(2*n,&idx);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    idx[i]   = n/4 + i;
+    idx[n+i] = 5*n + i;
+  }
+  ierr = ISCreateGeneral(PETSC_COMM_SELF,2*n,idx,PETSC_USE_POINTER,&isx);CHKERRQ(ierr);
+  ierr = ISCreateStride(PETSC_COMM_SELF,2*n,0,1,&isy);CHKERRQ(ierr);
+
+  /* general to stride 1 packs x in the forward scatter, stride 1 to general packs x in the reverse scatter */
+  ierr = VecScatterCreateWithData(x,isx,y,isy,&vscat);CHKERRQ(ierr);
+  ierr = VecScatterCreateWithData(y,isy,x,isx,&rscat);CHKERRQ(ierr);
+  ierr = CheckScatter(vscat,PETSC_FALSE,x,y,ADD_VALUES,idx);CHKERRQ(ierr);
+  ierr = CheckScatter(vscat,PETSC_FALSE,x,y,MAX_VALUES,idx);CHKERRQ(ierr);
+  ierr = CheckScatter(rscat,PETSC_TRUE,x,y,ADD_VALUES,idx);CHKERRQ(ierr);
+  ierr = CheckScatter(rscat,PETSC_TRUE,x,y,MAX_VALUES,idx);CHKERRQ(ierr);
+
+  ierr = VecScatterDestroy(&vscat);CHKERRQ(ierr);
+  ierr = VecScatterDestroy(&rscat);CHKERRQ(ierr);
+  ierr = ISDestroy(&isx);CHKERRQ(ierr);
+  ierr = ISDestroy(&isy);CHKERRQ(ierr);
+  ierr = PetscFree(idx);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   build:
+      requires: !complex
+
+   test:
+
+   test:
+      suffix: 2
+      args: -n 1000
+      output_file: output/ex6_1.out
+
+TEST*/
@@ -85,6 +85,101 @@ PetscErrorCode VecScatterView_MPI_MPI1(VecScatter ctx,PetscViewer viewer)
 }
 
 /* -------------------------------------------------------------------------------------*/
+/*
+   A message whose memcpy plan is a single copy is one contiguous run of the vector, so VecScatterBegin() can send it
+   directly from the vector array without packing it; these sends get their own requests since the persistent ones
+   are bound to the values buffer
+*/
+static PetscErrorCode VecScatterZeroCopyCreate_Private(VecScatter_MPI_General *X,PetscMPIInt tag)
+{
+  PetscErrorCode ierr;
+  PetscInt       i;
+
+  PetscFunctionBegin;
+  X->sendtag    = tag;
+  X->zcrequests = NULL;
+  for (i=0; i<X->n; i++) {
+    if (X->memcpy_plan.optimized[i] && X->memcpy_plan.copy_offsets[i+1] == X->memcpy_plan.copy_offsets[i]+1) break;
+  }
+  if (i == X->n) PetscFunctionReturn(0);
+  ierr = PetscMalloc1(X->n,&X->zcrequests);CHKERRQ(ierr);
+  for (i=0; i<X->n; i++) X->zcrequests[i] = MPI_REQUEST_NULL;
+  PetscFunctionReturn(0);
+}
+
+#if defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+/*
+   Builds, for each side of the scatter, the distributed graph communicator from the procs of the other side
+   (the sources) to its own procs (the destinations) so that a scatter sending from that side is one neighborhood collective
+*/
+static PetscErrorCode VecScatterNeighborCreate_Private(VecScatter ctx)
+{
+  VecScatter_MPI_General *to   = (VecScatter_MPI_General*)ctx->todata;
+  VecScatter_MPI_General *from = (VecScatter_MPI_General*)ctx->fromdata;
+  VecScatter_MPI_General *sides[2],*X,*Y;
+  PetscErrorCode         ierr;
+  PetscInt               i,k,bs = to->bs;
+  PetscMPIInt            empty = 0;
+  MPI_Comm               comm;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)ctx,&comm);CHKERRQ(ierr);
+  sides[0] = to; sides[1] = from;
+  for (k=0; k<2; k++) {
+    X    = sides[k];
+    ierr = PetscMalloc2(X->n,&X->counts,X->n,&X->displs);CHKERRQ(ierr);
+    for (i=0; i<X->n; i++) {
+      ierr = PetscMPIIntCast(bs*(X->starts[i+1]-X->starts[i]),&X->counts[i]);CHKERRQ(ierr);
+      ierr = PetscMPIIntCast(bs*X->starts[i],&X->displs[i]);CHKERRQ(ierr);
+    }
+  }
+  for (k=0; k<2; k++) {
+    X    = sides[k];
+    Y    = sides[1-k];
+    /* the message lengths are the edge weights on every process, the address of empty stands for an empty list */
+    ierr = MPI_Dist_graph_create_adjacent(comm,Y->n,Y->n ? Y->procs : &empty,Y->n ? Y->counts : &empty,X->n,X->n ? X->procs : &empty,X->n ? X->counts : &empty,MPI_INFO_NULL,0,&X->neighcomm);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_MPI_PERSISTENT_NEIGHBORHOOD_COLLECTIVES)
+    ierr = MPI_Neighbor_alltoallv_init(X->values,X->counts,X->displs,MPIU_SCALAR,Y->values,Y->counts,Y->displs,MPIU_SCALAR,X->neighcomm,MPI_INFO_NULL,&X->neighreq);CHKERRQ(ierr);
+#endif
+    X->neighbor = PETSC_TRUE;
+  }
+  PetscFunctionReturn(0);
+}
+
+/* starts the neighborhood collective sending the packed values of to into the values of from */
+static PetscErrorCode VecScatterNeighborStart_Private(VecScatter_MPI_General *to,VecScatter_MPI_General *from)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_MPI_PERSISTENT_NEIGHBORHOOD_COLLECTIVES)
+  ierr = MPI_Start(&to->neighreq);CHKERRQ(ierr);
+#else
+  ierr = MPI_Ineighbor_alltoallv(to->values,to->counts,to->displs,MPIU_SCALAR,from->values,from->counts,from->displs,MPIU_SCALAR,to->neighcomm,&to->neighreq);CHKERRQ(ierr);
+#endif
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecScatterNeighborDestroy_Private(VecScatter_MPI_General *to,VecScatter_MPI_General *from)
+{
+  VecScatter_MPI_General *sides[2];
+  PetscErrorCode         ierr;
+  PetscInt               k;
+
+  PetscFunctionBegin;
+  sides[0] = to; sides[1] = from;
+  for (k=0; k<2; k++) {
+    if (!sides[k]->neighbor) continue;
+#if defined(PETSC_HAVE_MPI_PERSISTENT_NEIGHBORHOOD_COLLECTIVES)
+    ierr = MPI_Request_free(&sides[k]->neighreq);CHKERRQ(ierr);
+#endif
+    ierr = MPI_Comm_free(&sides[k]->neighcomm);CHKERRQ(ierr);
+    ierr = PetscFree2(sides[k]->counts,sides[k]->displs);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+#endif
+
 PetscErrorCode VecScatterDestroy_PtoP_MPI1(VecScatter ctx)
 {
   VecScatter_MPI_General *to   = (VecScatter_MPI_General*)ctx->todata;
@@ -116,6 +211,9 @@ PetscErrorCode VecScatterDestroy_PtoP_MPI1(VecScatter ctx)
     }
   }
 
+#if defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+  ierr = VecScatterNeighborDestroy_Private(to,from);CHKERRQ(ierr);
+#endif
   ierr = PetscFree(to->local.vslots);CHKERRQ(ierr);
   ierr = PetscFree(from->local.vslots);CHKERRQ(ierr);
   ierr = PetscFree(to->local.slots_nonmatching);CHKERRQ(ierr);
@@ -124,6 +222,8 @@ PetscErrorCode VecScatterDestroy_PtoP_MPI1(VecScatter ctx)
   ierr = PetscFree(from->rev_requests);CHKERRQ(ierr);
   ierr = PetscFree(to->requests);CHKERRQ(ierr);
   ierr = PetscFree(from->requests);CHKERRQ(ierr);
+  ierr = PetscFree(to->zcrequests);CHKERRQ(ierr);
+  ierr = PetscFree(from->zcrequests);CHKERRQ(ierr);
   ierr = PetscFree4(to->values,to->indices,to->starts,to->procs);CHKERRQ(ierr);
   ierr = PetscFree2(to->sstatus,to->rstatus);CHKERRQ(ierr);
   ierr = PetscFree4(from->values,from->indices,from->starts,from->procs);CHKERRQ(ierr);
@@ -232,6 +332,11 @@ PetscErrorCode VecScatterCopy_PtoP_X_MPI1(VecScatter in,VecScatter out)
   }
 
   ierr = VecScatterMemcpyPlanCopy_PtoP(in_to,in_from,out_to,out_from);CHKERRQ(ierr);
+  ierr = VecScatterZeroCopyCreate_Private(out_to,((PetscObject)out)->tag);CHKERRQ(ierr);
+  ierr = VecScatterZeroCopyCreate_Private(out_from,((PetscObject)out)->tag);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+  if (in_to->neighbor) {ierr = VecScatterNeighborCreate_Private(out);CHKERRQ(ierr);}
+#endif
   PetscFunctionReturn(0);
 }
 
@@ -2326,6 +2431,8 @@ PetscErrorCode VecScatterCreateCommon_PtoS_MPI1(VecScatter_MPI_General *from,Vec
   ctx->ops->view = VecScatterView_MPI_MPI1;
   /* try to optimize PtoP vecscatter with memcpy's */
   ierr = VecScatterMemcpyPlanCreate_PtoP(to,from);CHKERRQ(ierr);
+  ierr = VecScatterZeroCopyCreate_Private(to,tag);CHKERRQ(ierr);
+  ierr = VecScatterZeroCopyCreate_Private(from,tagr);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -2555,3 +2662,29 @@ PetscErrorCode VecScatterCreate_MPI1(VecScatter ctx)
   PetscFunctionReturn(0);
 }
 
+
+#if defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+static PetscErrorCode VecScatterSetUp_MPINeighbor(VecScatter ctx)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecScatterSetUp_MPI1(ctx);CHKERRQ(ierr);
+  /* only the general parallel scatters exchange messages with a few neighbors; the others keep their MPI1 implementation */
+  if (((VecScatter_Common*)ctx->todata)->format == VEC_SCATTER_MPI_GENERAL) {
+    ierr = VecScatterNeighborCreate_Private(ctx);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecScatterCreate_MPINeighbor(VecScatter ctx)
+{
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ctx->ops->setup = VecScatterSetUp_MPINeighbor;
+  ierr = PetscObjectChangeTypeName((PetscObject)ctx,VECSCATTERMPINEIGHBOR);CHKERRQ(ierr);
+  ierr = PetscInfo(ctx,"Using MPI3 neighborhood collectives for vector scatter\n");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
@@ -16,6 +16,7 @@ PetscErrorCode PETSCMAP1(VecScatterBeginMPI1)(VecScatter ctx,Vec xin,Vec yin,Ins
   MPI_Request            *rwaits,*swaits;
   PetscErrorCode         ierr;
   PetscInt               i,*indices,*sstarts,nrecvs,nsends,bs;
+  PetscBool              zerocopy;
 #if defined(PETSC_HAVE_CUDA)
   PetscBool              is_cudatype = PETSC_FALSE;
 #endif
@@ -60,17 +61,39 @@ PetscErrorCode PETSCMAP1(VecScatterBeginMPI1)(VecScatter ctx,Vec xin,Vec yin,Ins
   else yv = xv;
 
   if (!(mode & SCATTER_LOCAL)) {
-    /* post receives since they were not previously posted    */
-    if (nrecvs) {ierr = MPI_Startall_irecv(from->starts[nrecvs]*bs,nrecvs,rwaits);CHKERRQ(ierr);}
+#if defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+    if (to->neighbor) {
+      /* pack all the messages, then one neighborhood collective sends them */
+      for (i=0; i<nsends; i++) {
+        if (to->memcpy_plan.optimized[i]) {
+          ierr = VecScatterMemcpyPlanExecute_Pack(i,xv,&to->memcpy_plan,svalues+bs*sstarts[i],INSERT_VALUES,bs);CHKERRQ(ierr);
+        } else {
+          PETSCMAP1(Pack_MPI1)(sstarts[i+1]-sstarts[i],indices + sstarts[i],xv,svalues + bs*sstarts[i],bs);
+        }
+      }
+      ierr = VecScatterNeighborStart_Private(to,from);CHKERRQ(ierr);
+    } else
+#endif
+    {
+      /* post receives since they were not previously posted    */
+      if (nrecvs) {ierr = MPI_Startall_irecv(from->starts[nrecvs]*bs,nrecvs,rwaits);CHKERRQ(ierr);}
 
-    /* this version packs and sends one at a time */
-    for (i=0; i<nsends; i++) {
-      if (to->memcpy_plan.optimized[i]) { /* use memcpy instead of indivisual load/store */
-        ierr = VecScatterMemcpyPlanExecute_Pack(i,xv,&to->memcpy_plan,svalues+bs*sstarts[i],INSERT_VALUES,bs);CHKERRQ(ierr);
-      } else {
-        PETSCMAP1(Pack_MPI1)(sstarts[i+1]-sstarts[i],indices + sstarts[i],xv,svalues + bs*sstarts[i],bs);
+      /* the contiguous messages can be sent from x only while nothing writes into it before VecScatterEnd() */
+      zerocopy = (to->zcrequests && xin != yin && xin->petscnative) ? PETSC_TRUE : PETSC_FALSE;
+
+      /* this version packs and sends one at a time */
+      for (i=0; i<nsends; i++) {
+        if (zerocopy && to->memcpy_plan.optimized[i] && to->memcpy_plan.copy_offsets[i+1] == to->memcpy_plan.copy_offsets[i]+1) {
+          ierr = MPI_Isend(xv+to->memcpy_plan.copy_starts[to->memcpy_plan.copy_offsets[i]],bs*(sstarts[i+1]-sstarts[i]),MPIU_SCALAR,to->procs[i],to->sendtag,PetscObjectComm((PetscObject)ctx),to->zcrequests+i);CHKERRQ(ierr);
+          continue;
+        }
+        if (to->memcpy_plan.optimized[i]) { /* use memcpy instead of indivisual load/store */
+          ierr = VecScatterMemcpyPlanExecute_Pack(i,xv,&to->memcpy_plan,svalues+bs*sstarts[i],INSERT_VALUES,bs);CHKERRQ(ierr);
+        } else {
+          PETSCMAP1(Pack_MPI1)(sstarts[i+1]-sstarts[i],indices + sstarts[i],xv,svalues + bs*sstarts[i],bs);
+        }
+        ierr = MPI_Start_isend((sstarts[i+1]-sstarts[i])*bs,swaits+i);CHKERRQ(ierr);
       }
-      ierr = MPI_Start_isend((sstarts[i+1]-sstarts[i])*bs,swaits+i);CHKERRQ(ierr);
     }
   }
 
@@ -103,6 +126,9 @@ PetscErrorCode PETSCMAP1(VecScatterEndMPI1)(VecScatter ctx,Vec xin,Vec yin,Inser
   PetscScalar            *rvalues,*yv;
   PetscErrorCode         ierr;
   PetscInt               nrecvs,nsends,*indices,count,*rstarts,bs;
+#if defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+  PetscInt               i;
+#endif
   PetscMPIInt            imdex;
   MPI_Request            *rwaits,*swaits;
   MPI_Status             xrstatus,*sstatus;
@@ -129,6 +155,22 @@ PetscErrorCode PETSCMAP1(VecScatterEndMPI1)(VecScatter ctx,Vec xin,Vec yin,Inser
   indices = from->indices;
   rstarts = from->starts;
 
+#if defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+  if (to->neighbor) {
+    /* the sending side owns the request of the neighborhood collective */
+    ierr = MPI_Wait(&to->neighreq,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+    for (i=0; i<nrecvs; i++) {
+      if (from->memcpy_plan.optimized[i]) {
+        ierr = VecScatterMemcpyPlanExecute_Unpack(i,rvalues+bs*rstarts[i],yv,&from->memcpy_plan,addv,bs);CHKERRQ(ierr);
+      } else {
+        ierr = PETSCMAP1(UnPack_MPI1)(rstarts[i+1] - rstarts[i],rvalues + bs*rstarts[i],indices + rstarts[i],yv,addv,bs);CHKERRQ(ierr);
+      }
+    }
+    ierr = VecRestoreArray(yin,&yv);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
+
   /* unpack one at a time */
   count = nrecvs;
   while (count) {
@@ -142,8 +184,9 @@ PetscErrorCode PETSCMAP1(VecScatterEndMPI1)(VecScatter ctx,Vec xin,Vec yin,Inser
     count--;
   }
 
-  /* wait on sends */
+  /* wait on sends; the persistent requests of the sends done from the array of x were not started */
   if (nsends) {ierr = MPI_Waitall(nsends,swaits,sstatus);CHKERRQ(ierr);}
+  if (nsends && to->zcrequests) {ierr = MPI_Waitall(nsends,to->zcrequests,MPI_STATUSES_IGNORE);CHKERRQ(ierr);}
   ierr = VecRestoreArray(yin,&yv);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -85,6 +85,9 @@ PetscErrorCode VecScatterRegisterAll(void)
 
   ierr = VecScatterRegister(VECSCATTERSEQ,        VecScatterCreate_Seq);CHKERRQ(ierr);
   ierr = VecScatterRegister(VECSCATTERMPI1,       VecScatterCreate_MPI1);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+  ierr = VecScatterRegister(VECSCATTERMPINEIGHBOR, VecScatterCreate_MPINeighbor);CHKERRQ(ierr);
+#endif
 #if defined(PETSC_HAVE_MPI_WIN_CREATE_FEATURE)
   ierr = VecScatterRegister(VECSCATTERMPI3,       VecScatterCreate_MPI3);CHKERRQ(ierr);
   ierr = VecScatterRegister(VECSCATTERMPI3NODE,   VecScatterCreate_MPI3Node);CHKERRQ(ierr);